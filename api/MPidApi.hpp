@@ -3,7 +3,7 @@
 //! @author 		Geoffrey Hunter <gbmhunter@gmail.com> (www.mbedded.ninja)
 //! @edited 		n/a
 //! @created		2014-03-24
-//! @last-modified 	2014-03-24
+//! @last-modified 	2026-10-16
 //! @brief 			API header file for the MPid module.
 //! @details
 //!					See README.rst in repo root dir for more info.
@@ -20,7 +20,26 @@
 #ifndef M_PID_M_PID_API_H
 #define M_PID_M_PID_API_H
 
+#include "../include/Config.hpp"
+#include "../include/FixedQ.hpp"
 #include "../include/Pid.hpp"
+#include "../include/PidBank.hpp"
+#include "../include/ConcurrentPid.hpp"
+#include "../include/StaticPid.hpp"
+#include "../include/LeanPid.hpp"
+#include "../include/PidCascade.hpp"
+#include "../include/GainSchedule.hpp"
+#include "../include/PidScheduler.hpp"
+#include "../include/PidExecutor.hpp"
+#include "../include/PidShards.hpp"
+#include "../include/PidLoop.hpp"
+#include "../include/PidTrace.hpp"
+#include "../include/LogHistogram.hpp"
+#include "../include/PidInstrumentation.hpp"
+#include "../include/PidLog.hpp"
+#include "../include/PidCheckpoint.hpp"
+#include "../include/PlantSimulator.hpp"
+#include "../include/PidAutoTuner.hpp"
 
 #endif // #ifndef M_PID_M_PID_API_H
 
@@ -0,0 +1,157 @@
+//!
+//! @file 			MPidC.h
+//! @author 		Geoffrey Hunter <gbmhunter@gmail.com> (www.mbedded.ninja)
+//! @edited 		n/a
+//! @created		2026-10-16
+//! @last-modified 	2026-10-16
+//! @brief			C interface to the MPid shared library, for calling MPid from other languages.
+//! @details
+//!					See README.rst in repo root dir for more info.
+
+//===============================================================================================//
+//====================================== HEADER GUARD ===========================================//
+//===============================================================================================//
+
+#ifndef M_PID_C_H
+#define M_PID_C_H
+
+//===== SYSTEM LIBRARIES =====//
+#include <stdint.h>		// int32_t, uint32_t
+#include <stddef.h>		// size_t
+
+//===============================================================================================//
+//================================== PRECOMPILER CHECKS =========================================//
+//===============================================================================================//
+
+// Only the functions below are exported. Everything else in the library is hidden.
+#if defined(_WIN32)
+	#if defined(M_PID_BUILDING_LIBRARY)
+		#define M_PID_C_API __declspec(dllexport)
+	#else
+		#define M_PID_C_API __declspec(dllimport)
+	#endif
+#elif defined(__GNUC__)
+	#define M_PID_C_API __attribute__((visibility("default")))
+#else
+	#define M_PID_C_API
+#endif
+
+//! @brief		Changes whenever a function below changes in a way that breaks existing callers.
+#define M_PID_C_ABI_VERSION 1
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//===============================================================================================//
+//========================================== TYPES ==============================================//
+//===============================================================================================//
+
+//! @brief		A bank of controllers (a PidBank). Only ever used through a pointer.
+typedef struct MPidBank MPidBank;
+
+//! @brief		The number type of a bank. Every value array passed to a bank holds this type.
+typedef enum
+{
+	MPID_TYPE_FLOAT = 0,		//!< float
+	MPID_TYPE_DOUBLE = 1,		//!< double
+	MPID_TYPE_Q16_16 = 2		//!< Q16_16, passed as its raw int32_t (value * 65536)
+} MPidType;
+
+//! @brief		Controller directions, passed as int32_t.
+enum
+{
+	MPID_DIRECT = 0,
+	MPID_REVERSE = 1
+};
+
+//! @brief		Output modes, passed as int32_t.
+enum
+{
+	MPID_DONT_ACCUMULATE_OUTPUT = 0,
+	MPID_ACCUMULATE_OUTPUT = 1
+};
+
+//! @brief		Returned by every function that can fail.
+typedef enum
+{
+	MPID_OK = 0,
+	MPID_ERROR_NULL = -1,			//!< A required pointer was NULL.
+	MPID_ERROR_RANGE = -2,			//!< The controllers asked for are not all in the bank.
+	MPID_ERROR_ARGUMENT = -3,		//!< An argument is not one of the allowed values.
+	MPID_ERROR_NO_MEMORY = -4		//!< Memory could not be allocated.
+} MPidStatus;
+
+//===============================================================================================//
+//======================================== FUNCTIONS ============================================//
+//===============================================================================================//
+
+// Every "batched" function works on count controllers at once, starting at index first, so one call
+// covers a whole tick. Value arrays ("const void *" or "void *") hold count elements of the bank's
+// MPidType. The other arrays hold count elements of the type given.
+
+//! @brief		Returns M_PID_C_ABI_VERSION of the library, to check it matches the header.
+M_PID_C_API uint32_t MPid_GetAbiVersion(void);
+
+//! @brief		Creates an empty bank of controllers of the given type.
+//! @param		capacity	The number of controllers to reserve space for (more can still be added).
+//! @returns	The bank, or NULL if type is not valid or memory could not be allocated.
+M_PID_C_API MPidBank * MPid_CreateBank(MPidType type, size_t capacity);
+
+//! @brief		Destroys a bank made with MPid_CreateBank(). Does nothing if bank is NULL.
+M_PID_C_API void MPid_DestroyBank(MPidBank * bank);
+
+//! @brief		Returns the number type of the bank (which must not be NULL).
+M_PID_C_API MPidType MPid_GetType(const MPidBank * bank);
+
+//! @brief		Returns the number of controllers in the bank.
+M_PID_C_API size_t MPid_GetSize(const MPidBank * bank);
+
+//! @brief		Adds count controllers to the end of the bank, with the same parameters as the Pid constructor.
+//! @param		directions			MPID_DIRECT or MPID_REVERSE for each controller.
+//! @param		outputModes			MPID_DONT_ACCUMULATE_OUTPUT or MPID_ACCUMULATE_OUTPUT for each controller.
+//! @param		samplePeriodsMs		Sample periods, in milliseconds (rounded down for MPID_TYPE_Q16_16).
+//! @param		firstIndex			If not NULL, set to the index of the first controller added.
+M_PID_C_API MPidStatus MPid_AddControllers(
+	MPidBank * bank, size_t count,
+	const void * kp, const void * ki, const void * kd,
+	const int32_t * directions, const int32_t * outputModes, const double * samplePeriodsMs,
+	const void * minOutputs, const void * maxOutputs, const void * setPoints,
+	size_t * firstIndex);
+
+//! @brief		Same as Pid::SetTunings() for controllers [first, first + count).
+M_PID_C_API MPidStatus MPid_SetTunings(
+	MPidBank * bank, size_t first, size_t count, const void * kp, const void * ki, const void * kd);
+
+//! @brief		Same as Pid::SetOutputLimits() for controllers [first, first + count).
+M_PID_C_API MPidStatus MPid_SetOutputLimits(
+	MPidBank * bank, size_t first, size_t count, const void * minOutputs, const void * maxOutputs);
+
+//! @brief		Changes the set-points of controllers [first, first + count).
+M_PID_C_API MPidStatus MPid_SetSetPoints(MPidBank * bank, size_t first, size_t count, const void * setPoints);
+
+//! @brief		Runs every controller in the bank once (one tick).
+//! @param		inputs		MPid_GetSize() inputs.
+//! @param		outputs		Where to write MPid_GetSize() outputs.
+M_PID_C_API MPidStatus MPid_RunAll(MPidBank * bank, const void * inputs, void * outputs);
+
+//! @brief		Reads the run-time state of controllers [first, first + count).
+//! @details	Any of the arrays can be NULL, to skip that part of the state.
+M_PID_C_API MPidStatus MPid_GetStates(
+	const MPidBank * bank, size_t first, size_t count,
+	void * setPoints, void * prevInputs, void * iTerms, void * prevOutputs, uint32_t * numTimesRan);
+
+//! @brief		Restores the run-time state of controllers [first, first + count), like Pid::SetState().
+//! @details	All of the arrays are required.
+M_PID_C_API MPidStatus MPid_SetStates(
+	MPidBank * bank, size_t first, size_t count,
+	const void * setPoints, const void * prevInputs, const void * iTerms, const void * prevOutputs,
+	const uint32_t * numTimesRan);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif // #ifndef M_PID_C_H
+
+// EOF
@@ -0,0 +1,634 @@
+//!
+//! @file 			main.cpp
+//! @author 		Geoffrey Hunter <gbmhunter@gmail.com> (www.mbedded.ninja)
+//! @created		2026-10-16
+//! @last-modified 	2026-10-16
+//! @brief 			Microbenchmarks for Pid::Run(), PidBank::RunAll(), checkpoints and PlantSimulator.
+//! @details
+//!					Usage: MPidBenchmarks [--quick] [--json <file>]
+//!					Prints a table to stdout, and optionally writes the results as JSON
+//!					so they can be compared between releases.
+
+//===== SYSTEM LIBRARIES =====//
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <chrono>
+#include <string>
+#include <vector>
+
+//===== USER SOURCE =====//
+#include "../api/MPidApi.hpp"
+#include "../include/CycleClock.hpp"
+
+using namespace MbeddedNinja::MPidNs;
+
+//===============================================================================================//
+//========================================== HARNESS ============================================//
+//===============================================================================================//
+
+//! @brief		One row of the results table.
+struct BenchmarkResult
+{
+	std::string name;
+	std::string dataType;
+	std::string outputMode;
+	std::string direction;
+	size_t numControllers;
+	uint64_t numCalls;
+	double nsPerCall;
+	double callsPerSec;
+	double cyclesPerCall;
+};
+
+static std::vector<BenchmarkResult> results;
+
+//! @brief		Stops the compiler optimising away results.
+static volatile double sink;
+
+//! @brief		Minimum time spent in each repetition of a benchmark.
+static double minRepSeconds = 0.1;
+
+//! @brief		Number of repetitions. The fastest one is reported.
+static const int numReps = 5;
+
+//! @brief		Worker pool (one worker per allowed CPU) for the pid_bank_executor benchmarks.
+static PidExecutor * executor = NULL;
+
+//! @brief		Times body(), which must make callsPerBody calls to Run(), and records the fastest repetition.
+template <class bodyType> static void Measure(
+	const std::string & name, const std::string & dataType, const std::string & outputMode,
+	const std::string & direction, size_t numControllers, uint64_t callsPerBody, bodyType body)
+{
+	// Warm up caches and branch predictors
+	body();
+
+	double bestNsPerCall = 0;
+	double bestCyclesPerCall = 0;
+	uint64_t totalCalls = 0;
+
+	for(int rep = 0; rep < numReps; rep++)
+	{
+		uint64_t numCalls = 0;
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		uint64_t startCycles = ReadCycleCounter();
+		double elapsedSeconds = 0;
+		do
+		{
+			body();
+			numCalls += callsPerBody;
+			elapsedSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+		} while(elapsedSeconds < minRepSeconds);
+		uint64_t cycles = ReadCycleCounter() - startCycles;
+
+		double nsPerCall = elapsedSeconds*1.0e9/(double)numCalls;
+		if(rep == 0 || nsPerCall < bestNsPerCall)
+		{
+			bestNsPerCall = nsPerCall;
+			bestCyclesPerCall = (double)cycles/(double)numCalls;
+		}
+		totalCalls += numCalls;
+	}
+
+	BenchmarkResult result;
+	result.name = name;
+	result.dataType = dataType;
+	result.outputMode = outputMode;
+	result.direction = direction;
+	result.numControllers = numControllers;
+	result.numCalls = totalCalls;
+	result.nsPerCall = bestNsPerCall;
+	result.callsPerSec = 1.0e9/bestNsPerCall;
+	result.cyclesPerCall = bestCyclesPerCall;
+	results.push_back(result);
+
+	printf("%-18s %-8s %-24s %-12s %10zu %10.3f %14.0f %10.2f\n",
+		name.c_str(), dataType.c_str(), outputMode.c_str(), direction.c_str(),
+		numControllers, result.nsPerCall, result.callsPerSec, result.cyclesPerCall);
+	fflush(stdout);
+}
+
+//! @brief		Converts a controller output to a double, for the sink.
+template <class dataType> static double ToDouble(dataType value) { return (double)value; }
+template <class baseType, uint8_t numFracBits> static double ToDouble(FixedQ<baseType, numFracBits> value) { return value.ToDouble(); }
+
+#if(M_PID_CONFIG_ENABLE_TRACE == 1)
+	//! @brief		Trace sink which throws the records away, so only the cost of tracing is measured.
+	template <class dataType> static void DiscardTraceRecord(void * context, size_t ringId, const PidTraceRecord<dataType> & record)
+	{
+		(void)context;
+		(void)ringId;
+		sink = ToDouble(record.output);
+	}
+#endif
+
+//===============================================================================================//
+//========================================= BENCHMARKS ==========================================//
+//===============================================================================================//
+
+//! @brief		Runs every benchmark for one dataType, output mode and direction.
+template <class dataType> static void RunBenchmarks(
+	const char * typeName,
+	typename Pid<dataType>::OutputMode outputMode,
+	typename Pid<dataType>::ControllerDirection direction,
+	const std::vector<size_t> & arraySizes)
+{
+	const std::string modeName = (outputMode == Pid<dataType>::OutputMode::ACCUMULATE_OUTPUT) ? "ACCUMULATE_OUTPUT" : "DONT_ACCUMULATE_OUTPUT";
+	const std::string dirName = (direction == Pid<dataType>::ControllerDirection::PID_DIRECT) ? "PID_DIRECT" : "PID_REVERSE";
+
+	const dataType kp(0.8);
+	const dataType ki(0.4);
+	const dataType kd(0.01);
+	const dataType minOutput(-100.0);
+	const dataType maxOutput(100.0);
+	const dataType setPoint(1.0);
+
+	// Pre-computed inputs, so generating them isn't part of the measurement
+	const size_t numInputs = 4096;
+	std::vector<dataType> inputs;
+	for(size_t i = 0; i < numInputs; i++)
+		inputs.push_back(dataType((double)((i*2654435761u) % 2000)/1000.0 - 1.0));
+
+	//===== SINGLE CONTROLLER, INDEPENDENT INPUTS (THROUGHPUT) =====//
+	{
+		Pid<dataType> pid(kp, ki, kd, direction, outputMode, 10, minOutput, maxOutput, setPoint);
+		Measure("single_throughput", typeName, modeName, dirName, 1, numInputs, [&]()
+		{
+			for(size_t i = 0; i < numInputs; i++)
+				pid.Run(inputs[i]);
+			sink = ToDouble(pid.output);
+		});
+	}
+
+	#if(M_PID_CONFIG_ENABLE_TRACE == 1)
+		//===== SINGLE CONTROLLER, TRACED, DRAINED BY A CONSUMER THREAD =====//
+		{
+			Pid<dataType> pid(kp, ki, kd, direction, outputMode, 10, minOutput, maxOutput, setPoint);
+			PidTraceRing<dataType> ring(1 << 16);
+			PidTraceConsumer<dataType> consumer(&DiscardTraceRecord<dataType>, NULL);
+			consumer.AddRing(&ring, 0);
+			consumer.Start();
+			pid.SetTraceRing(&ring);
+			Measure("single_traced", typeName, modeName, dirName, 1, numInputs, [&]()
+			{
+				for(size_t i = 0; i < numInputs; i++)
+					pid.Run(inputs[i]);
+				sink = ToDouble(pid.output);
+			});
+			consumer.Stop();
+			printf("%-18s %zu records dropped (ring full)\n", "", ring.GetNumDropped());
+		}
+	#endif
+
+	//===== SINGLE CONTROLLER, WHOLE BLOCK OF INPUTS AT ONCE =====//
+	{
+		Pid<dataType> pid(kp, ki, kd, direction, outputMode, 10, minOutput, maxOutput, setPoint);
+		std::vector<dataType> outputs(numInputs);
+		Measure("single_run_block", typeName, modeName, dirName, 1, numInputs, [&]()
+		{
+			pid.RunBlock(inputs.data(), outputs.data(), numInputs);
+			sink = ToDouble(outputs[numInputs - 1]);
+		});
+	}
+
+	//===== 3 STAGE CASCADE (OUTER EVERY 4 TICKS, MIDDLE EVERY 2), CHAINED BY HAND VS FUSED =====//
+	{
+		Pid<dataType> pids[3] = {
+			Pid<dataType>(kp, ki, kd, direction, outputMode, 40, minOutput, maxOutput, setPoint),
+			Pid<dataType>(kp, ki, kd, direction, outputMode, 20, minOutput, maxOutput, setPoint),
+			Pid<dataType>(kp, ki, kd, direction, outputMode, 10, minOutput, maxOutput, setPoint) };
+		Measure("cascade_chained", typeName, modeName, dirName, 3, numInputs, [&]()
+		{
+			for(size_t i = 0; i < numInputs; i++)
+			{
+				if(i % 4 == 0)
+					pids[0].Run(inputs[i]);
+				pids[1].setPoint = pids[0].output;
+				if(i % 2 == 0)
+					pids[1].Run(inputs[i]);
+				pids[2].setPoint = pids[1].output;
+				pids[2].Run(inputs[i]);
+			}
+			sink = ToDouble(pids[2].output);
+		});
+
+		PidCascade<dataType, 3> cascade(10, setPoint);
+		cascade.SetStage(0, kp, ki, kd, direction, outputMode, 4, minOutput, maxOutput);
+		cascade.SetStage(1, kp, ki, kd, direction, outputMode, 2, minOutput, maxOutput);
+		cascade.SetStage(2, kp, ki, kd, direction, outputMode, 1, minOutput, maxOutput);
+		Measure("cascade_fused", typeName, modeName, dirName, 3, numInputs, [&]()
+		{
+			for(size_t i = 0; i < numInputs; i++)
+				cascade.Run(inputs[i], inputs[i], inputs[i]);
+			sink = ToDouble(cascade.output);
+		});
+	}
+
+	//===== SINGLE CONTROLLER, INPUT DEPENDS ON LAST OUTPUT (LATENCY) =====//
+	{
+		Pid<dataType> pid(kp, ki, kd, direction, outputMode, 10, minOutput, maxOutput, setPoint);
+		const dataType plantGain(0.01);
+		Measure("single_latency", typeName, modeName, dirName, 1, numInputs, [&]()
+		{
+			// A trivial plant closes the loop, so each Run() has to wait for the previous one
+			dataType input(0.0);
+			for(size_t i = 0; i < numInputs; i++)
+			{
+				pid.Run(input);
+				input = pid.output*plantGain + inputs[i];
+			}
+			sink = ToDouble(pid.output);
+		});
+	}
+
+	for(size_t s = 0; s < arraySizes.size(); s++)
+	{
+		const size_t numControllers = arraySizes[s];
+		std::vector<dataType> arrayInputs(numControllers);
+		std::vector<dataType> arrayOutputs(numControllers);
+		for(size_t i = 0; i < numControllers; i++)
+			arrayInputs[i] = inputs[i % numInputs];
+
+		//===== ARRAY OF PID OBJECTS =====//
+		{
+			std::vector<Pid<dataType>> pids(numControllers,
+				Pid<dataType>(kp, ki, kd, direction, outputMode, 10, minOutput, maxOutput, setPoint));
+			Measure("pid_array", typeName, modeName, dirName, numControllers, numControllers, [&]()
+			{
+				for(size_t i = 0; i < numControllers; i++)
+				{
+					pids[i].Run(arrayInputs[i]);
+					arrayOutputs[i] = pids[i].output;
+				}
+				sink = ToDouble(arrayOutputs[numControllers - 1]);
+			});
+		}
+
+		//===== ARRAY OF LEAN PIDS SHARING ONE SET OF PARAMETERS =====//
+		{
+			const LeanPidParams<dataType> params(kp, ki, kd, direction, outputMode, 10, minOutput, maxOutput);
+			std::vector<LeanPid<dataType>> pids(numControllers);
+			std::vector<dataType> setPoints(numControllers, setPoint);
+			Measure("lean_pid_array", typeName, modeName, dirName, numControllers, numControllers, [&]()
+			{
+				RunLeanPids(params, pids.data(), setPoints.data(), arrayInputs.data(), arrayOutputs.data(), numControllers);
+				sink = ToDouble(arrayOutputs[numControllers - 1]);
+			});
+		}
+
+		//===== PID BANK =====//
+		{
+			PidBank<dataType> bank;
+			bank.Reserve(numControllers);
+			for(size_t i = 0; i < numControllers; i++)
+				bank.Add(kp, ki, kd, direction, outputMode, 10, minOutput, maxOutput, setPoint);
+			Measure("pid_bank", typeName, modeName, dirName, numControllers, numControllers, [&]()
+			{
+				bank.RunAll(arrayInputs.data(), arrayOutputs.data());
+				sink = ToDouble(arrayOutputs[numControllers - 1]);
+			});
+		}
+
+		//===== PID BANK, ONLY 1% OF INPUTS CHANGING EACH TICK =====//
+		{
+			PidBank<dataType> bank;
+			bank.Reserve(numControllers);
+			for(size_t i = 0; i < numControllers; i++)
+				bank.Add(kp, ki, kd, direction, outputMode, 10, minOutput, maxOutput, setPoint);
+			for(size_t i = 0; i < numControllers; i++)
+				bank.SetInput(i, setPoint);
+			while(bank.RunActive(arrayOutputs.data()) > 0) {}
+			size_t tick = 0;
+			Measure("pid_bank_active", typeName, modeName, dirName, numControllers, numControllers, [&]()
+			{
+				// Every 100th controller is disturbed for one tick, starting at a different one each tick
+				for(size_t i = (tick + 99) % 100; i < numControllers; i += 100)
+					bank.SetInput(i, setPoint);
+				for(size_t i = tick % 100; i < numControllers; i += 100)
+					bank.SetInput(i, inputs[(i + tick) % numInputs]);
+				tick++;
+				bank.RunActive(arrayOutputs.data());
+				sink = ToDouble(arrayOutputs[numControllers - 1]);
+			});
+		}
+
+		//===== PID BANK ACROSS EVERY CPU =====//
+		{
+			PidBank<dataType> bank;
+			bank.Reserve(numControllers);
+			for(size_t i = 0; i < numControllers; i++)
+				bank.Add(kp, ki, kd, direction, outputMode, 10, minOutput, maxOutput, setPoint);
+			Measure("pid_bank_executor", typeName, modeName, dirName, numControllers, numControllers, [&]()
+			{
+				executor->RunBank(bank, arrayInputs.data(), arrayOutputs.data());
+				sink = ToDouble(arrayOutputs[numControllers - 1]);
+			});
+		}
+
+		//===== NUMA-LOCAL SHARDS, ONE PER CPU =====//
+		{
+			PidShards<dataType> shards;
+			for(size_t i = 0; i < numControllers; i++)
+				shards.Add(kp, ki, kd, direction, outputMode, 10, minOutput, maxOutput, setPoint);
+			shards.Build();
+			for(size_t s = 0; s < shards.GetNumShards(); s++)
+				memcpy(shards.GetShardInputs(s), &arrayInputs[shards.GetShardBegin(s)], shards.GetShardSize(s)*sizeof(dataType));
+			Measure("pid_shards", typeName, modeName, dirName, numControllers, numControllers, [&]()
+			{
+				shards.Tick();
+				sink = ToDouble(shards.GetOutput(numControllers - 1));
+			});
+		}
+	}
+}
+
+//! @brief		Runs the benchmarks for one dataType in both output modes and both directions.
+template <class dataType> static void RunAllModes(const char * typeName, const std::vector<size_t> & arraySizes)
+{
+	typedef typename Pid<dataType>::OutputMode OutputMode;
+	typedef typename Pid<dataType>::ControllerDirection ControllerDirection;
+
+	const OutputMode modes[] = { OutputMode::DONT_ACCUMULATE_OUTPUT, OutputMode::ACCUMULATE_OUTPUT };
+	const ControllerDirection dirs[] = { ControllerDirection::PID_DIRECT, ControllerDirection::PID_REVERSE };
+
+	for(int m = 0; m < 2; m++)
+		for(int d = 0; d < 2; d++)
+			RunBenchmarks<dataType>(typeName, modes[m], dirs[d], arraySizes);
+}
+
+//! @brief		Steps numPairs closed loops (a mix of every plant type, with and without dead time)
+//!				through PlantSimulator. One call is one plant/controller pair advanced by one step.
+template <class dataType> static void RunPlantSimulatorBenchmark(const char * typeName, size_t numPairs)
+{
+	typedef typename PlantSimulator<dataType>::OutputMode OutputMode;
+	typedef typename PlantSimulator<dataType>::ControllerDirection ControllerDirection;
+
+	PlantSimulator<dataType> sim(10.0);
+	for(size_t i = 0; i < numPairs; i++)
+	{
+		double deadTimeS = (double)(i % 8)*0.01;
+		PlantModel plant =
+			(i % 3 == 0) ? PlantModel::FirstOrder(2.0, 0.5, deadTimeS) :
+			(i % 3 == 1) ? PlantModel::SecondOrder(1.0, 5.0, 0.3, deadTimeS) :
+			PlantModel::Integrating(0.5, deadTimeS);
+		sim.Add(plant, dataType(1.0 + (double)(i % 16)*0.1), dataType(0.5), dataType(0.01),
+			ControllerDirection::PID_DIRECT, OutputMode::DONT_ACCUMULATE_OUTPUT,
+			dataType(-10), dataType(10), dataType(1));
+	}
+
+	const uint32_t stepsPerBody = 100;
+	Measure("plant_sim", typeName, "DONT_ACCUMULATE_OUTPUT", "PID_DIRECT", numPairs, numPairs*stepsPerBody, [&]()
+	{
+		sim.Run(stepsPerBody);
+		sink = (double)sim.GetPlantOutput(numPairs - 1);
+	});
+}
+
+//! @brief		Runs a controller whose time-step changes every tick: with SetSamplePeriod() and Run()
+//!				(whole milliseconds only), with Run(input, dt), and with Run(input, dt) for a steady dt.
+template <class dataType> static void RunTimestepBenchmark(const char * typeName)
+{
+	typedef typename Pid<dataType>::OutputMode OutputMode;
+	typedef typename Pid<dataType>::ControllerDirection ControllerDirection;
+
+	const size_t numInputs = 1024;
+	std::vector<dataType> inputs(numInputs);
+	std::vector<uint32_t> periodsMs(numInputs);
+	std::vector<double> dtsMs(numInputs);
+	for(size_t i = 0; i < numInputs; i++)
+	{
+		inputs[i] = dataType((double)(i % 200)/10.0 - 10.0);
+		periodsMs[i] = 9 + (uint32_t)(i % 3);
+		dtsMs[i] = 9.5 + (double)((i*37) % 100)/100.0;
+	}
+
+	Pid<dataType> pid(dataType(1), dataType(0.5), dataType(0.01), ControllerDirection::PID_DIRECT,
+		OutputMode::DONT_ACCUMULATE_OUTPUT, 10, dataType(-100), dataType(100), dataType(0));
+
+	Measure("set_period_run", typeName, "DONT_ACCUMULATE_OUTPUT", "PID_DIRECT", 1, numInputs, [&]()
+	{
+		for(size_t i = 0; i < numInputs; i++)
+		{
+			pid.SetSamplePeriod(periodsMs[i]);
+			pid.Run(inputs[i]);
+		}
+		sink = (double)pid.output;
+	});
+
+	Measure("run_dt_jitter", typeName, "DONT_ACCUMULATE_OUTPUT", "PID_DIRECT", 1, numInputs, [&]()
+	{
+		for(size_t i = 0; i < numInputs; i++)
+			pid.Run(inputs[i], dtsMs[i]);
+		sink = (double)pid.output;
+	});
+
+	Measure("run_dt_steady", typeName, "DONT_ACCUMULATE_OUTPUT", "PID_DIRECT", 1, numInputs, [&]()
+	{
+		for(size_t i = 0; i < numInputs; i++)
+			pid.Run(inputs[i], 10.5);
+		sink = (double)pid.output;
+	});
+}
+
+//! @brief		Checkpoints a bank of numControllers controllers into memory and restores it. One call
+//!				is one controller saved or restored.
+template <class dataType> static void RunCheckpointBenchmark(const char * typeName, size_t numControllers)
+{
+	typedef typename PidBank<dataType>::OutputMode OutputMode;
+	typedef typename PidBank<dataType>::ControllerDirection ControllerDirection;
+
+	PidBank<dataType> bank;
+	bank.Reserve(numControllers);
+	for(size_t i = 0; i < numControllers; i++)
+		bank.Add(dataType(1), dataType(0.5), dataType(0.01), ControllerDirection::PID_DIRECT,
+			OutputMode::DONT_ACCUMULATE_OUTPUT, 10, dataType(-100), dataType(100), dataType(1));
+
+	std::vector<dataType> inputs(numControllers, dataType(0.5));
+	std::vector<dataType> outputs(numControllers);
+	bank.RunAll(inputs.data(), outputs.data());
+
+	uint64_t size = PidCheckpointSize<dataType>(numControllers);
+	std::vector<uint64_t> buffer((size_t)(size + 7)/8);
+	uint8_t * bytes = reinterpret_cast<uint8_t *>(buffer.data());
+
+	Measure("checkpoint_save", typeName, "DONT_ACCUMULATE_OUTPUT", "PID_DIRECT", numControllers, numControllers, [&]()
+	{
+		sink = (double)SavePidCheckpoint(bank, bytes, (size_t)size);
+	});
+
+	Measure("checkpoint_restore", typeName, "DONT_ACCUMULATE_OUTPUT", "PID_DIRECT", numControllers, numControllers, [&]()
+	{
+		sink = RestorePidCheckpoint(bytes, (size_t)size, bank) ? 1.0 : 0.0;
+	});
+}
+
+//! @brief		Changes a controller's gains every tick based on an operating point, by interpolating
+//!				a table of Kp/Ki/Kd and calling SetTunings(), and then with a GainSchedule.
+template <class dataType> static void RunGainScheduleBenchmark(const char * typeName)
+{
+	typedef typename Pid<dataType>::OutputMode OutputMode;
+	typedef typename Pid<dataType>::ControllerDirection ControllerDirection;
+
+	const size_t numInputs = 1024;
+	std::vector<dataType> inputs(numInputs);
+	std::vector<dataType> operatingPoints(numInputs);
+	for(size_t i = 0; i < numInputs; i++)
+	{
+		inputs[i] = dataType((double)(i % 200)/10.0 - 10.0);
+		operatingPoints[i] = dataType((double)((i*7) % 100)/10.0);
+	}
+
+	// Gains at x = 0, 1, ..., 10
+	const size_t numPoints = 11;
+	dataType kps[numPoints], kis[numPoints], kds[numPoints];
+	for(size_t ix = 0; ix < numPoints; ix++)
+	{
+		kps[ix] = dataType(1) + dataType(ix);
+		kis[ix] = dataType(0.5)*dataType(ix);
+		kds[ix] = dataType(0.01)*dataType(ix);
+	}
+
+	{
+		Pid<dataType> pid(dataType(1), dataType(0.5), dataType(0.01), ControllerDirection::PID_DIRECT,
+			OutputMode::DONT_ACCUMULATE_OUTPUT, 10, dataType(-100), dataType(100), dataType(0));
+		Measure("set_tunings_run", typeName, "DONT_ACCUMULATE_OUTPUT", "PID_DIRECT", 1, numInputs, [&]()
+		{
+			for(size_t i = 0; i < numInputs; i++)
+			{
+				dataType x = operatingPoints[i];
+				int32_t ix = (int32_t)x;
+				ix = ix < (int32_t)numPoints - 2 ? ix : (int32_t)numPoints - 2;
+				dataType t = x - dataType(ix);
+				pid.SetTunings(
+					kps[ix] + t*(kps[ix + 1] - kps[ix]),
+					kis[ix] + t*(kis[ix + 1] - kis[ix]),
+					kds[ix] + t*(kds[ix + 1] - kds[ix]));
+				pid.Run(inputs[i]);
+			}
+			sink = (double)pid.output;
+		});
+	}
+
+	{
+		GainSchedule<dataType> schedule(10, dataType(0), dataType(10), numPoints);
+		for(size_t ix = 0; ix < numPoints; ix++)
+			schedule.SetTunings(ix, kps[ix], kis[ix], kds[ix]);
+		Pid<dataType> pid(dataType(1), dataType(0.5), dataType(0.01), ControllerDirection::PID_DIRECT,
+			OutputMode::DONT_ACCUMULATE_OUTPUT, 10, dataType(-100), dataType(100), dataType(0));
+		Measure("run_scheduled", typeName, "DONT_ACCUMULATE_OUTPUT", "PID_DIRECT", 1, numInputs, [&]()
+		{
+			for(size_t i = 0; i < numInputs; i++)
+				pid.RunScheduled(inputs[i], schedule, operatingPoints[i]);
+			sink = (double)pid.output;
+		});
+	}
+}
+
+//===============================================================================================//
+//========================================= JSON OUTPUT =========================================//
+//===============================================================================================//
+
+static const char * SimdLevelName(SimdLevel level)
+{
+	switch(level)
+	{
+		case SimdLevel::AVX512:	return "AVX512";
+		case SimdLevel::AVX2:	return "AVX2";
+		case SimdLevel::SSE2:	return "SSE2";
+		default:				return "SCALAR";
+	}
+}
+
+static bool WriteJson(const char * path)
+{
+	FILE * file = fopen(path, "w");
+	if(!file)
+		return false;
+
+	fprintf(file, "{\n");
+	fprintf(file, "  \"format_version\": 1,\n");
+	fprintf(file, "  \"simd_level\": \"%s\",\n", SimdLevelName(GetSimdLevel()));
+	fprintf(file, "  \"results\": [\n");
+	for(size_t i = 0; i < results.size(); i++)
+	{
+		const BenchmarkResult & r = results[i];
+		fprintf(file,
+			"    {\"name\": \"%s\", \"data_type\": \"%s\", \"output_mode\": \"%s\", \"direction\": \"%s\", "
+			"\"num_controllers\": %zu, \"num_calls\": %llu, \"ns_per_call\": %.4f, \"calls_per_sec\": %.1f, "
+			"\"cycles_per_call\": %.3f}%s\n",
+			r.name.c_str(), r.dataType.c_str(), r.outputMode.c_str(), r.direction.c_str(),
+			r.numControllers, (unsigned long long)r.numCalls, r.nsPerCall, r.callsPerSec, r.cyclesPerCall,
+			(i + 1 < results.size()) ? "," : "");
+	}
+	fprintf(file, "  ]\n");
+	fprintf(file, "}\n");
+	fclose(file);
+	return true;
+}
+
+//===============================================================================================//
+//=========================================== MAIN ==============================================//
+//===============================================================================================//
+
+int main(int argc, char ** argv)
+{
+	const char * jsonPath = NULL;
+	bool quick = false;
+
+	for(int i = 1; i < argc; i++)
+	{
+		if(strcmp(argv[i], "--quick") == 0)
+			quick = true;
+		else if(strcmp(argv[i], "--json") == 0 && i + 1 < argc)
+			jsonPath = argv[++i];
+		else
+		{
+			fprintf(stderr, "Usage: %s [--quick] [--json <file>]\n", argv[0]);
+			return 1;
+		}
+	}
+
+	// One size that fits in L1/L2, and one that has to come from DRAM
+	std::vector<size_t> arraySizes;
+	arraySizes.push_back(1024);
+	arraySizes.push_back(quick ? (1 << 16) : (1 << 20));
+	if(quick)
+		minRepSeconds = 0.01;
+
+	PidExecutor pool;
+	executor = &pool;
+	printf("pid_bank_executor uses %zu workers.\n\n", pool.GetNumWorkers());
+
+	printf("%-18s %-8s %-24s %-12s %10s %10s %14s %10s\n",
+		"benchmark", "type", "output_mode", "direction", "n", "ns/call", "calls/sec", "cycles/call");
+
+	RunAllModes<float>("float", arraySizes);
+	RunAllModes<double>("double", arraySizes);
+	RunAllModes<Q16_16>("Q16_16", arraySizes);
+#if defined(__SIZEOF_INT128__)
+	RunAllModes<Q32_32>("Q32_32", arraySizes);
+#endif
+
+	RunGainScheduleBenchmark<float>("float");
+	RunGainScheduleBenchmark<double>("double");
+
+	RunTimestepBenchmark<float>("float");
+	RunTimestepBenchmark<double>("double");
+
+	RunCheckpointBenchmark<float>("float", 100000);
+	RunCheckpointBenchmark<double>("double", 100000);
+
+	// 10^5 scenarios, each a different plant and tuning
+	RunPlantSimulatorBenchmark<float>("float", quick ? 10000 : 100000);
+	RunPlantSimulatorBenchmark<double>("double", quick ? 10000 : 100000);
+
+	if(jsonPath && !WriteJson(jsonPath))
+	{
+		fprintf(stderr, "Could not write '%s'.\n", jsonPath);
+		return 1;
+	}
+
+	return 0;
+}
+
+// EOF
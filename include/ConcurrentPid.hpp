@@ -0,0 +1,302 @@
+//!
+//! @file 			ConcurrentPid.hpp
+//! @author 		Geoffrey Hunter <gbmhunter@gmail.com> (www.mbedded.ninja)
+//! @edited 		n/a
+//! @created		2026-10-16
+//! @last-modified 	2026-10-16
+//! @brief			Pid wrapper which lets another thread change the tunings, limits and set-point
+//!					while Run() is being called, without tearing and without blocking Run().
+//! @details
+//!					See README.rst in repo root dir for more info.
+
+#ifndef __cplusplus
+	#error Please build with C++ compiler
+#endif
+
+//===============================================================================================//
+//====================================== HEADER GUARD ===========================================//
+//===============================================================================================//
+
+#ifndef M_PID_CONCURRENT_PID_H
+#define M_PID_CONCURRENT_PID_H
+
+//===== SYSTEM LIBRARIES =====//
+#include <stdint.h>		// uint32_t
+#include <mutex>		// std::mutex, std::lock_guard
+
+//===== USER SOURCE =====//
+#include "Pid.hpp"
+#include "SeqLock.hpp"
+
+namespace MbeddedNinja
+{
+	namespace MPidNs
+	{
+
+		//! @brief		Every parameter of a Pid which can be changed while it is running.
+		//! @details	Published as one block, so the real-time thread always sees a consistent set.
+		template <class dataType> struct PidParams
+		{
+			dataType Kp;
+			dataType Ki;
+			dataType Kd;
+			dataType Zp;
+			dataType Zi;
+			dataType Zd;
+			dataType outMin;
+			dataType outMax;
+			dataType setPoint;
+			typename Pid<dataType>::samplePeriodType samplePeriodMs;
+			typename Pid<dataType>::ControllerDirection controllerDir;
+		};
+
+		//===============================================================================================//
+		//===================================== CLASS DEFINITION ========================================//
+		//===============================================================================================//
+
+		//! @brief		A Pid which is run by one (real-time) thread and re-configured by others.
+		//! @details	The setters are called from supervisory threads. They compute the new time-scaled
+		//!				gains and publish the whole parameter block through a SeqLock. Run() is called
+		//!				from the real-time thread. It checks the sequence number (one atomic load), and if
+		//!				it has changed, tries once to copy the new block into the Pid. If it races with a
+		//!				writer, it keeps the old parameters for this tick and picks the new ones up on the
+		//!				next. Run() never blocks, spins or takes a mutex.
+		template <class dataType> class ConcurrentPid
+		{
+			public:
+
+				typedef typename Pid<dataType>::ControllerDirection ControllerDirection;
+				typedef typename Pid<dataType>::OutputMode OutputMode;
+				typedef typename Pid<dataType>::samplePeriodType samplePeriodType;
+
+				//! @brief		Parameters are identical to those of the Pid constructor.
+				ConcurrentPid(
+					dataType kp,
+					dataType ki,
+					dataType kd,
+					ControllerDirection controllerDir,
+					OutputMode outputMode,
+					samplePeriodType samplePeriodMs,
+					dataType minOutput,
+					dataType maxOutput,
+					dataType setPoint);
+
+				//===== REAL-TIME THREAD =====//
+
+				//! @brief		Applies any newly published parameters, then calls Pid::Run(). Wait-free.
+				void Run(dataType input);
+
+				//! @brief		Returns the output calculated by the last call to Run().
+				dataType GetOutput() const;
+
+				//! @brief		Gives the real-time thread access to the underlying Pid (e.g. for the getters).
+				//! @warning	Only call from the thread which calls Run().
+				Pid<dataType> & GetPid();
+
+				//===== SUPERVISORY THREADS =====//
+
+				//! @brief		Same as Pid::SetTunings(). Takes effect on the next Run().
+				void SetTunings(dataType kp, dataType ki, dataType kd);
+
+				//! @brief		Same as Pid::SetOutputLimits(). Takes effect on the next Run().
+				void SetOutputLimits(dataType min, dataType max);
+
+				//! @brief		Changes the set-point. Takes effect on the next Run().
+				void SetSetPoint(dataType setPoint);
+
+				//! @brief		Same as Pid::SetControllerDirection(). Takes effect on the next Run().
+				void SetControllerDirection(ControllerDirection controllerDir);
+
+				//! @brief		Same as Pid::SetSamplePeriod(). Takes effect on the next Run().
+				void SetSamplePeriod(uint32_t newSamplePeriodMs);
+
+				//! @brief		Changes the tunings, limits and set-point together, so Run() sees either all
+				//!				of the old values or all of the new ones.
+				void SetParameters(dataType kp, dataType ki, dataType kd, dataType min, dataType max, dataType setPoint);
+
+				//! @brief		Returns the number of parameter blocks published so far.
+				uint32_t GetNumPublished() const;
+
+			private:
+
+				//! @brief		Recomputes Zp, Zi and Zd from the writer's copy and publishes it. Caller holds writerMutex.
+				void Publish();
+
+				//! @brief		The controller. Only touched by the real-time thread after construction.
+				Pid<dataType> pid;
+
+				//! @brief		Sequence number of the parameters currently applied to pid.
+				uint32_t appliedSequence;
+
+				//! @brief		Carries parameter blocks from the writers to the real-time thread.
+				SeqLock<PidParams<dataType>> channel;
+
+				//! @brief		Serialises writers. Never taken by Run().
+				std::mutex writerMutex;
+
+				//! @brief		The writers' copy of the parameters. Protected by writerMutex.
+				PidParams<dataType> pending;
+		};
+
+		//===============================================================================================//
+		//============================ TEMPLATE FUNCTION DEFINITIONS ====================================//
+		//===============================================================================================//
+
+		template <class dataType> ConcurrentPid<dataType>::ConcurrentPid(
+			dataType kp,
+			dataType ki,
+			dataType kd,
+			ControllerDirection controllerDir,
+			OutputMode outputMode,
+			samplePeriodType samplePeriodMs,
+			dataType minOutput,
+			dataType maxOutput,
+			dataType setPoint) :
+				pid(kp, ki, kd, controllerDir, outputMode, samplePeriodMs, minOutput, maxOutput, setPoint),
+				appliedSequence(0)
+		{
+			this->pending.Kp = this->pid.Kp;
+			this->pending.Ki = this->pid.Ki;
+			this->pending.Kd = this->pid.Kd;
+			this->pending.outMin = this->pid.outMin;
+			this->pending.outMax = this->pid.outMax;
+			this->pending.setPoint = this->pid.setPoint;
+			this->pending.samplePeriodMs = this->pid.samplePeriodMs;
+			this->pending.controllerDir = this->pid.controllerDir;
+
+			std::lock_guard<std::mutex> lock(this->writerMutex);
+			this->Publish();
+			this->appliedSequence = this->channel.GetSequence();
+		}
+
+		template <class dataType> void ConcurrentPid<dataType>::Run(dataType input)
+		{
+			if(this->channel.GetSequence() != this->appliedSequence)
+			{
+				PidParams<dataType> params;
+				uint32_t sequence;
+				if(this->channel.TryRead(params, sequence))
+				{
+					this->pid.Kp = params.Kp;
+					this->pid.Ki = params.Ki;
+					this->pid.Kd = params.Kd;
+					this->pid.Zp = params.Zp;
+					this->pid.Zi = params.Zi;
+					this->pid.Zd = params.Zd;
+					this->pid.outMin = params.outMin;
+					this->pid.outMax = params.outMax;
+					this->pid.setPoint = params.setPoint;
+					this->pid.samplePeriodMs = params.samplePeriodMs;
+					this->pid.ResetTimestep();
+					this->pid.controllerDir = params.controllerDir;
+					#if(M_PID_CONFIG_ENABLE_INSTRUMENTATION == 1)
+						this->pid.instrumentation.Count(PidInstrumentation::TUNING_CHANGES);
+					#endif
+					this->appliedSequence = sequence;
+				}
+			}
+
+			this->pid.Run(input);
+		}
+
+		template <class dataType> dataType ConcurrentPid<dataType>::GetOutput() const
+		{
+			return this->pid.output;
+		}
+
+		template <class dataType> Pid<dataType> & ConcurrentPid<dataType>::GetPid()
+		{
+			return this->pid;
+		}
+
+		template <class dataType> void ConcurrentPid<dataType>::SetTunings(dataType kp, dataType ki, dataType kd)
+		{
+			if (kp<0 || ki<0 || kd<0)
+				return;
+
+			std::lock_guard<std::mutex> lock(this->writerMutex);
+			this->pending.Kp = kp;
+			this->pending.Ki = ki;
+			this->pending.Kd = kd;
+			this->Publish();
+		}
+
+		template <class dataType> void ConcurrentPid<dataType>::SetOutputLimits(dataType min, dataType max)
+		{
+			if(min >= max)
+				return;
+
+			std::lock_guard<std::mutex> lock(this->writerMutex);
+			this->pending.outMin = min;
+			this->pending.outMax = max;
+			this->Publish();
+		}
+
+		template <class dataType> void ConcurrentPid<dataType>::SetSetPoint(dataType setPoint)
+		{
+			std::lock_guard<std::mutex> lock(this->writerMutex);
+			this->pending.setPoint = setPoint;
+			this->Publish();
+		}
+
+		template <class dataType> void ConcurrentPid<dataType>::SetControllerDirection(ControllerDirection controllerDir)
+		{
+			std::lock_guard<std::mutex> lock(this->writerMutex);
+			this->pending.controllerDir = controllerDir;
+			this->Publish();
+		}
+
+		template <class dataType> void ConcurrentPid<dataType>::SetSamplePeriod(uint32_t newSamplePeriodMs)
+		{
+			if(newSamplePeriodMs == 0)
+				return;
+
+			std::lock_guard<std::mutex> lock(this->writerMutex);
+			this->pending.samplePeriodMs = newSamplePeriodMs;
+			this->Publish();
+		}
+
+		template <class dataType> void ConcurrentPid<dataType>::SetParameters(
+			dataType kp, dataType ki, dataType kd, dataType min, dataType max, dataType setPoint)
+		{
+			if (kp<0 || ki<0 || kd<0 || min >= max)
+				return;
+
+			std::lock_guard<std::mutex> lock(this->writerMutex);
+			this->pending.Kp = kp;
+			this->pending.Ki = ki;
+			this->pending.Kd = kd;
+			this->pending.outMin = min;
+			this->pending.outMax = max;
+			this->pending.setPoint = setPoint;
+			this->Publish();
+		}
+
+		template <class dataType> uint32_t ConcurrentPid<dataType>::GetNumPublished() const
+		{
+			return this->channel.GetSequence()/2;
+		}
+
+		template <class dataType> void ConcurrentPid<dataType>::Publish()
+		{
+			// Same scaling as Pid::SetTunings(), done here so Run() only has to copy
+			this->pending.Zp = this->pending.Kp;
+			this->pending.Zi = PidTraits<dataType>::ScaleKi(this->pending.Ki, this->pending.samplePeriodMs);
+			this->pending.Zd = PidTraits<dataType>::ScaleKd(this->pending.Kd, this->pending.samplePeriodMs);
+
+			if(this->pending.controllerDir == ControllerDirection::PID_REVERSE)
+			{
+				this->pending.Zp = (0 - this->pending.Zp);
+				this->pending.Zi = (0 - this->pending.Zi);
+				this->pending.Zd = (0 - this->pending.Zd);
+			}
+
+			this->channel.Write(this->pending);
+		}
+
+	} // namespace MPidNs
+} // namespace MbeddedNinja
+
+#endif // #ifndef M_PID_CONCURRENT_PID_H
+
+// EOF
@@ -0,0 +1,38 @@
+//!
+//! @file 			Config.hpp
+//! @author 		Geoffrey Hunter <gbmhunter@gmail.com> (www.mbedded.ninja)
+//! @edited 		n/a
+//! @created		2026-10-16
+//! @last-modified 	2026-10-16
+//! @brief			Compile-time configuration for the MPid library.
+//! @details
+//!					Each option can be overridden by defining it before including MPid (e.g. with
+//!					-DM_PID_CONFIG_ENABLE_TRACE=1). See README.rst in repo root dir for more info.
+
+#ifndef __cplusplus
+	#error Please build with C++ compiler
+#endif
+
+//===============================================================================================//
+//====================================== HEADER GUARD ===========================================//
+//===============================================================================================//
+
+#ifndef M_PID_CONFIG_H
+#define M_PID_CONFIG_H
+
+//! @brief		Set to 1 to compile in the trace facility (Pid::SetTraceRing()). When 0, no trace code
+//!				or data is compiled into Pid at all.
+#ifndef M_PID_CONFIG_ENABLE_TRACE
+	#define M_PID_CONFIG_ENABLE_TRACE 0
+#endif
+
+//! @brief		Set to 1 to compile in per-controller counters (integrator clamps, output saturations,
+//!				derivative skips, tuning changes) and a Run() cycle histogram, read with
+//!				Pid::GetInstrumentation(). When 0, Pid compiles to exactly the same code as without it.
+#ifndef M_PID_CONFIG_ENABLE_INSTRUMENTATION
+	#define M_PID_CONFIG_ENABLE_INSTRUMENTATION 0
+#endif
+
+#endif // #ifndef M_PID_CONFIG_H
+
+// EOF
@@ -0,0 +1,174 @@
+//!
+//! @file 			CpuAffinity.hpp
+//! @author 		Geoffrey Hunter <gbmhunter@gmail.com> (www.mbedded.ninja)
+//! @edited 		n/a
+//! @created		2026-10-16
+//! @last-modified 	2026-10-16
+//! @brief			Helpers for pinning threads to CPUs, and finding which NUMA node each CPU is on.
+//! @details
+//!					See README.rst in repo root dir for more info.
+
+#ifndef __cplusplus
+	#error Please build with C++ compiler
+#endif
+
+//===============================================================================================//
+//====================================== HEADER GUARD ===========================================//
+//===============================================================================================//
+
+#ifndef M_PID_CPU_AFFINITY_H
+#define M_PID_CPU_AFFINITY_H
+
+//===== SYSTEM LIBRARIES =====//
+#include <stddef.h>		// size_t
+#include <stdio.h>		// fopen(), fgets(), snprintf()
+#include <stdlib.h>		// strtoul()
+#include <thread>		// std::thread
+#include <vector>		// std::vector
+
+#if defined(__linux__)
+	#include <pthread.h>	// pthread_setaffinity_np()
+	#include <sched.h>		// cpu_set_t, CPU_SET()
+#endif
+
+namespace MbeddedNinja
+{
+	namespace MPidNs
+	{
+
+		//! @brief		Returns the IDs of the CPUs this process is allowed to run on, in ascending order.
+		//! @details	Falls back to 0..N-1 (from std::thread::hardware_concurrency()) when the affinity mask
+		//!				can't be read.
+		inline std::vector<size_t> GetAllowedCpus()
+		{
+			std::vector<size_t> cpus;
+			#if defined(__linux__)
+				cpu_set_t set;
+				CPU_ZERO(&set);
+				if(sched_getaffinity(0, sizeof(set), &set) == 0)
+				{
+					for(size_t cpu = 0; cpu < CPU_SETSIZE; cpu++)
+						if(CPU_ISSET(cpu, &set))
+							cpus.push_back(cpu);
+				}
+			#endif
+			if(cpus.empty())
+			{
+				unsigned int count = std::thread::hardware_concurrency();
+				for(size_t cpu = 0; cpu < (count ? count : 1); cpu++)
+					cpus.push_back(cpu);
+			}
+			return cpus;
+		}
+
+		//! @brief		Returns the number of CPUs this process is allowed to run on (at least 1).
+		inline size_t GetNumCpus()
+		{
+			return GetAllowedCpus().size();
+		}
+
+		//! @brief		Pins a thread to one CPU.
+		//! @returns	false if pinning failed, or is not supported on this platform.
+		inline bool PinThreadToCpu(std::thread & thread, size_t cpu)
+		{
+			#if defined(__linux__)
+				cpu_set_t set;
+				CPU_ZERO(&set);
+				CPU_SET(cpu, &set);
+				return pthread_setaffinity_np(thread.native_handle(), sizeof(set), &set) == 0;
+			#else
+				(void)thread;
+				(void)cpu;
+				return false;
+			#endif
+		}
+
+		//! @brief		Pins the calling thread to one CPU.
+		//! @returns	false if pinning failed, or is not supported on this platform.
+		inline bool PinCurrentThreadToCpu(size_t cpu)
+		{
+			#if defined(__linux__)
+				cpu_set_t set;
+				CPU_ZERO(&set);
+				CPU_SET(cpu, &set);
+				return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+			#else
+				(void)cpu;
+				return false;
+			#endif
+		}
+
+		//! @brief		Parses a Linux CPU or node list (e.g. "0-3,8,10-11"), as found in sysfs.
+		//! @returns	The IDs in the list, in the order written. Parsing stops at the first character
+		//!				that doesn't fit the format.
+		inline std::vector<size_t> ParseCpuList(const char * list)
+		{
+			std::vector<size_t> ids;
+			const char * p = list;
+			for(;;)
+			{
+				char * end;
+				unsigned long first = strtoul(p, &end, 10);
+				if(end == p)
+					break;
+				unsigned long last = first;
+				p = end;
+				if(*p == '-')
+				{
+					last = strtoul(p + 1, &end, 10);
+					if(end == p + 1 || last < first)
+						break;
+					p = end;
+				}
+				for(unsigned long id = first; id <= last; id++)
+					ids.push_back(id);
+				if(*p != ',')
+					break;
+				p++;
+			}
+			return ids;
+		}
+
+		//! @brief		Returns the NUMA node of each CPU in cpus (in the same order).
+		//! @details	Read from /sys/devices/system/node on Linux. CPUs that aren't found there, and every
+		//!				CPU on other platforms, are reported as being on node 0.
+		inline std::vector<size_t> GetCpuNodes(const std::vector<size_t> & cpus)
+		{
+			std::vector<size_t> nodes(cpus.size(), 0);
+			#if defined(__linux__)
+				char line[4096];
+				FILE * file = fopen("/sys/devices/system/node/possible", "r");
+				if(!file)
+					return nodes;
+				std::vector<size_t> nodeIds;
+				if(fgets(line, sizeof(line), file))
+					nodeIds = ParseCpuList(line);
+				fclose(file);
+
+				for(size_t n = 0; n < nodeIds.size(); n++)
+				{
+					char path[128];
+					snprintf(path, sizeof(path), "/sys/devices/system/node/node%zu/cpulist", nodeIds[n]);
+					file = fopen(path, "r");
+					if(!file)
+						continue;
+					std::vector<size_t> nodeCpus;
+					if(fgets(line, sizeof(line), file))
+						nodeCpus = ParseCpuList(line);
+					fclose(file);
+
+					for(size_t c = 0; c < nodeCpus.size(); c++)
+						for(size_t i = 0; i < cpus.size(); i++)
+							if(cpus[i] == nodeCpus[c])
+								nodes[i] = nodeIds[n];
+				}
+			#endif
+			return nodes;
+		}
+
+	} // namespace MPidNs
+} // namespace MbeddedNinja
+
+#endif // #ifndef M_PID_CPU_AFFINITY_H
+
+// EOF
@@ -0,0 +1,58 @@
+//!
+//! @file 			CycleClock.hpp
+//! @author 		Geoffrey Hunter <gbmhunter@gmail.com> (www.mbedded.ninja)
+//! @edited 		n/a
+//! @created		2026-10-16
+//! @last-modified 	2026-10-16
+//! @brief			Cheap, free-running cycle counter used for timing Run() calls.
+//! @details
+//!					See README.rst in repo root dir for more info.
+
+#ifndef __cplusplus
+	#error Please build with C++ compiler
+#endif
+
+//===============================================================================================//
+//====================================== HEADER GUARD ===========================================//
+//===============================================================================================//
+
+#ifndef M_PID_CYCLE_CLOCK_H
+#define M_PID_CYCLE_CLOCK_H
+
+//===== SYSTEM LIBRARIES =====//
+#include <stdint.h>		// uint64_t
+#include <chrono>		// std::chrono::steady_clock
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+	#include <x86intrin.h>	// __rdtsc()
+#endif
+
+namespace MbeddedNinja
+{
+	namespace MPidNs
+	{
+
+		//! @brief		Returns a free-running cycle count.
+		//! @details	On x86 this is the time-stamp counter (constant-rate "reference" cycles on modern
+		//!				CPUs), on AArch64 the virtual counter, and elsewhere nanoseconds from steady_clock.
+		//!				Only differences between two readings on the same core are meaningful.
+		inline uint64_t ReadCycleCounter()
+		{
+			#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+				return __rdtsc();
+			#elif defined(__GNUC__) && defined(__aarch64__)
+				uint64_t count;
+				__asm__ __volatile__("mrs %0, cntvct_el0" : "=r"(count));
+				return count;
+			#else
+				return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+					std::chrono::steady_clock::now().time_since_epoch()).count();
+			#endif
+		}
+
+	} // namespace MPidNs
+} // namespace MbeddedNinja
+
+#endif // #ifndef M_PID_CYCLE_CLOCK_H
+
+// EOF
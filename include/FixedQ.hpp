@@ -0,0 +1,190 @@
+//!
+//! @file 			FixedQ.hpp
+//! @author 		Geoffrey Hunter <gbmhunter@gmail.com> (www.mbedded.ninja)
+//! @edited 		n/a
+//! @created		2026-10-16
+//! @last-modified 	2026-10-16
+//! @brief			Saturating Q-format fixed-point number type, for use as the dataType of Pid.
+//! @details
+//!					See README.rst in repo root dir for more info.
+
+#ifndef __cplusplus
+	#error Please build with C++ compiler
+#endif
+
+//===============================================================================================//
+//====================================== HEADER GUARD ===========================================//
+//===============================================================================================//
+
+#ifndef M_PID_FIXED_Q_H
+#define M_PID_FIXED_Q_H
+
+//===== SYSTEM LIBRARIES =====//
+#include <stdint.h>		// int16_t, int32_t, int64_t
+#include <limits>		// std::numeric_limits
+#include <type_traits>	// std::enable_if, std::is_integral
+
+namespace MbeddedNinja
+{
+	namespace MPidNs
+	{
+
+		//! @brief		Maps the storage type of a FixedQ to an integer type wide enough to hold
+		//!				the full result of a multiply, before it is shifted and saturated.
+		template <class baseType> struct FixedQWide;
+		template <> struct FixedQWide<int16_t> { typedef int32_t type; };
+		template <> struct FixedQWide<int32_t> { typedef int64_t type; };
+#if defined(__SIZEOF_INT128__)
+		// 64-bit storage needs a 128-bit product, which 32-bit targets (e.g. -m32, Cortex-M) don't have
+		template <> struct FixedQWide<int64_t> { typedef __int128 type; };
+#endif
+
+		//===============================================================================================//
+		//===================================== CLASS DEFINITION ========================================//
+		//===============================================================================================//
+
+		//! @brief		A signed Q-format fixed-point number, stored in baseType with numFracBits fractional bits.
+		//! @details	All arithmetic is integer-only and saturates at the limits of baseType rather than
+		//!				wrapping. Multiplies round towards negative infinity (arithmetic shift right).
+		//!				Every operation is constexpr, so gains can be computed at compile time.
+		template <class baseType, uint8_t numFracBits> class FixedQ
+		{
+			public:
+
+				typedef typename FixedQWide<baseType>::type wideType;
+
+				static_assert(std::numeric_limits<baseType>::is_signed, "FixedQ requires a signed storage type.");
+				static_assert(numFracBits < sizeof(baseType)*8 - 1, "FixedQ needs at least one integer bit.");
+
+				//! @brief		Leaves the value uninitialised, like a built-in number type.
+				FixedQ() = default;
+
+				//! @brief		Converts from an integer, saturating if it is out of range.
+				//! @details	Only integers convert implicitly. Use the explicit double constructor
+				//!				(or FromRaw()) for fractional values.
+				template <class intType, class = typename std::enable_if<std::is_integral<intType>::value>::type>
+				constexpr FixedQ(intType integer) :
+					raw(Saturate((wideType)integer * One())) {}
+
+				//! @brief		Converts from a double, rounding to the nearest representable value and saturating.
+				//! @note		Uses floating-point maths. Intended for setting up constants, not for the control path.
+				constexpr explicit FixedQ(double value) :
+					raw(value*(double)One() >= (double)std::numeric_limits<baseType>::max() ? std::numeric_limits<baseType>::max() :
+						value*(double)One() <= (double)std::numeric_limits<baseType>::min() ? std::numeric_limits<baseType>::min() :
+						(baseType)(value*(double)One() + (value >= 0 ? 0.5 : -0.5))) {}
+
+				//! @brief		Creates a number directly from it's raw (scaled) integer representation.
+				static constexpr FixedQ FromRaw(baseType raw)
+				{
+					return FixedQ(raw, RawTag());
+				}
+
+				//! @brief		Returns the raw (scaled) integer representation.
+				constexpr baseType GetRaw() const
+				{
+					return this->raw;
+				}
+
+				//! @brief		Converts to a double. Uses floating-point maths, intended for display and tests.
+				constexpr double ToDouble() const
+				{
+					return (double)this->raw / (double)One();
+				}
+
+				//! @brief		The raw value which represents 1.0.
+				static constexpr wideType One()
+				{
+					return (wideType)1 << numFracBits;
+				}
+
+				//! @brief		Clamps a wide intermediate result to the range of baseType.
+				static constexpr baseType Saturate(wideType value)
+				{
+					return value > (wideType)std::numeric_limits<baseType>::max() ? std::numeric_limits<baseType>::max() :
+						value < (wideType)std::numeric_limits<baseType>::min() ? std::numeric_limits<baseType>::min() :
+						(baseType)value;
+				}
+
+				//===== ARITHMETIC OPERATORS =====//
+
+				constexpr FixedQ operator+(FixedQ rhs) const
+				{
+					return FromRaw(Saturate((wideType)this->raw + rhs.raw));
+				}
+
+				constexpr FixedQ operator-(FixedQ rhs) const
+				{
+					return FromRaw(Saturate((wideType)this->raw - rhs.raw));
+				}
+
+				constexpr FixedQ operator-() const
+				{
+					return FromRaw(Saturate(-(wideType)this->raw));
+				}
+
+				constexpr FixedQ operator*(FixedQ rhs) const
+				{
+					return FromRaw(Saturate(((wideType)this->raw * rhs.raw) >> numFracBits));
+				}
+
+				//! @details	Dividing by zero saturates towards the sign of the numerator.
+				constexpr FixedQ operator/(FixedQ rhs) const
+				{
+					return rhs.raw == 0 ?
+							FromRaw(this->raw >= 0 ? std::numeric_limits<baseType>::max() : std::numeric_limits<baseType>::min()) :
+							FromRaw(Saturate(((wideType)this->raw * One()) / rhs.raw));
+				}
+
+				FixedQ & operator+=(FixedQ rhs) { return *this = *this + rhs; }
+				FixedQ & operator-=(FixedQ rhs) { return *this = *this - rhs; }
+				FixedQ & operator*=(FixedQ rhs) { return *this = *this * rhs; }
+				FixedQ & operator/=(FixedQ rhs) { return *this = *this / rhs; }
+
+				//===== COMPARISON OPERATORS =====//
+
+				constexpr bool operator==(FixedQ rhs) const { return this->raw == rhs.raw; }
+				constexpr bool operator!=(FixedQ rhs) const { return this->raw != rhs.raw; }
+				constexpr bool operator<(FixedQ rhs) const { return this->raw < rhs.raw; }
+				constexpr bool operator>(FixedQ rhs) const { return this->raw > rhs.raw; }
+				constexpr bool operator<=(FixedQ rhs) const { return this->raw <= rhs.raw; }
+				constexpr bool operator>=(FixedQ rhs) const { return this->raw >= rhs.raw; }
+
+			private:
+
+				struct RawTag {};
+
+				constexpr FixedQ(baseType raw, RawTag) :
+					raw(raw) {}
+
+				//! @brief		The scaled integer value (value * 2^numFracBits).
+				baseType raw;
+		};
+
+		//! @brief		Integer on the left-hand side of a comparison (e.g. 0 < x).
+		template <class intType, class baseType, uint8_t numFracBits>
+		constexpr typename std::enable_if<std::is_integral<intType>::value, bool>::type
+		operator<(intType lhs, FixedQ<baseType, numFracBits> rhs) { return FixedQ<baseType, numFracBits>(lhs) < rhs; }
+
+		//! @brief		Integer on the left-hand side of a subtraction (e.g. 0 - x).
+		template <class intType, class baseType, uint8_t numFracBits>
+		constexpr typename std::enable_if<std::is_integral<intType>::value, FixedQ<baseType, numFracBits> >::type
+		operator-(intType lhs, FixedQ<baseType, numFracBits> rhs) { return FixedQ<baseType, numFracBits>(lhs) - rhs; }
+
+		//===============================================================================================//
+		//========================================= TYPEDEFS ============================================//
+		//===============================================================================================//
+
+		typedef FixedQ<int16_t, 8> Q8_8;			//!< 8 integer bits, 8 fractional bits, stored in an int16_t.
+		typedef FixedQ<int32_t, 16> Q16_16;		//!< 16 integer bits, 16 fractional bits, stored in an int32_t.
+		typedef FixedQ<int32_t, 24> Q8_24;		//!< 8 integer bits, 24 fractional bits, stored in an int32_t.
+#if defined(__SIZEOF_INT128__)
+		typedef FixedQ<int64_t, 32> Q32_32;		//!< 32 integer bits, 32 fractional bits, stored in an int64_t.
+		typedef FixedQ<int64_t, 24> Q40_24;		//!< 40 integer bits, 24 fractional bits, stored in an int64_t.
+#endif
+
+	} // namespace MPidNs
+} // namespace MbeddedNinja
+
+#endif // #ifndef M_PID_FIXED_Q_H
+
+// EOF
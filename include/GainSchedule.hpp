@@ -0,0 +1,245 @@
+//!
+//! @file 			GainSchedule.hpp
+//! @author 		Geoffrey Hunter <gbmhunter@gmail.com> (www.mbedded.ninja)
+//! @edited 		n/a
+//! @created		2026-10-16
+//! @last-modified 	2026-10-16
+//! @brief			Table of pre-scaled PID gains, interpolated by one or two scheduling variables.
+//! @details
+//!					See README.rst in repo root dir for more info.
+
+#ifndef __cplusplus
+	#error Please build with C++ compiler
+#endif
+
+//===============================================================================================//
+//====================================== HEADER GUARD ===========================================//
+//===============================================================================================//
+
+#ifndef M_PID_GAIN_SCHEDULE_H
+#define M_PID_GAIN_SCHEDULE_H
+
+//===== SYSTEM LIBRARIES =====//
+#include <stdint.h>			// int32_t
+#include <stddef.h>			// size_t
+#include <type_traits>		// std::is_floating_point
+#include <vector>			// std::vector
+
+//===== USER SOURCE =====//
+#include "PidTraits.hpp"
+
+namespace MbeddedNinja
+{
+	namespace MPidNs
+	{
+
+		//===============================================================================================//
+		//===================================== CLASS DEFINITION ========================================//
+		//===============================================================================================//
+
+		//! @brief		Gain schedule for Pid::RunScheduled().
+		//! @details	Holds Kp, Ki and Kd at the points of an evenly spaced grid over one scheduling
+		//!				variable (x) or two (x and y). They are stored already scaled by the sample period
+		//!				(Zp, Zi, Zd), four values per point, with neighbouring x points next to each other,
+		//!				so a lookup touches one or two cache lines. Lookup() clamps the operating point to
+		//!				the grid and interpolates linearly (bilinearly for two variables) with no branches:
+		//!				a handful of multiplies instead of the divide in SetTunings().
+		//!
+		//!				The gains are stored as positive values; Pid::RunScheduled() applies the
+		//!				controller's direction. Build the schedule with the same sample period as the
+		//!				controllers that use it.
+		template <class dataType> class GainSchedule
+		{
+			static_assert(std::is_floating_point<dataType>::value, "GainSchedule only supports float and double.");
+
+			public:
+
+				typedef typename PidTraits<dataType>::samplePeriodType samplePeriodType;
+
+				//! @brief		Creates a one-variable schedule with numX points from xMin to xMax, all zero.
+				GainSchedule(samplePeriodType samplePeriodMs, dataType xMin, dataType xMax, size_t numX);
+
+				//! @brief		Creates a two-variable schedule, numX by numY points, all zero.
+				GainSchedule(
+					samplePeriodType samplePeriodMs,
+					dataType xMin, dataType xMax, size_t numX,
+					dataType yMin, dataType yMax, size_t numY);
+
+				//! @brief		Sets the gains at grid point (ix, iy). Same units as Pid::SetTunings().
+				//!				Each axis can have at most 2^31 points.
+				//! @returns	false if the point is outside the grid or a gain is negative.
+				bool SetTunings(size_t ix, size_t iy, dataType kp, dataType ki, dataType kd);
+
+				//! @brief		Sets the gains at grid point ix of a one-variable schedule.
+				bool SetTunings(size_t ix, dataType kp, dataType ki, dataType kd);
+
+				//! @brief		Interpolates the time-scaled gains at operating point (x, y).
+				//!				y is ignored by a one-variable schedule.
+				void Lookup(dataType x, dataType y, dataType & zp, dataType & zi, dataType & zd) const;
+
+				size_t GetNumX() const;					//!< Returns the number of points along x.
+				size_t GetNumY() const;					//!< Returns the number of points along y (1 for one variable).
+				samplePeriodType GetSamplePeriod() const;	//!< Returns the sample period the gains are scaled for.
+
+			private:
+
+				//! @brief		One grid point. Padded to four values so points don't straddle cache lines.
+				struct Entry
+				{
+					dataType Zp;
+					dataType Zi;
+					dataType Zd;
+					dataType padding;
+				};
+
+				//! @brief		Sets up one axis of the grid.
+				static void InitAxis(dataType min, dataType max, size_t num,
+					dataType & invStep, dataType & maxIndex, int32_t & lastCell, size_t & next);
+
+				samplePeriodType samplePeriodMs;
+
+				dataType xMin, invStepX, maxIndexX;
+				dataType yMin, invStepY, maxIndexY;
+				size_t numX, nextX;
+				size_t numY;
+				int32_t lastCellX, lastCellY;
+
+				//! @brief		Row-major, [iy*numX + ix].
+				std::vector<Entry> table;
+		};
+
+		//===============================================================================================//
+		//============================ TEMPLATE FUNCTION DEFINITIONS ====================================//
+		//===============================================================================================//
+
+		template <class dataType> GainSchedule<dataType>::GainSchedule(
+			samplePeriodType samplePeriodMs, dataType xMin, dataType xMax, size_t numX) :
+			GainSchedule(samplePeriodMs, xMin, xMax, numX, 0, 0, 1)
+		{
+		}
+
+		template <class dataType> GainSchedule<dataType>::GainSchedule(
+			samplePeriodType samplePeriodMs,
+			dataType xMin, dataType xMax, size_t numX,
+			dataType yMin, dataType yMax, size_t numY) :
+			samplePeriodMs(samplePeriodMs),
+			xMin(xMin),
+			yMin(yMin),
+			numX(numX ? numX : 1),
+			numY(numY ? numY : 1)
+		{
+			InitAxis(xMin, xMax, this->numX, this->invStepX, this->maxIndexX, this->lastCellX, this->nextX);
+			size_t nextY;
+			InitAxis(yMin, yMax, this->numY, this->invStepY, this->maxIndexY, this->lastCellY, nextY);
+
+			Entry zero = { 0, 0, 0, 0 };
+			this->table.assign(this->numX*this->numY, zero);
+		}
+
+		template <class dataType> void GainSchedule<dataType>::InitAxis(dataType min, dataType max, size_t num,
+			dataType & invStep, dataType & maxIndex, int32_t & lastCell, size_t & next)
+		{
+			if(num < 2 || !(max > min))
+			{
+				// A single point, every lookup lands on it
+				invStep = 0;
+				maxIndex = 0;
+				lastCell = 0;
+				next = 0;
+				return;
+			}
+			invStep = (dataType)(num - 1)/(max - min);
+			maxIndex = (dataType)(num - 1);
+			lastCell = (int32_t)(num - 2);
+			next = 1;
+		}
+
+		template <class dataType> bool GainSchedule<dataType>::SetTunings(
+			size_t ix, size_t iy, dataType kp, dataType ki, dataType kd)
+		{
+			if(ix >= this->numX || iy >= this->numY || kp < 0 || ki < 0 || kd < 0)
+				return false;
+
+			// Same scaling as Pid::SetTunings()
+			Entry & entry = this->table[iy*this->numX + ix];
+			entry.Zp = kp;
+			entry.Zi = PidTraits<dataType>::ScaleKi(ki, this->samplePeriodMs);
+			entry.Zd = PidTraits<dataType>::ScaleKd(kd, this->samplePeriodMs);
+			entry.padding = 0;
+			return true;
+		}
+
+		template <class dataType> bool GainSchedule<dataType>::SetTunings(size_t ix, dataType kp, dataType ki, dataType kd)
+		{
+			return this->SetTunings(ix, 0, kp, ki, kd);
+		}
+
+		template <class dataType> void GainSchedule<dataType>::Lookup(
+			dataType x, dataType y, dataType & zp, dataType & zi, dataType & zd) const
+		{
+			// Position on the grid, clamped to it. Written as selects so they compile to min/max, and
+			// converted through int32_t, which is one instruction (unlike size_t).
+			dataType fx = (x - this->xMin)*this->invStepX;
+			fx = fx > 0 ? fx : dataType(0);
+			fx = fx < this->maxIndexX ? fx : this->maxIndexX;
+			int32_t ix = (int32_t)fx;
+			ix = ix < this->lastCellX ? ix : this->lastCellX;
+			const dataType tx = fx - (dataType)ix;
+
+			const Entry * e00 = &this->table[ix];
+			const Entry * e10 = e00 + this->nextX;
+
+			if(this->numY == 1)
+			{
+				zp = e00->Zp + tx*(e10->Zp - e00->Zp);
+				zi = e00->Zi + tx*(e10->Zi - e00->Zi);
+				zd = e00->Zd + tx*(e10->Zd - e00->Zd);
+				return;
+			}
+
+			dataType fy = (y - this->yMin)*this->invStepY;
+			fy = fy > 0 ? fy : dataType(0);
+			fy = fy < this->maxIndexY ? fy : this->maxIndexY;
+			int32_t iy = (int32_t)fy;
+			iy = iy < this->lastCellY ? iy : this->lastCellY;
+			const dataType ty = fy - (dataType)iy;
+
+			e00 += (size_t)iy*this->numX;
+			e10 += (size_t)iy*this->numX;
+			const Entry * e01 = e00 + this->numX;
+			const Entry * e11 = e10 + this->numX;
+
+			// Along x on both rows, then along y
+			const dataType zp0 = e00->Zp + tx*(e10->Zp - e00->Zp);
+			const dataType zi0 = e00->Zi + tx*(e10->Zi - e00->Zi);
+			const dataType zd0 = e00->Zd + tx*(e10->Zd - e00->Zd);
+			const dataType zp1 = e01->Zp + tx*(e11->Zp - e01->Zp);
+			const dataType zi1 = e01->Zi + tx*(e11->Zi - e01->Zi);
+			const dataType zd1 = e01->Zd + tx*(e11->Zd - e01->Zd);
+			zp = zp0 + ty*(zp1 - zp0);
+			zi = zi0 + ty*(zi1 - zi0);
+			zd = zd0 + ty*(zd1 - zd0);
+		}
+
+		template <class dataType> size_t GainSchedule<dataType>::GetNumX() const
+		{
+			return this->numX;
+		}
+
+		template <class dataType> size_t GainSchedule<dataType>::GetNumY() const
+		{
+			return this->numY;
+		}
+
+		template <class dataType>
+		typename GainSchedule<dataType>::samplePeriodType GainSchedule<dataType>::GetSamplePeriod() const
+		{
+			return this->samplePeriodMs;
+		}
+
+	} // namespace MPidNs
+} // namespace MbeddedNinja
+
+#endif // #ifndef M_PID_GAIN_SCHEDULE_H
+
+// EOF
@@ -0,0 +1,300 @@
+//!
+//! @file 			LeanPid.hpp
+//! @author 		Geoffrey Hunter <gbmhunter@gmail.com> (www.mbedded.ninja)
+//! @edited 		n/a
+//! @created		2026-10-16
+//! @last-modified 	2026-10-16
+//! @brief			PID controller which holds only its run-time state, with the gains and limits in a
+//!					parameter block that many controllers can share.
+//! @details
+//!					See README.rst in repo root dir for more info.
+
+#ifndef __cplusplus
+	#error Please build with C++ compiler
+#endif
+
+//===============================================================================================//
+//====================================== HEADER GUARD ===========================================//
+//===============================================================================================//
+
+#ifndef M_PID_LEAN_PID_H
+#define M_PID_LEAN_PID_H
+
+//===== SYSTEM LIBRARIES =====//
+#include <stdint.h>		// uint32_t
+#include <stddef.h>		// size_t
+
+//===== USER SOURCE =====//
+#include "FixedQ.hpp"
+#include "Pid.hpp"
+#include "PidTraits.hpp"
+
+namespace MbeddedNinja
+{
+	namespace MPidNs
+	{
+
+		//===============================================================================================//
+		//===================================== CLASS DEFINITION ========================================//
+		//===============================================================================================//
+
+		//! @brief		Gains, limits and modes for one class of LeanPid controllers.
+		//! @details	Every controller that uses the same parameters refers to one of these, rather than
+		//!				carrying its own copy. The constructor is constexpr, so a parameter block with
+		//!				constant arguments can be built at compile time (and be const).
+		template <class dataType> class LeanPidParams
+		{
+			public:
+
+				typedef typename Pid<dataType>::ControllerDirection ControllerDirection;
+				typedef typename Pid<dataType>::OutputMode OutputMode;
+				typedef typename Pid<dataType>::samplePeriodType samplePeriodType;
+
+				//! @brief		Same parameters (and checks) as the Pid constructor, minus the set-point,
+				//!				which is passed to LeanPid::Run().
+				constexpr LeanPidParams(
+					dataType kp,
+					dataType ki,
+					dataType kd,
+					ControllerDirection controllerDir,
+					OutputMode outputMode,
+					samplePeriodType samplePeriodMs,
+					dataType minOutput,
+					dataType maxOutput);
+
+				//! @brief		Same as Pid::SetTunings(). Affects every controller using these parameters.
+				void SetTunings(dataType kp, dataType ki, dataType kd);
+
+				//! @brief		Same as Pid::SetOutputLimits().
+				void SetOutputLimits(dataType min, dataType max);
+
+				constexpr dataType GetKp() const;		//!< Returns the actual (not time-scaled) proportional constant.
+				constexpr dataType GetKi() const;		//!< Returns the actual (not time-scaled) integral constant.
+				constexpr dataType GetKd() const;		//!< Returns the actual (not time-scaled) derivative constant.
+				constexpr dataType GetZp() const;		//!< Returns the time-scaled proportional constant.
+				constexpr dataType GetZi() const;		//!< Returns the time-scaled integral constant.
+				constexpr dataType GetZd() const;		//!< Returns the time-scaled derivative constant.
+				constexpr dataType GetOutMin() const;	//!< Returns the minimum output.
+				constexpr dataType GetOutMax() const;	//!< Returns the maximum output.
+
+			private:
+
+				template <class> friend class LeanPid;
+
+				//! @brief		true if none of the gains are negative.
+				static constexpr bool TuningsAreValid(dataType kp, dataType ki, dataType kd);
+
+				//! @brief		Negates a time-scaled gain for a reverse acting controller.
+				static constexpr dataType ApplyDirection(dataType gain, ControllerDirection controllerDir);
+
+				//===== USED BY RUN() =====//
+
+				dataType Zp;				//!< Time-scaled proportional constant (direction applied).
+				dataType Zi;				//!< Time-scaled integral constant (direction applied).
+				dataType Zd;				//!< Time-scaled derivative constant (direction applied).
+				dataType outMin;			//!< The minimum output value.
+				dataType outMax;			//!< The maximum output value.
+				bool accumulate;			//!< true in ACCUMULATE_OUTPUT mode.
+
+				//===== ONLY USED WHEN RE-TUNING =====//
+
+				bool reverse;				//!< true for PID_REVERSE.
+				dataType Kp;				//!< Actual (non-scaled) proportional constant.
+				dataType Ki;				//!< Actual (non-scaled) integral constant.
+				dataType Kd;				//!< Actual (non-scaled) derivative constant.
+				samplePeriodType samplePeriodMs;
+		};
+
+		//! @brief		A PID controller that holds only the state Run() carries from one call to the next:
+		//!				the integral term, the previous input and the previous output.
+		//! @details	The gains, limits and modes come from a LeanPidParams, and the set-point is passed
+		//!				to Run(), so a float controller is 12 bytes (compared to over 100 for Pid<float>).
+		//!				Use it for populations of millions of controllers, where memory bandwidth is the
+		//!				limit.
+		//!
+		//!				Gives the same outputs as a Pid with the same settings, except on the first run. Pid
+		//!				skips the derivative on its first run, but LeanPid has no run count, so it takes
+		//!				the change from initialInput instead. Pass the first input as initialInput to get
+		//!				exactly the same outputs as Pid.
+		template <class dataType> class LeanPid
+		{
+			public:
+
+				//! @brief		Creates a controller with a zero integral and output.
+				//! @param		initialInput	The input the first derivative is taken from.
+				constexpr explicit LeanPid(dataType initialInput = dataType(0));
+
+				//! @brief		Computes and returns the new output.
+				dataType Run(const LeanPidParams<dataType> & params, dataType setPoint, dataType input);
+
+				//! @brief		Zeroes the integral term and output, and sets the previous input.
+				void Reset(dataType initialInput);
+
+				constexpr dataType GetOutput() const;		//!< Returns the output calculated by the last Run().
+				constexpr dataType GetITerm() const;		//!< Returns the (clamped) integral term.
+
+			private:
+
+				dataType iTerm;
+				dataType prevInput;
+				dataType prevOutput;
+		};
+
+		static_assert(sizeof(LeanPid<float>) == 12, "LeanPid<float> must be 12 bytes.");
+		static_assert(sizeof(LeanPid<double>) == 24, "LeanPid<double> must be 24 bytes.");
+		static_assert(sizeof(LeanPid<Q16_16>) == 12, "LeanPid<Q16_16> must be 12 bytes.");
+#if defined(__SIZEOF_INT128__)
+		static_assert(sizeof(LeanPid<Q32_32>) == 24, "LeanPid<Q32_32> must be 24 bytes.");
+#endif
+
+		//! @brief		Runs numPids controllers which share params, each with its own set-point and input.
+		//! @details	Equivalent to outputs[i] = pids[i].Run(params, setPoints[i], inputs[i]) for each i.
+		template <class dataType> void RunLeanPids(
+			const LeanPidParams<dataType> & params, LeanPid<dataType> * pids,
+			const dataType * setPoints, const dataType * inputs, dataType * outputs, size_t numPids);
+
+		//===============================================================================================//
+		//============================ TEMPLATE FUNCTION DEFINITIONS ====================================//
+		//===============================================================================================//
+
+		template <class dataType> constexpr bool LeanPidParams<dataType>::TuningsAreValid(dataType kp, dataType ki, dataType kd)
+		{
+			return !(kp < 0 || ki < 0 || kd < 0);
+		}
+
+		template <class dataType>
+		constexpr dataType LeanPidParams<dataType>::ApplyDirection(dataType gain, ControllerDirection controllerDir)
+		{
+			return (controllerDir == ControllerDirection::PID_REVERSE) ? (0 - gain) : gain;
+		}
+
+		template <class dataType> constexpr LeanPidParams<dataType>::LeanPidParams(
+			dataType kp,
+			dataType ki,
+			dataType kd,
+			ControllerDirection controllerDir,
+			OutputMode outputMode,
+			samplePeriodType samplePeriodMs,
+			dataType minOutput,
+			dataType maxOutput) :
+				Zp(TuningsAreValid(kp, ki, kd) ? ApplyDirection(kp, controllerDir) : dataType(0)),
+				Zi(TuningsAreValid(kp, ki, kd) ? ApplyDirection(PidTraits<dataType>::ScaleKi(ki, samplePeriodMs), controllerDir) : dataType(0)),
+				Zd(TuningsAreValid(kp, ki, kd) ? ApplyDirection(PidTraits<dataType>::ScaleKd(kd, samplePeriodMs), controllerDir) : dataType(0)),
+				outMin((minOutput < maxOutput) ? minOutput : dataType(0)),
+				outMax((minOutput < maxOutput) ? maxOutput : dataType(0)),
+				accumulate(outputMode == OutputMode::ACCUMULATE_OUTPUT),
+				reverse(controllerDir == ControllerDirection::PID_REVERSE),
+				Kp(TuningsAreValid(kp, ki, kd) ? kp : dataType(0)),
+				Ki(TuningsAreValid(kp, ki, kd) ? ki : dataType(0)),
+				Kd(TuningsAreValid(kp, ki, kd) ? kd : dataType(0)),
+				samplePeriodMs(samplePeriodMs)
+		{
+		}
+
+		template <class dataType> void LeanPidParams<dataType>::SetTunings(dataType kp, dataType ki, dataType kd)
+		{
+			if(!TuningsAreValid(kp, ki, kd))
+				return;
+
+			this->Kp = kp;
+			this->Ki = ki;
+			this->Kd = kd;
+
+			// Same time-step scaling as Pid::SetTunings()
+			this->Zp = kp;
+			this->Zi = PidTraits<dataType>::ScaleKi(ki, this->samplePeriodMs);
+			this->Zd = PidTraits<dataType>::ScaleKd(kd, this->samplePeriodMs);
+			if(this->reverse)
+			{
+				this->Zp = (0 - this->Zp);
+				this->Zi = (0 - this->Zi);
+				this->Zd = (0 - this->Zd);
+			}
+		}
+
+		template <class dataType> void LeanPidParams<dataType>::SetOutputLimits(dataType min, dataType max)
+		{
+			if(min >= max)
+				return;
+			this->outMin = min;
+			this->outMax = max;
+		}
+
+		template <class dataType> constexpr dataType LeanPidParams<dataType>::GetKp() const { return this->Kp; }
+		template <class dataType> constexpr dataType LeanPidParams<dataType>::GetKi() const { return this->Ki; }
+		template <class dataType> constexpr dataType LeanPidParams<dataType>::GetKd() const { return this->Kd; }
+		template <class dataType> constexpr dataType LeanPidParams<dataType>::GetZp() const { return this->Zp; }
+		template <class dataType> constexpr dataType LeanPidParams<dataType>::GetZi() const { return this->Zi; }
+		template <class dataType> constexpr dataType LeanPidParams<dataType>::GetZd() const { return this->Zd; }
+		template <class dataType> constexpr dataType LeanPidParams<dataType>::GetOutMin() const { return this->outMin; }
+		template <class dataType> constexpr dataType LeanPidParams<dataType>::GetOutMax() const { return this->outMax; }
+
+		template <class dataType> constexpr LeanPid<dataType>::LeanPid(dataType initialInput) :
+			iTerm(0),
+			prevInput(initialInput),
+			prevOutput(0)
+		{
+		}
+
+		template <class dataType> dataType LeanPid<dataType>::Run(
+			const LeanPidParams<dataType> & params, dataType setPoint, dataType input)
+		{
+			// Same operations, in the same order, as Pid::Run()
+			const dataType error = setPoint - input;
+			const dataType pTerm = params.Zp*error;
+
+			dataType iTerm = this->iTerm + (params.Zi * error);
+			if(iTerm > params.outMax)
+				iTerm = params.outMax;
+			else if(iTerm < params.outMin)
+				iTerm = params.outMin;
+			this->iTerm = iTerm;
+
+			const dataType dTerm = -params.Zd*(input - this->prevInput);
+
+			dataType output = params.accumulate ?
+				this->prevOutput + pTerm + iTerm + dTerm :
+				pTerm + iTerm + dTerm;
+			if(output > params.outMax)
+				output = params.outMax;
+			else if(output < params.outMin)
+				output = params.outMin;
+
+			this->prevInput = input;
+			this->prevOutput = output;
+			return output;
+		}
+
+		template <class dataType> void LeanPid<dataType>::Reset(dataType initialInput)
+		{
+			this->iTerm = 0;
+			this->prevInput = initialInput;
+			this->prevOutput = 0;
+		}
+
+		template <class dataType> constexpr dataType LeanPid<dataType>::GetOutput() const
+		{
+			return this->prevOutput;
+		}
+
+		template <class dataType> constexpr dataType LeanPid<dataType>::GetITerm() const
+		{
+			return this->iTerm;
+		}
+
+		template <class dataType> void RunLeanPids(
+			const LeanPidParams<dataType> & params, LeanPid<dataType> * pids,
+			const dataType * setPoints, const dataType * inputs, dataType * outputs, size_t numPids)
+		{
+			// Copied once, so the compiler knows the parameters can't change part way through
+			const LeanPidParams<dataType> shared = params;
+			for(size_t i = 0; i < numPids; i++)
+				outputs[i] = pids[i].Run(shared, setPoints[i], inputs[i]);
+		}
+
+	} // namespace MPidNs
+} // namespace MbeddedNinja
+
+#endif // #ifndef M_PID_LEAN_PID_H
+
+// EOF
@@ -0,0 +1,234 @@
+//!
+//! @file 			LogHistogram.hpp
+//! @author 		Geoffrey Hunter <gbmhunter@gmail.com> (www.mbedded.ninja)
+//! @edited 		n/a
+//! @created		2026-10-16
+//! @last-modified 	2026-10-16
+//! @brief			Power-of-two bucketed histogram, for latencies measured in cycles or nanoseconds.
+//! @details
+//!					See README.rst in repo root dir for more info.
+
+#ifndef __cplusplus
+	#error Please build with C++ compiler
+#endif
+
+//===============================================================================================//
+//====================================== HEADER GUARD ===========================================//
+//===============================================================================================//
+
+#ifndef M_PID_LOG_HISTOGRAM_H
+#define M_PID_LOG_HISTOGRAM_H
+
+//===== SYSTEM LIBRARIES =====//
+#include <stdint.h>		// uint64_t
+#include <stddef.h>		// size_t
+#include <atomic>		// std::atomic
+
+namespace MbeddedNinja
+{
+	namespace MPidNs
+	{
+
+		//! @brief		A std::atomic<uint64_t> which starts at zero.
+		//! @details	The default constructor of std::atomic leaves the value uninitialised, so an array
+		//!				of them can't be part of an object built at compile time. An array of these can.
+		struct AtomicCounter : public std::atomic<uint64_t>
+		{
+			constexpr AtomicCounter() : std::atomic<uint64_t>(0) {}
+		};
+
+		//! @brief		A copy of a LogHistogram at one point in time.
+		struct LogHistogramSnapshot
+		{
+			//! @brief		Bucket 0 counts zeros, bucket b counts values in [2^(b-1), 2^b).
+			static const size_t numBuckets = 65;
+
+			uint64_t counts[numBuckets];
+			uint64_t total;		//!< Sum of counts.
+			uint64_t sum;		//!< Sum of the recorded values.
+			uint64_t max;		//!< Largest recorded value.
+
+			LogHistogramSnapshot();
+
+			//! @brief		Adds the counts of another snapshot to this one, e.g. to aggregate many controllers.
+			void Add(const LogHistogramSnapshot & other);
+
+			//! @brief		Returns the upper bound of the bucket which holds the given fraction (0 to 1)
+			//!				of the values, e.g. 0.99 for the 99th percentile. 0 if nothing was recorded.
+			uint64_t Percentile(double fraction) const;
+
+			//! @brief		Returns the mean of the recorded values.
+			double Mean() const;
+		};
+
+		//===============================================================================================//
+		//===================================== CLASS DEFINITION ========================================//
+		//===============================================================================================//
+
+		//! @brief		Histogram with one bucket per power of two.
+		//! @details	Recording is a count-leading-zeros and a few relaxed loads and stores. Only one thread
+		//!				may call Record(), so it doesn't need locked read-modify-write instructions, but any
+		//!				thread can call GetSnapshot() at any time without stopping the writer. A snapshot
+		//!				taken while recording may be one value behind in some buckets.
+		class LogHistogram
+		{
+			public:
+
+				//! @brief		Creates an empty histogram. constexpr, so it can be part of a controller
+				//!				built at compile time.
+				constexpr LogHistogram();
+
+				//! @brief		Copies the current counts.
+				LogHistogram(const LogHistogram & other);
+				LogHistogram & operator=(const LogHistogram & other);
+
+				//! @brief		Records one value. Only call from one thread.
+				void Record(uint64_t value);
+
+				//! @brief		Returns a copy of the counts. Safe to call from any thread.
+				LogHistogramSnapshot GetSnapshot() const;
+
+				//! @brief		Zeroes every bucket. Don't call while another thread is recording.
+				void Reset();
+
+				//! @brief		Returns the bucket a value is counted in.
+				static size_t BucketOf(uint64_t value);
+
+				//! @brief		Returns the largest value counted in a bucket.
+				static uint64_t BucketUpperBound(size_t bucket);
+
+			private:
+
+				AtomicCounter counts[LogHistogramSnapshot::numBuckets];
+				std::atomic<uint64_t> sum;
+				std::atomic<uint64_t> max;
+		};
+
+		//===============================================================================================//
+		//=================================== FUNCTION DEFINITIONS ======================================//
+		//===============================================================================================//
+
+		inline LogHistogramSnapshot::LogHistogramSnapshot() :
+			total(0),
+			sum(0),
+			max(0)
+		{
+			for(size_t b = 0; b < numBuckets; b++)
+				this->counts[b] = 0;
+		}
+
+		inline void LogHistogramSnapshot::Add(const LogHistogramSnapshot & other)
+		{
+			for(size_t b = 0; b < numBuckets; b++)
+				this->counts[b] += other.counts[b];
+			this->total += other.total;
+			this->sum += other.sum;
+			if(other.max > this->max)
+				this->max = other.max;
+		}
+
+		inline uint64_t LogHistogramSnapshot::Percentile(double fraction) const
+		{
+			if(this->total == 0)
+				return 0;
+
+			double target = fraction*(double)this->total;
+			uint64_t seen = 0;
+			for(size_t b = 0; b < numBuckets; b++)
+			{
+				seen += this->counts[b];
+				if((double)seen >= target && seen != 0)
+					return LogHistogram::BucketUpperBound(b);
+			}
+			return this->max;
+		}
+
+		inline double LogHistogramSnapshot::Mean() const
+		{
+			return this->total ? (double)this->sum/(double)this->total : 0.0;
+		}
+
+		constexpr LogHistogram::LogHistogram() :
+			counts(),
+			sum(0),
+			max(0)
+		{
+		}
+
+		inline LogHistogram::LogHistogram(const LogHistogram & other)
+		{
+			*this = other;
+		}
+
+		inline LogHistogram & LogHistogram::operator=(const LogHistogram & other)
+		{
+			for(size_t b = 0; b < LogHistogramSnapshot::numBuckets; b++)
+				this->counts[b].store(other.counts[b].load(std::memory_order_relaxed), std::memory_order_relaxed);
+			this->sum.store(other.sum.load(std::memory_order_relaxed), std::memory_order_relaxed);
+			this->max.store(other.max.load(std::memory_order_relaxed), std::memory_order_relaxed);
+			return *this;
+		}
+
+		inline void LogHistogram::Record(uint64_t value)
+		{
+			// Single writer, so a plain load and store is enough (no lock prefix)
+			std::atomic<uint64_t> & count = this->counts[BucketOf(value)];
+			count.store(count.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+			this->sum.store(this->sum.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+			if(value > this->max.load(std::memory_order_relaxed))
+				this->max.store(value, std::memory_order_relaxed);
+		}
+
+		inline LogHistogramSnapshot LogHistogram::GetSnapshot() const
+		{
+			LogHistogramSnapshot snapshot;
+			for(size_t b = 0; b < LogHistogramSnapshot::numBuckets; b++)
+			{
+				snapshot.counts[b] = this->counts[b].load(std::memory_order_relaxed);
+				snapshot.total += snapshot.counts[b];
+			}
+			snapshot.sum = this->sum.load(std::memory_order_relaxed);
+			snapshot.max = this->max.load(std::memory_order_relaxed);
+			return snapshot;
+		}
+
+		inline void LogHistogram::Reset()
+		{
+			for(size_t b = 0; b < LogHistogramSnapshot::numBuckets; b++)
+				this->counts[b].store(0, std::memory_order_relaxed);
+			this->sum.store(0, std::memory_order_relaxed);
+			this->max.store(0, std::memory_order_relaxed);
+		}
+
+		inline size_t LogHistogram::BucketOf(uint64_t value)
+		{
+			if(value == 0)
+				return 0;
+			#if defined(__GNUC__)
+				return (size_t)(64 - __builtin_clzll(value));
+			#else
+				size_t bucket = 0;
+				while(value)
+				{
+					value >>= 1;
+					bucket++;
+				}
+				return bucket;
+			#endif
+		}
+
+		inline uint64_t LogHistogram::BucketUpperBound(size_t bucket)
+		{
+			if(bucket == 0)
+				return 0;
+			if(bucket >= 64)
+				return UINT64_MAX;
+			return ((uint64_t)1 << bucket) - 1;
+		}
+
+	} // namespace MPidNs
+} // namespace MbeddedNinja
+
+#endif // #ifndef M_PID_LOG_HISTOGRAM_H
+
+// EOF
@@ -0,0 +1,140 @@
+//!
+//! @file 			MappedFile.hpp
+//! @author 		Geoffrey Hunter <gbmhunter@gmail.com> (www.mbedded.ninja)
+//! @edited 		n/a
+//! @created		2026-10-16
+//! @last-modified 	2026-10-16
+//! @brief			Read-only memory-mapped file.
+//! @details
+//!					See README.rst in repo root dir for more info.
+
+#ifndef __cplusplus
+	#error Please build with C++ compiler
+#endif
+
+//===============================================================================================//
+//====================================== HEADER GUARD ===========================================//
+//===============================================================================================//
+
+#ifndef M_PID_MAPPED_FILE_H
+#define M_PID_MAPPED_FILE_H
+
+//===== SYSTEM LIBRARIES =====//
+#include <stdint.h>		// uint8_t
+#include <stddef.h>		// size_t
+
+#if defined(__unix__) || defined(__APPLE__)
+	#include <fcntl.h>		// open()
+	#include <sys/mman.h>	// mmap(), munmap(), madvise()
+	#include <sys/stat.h>	// fstat()
+	#include <unistd.h>		// close()
+	#define M_PID_HAS_MMAP 1
+#else
+	#define M_PID_HAS_MMAP 0
+#endif
+
+namespace MbeddedNinja
+{
+	namespace MPidNs
+	{
+
+		//===============================================================================================//
+		//===================================== CLASS DEFINITION ========================================//
+		//===============================================================================================//
+
+		//! @brief		Maps a whole file into memory, read-only.
+		//! @details	The pages are loaded by the OS as they are touched, so reading the mapping is
+		//!				limited by I/O (or page cache) bandwidth, with no copies into user buffers.
+		//!				Only supported on POSIX systems; elsewhere Open() always fails.
+		class MappedFile
+		{
+			public:
+
+				MappedFile() :
+					data(NULL),
+					size(0)
+				{
+				}
+
+				~MappedFile()
+				{
+					this->Close();
+				}
+
+				MappedFile(const MappedFile &) = delete;
+				MappedFile & operator=(const MappedFile &) = delete;
+
+				//! @brief		Maps the file at path, closing any file that is already mapped.
+				//! @param		sequential		Hint to the OS that the file will be read front to back,
+				//!								so it reads ahead aggressively.
+				//! @returns	false if the file couldn't be opened or mapped (or is empty).
+				bool Open(const char * path, bool sequential = true)
+				{
+					this->Close();
+
+					#if(M_PID_HAS_MMAP == 1)
+						int fd = open(path, O_RDONLY);
+						if(fd < 0)
+							return false;
+
+						struct stat info;
+						if(fstat(fd, &info) != 0 || info.st_size <= 0)
+						{
+							close(fd);
+							return false;
+						}
+
+						void * mapping = mmap(NULL, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+						// The mapping keeps the file open
+						close(fd);
+						if(mapping == MAP_FAILED)
+							return false;
+
+						if(sequential)
+							madvise(mapping, (size_t)info.st_size, MADV_SEQUENTIAL);
+
+						this->data = static_cast<const uint8_t *>(mapping);
+						this->size = (size_t)info.st_size;
+						return true;
+					#else
+						(void)path;
+						(void)sequential;
+						return false;
+					#endif
+				}
+
+				//! @brief		Unmaps the file. Pointers into it become invalid.
+				void Close()
+				{
+					#if(M_PID_HAS_MMAP == 1)
+						if(this->data)
+							munmap(const_cast<uint8_t *>(this->data), this->size);
+					#endif
+					this->data = NULL;
+					this->size = 0;
+				}
+
+				//! @brief		Returns the start of the mapping, or NULL if no file is mapped.
+				const uint8_t * GetData() const
+				{
+					return this->data;
+				}
+
+				//! @brief		Returns the size of the mapped file in bytes.
+				size_t GetSize() const
+				{
+					return this->size;
+				}
+
+			private:
+
+				const uint8_t * data;
+				size_t size;
+		};
+
+	} // namespace MPidNs
+} // namespace MbeddedNinja
+
+#endif // #ifndef M_PID_MAPPED_FILE_H
+
+// EOF
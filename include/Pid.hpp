@@ -3,7 +3,7 @@
 //! @author 		Geoffrey Hunter <gbmhunter@gmail.com> (www.mbedded.ninja)
 //! @edited 		n/a
 //! @created		2012-10-01
-//! @last-modified 	2014-10-10
+//! @last-modified 	2026-10-16
 //! @brief
 //! @details
 //!					See README.rst in repo root dir for more info.
@@ -22,13 +22,19 @@
 
 //===== SYSTEM LIBRARIES =====//
 #include <stdint.h>		// uint32_t
+#include <stddef.h>		// size_t, NULL
 //#include <iostream>		//! @debug
 
-//===== USER LIBRARIES =====//
-//#include "MSlotmachine/api/MSlotmachineApi.hpp"			//!< Callback functionality
-
 //===== USER SOURCE =====//
-// none
+#include "Config.hpp"
+#include "PidTraits.hpp"
+#if(M_PID_CONFIG_ENABLE_TRACE == 1)
+	#include "PidTrace.hpp"
+#endif
+#if(M_PID_CONFIG_ENABLE_INSTRUMENTATION == 1)
+	#include "CycleClock.hpp"
+	#include "PidInstrumentation.hpp"
+#endif
 
 
 namespace MbeddedNinja
@@ -36,6 +42,21 @@ namespace MbeddedNinja
 	namespace MPidNs
 	{
 		
+		// Forward declarations
+		template <class dataType> class ConcurrentPid;
+
+		//! @brief		Everything a controller carries from one Run() to the next, plus it's set-point.
+		//! @details	Restoring this into a controller with the same settings makes it's next Run()
+		//!				give exactly the output the original controller would have given.
+		template <class dataType> struct PidState
+		{
+			dataType setPoint;
+			dataType prevInput;
+			dataType iTerm;
+			dataType prevOutput;
+			uint32_t numTimesRan;
+		};
+
 		//===============================================================================================//
 		//===================================== CLASS DEFINITION ========================================//
 		//===============================================================================================//
@@ -65,17 +86,25 @@ namespace MbeddedNinja
 					DISTANCE_PID = DONT_ACCUMULATE_OUTPUT,
 					VELOCITY_PID = ACCUMULATE_OUTPUT
 				};
+
+				//! @brief		The type used to store the sample period. double, except for fixed-point
+				//!				dataTypes, which use an integer number of milliseconds (see PidTraits).
+				typedef typename PidTraits<dataType>::samplePeriodType samplePeriodType;
 			
 				//! @brief 		Init function
 				//! @details   	The parameters specified here are those for for which we can't set up
 				//!    			reliable defaults, so we need to have the user set them.
-				Pid(
+				//!				The constructor is constexpr, so a controller (or an array of them) with
+				//!				constant arguments is built at compile time, gains scaled and all, and
+				//!				needs no code to run at startup. If a gain is negative, all gains are
+				//!				zero, and if minOutput >= maxOutput, both limits are zero.
+				constexpr Pid(
 					dataType kp,
 					dataType ki,
 					dataType kd,
 					ControllerDirection controllerDir,
 					OutputMode outputMode,
-					double samplePeriodMs,
+					samplePeriodType samplePeriodMs,
 					dataType minOutput,
 					dataType maxOutput,
 					dataType setPoint);
@@ -84,6 +113,38 @@ namespace MbeddedNinja
 				//! @details 	Call once per sampleTimeMs. Output is stored in the pidData structure.
 				void Run(dataType input);
 
+				//! @brief		Same as Run(), but with the integral and derivative scaled for dtMs
+				//!				milliseconds since the last call, rather than the sample period.
+				//! @details	The scale factors are cached, and only recalculated (with a divide) when dtMs
+				//!				changes. A dtMs equal to the sample period gives exactly the same result as
+				//!				Run(). A dtMs of 0 adds nothing to the integral and skips the derivative.
+				void Run(dataType input, samplePeriodType dtMs);
+
+				//! @brief		Same as Run(input, dt), with dt the time since the timestamp of the last call
+				//!				to RunAt(), e.g. from clock_gettime() or a hardware timer.
+				//! @details	The first call uses the sample period. A timestamp earlier than the last one
+				//!				is treated as a dt of 0.
+				void RunAt(dataType input, uint64_t timestampNs);
+
+				//! @brief		Runs the controller once for each of n inputs, writing each output to outputs.
+				//! @details	Gives exactly the same outputs, and leaves the controller in exactly the same state,
+				//!				as calling Run() on each input in turn. The controller state is kept in local
+				//!				variables for the whole block, rather than being loaded and stored every step.
+				//!				Intended for offline replay and simulation.
+				void RunBlock(const dataType * inputs, dataType * outputs, size_t n);
+
+				//! @brief		Same as RunBlock(), but also writes the proportional, integral and derivative
+				//!				terms of each step.
+				void RunBlock(
+					const dataType * inputs, dataType * outputs,
+					dataType * pTerms, dataType * iTerms, dataType * dTerms, size_t n);
+
+				//! @brief		Looks up the gains for operating point (x, y) in a GainSchedule, then calls Run().
+				//! @details	Same as calling SetTunings() with the interpolated gains and then Run(), but the
+				//!				gains come out of the table already time-scaled, so there is no divide.
+				//!				GetKp(), GetKi() and GetKd() keep returning the gains last given to SetTunings().
+				template <class scheduleType> void RunScheduled(dataType input, const scheduleType & schedule, dataType x, dataType y = 0);
+
 				void SetOutputLimits(dataType min, dataType max);
 			
 				//! @details	The PID will either be connected to a direct acting process (+error leads to +output, aka inputs are positive)
@@ -99,29 +160,46 @@ namespace MbeddedNinja
 				void SetTunings(dataType kp, dataType ki, dataType kd);
 
 				//! @brief		Returns the actual (not time-scaled) proportional constant.
-				dataType GetKp();
+				constexpr dataType GetKp() const;
 
 				//! @brief		Returns the actual (not time-scaled) integral constant.
-				dataType GetKi();
+				constexpr dataType GetKi() const;
 
 				//! @brief		Returns the actual (not time-scaled) derivative constant.
-				dataType GetKd();
+				constexpr dataType GetKd() const;
 
 				//! @brief		Returns the time-scaled (dependent on sample period) proportional constant.
-				dataType GetZp();
+				constexpr dataType GetZp() const;
 
 				//! @brief		Returns the time-scaled (dependent on sample period) integral constant.
-				dataType GetZi();
+				constexpr dataType GetZi() const;
 
 				//! @brief		Returns the time-scaled (dependent on sample period) derivative constant.
-				dataType GetZd();
+				constexpr dataType GetZd() const;
+
+				//! @brief		Returns the controller's run-time state, e.g. to checkpoint it.
+				PidState<dataType> GetState() const;
+
+				//! @brief		Restores run-time state saved with GetState(). The settings (gains, limits,
+				//!				direction, ...) are left as they are. output is set to state.prevOutput.
+				void SetState(const PidState<dataType> & state);
+
+				#if(M_PID_CONFIG_ENABLE_TRACE == 1)
+					//! @brief		Every call to Run() (and every step of RunBlock()) pushes a PidTraceRecord
+					//!				into this ring. Pass NULL to stop tracing.
+					//! @details	Pushing never blocks; if the ring is full the record is dropped and counted.
+					//!				Drain the ring from another thread with a PidTraceConsumer.
+					void SetTraceRing(PidTraceRing<dataType> * traceRing);
+				#endif
+
+				#if(M_PID_CONFIG_ENABLE_INSTRUMENTATION == 1)
+					//! @brief		Returns a copy of the controller's counters and Run() latency histogram.
+					//! @details	Safe to call from any thread while another thread is calling Run().
+					PidInstrumentationSnapshot GetInstrumentation() const;
 
-				/*
-				#if(cp3id_config_INCLUDE_DEBUG_CODE == 1)
-					//! @brief		Pass in a callback for printing debug information.
-					//! @details	Uses the slotmachine-cpp library to provide callback to method functionality.
-					void SetDebugPrintCallback(SlotMachine::Callback<void, const char*> debugPrintCallback);
-				#endif*/
+					//! @brief		Zeroes the counters. Don't call while another thread is calling Run().
+					void ResetInstrumentation();
+				#endif
 
 				//! @brief 		The set-point the PID control is trying to make the output converge to.
 				dataType setPoint;
@@ -132,11 +210,42 @@ namespace MbeddedNinja
 			
 			private:
 
-				/*
-				#if(cp3id_config_INCLUDE_DEBUG_CODE == 1)
-					//! @brief		Buffer for debug snprintf() calls.
-					char debugBuff[cp3id_config_DEBUG_BUFF_SIZE];
-				#endif*/
+				//! @brief		Applies parameter blocks published from other threads directly to the private fields.
+				friend class ConcurrentPid<dataType>;
+
+				//! @brief		true if none of the gains are negative.
+				static constexpr bool TuningsAreValid(dataType kp, dataType ki, dataType kd);
+
+				//! @brief		Negates a time-scaled gain for a reverse acting controller.
+				static constexpr dataType ApplyDirection(dataType gain, ControllerDirection controllerDir);
+
+				//! @brief		The body of Run(), using zi and zd rather than Zi and Zd.
+				void RunWithGains(dataType input, dataType zi, dataType zd);
+
+				//! @brief		Runs with Zi and Zd scaled for a time-step of dtNs.
+				void RunForTimestep(dataType input, uint64_t dtNs);
+
+				//! @brief		Recalculates samplePeriodNs, and caches the ratios for a time-step of one sample period.
+				void ResetTimestep();
+
+				//! @brief		Implementation of RunBlock(), with the output mode and term recording fixed at
+				//!				compile time so the loop has no mode checks.
+				template <bool accumulate, bool writeTerms> void RunBlockImpl(
+					const dataType * inputs, dataType * outputs,
+					dataType * pTerms, dataType * iTerms, dataType * dTerms, size_t n);
+
+				#if(M_PID_CONFIG_ENABLE_TRACE == 1)
+					//! @brief		Pushes a record into traceRing (if one is set).
+					void PushTrace(dataType input, dataType error, dataType pTerm, dataType iTerm, dataType dTerm, dataType output, uint32_t tick);
+
+					//! @brief		Where trace records go. NULL when not tracing.
+					PidTraceRing<dataType> * traceRing;
+				#endif
+
+				#if(M_PID_CONFIG_ENABLE_INSTRUMENTATION == 1)
+					//! @brief		Hot-path counters. Written only by the thread calling Run().
+					PidInstrumentation instrumentation;
+				#endif
 
 				//! @brief		Time-step scaled proportional constant for quick calculation (equal to actualKp)
 				dataType Zp;
@@ -172,7 +281,7 @@ namespace MbeddedNinja
 
 				//! @brief		The sample period (in milliseconds) between successive Pid_Run() calls.
 				//! @details	The constants with the z prefix are scaled according to this value.
-				double samplePeriodMs;
+				samplePeriodType samplePeriodMs;
 
 				dataType pTerm;				//!< The proportional term that is summed as part of the output (calculated in Pid_Run())
 				dataType iTerm;				//!< The integral term that is summed as part of the output (calculated in Pid_Run())
@@ -185,6 +294,24 @@ namespace MbeddedNinja
 				//! @details	Safely stops counting once it reaches 2^32-1 (rather than overflowing).
 				uint32_t numTimesRan;
 
+				//! @brief		The sample period, in nanoseconds.
+				uint64_t samplePeriodNs;
+
+				//! @brief		The time-step that timestepRatio and invTimestepRatio were calculated for.
+				uint64_t timestepNs;
+
+				//! @brief		timestepNs/samplePeriodNs, multiplies Zi in Run(input, dt).
+				dataType timestepRatio;
+
+				//! @brief		samplePeriodNs/timestepNs, multiplies Zd in Run(input, dt).
+				dataType invTimestepRatio;
+
+				//! @brief		The timestamp passed to the last call to RunAt().
+				uint64_t lastTimestampNs;
+
+				//! @brief		false until RunAt() is first called.
+				bool hasTimestamp;
+
 				//! @brief		The controller direction (FORWARD or REVERSE).
 				ControllerDirection controllerDir;
 
@@ -196,47 +323,120 @@ namespace MbeddedNinja
 		//============================ TEMPLATE FUNCTION DEFINITIONS ====================================//
 		//===============================================================================================//
 
-		template <class dataType> Pid<dataType>::Pid(
+		template <class dataType> constexpr bool Pid<dataType>::TuningsAreValid(dataType kp, dataType ki, dataType kd)
+		{
+			return !(kp < 0 || ki < 0 || kd < 0);
+		}
+
+		template <class dataType>
+		constexpr dataType Pid<dataType>::ApplyDirection(dataType gain, ControllerDirection controllerDir)
+		{
+			return (controllerDir == ControllerDirection::PID_REVERSE) ? (0 - gain) : gain;
+		}
+
+		// Everything is set in the initialiser list, so the constructor can be constexpr. The gains are
+		// scaled the same way as SetTunings() does it.
+		template <class dataType> constexpr Pid<dataType>::Pid(
 			dataType kp,
 			dataType ki,
 			dataType kd,
 			ControllerDirection controllerDir,
 			OutputMode outputMode,
-			double samplePeriodMs,
+			samplePeriodType samplePeriodMs,
 			dataType minOutput,
 			dataType maxOutput,
 			dataType setPoint) :
-				numTimesRan(0)
+				setPoint(setPoint),
+				output(0),
+				#if(M_PID_CONFIG_ENABLE_TRACE == 1)
+					traceRing(NULL),
+				#endif
+				#if(M_PID_CONFIG_ENABLE_INSTRUMENTATION == 1)
+					instrumentation(),
+				#endif
+				Zp(TuningsAreValid(kp, ki, kd) ? ApplyDirection(kp, controllerDir) : dataType(0)),
+				Zi(TuningsAreValid(kp, ki, kd) ? ApplyDirection(PidTraits<dataType>::ScaleKi(ki, samplePeriodMs), controllerDir) : dataType(0)),
+				Zd(TuningsAreValid(kp, ki, kd) ? ApplyDirection(PidTraits<dataType>::ScaleKd(kd, samplePeriodMs), controllerDir) : dataType(0)),
+				Kp(TuningsAreValid(kp, ki, kd) ? kp : dataType(0)),
+				Ki(TuningsAreValid(kp, ki, kd) ? ki : dataType(0)),
+				Kd(TuningsAreValid(kp, ki, kd) ? kd : dataType(0)),
+				prevInput(0),
+				inputChange(0),
+				error(0),
+				prevOutput(0),
+				samplePeriodMs(samplePeriodMs),
+				pTerm(0),
+				iTerm(0),
+				dTerm(0),
+				outMin((minOutput < maxOutput) ? minOutput : dataType(0)),
+				outMax((minOutput < maxOutput) ? maxOutput : dataType(0)),
+				numTimesRan(0),
+				samplePeriodNs(PidTraits<dataType>::ToNanoseconds(samplePeriodMs)),
+				timestepNs(PidTraits<dataType>::ToNanoseconds(samplePeriodMs)),
+				timestepRatio(1),
+				invTimestepRatio(1),
+				lastTimestampNs(0),
+				hasTimestamp(false),
+				controllerDir(controllerDir),
+				outputMode(outputMode)
+		{
+		}
+
+		template <class dataType> void Pid<dataType>::Run(dataType input)
+		{
+			this->RunWithGains(input, this->Zi, this->Zd);
+		}
 
+		template <class dataType> void Pid<dataType>::Run(dataType input, samplePeriodType dtMs)
 		{
-			//std::cout << __PRETTY_FUNCTION__ << " called." << std::endl;
+			this->RunForTimestep(input, PidTraits<dataType>::ToNanoseconds(dtMs));
+		}
 
-			this->SetOutputLimits(minOutput, maxOutput);
+		template <class dataType> void Pid<dataType>::RunAt(dataType input, uint64_t timestampNs)
+		{
+			uint64_t dtNs = this->samplePeriodNs;
+			if(this->hasTimestamp)
+				dtNs = (timestampNs > this->lastTimestampNs) ? timestampNs - this->lastTimestampNs : 0;
+			this->lastTimestampNs = timestampNs;
+			this->hasTimestamp = true;
 
-			this->samplePeriodMs = samplePeriodMs;
+			this->RunForTimestep(input, dtNs);
+		}
 
-			this->SetControllerDirection(controllerDir);
-			this->outputMode = outputMode;
-			
-			// Set tunings with provided constants
-			this->SetTunings(kp, ki, kd);
-			this->setPoint = setPoint;
-			this->prevInput = 0;
-			this->prevOutput = 0;
+		template <class dataType> void Pid<dataType>::RunForTimestep(dataType input, uint64_t dtNs)
+		{
+			// Jittery time-steps change every call, but a steady one only pays for the divides once
+			if(dtNs != this->timestepNs)
+			{
+				this->timestepNs = dtNs;
+				PidTraits<dataType>::TimestepRatios(dtNs, this->samplePeriodNs, this->timestepRatio, this->invTimestepRatio);
+			}
 
-			this->pTerm = 0.0;
-			this->iTerm = 0.0;
-			this->dTerm = 0.0;
+			if(dtNs == this->samplePeriodNs)
+				this->RunWithGains(input, this->Zi, this->Zd);
+			else
+				this->RunWithGains(input, this->Zi*this->timestepRatio, this->Zd*this->invTimestepRatio);
+		}
 
+		template <class dataType> void Pid<dataType>::ResetTimestep()
+		{
+			this->samplePeriodNs = PidTraits<dataType>::ToNanoseconds(this->samplePeriodMs);
+			this->timestepNs = this->samplePeriodNs;
+			this->timestepRatio = 1;
+			this->invTimestepRatio = 1;
 		}
 
-		template <class dataType> void Pid<dataType>::Run(dataType input)
+		template <class dataType> void Pid<dataType>::RunWithGains(dataType input, dataType zi, dataType zd)
 		{
 			// Compute all the working error variables
 			//dataType input = *_input;
 			
 			//std::cout << __PRETTY_FUNCTION__ << " called with input = '" << input << "'." << std::endl;
 
+			#if(M_PID_CONFIG_ENABLE_INSTRUMENTATION == 1)
+				const uint64_t startCycles = ReadCycleCounter();
+			#endif
+
 			this->error = this->setPoint - input;
 			
 			// PROPORTIONAL CALCS
@@ -245,12 +445,22 @@ namespace MbeddedNinja
 
 			// INTEGRAL CALCS
 			
-			this->iTerm += (this->Zi * this->error);
+			this->iTerm += (zi * this->error);
 			// Perform min/max bound checking on integral term
 			if(this->iTerm > this->outMax)
+			{
 				this->iTerm = this->outMax;
+				#if(M_PID_CONFIG_ENABLE_INSTRUMENTATION == 1)
+					this->instrumentation.Count(PidInstrumentation::INTEGRATOR_CLAMPS);
+				#endif
+			}
 			else if(this->iTerm < this->outMin)
+			{
 				this->iTerm = this->outMin;
+				#if(M_PID_CONFIG_ENABLE_INSTRUMENTATION == 1)
+					this->instrumentation.Count(PidInstrumentation::INTEGRATOR_CLAMPS);
+				#endif
+			}
 
 			//===== DERIVATIVE CALS =====//
 
@@ -259,12 +469,15 @@ namespace MbeddedNinja
 			{
 				//std::cout << "numTimesRan is '" << this->numTimesRan << "'." << std::endl;
 				this->inputChange = (input - this->prevInput);
-				this->dTerm = -this->Zd*this->inputChange;
+				this->dTerm = -zd*this->inputChange;
 			}
 			else
 			{
 				//std::cout << "numTimesRan is 0, derivative not calculated." << std::endl;
 				this->dTerm = 0;
+				#if(M_PID_CONFIG_ENABLE_INSTRUMENTATION == 1)
+					this->instrumentation.Count(PidInstrumentation::DERIVATIVE_SKIPS);
+				#endif
 			}
 
 			// Compute PID Output. Value depends on outputMode
@@ -281,19 +494,181 @@ namespace MbeddedNinja
 
 			// Limit output
 			if(this->output > this->outMax)
+			{
 				this->output = this->outMax;
+				#if(M_PID_CONFIG_ENABLE_INSTRUMENTATION == 1)
+					this->instrumentation.Count(PidInstrumentation::OUTPUT_SATURATIONS);
+				#endif
+			}
 			else if(this->output < this->outMin)
+			{
 				this->output = this->outMin;
+				#if(M_PID_CONFIG_ENABLE_INSTRUMENTATION == 1)
+					this->instrumentation.Count(PidInstrumentation::OUTPUT_SATURATIONS);
+				#endif
+			}
 			
 			// Remember input value to next call
 			this->prevInput = input;
 			// Remember last output for next call
 			this->prevOutput = this->output;
 
+			#if(M_PID_CONFIG_ENABLE_TRACE == 1)
+				this->PushTrace(input, this->error, this->pTerm, this->iTerm, this->dTerm, this->output, this->numTimesRan);
+			#endif
+
 			// Increment the Run() counter, after checking to make sure it hasn't reached
 			// max value.
 			if(this->numTimesRan < 0xFFFFFFFF)
 				this->numTimesRan++;
+
+			#if(M_PID_CONFIG_ENABLE_INSTRUMENTATION == 1)
+				this->instrumentation.Count(PidInstrumentation::NUM_RUNS);
+				this->instrumentation.RecordRunCycles(ReadCycleCounter() - startCycles);
+			#endif
+		}
+
+		template <class dataType>
+		template <class scheduleType>
+		void Pid<dataType>::RunScheduled(dataType input, const scheduleType & schedule, dataType x, dataType y)
+		{
+			schedule.Lookup(x, y, this->Zp, this->Zi, this->Zd);
+			if(this->controllerDir == ControllerDirection::PID_REVERSE)
+			{
+				this->Zp = (0 - this->Zp);
+				this->Zi = (0 - this->Zi);
+				this->Zd = (0 - this->Zd);
+			}
+			this->Run(input);
+		}
+
+		template <class dataType> void Pid<dataType>::RunBlock(const dataType * inputs, dataType * outputs, size_t n)
+		{
+			if(this->outputMode == OutputMode::ACCUMULATE_OUTPUT)
+				this->RunBlockImpl<true, false>(inputs, outputs, NULL, NULL, NULL, n);
+			else
+				this->RunBlockImpl<false, false>(inputs, outputs, NULL, NULL, NULL, n);
+		}
+
+		template <class dataType> void Pid<dataType>::RunBlock(
+			const dataType * inputs, dataType * outputs,
+			dataType * pTerms, dataType * iTerms, dataType * dTerms, size_t n)
+		{
+			if(this->outputMode == OutputMode::ACCUMULATE_OUTPUT)
+				this->RunBlockImpl<true, true>(inputs, outputs, pTerms, iTerms, dTerms, n);
+			else
+				this->RunBlockImpl<false, true>(inputs, outputs, pTerms, iTerms, dTerms, n);
+		}
+
+		template <class dataType>
+		template <bool accumulate, bool writeTerms>
+		void Pid<dataType>::RunBlockImpl(
+			const dataType * inputs, dataType * outputs,
+			dataType * pTerms, dataType * iTerms, dataType * dTerms, size_t n)
+		{
+			if(n == 0)
+				return;
+
+			// Parameters can't change during the block
+			const dataType setPoint = this->setPoint;
+			const dataType Zp = this->Zp;
+			const dataType Zi = this->Zi;
+			const dataType Zd = this->Zd;
+			const dataType outMin = this->outMin;
+			const dataType outMax = this->outMax;
+
+			// State, written back once at the end
+			dataType error = this->error;
+			dataType pTerm = this->pTerm;
+			dataType iTerm = this->iTerm;
+			dataType dTerm = this->dTerm;
+			dataType inputChange = this->inputChange;
+			dataType prevInput = this->prevInput;
+			dataType output = this->prevOutput;
+
+			// Same as Run(), the very first step has no derivative
+			const size_t firstWithDerivative = (this->numTimesRan == 0) ? 1 : 0;
+
+			#if(M_PID_CONFIG_ENABLE_INSTRUMENTATION == 1)
+				// Counted locally and added once at the end of the block
+				uint64_t integratorClamps = 0;
+				uint64_t outputSaturations = 0;
+			#endif
+
+			for(size_t i = 0; i < n; i++)
+			{
+				const dataType input = inputs[i];
+
+				error = setPoint - input;
+				pTerm = Zp*error;
+
+				iTerm += (Zi * error);
+				#if(M_PID_CONFIG_ENABLE_INSTRUMENTATION == 1)
+					integratorClamps += (iTerm > outMax || iTerm < outMin) ? 1 : 0;
+				#endif
+				if(iTerm > outMax)
+					iTerm = outMax;
+				else if(iTerm < outMin)
+					iTerm = outMin;
+
+				if(i >= firstWithDerivative)
+				{
+					inputChange = (input - prevInput);
+					dTerm = -Zd*inputChange;
+				}
+				else
+					dTerm = 0;
+
+				if(accumulate)
+					output = output + pTerm + iTerm + dTerm;
+				else
+					output = pTerm + iTerm + dTerm;
+
+				#if(M_PID_CONFIG_ENABLE_INSTRUMENTATION == 1)
+					outputSaturations += (output > outMax || output < outMin) ? 1 : 0;
+				#endif
+				if(output > outMax)
+					output = outMax;
+				else if(output < outMin)
+					output = outMin;
+
+				prevInput = input;
+				outputs[i] = output;
+
+				if(writeTerms)
+				{
+					pTerms[i] = pTerm;
+					iTerms[i] = iTerm;
+					dTerms[i] = dTerm;
+				}
+
+				#if(M_PID_CONFIG_ENABLE_TRACE == 1)
+					uint32_t tick = this->numTimesRan + (uint32_t)i;
+					this->PushTrace(input, error, pTerm, iTerm, dTerm, output, (tick < this->numTimesRan) ? 0xFFFFFFFF : tick);
+				#endif
+			}
+
+			this->error = error;
+			this->pTerm = pTerm;
+			this->iTerm = iTerm;
+			this->dTerm = dTerm;
+			this->inputChange = inputChange;
+			this->prevInput = prevInput;
+			this->prevOutput = output;
+			this->output = output;
+
+			#if(M_PID_CONFIG_ENABLE_INSTRUMENTATION == 1)
+				this->instrumentation.Count(PidInstrumentation::NUM_RUNS, n);
+				this->instrumentation.Count(PidInstrumentation::INTEGRATOR_CLAMPS, integratorClamps);
+				this->instrumentation.Count(PidInstrumentation::OUTPUT_SATURATIONS, outputSaturations);
+				this->instrumentation.Count(PidInstrumentation::DERIVATIVE_SKIPS, firstWithDerivative);
+			#endif
+
+			// Same saturating count as Run()
+			if(n >= (size_t)(0xFFFFFFFF - this->numTimesRan))
+				this->numTimesRan = 0xFFFFFFFF;
+			else
+				this->numTimesRan += (uint32_t)n;
 		}
 
 		//! @brief		Sets the PID tunings.
@@ -309,10 +684,8 @@ namespace MbeddedNinja
 
 		   // Calculate time-step-scaled PID terms
 		   this->Zp = kp;
-
-			// The next bit requires double->dataType casting functionality.
-		   this->Zi = ki * (dataType)(this->samplePeriodMs/1000.0);
-		   this->Zd = kd / (dataType)(this->samplePeriodMs/1000.0);
+		   this->Zi = PidTraits<dataType>::ScaleKi(ki, this->samplePeriodMs);
+		   this->Zd = PidTraits<dataType>::ScaleKd(kd, this->samplePeriodMs);
 
 		  if(this->controllerDir == ControllerDirection::PID_REVERSE)
 		   {
@@ -320,62 +693,70 @@ namespace MbeddedNinja
 			  this->Zi = (0 - this->Zi);
 			  this->Zd = (0 - this->Zd);
 		   }
-	/*
-			#if(cp3id_config_INCLUDE_DEBUG_CODE == 1)
-				snprintf(debugBuff,
-					sizeof(debugBuff)/sizeof(debugBuff[0]),
-					"PID: Tuning parameters set. Kp = %.1f, Ki = %.1f, Kd = %f.1, "
-					"Zp = %.1f, Zi = %.1f, Zd = %.1f, with sample period = %.1fms\r\n",
-					Kp,
-					Ki,
-					Kd,
-					Zp,
-					Zi,
-					Zd,
-					samplePeriodMs);
-				this->PrintDebugInfo(this->debugBuff);
-			#endif*/
+
+			#if(M_PID_CONFIG_ENABLE_INSTRUMENTATION == 1)
+				this->instrumentation.Count(PidInstrumentation::TUNING_CHANGES);
+			#endif
 		}
 
-		template <class dataType> dataType Pid<dataType>::GetKp()
+		template <class dataType> constexpr dataType Pid<dataType>::GetKp() const
 		{
 			return this->Kp;
 		}
 
-		template <class dataType> dataType Pid<dataType>::GetKi()
+		template <class dataType> constexpr dataType Pid<dataType>::GetKi() const
 		{
 			return this->Ki;
 		}
 
-		template <class dataType> dataType Pid<dataType>::GetKd()
+		template <class dataType> constexpr dataType Pid<dataType>::GetKd() const
 		{
 			return this->Kd;
 		}
 
-		template <class dataType> dataType Pid<dataType>::GetZp()
+		template <class dataType> constexpr dataType Pid<dataType>::GetZp() const
 		{
 			return this->Zp;
 		}
 
-		template <class dataType> dataType Pid<dataType>::GetZi()
+		template <class dataType> constexpr dataType Pid<dataType>::GetZi() const
 		{
 			return this->Zi;
 		}
 
-		template <class dataType> dataType Pid<dataType>::GetZd()
+		template <class dataType> constexpr dataType Pid<dataType>::GetZd() const
 		{
 			return this->Zd;
 		}
+
+		template <class dataType> PidState<dataType> Pid<dataType>::GetState() const
+		{
+			PidState<dataType> state;
+			state.setPoint = this->setPoint;
+			state.prevInput = this->prevInput;
+			state.iTerm = this->iTerm;
+			state.prevOutput = this->prevOutput;
+			state.numTimesRan = this->numTimesRan;
+			return state;
+		}
+
+		template <class dataType> void Pid<dataType>::SetState(const PidState<dataType> & state)
+		{
+			this->setPoint = state.setPoint;
+			this->prevInput = state.prevInput;
+			this->iTerm = state.iTerm;
+			this->prevOutput = state.prevOutput;
+			this->output = state.prevOutput;
+			this->numTimesRan = state.numTimesRan;
+		}
 		
 		template <class dataType> void Pid<dataType>::SetSamplePeriod(uint32_t newSamplePeriodMs)
 		{
 		   if (newSamplePeriodMs > 0)
 		   {
-			  dataType ratio  = (dataType)newSamplePeriodMs
-							  / (double)this->samplePeriodMs;
-			  this->Zi *= ratio;
-			  this->Zd /= ratio;
+			  PidTraits<dataType>::RescaleForSamplePeriod(this->Zi, this->Zd, newSamplePeriodMs, this->samplePeriodMs);
 			  this->samplePeriodMs = newSamplePeriodMs;
+			  this->ResetTimestep();
 		   }
 		}
 	
@@ -399,20 +780,43 @@ namespace MbeddedNinja
 			}
 		   this->controllerDir = controllerDir;
 		}
-/*
-		#if(cp3id_config_INCLUDE_DEBUG_CODE == 1)
-			template <class dataType> void Pid<dataType>::PrintDebugInfo(const char* msg)
+
+		#if(M_PID_CONFIG_ENABLE_TRACE == 1)
+			template <class dataType> void Pid<dataType>::SetTraceRing(PidTraceRing<dataType> * traceRing)
+			{
+				this->traceRing = traceRing;
+			}
+
+			template <class dataType> void Pid<dataType>::PushTrace(
+				dataType input, dataType error, dataType pTerm, dataType iTerm, dataType dTerm, dataType output, uint32_t tick)
+			{
+				if(this->traceRing == NULL)
+					return;
+
+				PidTraceRecord<dataType> record;
+				record.tick = tick;
+				record.flags = GetPidTraceFlags(iTerm, output, this->outMin, this->outMax);
+				record.input = input;
+				record.error = error;
+				record.pTerm = pTerm;
+				record.iTerm = iTerm;
+				record.dTerm = dTerm;
+				record.output = output;
+				this->traceRing->TryPush(record);
+			}
+		#endif
+
+		#if(M_PID_CONFIG_ENABLE_INSTRUMENTATION == 1)
+			template <class dataType> PidInstrumentationSnapshot Pid<dataType>::GetInstrumentation() const
 			{
-				// Execute the callback, passing in the message
-				this->debugPrintCallback.Execute(msg);
+				return this->instrumentation.GetSnapshot();
 			}
 
-			template <class dataType>
-			void Pid<dataType>::SetDebugPrintCallback(SlotMachine::Callback<void, const char*> debugPrintCallback)
+			template <class dataType> void Pid<dataType>::ResetInstrumentation()
 			{
-				this->debugPrintCallback = debugPrintCallback;
+				this->instrumentation.Reset();
 			}
-		#endif*/
+		#endif
 
 	} // namespace MPid
 } // namespace MbeddedNinja
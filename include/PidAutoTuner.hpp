@@ -0,0 +1,632 @@
+//!
+//! @file 			PidAutoTuner.hpp
+//! @author 		Geoffrey Hunter <gbmhunter@gmail.com> (www.mbedded.ninja)
+//! @edited 		n/a
+//! @created		2026-10-16
+//! @last-modified 	2026-10-16
+//! @brief			Relay-feedback plant identification, tuning rules, and a parallel gain search.
+//! @details
+//!					See README.rst in repo root dir for more info.
+
+#ifndef __cplusplus
+	#error Please build with C++ compiler
+#endif
+
+//===============================================================================================//
+//====================================== HEADER GUARD ===========================================//
+//===============================================================================================//
+
+#ifndef M_PID_PID_AUTO_TUNER_H
+#define M_PID_PID_AUTO_TUNER_H
+
+//===== SYSTEM LIBRARIES =====//
+#include <stdint.h>			// uint32_t
+#include <stddef.h>			// size_t
+#include <math.h>			// sqrt(), atan(), pow(), fabs(), HUGE_VAL
+#include <algorithm>		// std::stable_sort(), std::min()
+#include <vector>			// std::vector
+
+//===== USER SOURCE =====//
+#include "PidExecutor.hpp"
+#include "PlantSimulator.hpp"
+
+namespace MbeddedNinja
+{
+	namespace MPidNs
+	{
+
+		//! @brief		Controller gains, in the units the Pid constructor and SetTunings() take.
+		struct PidGains
+		{
+			double kp;
+			double ki;		//!< Kp/Ti, per second.
+			double kd;		//!< Kp*Td, in seconds.
+		};
+
+		//! @brief		The result of a relay-feedback experiment.
+		struct UltimateGain
+		{
+			double ku;		//!< Ultimate gain (the proportional gain at which the loop oscillates).
+			double tuS;		//!< Ultimate period, in seconds.
+		};
+
+		//! @brief		Ziegler-Nichols closed-loop rules. Kp = 0.6*Ku, Ti = Tu/2, Td = Tu/8.
+		inline PidGains ZieglerNicholsPid(const UltimateGain & ultimate);
+
+		//! @brief		Ziegler-Nichols closed-loop rules. Kp = 0.45*Ku, Ti = Tu/1.2.
+		inline PidGains ZieglerNicholsPi(const UltimateGain & ultimate);
+
+		//! @brief		Fits a first-order-plus-dead-time model with a known steady-state gain to the
+		//!				ultimate gain and period, by matching the phase crossover frequency.
+		//! @returns	false if |gain*Ku| <= 1, which no first-order-plus-dead-time plant can produce.
+		inline bool FitFirstOrderPlusDeadTime(double gain, const UltimateGain & ultimate, PlantModel & model);
+
+		//! @brief		Skogestad's SIMC PI rules, for a first-order-plus-dead-time or integrating plant.
+		//! @param		closedLoopTimeConstantS		tau_c. 0 picks tau_c = theta ("tight" control), or
+		//!											tau/10 for a plant with no dead time.
+		//! @returns	false for second-order plants.
+		inline bool SimcPi(const PlantModel & plant, double closedLoopTimeConstantS, PidGains & gains);
+
+		//! @brief		Weights of each metric in the cost of a tuning. Lower cost is better.
+		struct TuningCostWeights
+		{
+			double iae;
+			double ise;
+			double overshoot;
+			double settlingTime;
+			double saturationTime;
+
+			//! @brief		IAE only.
+			TuningCostWeights() :
+				iae(1.0), ise(0), overshoot(0), settlingTime(0), saturationTime(0)
+			{
+			}
+		};
+
+		//! @brief		A tuning, the step response metrics it produced, and it's cost.
+		template <class dataType> struct TuningResult
+		{
+			PidGains gains;
+			PlantMetrics<dataType> metrics;
+			double cost;		//!< HUGE_VAL if the loop went unstable.
+		};
+
+		//===============================================================================================//
+		//===================================== CLASS DEFINITION ========================================//
+		//===============================================================================================//
+
+		//! @brief		Relay-feedback experiment, driven one sample at a time like a Pid.
+		//! @details	The output switches between bias + amplitude and bias - amplitude whenever the
+		//!				error crosses +/- hysteresis, which makes most plants oscillate at their phase
+		//!				crossover frequency. The first cycle is discarded as a transient, then the period
+		//!				and peak-to-peak amplitude of the input are averaged over numCycles cycles.
+		//!				The describing function then gives Ku = 4*amplitude/(pi*sqrt(a^2 - hysteresis^2)).
+		template <class dataType> class RelayExperiment
+		{
+			public:
+
+				//! @param		reverseActing		Set for plants with a negative gain.
+				RelayExperiment(
+					dataType setPoint,
+					dataType amplitude,
+					dataType hysteresis,
+					double samplePeriodMs,
+					dataType bias = 0,
+					uint32_t numCycles = 3,
+					bool reverseActing = false);
+
+				//! @brief		Call at the sample period with the process variable.
+				//! @returns	The output to drive the plant with. bias once the experiment is complete.
+				dataType Run(dataType input);
+
+				//! @brief		Returns true once numCycles cycles have been measured.
+				bool IsComplete() const;
+
+				//! @brief		Returns the ultimate gain and period. Only valid once IsComplete() is true.
+				UltimateGain GetUltimateGain() const;
+
+			private:
+
+				dataType setPoint;
+				dataType amplitude;
+				dataType hysteresis;
+				double samplePeriodS;
+				dataType bias;
+				uint32_t numCycles;
+				bool reverseActing;
+
+				bool started;
+				bool high;
+				uint64_t tick;
+				uint64_t lastRiseTick;
+				bool haveRise;
+				dataType cycleMax;
+				dataType cycleMin;
+				uint32_t numCyclesSeen;
+				double periodSumTicks;
+				double amplitudeSum;
+		};
+
+		//! @brief		Runs a relay experiment against a simulated plant, starting at rest.
+		//! @returns	false if the plant did not settle into numCycles cycles within maxSteps steps.
+		inline bool IdentifyUltimateGain(
+			const PlantModel & plant,
+			double samplePeriodMs,
+			double relayAmplitude,
+			double hysteresis,
+			uint32_t maxSteps,
+			UltimateGain & ultimate);
+
+		//! @brief		Scores candidate tunings against a simulated plant, in parallel.
+		//! @details	Every candidate is a step response of the same plant, from initialOutput to
+		//!				setPoint over numSteps samples, simulated with PlantSimulator. Candidates are
+		//!				split into chunks which are fanned out across a PidExecutor, so the wall-clock
+		//!				time drops with the number of workers. Each chunk is it's own batch of plant/
+		//!				controller pairs, and pairs don't interact, so the results don't depend on the
+		//!				number of workers.
+		//!
+		//!				Search() refines a starting tuning with a grid search in log space: a grid of
+		//!				pointsPerAxis points per gain, spanning initial/span to initial*span, is evaluated
+		//!				in parallel, then re-centred on the best point with the span square-rooted, and
+		//!				so on. A gain which starts at 0 is left at 0. Points a later grid shares with an
+		//!				earlier one (such as it's centre) aren't evaluated again, so every tuning
+		//!				returned is different.
+		template <class dataType> class PidAutoTuner
+		{
+			public:
+
+				//! @param		executor		Workers to run the evaluations on. NULL runs them on the calling thread.
+				PidAutoTuner(
+					const PlantModel & plant,
+					double samplePeriodMs,
+					dataType minOutput,
+					dataType maxOutput,
+					dataType setPoint,
+					uint32_t numSteps,
+					PidExecutor * executor = NULL,
+					dataType initialOutput = 0);
+
+				//! @brief		Sets the weights of the metrics in the cost.
+				void SetCostWeights(const TuningCostWeights & weights);
+
+				//! @brief		Sets the number of candidates simulated together in each chunk of work.
+				void SetChunkSize(size_t chunkSize);
+
+				//! @brief		Scores every candidate.
+				//! @returns	One result per candidate, in the same order.
+				std::vector<TuningResult<dataType>> Evaluate(const std::vector<PidGains> & candidates) const;
+
+				//! @brief		Refines initial with a parallel grid search.
+				//! @returns	The best numResults tunings found, lowest cost first.
+				std::vector<TuningResult<dataType>> Search(
+					const PidGains & initial,
+					uint32_t pointsPerAxis = 7,
+					double span = 4.0,
+					uint32_t numRefinements = 3,
+					size_t numResults = 10) const;
+
+			private:
+
+				//! @brief		A chunk of an Evaluate() call.
+				struct EvaluateJob
+				{
+					const PidAutoTuner * tuner;
+					const PidGains * candidates;
+					TuningResult<dataType> * results;
+
+					static void RunChunk(void * context, size_t begin, size_t end);
+				};
+
+				//! @brief		Returns the cost of a set of metrics (HUGE_VAL if any of them are not finite).
+				double Cost(const PlantMetrics<dataType> & metrics) const;
+
+				//! @brief		Returns the grid values for one gain, centred on value.
+				static std::vector<double> Axis(double value, uint32_t pointsPerAxis, double span);
+
+				//! @brief		Returns true if a and b are the same tuning. Compared with a relative tolerance,
+				//!				as Axis() can round the same point differently in different grids.
+				static bool SameGains(const PidGains & a, const PidGains & b);
+
+				PlantModel plant;
+				double samplePeriodMs;
+				dataType minOutput;
+				dataType maxOutput;
+				dataType setPoint;
+				uint32_t numSteps;
+				PidExecutor * executor;
+				dataType initialOutput;
+				TuningCostWeights weights;
+				size_t chunkSize;
+		};
+
+		//===============================================================================================//
+		//============================ TEMPLATE FUNCTION DEFINITIONS ====================================//
+		//===============================================================================================//
+
+		template <class dataType> RelayExperiment<dataType>::RelayExperiment(
+			dataType setPoint,
+			dataType amplitude,
+			dataType hysteresis,
+			double samplePeriodMs,
+			dataType bias,
+			uint32_t numCycles,
+			bool reverseActing) :
+			setPoint(setPoint),
+			amplitude(amplitude),
+			hysteresis(hysteresis),
+			samplePeriodS(samplePeriodMs/1000.0),
+			bias(bias),
+			numCycles(numCycles ? numCycles : 1),
+			reverseActing(reverseActing),
+			started(false),
+			high(true),
+			tick(0),
+			lastRiseTick(0),
+			haveRise(false),
+			cycleMax(0),
+			cycleMin(0),
+			numCyclesSeen(0),
+			periodSumTicks(0),
+			amplitudeSum(0)
+		{
+		}
+
+		template <class dataType> dataType RelayExperiment<dataType>::Run(dataType input)
+		{
+			if(this->IsComplete())
+				return this->bias;
+
+			dataType error = this->setPoint - input;
+			if(this->reverseActing)
+				error = -error;
+
+			if(!this->started)
+			{
+				this->started = true;
+				this->high = !(error < 0);
+				this->cycleMax = input;
+				this->cycleMin = input;
+			}
+			else if(this->high && error < -this->hysteresis)
+				this->high = false;
+			else if(!this->high && error > this->hysteresis)
+			{
+				// Rising edge of the relay, a cycle has ended
+				this->high = true;
+				if(this->haveRise)
+				{
+					// The first cycle is the transient from rest, ignore it
+					if(this->numCyclesSeen > 0)
+					{
+						this->periodSumTicks += (double)(this->tick - this->lastRiseTick);
+						this->amplitudeSum += 0.5*(double)(this->cycleMax - this->cycleMin);
+					}
+					this->numCyclesSeen++;
+				}
+				this->haveRise = true;
+				this->lastRiseTick = this->tick;
+				this->cycleMax = input;
+				this->cycleMin = input;
+			}
+
+			if(this->cycleMax < input)
+				this->cycleMax = input;
+			if(input < this->cycleMin)
+				this->cycleMin = input;
+
+			this->tick++;
+
+			if(this->IsComplete())
+				return this->bias;
+			dataType sign = (this->high != this->reverseActing) ? dataType(1) : dataType(-1);
+			return this->bias + sign*this->amplitude;
+		}
+
+		template <class dataType> bool RelayExperiment<dataType>::IsComplete() const
+		{
+			return this->numCyclesSeen > this->numCycles;
+		}
+
+		template <class dataType> UltimateGain RelayExperiment<dataType>::GetUltimateGain() const
+		{
+			double a = this->amplitudeSum/(double)this->numCycles;
+			double h = (double)this->hysteresis;
+			double effective = a > h ? sqrt(a*a - h*h) : a;
+
+			UltimateGain ultimate;
+			ultimate.ku = 4.0*(double)this->amplitude/(M_PI*effective);
+			ultimate.tuS = this->periodSumTicks/(double)this->numCycles*this->samplePeriodS;
+			return ultimate;
+		}
+
+		template <class dataType> PidAutoTuner<dataType>::PidAutoTuner(
+			const PlantModel & plant,
+			double samplePeriodMs,
+			dataType minOutput,
+			dataType maxOutput,
+			dataType setPoint,
+			uint32_t numSteps,
+			PidExecutor * executor,
+			dataType initialOutput) :
+			plant(plant),
+			samplePeriodMs(samplePeriodMs),
+			minOutput(minOutput),
+			maxOutput(maxOutput),
+			setPoint(setPoint),
+			numSteps(numSteps),
+			executor(executor),
+			initialOutput(initialOutput),
+			chunkSize(64)
+		{
+		}
+
+		template <class dataType> void PidAutoTuner<dataType>::SetCostWeights(const TuningCostWeights & weights)
+		{
+			this->weights = weights;
+		}
+
+		template <class dataType> void PidAutoTuner<dataType>::SetChunkSize(size_t chunkSize)
+		{
+			this->chunkSize = chunkSize ? chunkSize : 1;
+		}
+
+		template <class dataType> std::vector<TuningResult<dataType>> PidAutoTuner<dataType>::Evaluate(
+			const std::vector<PidGains> & candidates) const
+		{
+			std::vector<TuningResult<dataType>> results(candidates.size());
+			if(candidates.empty())
+				return results;
+
+			EvaluateJob job;
+			job.tuner = this;
+			job.candidates = candidates.data();
+			job.results = results.data();
+
+			if(this->executor)
+				this->executor->Run(candidates.size(), this->chunkSize, &EvaluateJob::RunChunk, &job);
+			else
+				EvaluateJob::RunChunk(&job, 0, candidates.size());
+
+			return results;
+		}
+
+		template <class dataType> void PidAutoTuner<dataType>::EvaluateJob::RunChunk(void * context, size_t begin, size_t end)
+		{
+			EvaluateJob * job = static_cast<EvaluateJob *>(context);
+			const PidAutoTuner * tuner = job->tuner;
+
+			// Plants with a negative gain need a reverse-acting controller
+			typedef typename PlantSimulator<dataType>::ControllerDirection ControllerDirection;
+			ControllerDirection dir = tuner->plant.gain < 0 ?
+				ControllerDirection::PID_REVERSE : ControllerDirection::PID_DIRECT;
+
+			PlantSimulator<dataType> sim(tuner->samplePeriodMs);
+			for(size_t i = begin; i < end; i++)
+			{
+				const PidGains & gains = job->candidates[i];
+				sim.Add(tuner->plant, (dataType)gains.kp, (dataType)gains.ki, (dataType)gains.kd,
+					dir, PlantSimulator<dataType>::OutputMode::DONT_ACCUMULATE_OUTPUT,
+					tuner->minOutput, tuner->maxOutput, tuner->setPoint, tuner->initialOutput);
+			}
+
+			sim.Run(tuner->numSteps);
+
+			for(size_t i = begin; i < end; i++)
+			{
+				TuningResult<dataType> & result = job->results[i];
+				result.gains = job->candidates[i];
+				result.metrics = sim.GetMetrics(i - begin);
+				result.cost = tuner->Cost(result.metrics);
+			}
+		}
+
+		template <class dataType> std::vector<TuningResult<dataType>> PidAutoTuner<dataType>::Search(
+			const PidGains & initial,
+			uint32_t pointsPerAxis,
+			double span,
+			uint32_t numRefinements,
+			size_t numResults) const
+		{
+			std::vector<TuningResult<dataType>> all;
+			PidGains centre = initial;
+			double bestCost = HUGE_VAL;
+
+			for(uint32_t pass = 0; pass <= numRefinements; pass++)
+			{
+				std::vector<double> kps = Axis(centre.kp, pointsPerAxis, span);
+				std::vector<double> kis = Axis(centre.ki, pointsPerAxis, span);
+				std::vector<double> kds = Axis(centre.kd, pointsPerAxis, span);
+
+				std::vector<PidGains> candidates;
+				candidates.reserve(kps.size()*kis.size()*kds.size());
+
+				// Skip points an earlier grid (or this one) already has
+				auto isNew = [&](const PidGains & gains)
+				{
+					for(size_t k = 0; k < all.size(); k++)
+						if(SameGains(all[k].gains, gains))
+							return false;
+					for(size_t k = 0; k < candidates.size(); k++)
+						if(SameGains(candidates[k], gains))
+							return false;
+					return true;
+				};
+
+				for(size_t p = 0; p < kps.size(); p++)
+					for(size_t i = 0; i < kis.size(); i++)
+						for(size_t d = 0; d < kds.size(); d++)
+						{
+							PidGains gains = { kps[p], kis[i], kds[d] };
+							if(isNew(gains))
+								candidates.push_back(gains);
+						}
+
+				std::vector<TuningResult<dataType>> results = this->Evaluate(candidates);
+				for(size_t i = 0; i < results.size(); i++)
+				{
+					if(results[i].cost < bestCost)
+					{
+						bestCost = results[i].cost;
+						centre = results[i].gains;
+					}
+				}
+				all.insert(all.end(), results.begin(), results.end());
+
+				span = sqrt(span);
+			}
+
+			std::stable_sort(all.begin(), all.end(),
+				[](const TuningResult<dataType> & a, const TuningResult<dataType> & b) { return a.cost < b.cost; });
+			if(all.size() > numResults)
+				all.resize(numResults);
+			return all;
+		}
+
+		template <class dataType> double PidAutoTuner<dataType>::Cost(const PlantMetrics<dataType> & metrics) const
+		{
+			double cost =
+				this->weights.iae*(double)metrics.iae +
+				this->weights.ise*(double)metrics.ise +
+				this->weights.overshoot*(double)metrics.overshoot +
+				this->weights.settlingTime*(double)metrics.settlingTimeS +
+				this->weights.saturationTime*(double)metrics.saturationTimeS;
+
+			// NaN and infinity both fail this
+			if(!(cost < HUGE_VAL))
+				return HUGE_VAL;
+			return cost;
+		}
+
+		template <class dataType> std::vector<double> PidAutoTuner<dataType>::Axis(double value, uint32_t pointsPerAxis, double span)
+		{
+			std::vector<double> axis;
+			if(value == 0 || pointsPerAxis < 2)
+			{
+				axis.push_back(value);
+				return axis;
+			}
+
+			// Log spaced, with value in the middle when pointsPerAxis is odd
+			for(uint32_t i = 0; i < pointsPerAxis; i++)
+			{
+				double exponent = 2.0*(double)i/(double)(pointsPerAxis - 1) - 1.0;
+				axis.push_back(value*pow(span, exponent));
+			}
+			return axis;
+		}
+
+		template <class dataType> bool PidAutoTuner<dataType>::SameGains(const PidGains & a, const PidGains & b)
+		{
+			const double tolerance = 1e-9;
+			return fabs(a.kp - b.kp) <= tolerance*fabs(a.kp) &&
+				fabs(a.ki - b.ki) <= tolerance*fabs(a.ki) &&
+				fabs(a.kd - b.kd) <= tolerance*fabs(a.kd);
+		}
+
+		//===============================================================================================//
+		//=================================== FUNCTION DEFINITIONS ======================================//
+		//===============================================================================================//
+
+		inline PidGains ZieglerNicholsPid(const UltimateGain & ultimate)
+		{
+			double kp = 0.6*ultimate.ku;
+			PidGains gains = { kp, kp/(ultimate.tuS/2.0), kp*(ultimate.tuS/8.0) };
+			return gains;
+		}
+
+		inline PidGains ZieglerNicholsPi(const UltimateGain & ultimate)
+		{
+			double kp = 0.45*ultimate.ku;
+			PidGains gains = { kp, kp/(ultimate.tuS/1.2), 0 };
+			return gains;
+		}
+
+		inline bool FitFirstOrderPlusDeadTime(double gain, const UltimateGain & ultimate, PlantModel & model)
+		{
+			double loopGain = fabs(gain)*ultimate.ku;
+			if(loopGain <= 1.0 || ultimate.tuS <= 0)
+				return false;
+
+			// At the crossover frequency |G| = 1/Ku and the phase is -pi
+			double w = 2.0*M_PI/ultimate.tuS;
+			double tau = sqrt(loopGain*loopGain - 1.0)/w;
+			double theta = (M_PI - atan(w*tau))/w;
+			model = PlantModel::FirstOrder(gain, tau, theta);
+			return true;
+		}
+
+		inline bool SimcPi(const PlantModel & plant, double closedLoopTimeConstantS, PidGains & gains)
+		{
+			double theta = plant.deadTimeS;
+			double tauC = closedLoopTimeConstantS;
+			if(tauC <= 0)
+				tauC = theta > 0 ? theta : 0.1*plant.timeConstantS;
+
+			switch(plant.type)
+			{
+				case PlantType::FIRST_ORDER:
+				{
+					double kp = plant.timeConstantS/(fabs(plant.gain)*(tauC + theta));
+					double ti = std::min(plant.timeConstantS, 4.0*(tauC + theta));
+					gains.kp = kp;
+					gains.ki = kp/ti;
+					gains.kd = 0;
+					return true;
+				}
+				case PlantType::INTEGRATING:
+				{
+					if(tauC + theta <= 0)
+						return false;
+					double kp = 1.0/(fabs(plant.gain)*(tauC + theta));
+					gains.kp = kp;
+					gains.ki = kp/(4.0*(tauC + theta));
+					gains.kd = 0;
+					return true;
+				}
+				default:
+					return false;
+			}
+		}
+
+		inline bool IdentifyUltimateGain(
+			const PlantModel & plant,
+			double samplePeriodMs,
+			double relayAmplitude,
+			double hysteresis,
+			uint32_t maxSteps,
+			UltimateGain & ultimate)
+		{
+			DiscretePlant discrete = DiscretisePlant(plant, samplePeriodMs);
+			RelayExperiment<double> relay(0.0, relayAmplitude, hysteresis, samplePeriodMs, 0.0, 3, plant.gain < 0);
+
+			// Ring buffer for the dead time
+			std::vector<double> delayLine(discrete.delaySamples + 1, 0.0);
+			size_t head = 0;
+
+			double x1 = 0;
+			double x2 = 0;
+			for(uint32_t step = 0; step < maxSteps && !relay.IsComplete(); step++)
+			{
+				double u = relay.Run(x1);
+				delayLine[head] = u;
+				head = (head + 1) % delayLine.size();
+				double ud = delayLine[head];
+
+				double nx1 = discrete.a11*x1 + discrete.a12*x2 + discrete.b1*ud;
+				double nx2 = discrete.a21*x1 + discrete.a22*x2 + discrete.b2*ud;
+				x1 = nx1;
+				x2 = nx2;
+			}
+
+			if(!relay.IsComplete())
+				return false;
+			ultimate = relay.GetUltimateGain();
+			return true;
+		}
+
+	} // namespace MPidNs
+} // namespace MbeddedNinja
+
+#endif // #ifndef M_PID_PID_AUTO_TUNER_H
+
+// EOF
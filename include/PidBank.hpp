@@ -0,0 +1,767 @@
+//!
+//! @file 			PidBank.hpp
+//! @author 		Geoffrey Hunter <gbmhunter@gmail.com> (www.mbedded.ninja)
+//! @edited 		n/a
+//! @created		2026-10-16
+//! @last-modified 	2026-10-16
+//! @brief			A bank of independent PID controllers stored as a structure-of-arrays.
+//! @details
+//!					See README.rst in repo root dir for more info.
+
+#ifndef __cplusplus
+	#error Please build with C++ compiler
+#endif
+
+//===============================================================================================//
+//====================================== HEADER GUARD ===========================================//
+//===============================================================================================//
+
+#ifndef M_PID_PID_BANK_H
+#define M_PID_PID_BANK_H
+
+//===== SYSTEM LIBRARIES =====//
+#include <stdint.h>		// uint8_t, uint32_t
+#include <stddef.h>		// size_t
+#include <string.h>		// memcpy(), memcmp()
+#include <atomic>		// std::atomic
+#include <vector>		// std::vector
+
+//===== USER SOURCE =====//
+#include "Pid.hpp"
+#include "PidKernels.hpp"
+
+namespace MbeddedNinja
+{
+	namespace MPidNs
+	{
+
+		//===============================================================================================//
+		//===================================== CLASS DEFINITION ========================================//
+		//===============================================================================================//
+
+		//! @brief		A bank of many independent PID controllers, stored as a structure-of-arrays.
+		//! @details	Each controller behaves exactly like a Pid<dataType> object, but every field that
+		//!				Run() touches is kept in it's own contiguous array, so RunAll() streams through
+		//!				memory rather than hopping from object to object. Fields only needed when re-tuning
+		//!				(Kp, Ki, Kd, sample period, direction) are kept in separate "cold" arrays.
+		template <class dataType> class PidBank
+		{
+			public:
+
+				//===============================================================================================//
+				//=================================== PUBLIC TYPEDEFS ===========================================//
+				//===============================================================================================//
+
+				typedef typename Pid<dataType>::ControllerDirection ControllerDirection;
+				typedef typename Pid<dataType>::OutputMode OutputMode;
+				typedef typename Pid<dataType>::samplePeriodType samplePeriodType;
+
+				//! @brief		Creates an empty bank. Use Add() to add controllers.
+				PidBank();
+
+				//! @brief		Reserves storage for numControllers controllers, to avoid re-allocation while adding.
+				void Reserve(size_t numControllers);
+
+				//! @brief		Adds a controller to the bank.
+				//! @details	Parameters are identical to those of the Pid constructor.
+				//! @returns	The index of the new controller within the bank.
+				size_t Add(
+					dataType kp,
+					dataType ki,
+					dataType kd,
+					ControllerDirection controllerDir,
+					OutputMode outputMode,
+					samplePeriodType samplePeriodMs,
+					dataType minOutput,
+					dataType maxOutput,
+					dataType setPoint);
+
+				//! @brief		Returns the number of controllers in the bank.
+				size_t Size() const;
+
+				//! @brief		Runs every controller in the bank once.
+				//! @details	Equivalent to calling Pid::Run(inputs[i]) on each controller and copying
+				//!				out it's output into outputs[i]. Both arrays must hold Size() elements.
+				void RunAll(const dataType * inputs, dataType * outputs);
+
+				//! @brief		Runs the controllers with indexes in the range [begin, end).
+				//! @details	inputs and outputs are indexed with the controller index (not relative to begin).
+				//!				Disjoint ranges may be run concurrently from different threads.
+				void RunRange(size_t begin, size_t end, const dataType * inputs, dataType * outputs);
+
+				//! @brief		Sets the input the controller at index will use the next time RunActive() is called.
+				//! @details	Only needs calling when the input changes. A controller whose input hasn't been
+				//!				set since it last ran (by RunActive(), RunAll() or RunRange(), or as restored
+				//!				by SetState()) is run again with the same input.
+				void SetInput(size_t index, dataType input);
+
+				//! @brief		Runs every controller which isn't quiescent once, with the inputs given to SetInput().
+				//! @details	A controller is quiescent once a run with an unchanged input leaves it's state
+				//!				(integral term, output and previous input) exactly as it was. Running it again
+				//!				with the same input and settings could only repeat that, so it is skipped until
+				//!				SetInput() changes it's input, or a setter or RunAll()/RunRange() touches it.
+				//!				The results are therefore bit-for-bit those of RunAll() with the same inputs every
+				//!				tick, including accumulate-mode outputs, which only settle once the integral term
+				//!				is zero or the output is clamped. Only the outputs of controllers that ran are
+				//!				written, so re-use the same outputs array (of Size() elements) every tick.
+				//! @returns	The number of controllers that were run.
+				size_t RunActive(dataType * outputs);
+
+				//! @brief		Returns the number of controllers RunActive() would run, if no more inputs changed.
+				size_t GetNumActive() const;
+
+				//! @brief		Returns true if RunActive() is skipping the controller at index.
+				bool IsQuiescent(size_t index) const;
+
+				//! @brief		Limits the kernel used by RunAll() to the given instruction set.
+				//! @details	By default the fastest kernel supported by the CPU is used. Requesting a level
+				//!				the CPU doesn't support falls back to the best supported one.
+				void SetSimdLevel(SimdLevel level);
+
+				//! @brief		Returns the instruction set of the kernel RunAll() is using.
+				SimdLevel GetSimdLevel() const;
+
+				//! @brief		Equivalent to Pid::SetTunings() for the controller at index.
+				void SetTunings(size_t index, dataType kp, dataType ki, dataType kd);
+
+				//! @brief		Equivalent to Pid::SetOutputLimits() for the controller at index.
+				void SetOutputLimits(size_t index, dataType min, dataType max);
+
+				//! @brief		Equivalent to Pid::SetControllerDirection() for the controller at index.
+				void SetControllerDirection(size_t index, ControllerDirection controllerDir);
+
+				//! @brief		Equivalent to Pid::SetSamplePeriod() for the controller at index.
+				void SetSamplePeriod(size_t index, uint32_t newSamplePeriodMs);
+
+				//! @brief		Changes the set-point of the controller at index.
+				void SetSetPoint(size_t index, dataType setPoint);
+
+				//! @brief		Returns the set-point of the controller at index.
+				dataType GetSetPoint(size_t index) const;
+
+				//! @brief		Returns the output calculated the last time the controller at index was run.
+				dataType GetOutput(size_t index) const;
+
+				//! @brief		Returns the (clamped) integral term of the controller at index.
+				dataType GetITerm(size_t index) const;
+
+				dataType GetKp(size_t index) const;		//!< Returns the actual (not time-scaled) proportional constant.
+				dataType GetKi(size_t index) const;		//!< Returns the actual (not time-scaled) integral constant.
+				dataType GetKd(size_t index) const;		//!< Returns the actual (not time-scaled) derivative constant.
+				dataType GetZp(size_t index) const;		//!< Returns the time-scaled proportional constant.
+				dataType GetZi(size_t index) const;		//!< Returns the time-scaled integral constant.
+				dataType GetZd(size_t index) const;		//!< Returns the time-scaled derivative constant.
+
+				dataType GetOutMin(size_t index) const;		//!< Returns the minimum output.
+				dataType GetOutMax(size_t index) const;		//!< Returns the maximum output.
+				ControllerDirection GetControllerDirection(size_t index) const;		//!< Returns the controller direction.
+				OutputMode GetOutputMode(size_t index) const;		//!< Returns the output mode.
+				samplePeriodType GetSamplePeriod(size_t index) const;		//!< Returns the sample period, in milliseconds.
+
+				//! @brief		Returns the run-time state of the controller at index.
+				//! @details	The bank only records whether a controller has been run, so numTimesRan is 0 or 1.
+				PidState<dataType> GetState(size_t index) const;
+
+				//! @brief		Equivalent to Pid::SetState() for the controller at index.
+				void SetState(size_t index, const PidState<dataType> & state);
+
+				//! @brief		Copies the run-time state of every controller out into arrays of Size() elements.
+				void GetStates(
+					dataType * setPoints, dataType * prevInputs, dataType * iTerms,
+					dataType * prevOutputs, uint32_t * numTimesRan) const;
+
+				//! @brief		Restores the run-time state of every controller from arrays of Size() elements.
+				//! @details	The same as calling SetState() for each controller, but the value arrays are
+				//!				copied straight into the bank's arrays.
+				void SetStates(
+					const dataType * setPoints, const dataType * prevInputs, const dataType * iTerms,
+					const dataType * prevOutputs, const uint32_t * numTimesRan);
+
+				//! @brief		Returns true if any step of the controller at index has saturated since the
+				//!				last ClearOverflow().
+				//! @details	Only banks of FixedQ numbers record this. FixedQ arithmetic saturates at the
+				//!				limits of it's storage type rather than wrapping, so the result is still
+				//!				bounded, but one of the terms was clipped before the outMin/outMax clamps.
+				bool GetOverflowed(size_t index) const;
+
+				//! @brief		Returns the overflow flags of every controller as a bitmask. Bit (index % 64)
+				//!				of word (index / 64) belongs to the controller at index.
+				const uint64_t * GetOverflowMask() const;
+
+				//! @brief		Clears the overflow flag of every controller.
+				void ClearOverflow();
+
+			private:
+
+				//! @brief		Runs [begin, end) when some of the controllers in it have never been run.
+				//! @details	Those are run with firstRunKernel, which leaves the derivative term out as
+				//!				Pid::Run() does when numTimesRan is 0 (priming prevInput instead would give
+				//!				-Zd*0, which is -0, or NaN if Zd is infinite). The rest are run with kernel,
+				//!				in runs as long as possible. This keeps the check out of the kernels.
+				void RunRangeUnprimed(size_t begin, size_t end, const dataType * inputs, dataType * outputs);
+
+				//! @brief		Returns the hot arrays, for passing to the kernel.
+				PidBankArrays<dataType> GetArrays();
+
+				//! @brief		Makes RunActive() run the controller at index again, because it's settings changed.
+				void Wake(size_t index);
+
+				//! @brief		Called by RunRange() once RunActive() has been used, so the two see the same inputs.
+				void WakeRange(size_t begin, size_t end, const dataType * inputs);
+
+				//! @brief		Makes RunActive() run every controller again.
+				void WakeAll();
+
+				//! @brief		Called by SetInput() and RunActive(). The first time, seeds nextInput with each
+				//!				controller's last input, so one that was last run by RunAll() carries on with
+				//!				the same input, as it would with RunAll().
+				void StartEventDriven();
+
+				//===== HOT DATA (touched by RunAll()) =====//
+
+				std::vector<dataType> Zp;				//!< Time-scaled proportional constants (direction applied).
+				std::vector<dataType> Zi;				//!< Time-scaled integral constants (direction applied).
+				std::vector<dataType> Zd;				//!< Time-scaled derivative constants (direction applied).
+				std::vector<dataType> setPoint;		//!< Set-points.
+				std::vector<dataType> prevInput;		//!< Input from the previous run.
+				std::vector<dataType> iTerm;			//!< Integral terms.
+				std::vector<dataType> prevOutput;		//!< Output from the previous run.
+				std::vector<dataType> outMin;			//!< Minimum outputs.
+				std::vector<dataType> outMax;			//!< Maximum outputs.
+				std::vector<uint8_t> accumulate;		//!< 1 if the controller is in ACCUMULATE_OUTPUT mode, otherwise 0.
+				std::vector<uint64_t> overflow;		//!< Overflow flags, one bit per controller (FixedQ banks only).
+
+				//===== COLD DATA (only touched when re-tuning) =====//
+
+				std::vector<uint8_t> primed;			//!< 1 once the controller has been run at least once.
+				std::vector<dataType> Kp;				//!< Actual (non-scaled) proportional constants.
+				std::vector<dataType> Ki;				//!< Actual (non-scaled) integral constants.
+				std::vector<dataType> Kd;				//!< Actual (non-scaled) derivative constants.
+				std::vector<samplePeriodType> samplePeriodMs;	//!< Sample periods, in milliseconds.
+				std::vector<ControllerDirection> controllerDir;	//!< Controller directions.
+
+				//===== EVENT DATA (only touched by SetInput() and RunActive()) =====//
+
+				std::vector<dataType> nextInput;		//!< Input to use the next time RunActive() runs the controller.
+				std::vector<uint8_t> quiescent;		//!< 1 if RunActive() is skipping the controller.
+				std::vector<size_t> activeList;		//!< Indexes of the controllers which aren't quiescent.
+
+				//! @brief		true once SetInput() or RunActive() has been used, after which RunRange() keeps
+				//!				the event data up to date as well.
+				bool eventDriven;
+
+				//! @brief		The number of controllers that are quiescent.
+				std::atomic<size_t> numQuiescent;
+
+				//! @brief		Set when RunRange() wakes controllers, which can run concurrently, so can't
+				//!				push to activeList. RunActive() then rebuilds activeList from quiescent.
+				std::atomic<bool> activeListStale;
+
+				//! @brief		The kernel that RunRange() uses, chosen with CPUID when the bank is created.
+				PidKernel<dataType> kernel;
+
+				//! @brief		The scalar kernel, which RunActive() uses to run one controller at a time.
+				PidKernel<dataType> scalarKernel;
+
+				//! @brief		The scalar kernel for a controller's first run, without the derivative term.
+				PidKernel<dataType> firstRunKernel;
+
+				//! @brief		The instruction set of kernel.
+				SimdLevel simdLevel;
+
+				//! @brief		The number of controllers which have never been run.
+				//! @details	While this is non-zero, RunRange() looks for them with RunRangeUnprimed().
+				std::atomic<size_t> numUnprimed;
+		};
+
+		//===============================================================================================//
+		//============================ TEMPLATE FUNCTION DEFINITIONS ====================================//
+		//===============================================================================================//
+
+		template <class dataType> PidBank<dataType>::PidBank() :
+			eventDriven(false),
+			numQuiescent(0),
+			activeListStale(false),
+			scalarKernel(PidKernelSelector<dataType>::Select(SimdLevel::SCALAR)),
+			firstRunKernel(PidFirstRunKernelSelector<dataType>::Select()),
+			numUnprimed(0)
+		{
+			this->SetSimdLevel(MPidNs::GetSimdLevel());
+		}
+
+		template <class dataType> void PidBank<dataType>::SetSimdLevel(SimdLevel level)
+		{
+			if(level > MPidNs::GetSimdLevel())
+				level = MPidNs::GetSimdLevel();
+			this->simdLevel = level;
+			this->kernel = PidKernelSelector<dataType>::Select(level);
+		}
+
+		template <class dataType> SimdLevel PidBank<dataType>::GetSimdLevel() const
+		{
+			return this->simdLevel;
+		}
+
+		template <class dataType> void PidBank<dataType>::Reserve(size_t numControllers)
+		{
+			this->Zp.reserve(numControllers);
+			this->Zi.reserve(numControllers);
+			this->Zd.reserve(numControllers);
+			this->setPoint.reserve(numControllers);
+			this->prevInput.reserve(numControllers);
+			this->iTerm.reserve(numControllers);
+			this->prevOutput.reserve(numControllers);
+			this->outMin.reserve(numControllers);
+			this->outMax.reserve(numControllers);
+			this->accumulate.reserve(numControllers);
+			this->overflow.reserve((numControllers + 63)/64);
+			this->primed.reserve(numControllers);
+			this->Kp.reserve(numControllers);
+			this->Ki.reserve(numControllers);
+			this->Kd.reserve(numControllers);
+			this->samplePeriodMs.reserve(numControllers);
+			this->controllerDir.reserve(numControllers);
+			this->nextInput.reserve(numControllers);
+			this->quiescent.reserve(numControllers);
+			this->activeList.reserve(numControllers);
+		}
+
+		template <class dataType> size_t PidBank<dataType>::Add(
+			dataType kp,
+			dataType ki,
+			dataType kd,
+			ControllerDirection controllerDir,
+			OutputMode outputMode,
+			samplePeriodType samplePeriodMs,
+			dataType minOutput,
+			dataType maxOutput,
+			dataType setPoint)
+		{
+			size_t index = this->Size();
+
+			this->Zp.push_back(0);
+			this->Zi.push_back(0);
+			this->Zd.push_back(0);
+			this->setPoint.push_back(setPoint);
+			this->prevInput.push_back(0);
+			this->iTerm.push_back(0);
+			this->prevOutput.push_back(0);
+			this->outMin.push_back(0);
+			this->outMax.push_back(0);
+			this->accumulate.push_back(outputMode == OutputMode::ACCUMULATE_OUTPUT ? 1 : 0);
+			if(index % 64 == 0)
+				this->overflow.push_back(0);
+			this->primed.push_back(0);
+			this->Kp.push_back(0);
+			this->Ki.push_back(0);
+			this->Kd.push_back(0);
+			this->samplePeriodMs.push_back(samplePeriodMs);
+			this->controllerDir.push_back(controllerDir);
+			this->nextInput.push_back(0);
+			this->quiescent.push_back(0);
+			this->activeList.push_back(index);
+
+			this->SetOutputLimits(index, minOutput, maxOutput);
+			this->SetTunings(index, kp, ki, kd);
+
+			this->numUnprimed.fetch_add(1, std::memory_order_relaxed);
+			return index;
+		}
+
+		template <class dataType> size_t PidBank<dataType>::Size() const
+		{
+			return this->Zp.size();
+		}
+
+		template <class dataType> void PidBank<dataType>::RunAll(const dataType * inputs, dataType * outputs)
+		{
+			this->RunRange(0, this->Size(), inputs, outputs);
+		}
+
+		template <class dataType> void PidBank<dataType>::RunRange(
+			size_t begin, size_t end, const dataType * inputs, dataType * outputs)
+		{
+			if(this->numUnprimed.load(std::memory_order_relaxed) != 0)
+				this->RunRangeUnprimed(begin, end, inputs, outputs);
+			else
+				this->kernel(this->GetArrays(), begin, end, inputs, outputs);
+
+			if(this->eventDriven)
+				this->WakeRange(begin, end, inputs);
+		}
+
+		template <class dataType> PidBankArrays<dataType> PidBank<dataType>::GetArrays()
+		{
+			PidBankArrays<dataType> arrays;
+			arrays.Zp = this->Zp.data();
+			arrays.Zi = this->Zi.data();
+			arrays.Zd = this->Zd.data();
+			arrays.setPoint = this->setPoint.data();
+			arrays.outMin = this->outMin.data();
+			arrays.outMax = this->outMax.data();
+			arrays.accumulate = this->accumulate.data();
+			arrays.prevInput = this->prevInput.data();
+			arrays.iTerm = this->iTerm.data();
+			arrays.prevOutput = this->prevOutput.data();
+			arrays.overflow = this->overflow.data();
+			return arrays;
+		}
+
+		template <class dataType> void PidBank<dataType>::SetInput(size_t index, dataType input)
+		{
+			this->StartEventDriven();
+			this->nextInput[index] = input;
+			this->Wake(index);
+		}
+
+		template <class dataType> size_t PidBank<dataType>::RunActive(dataType * outputs)
+		{
+			this->StartEventDriven();
+			if(this->activeListStale.exchange(false, std::memory_order_relaxed))
+			{
+				this->activeList.clear();
+				for(size_t i = 0; i < this->Size(); i++)
+				{
+					if(!this->quiescent[i])
+						this->activeList.push_back(i);
+				}
+			}
+
+			PidBankArrays<dataType> arrays = this->GetArrays();
+			size_t numRun = this->activeList.size();
+			size_t numStillActive = 0;
+			for(size_t k = 0; k < numRun; k++)
+			{
+				size_t i = this->activeList[k];
+
+				// Compared bit-for-bit, so skipping is exact even for -0.0 and NaN. A first run never
+				// counts, as the run after it has a derivative term.
+				bool primed = (this->primed[i] != 0);
+				bool sameInput = primed && (memcmp(&this->nextInput[i], &this->prevInput[i], sizeof(dataType)) == 0);
+				dataType iTermBefore = this->iTerm[i];
+				dataType outputBefore = this->prevOutput[i];
+
+				if(primed)
+					this->scalarKernel(arrays, i, i + 1, this->nextInput.data(), outputs);
+				else
+				{
+					this->firstRunKernel(arrays, i, i + 1, this->nextInput.data(), outputs);
+					this->primed[i] = 1;
+					this->numUnprimed.fetch_sub(1, std::memory_order_relaxed);
+				}
+
+				if(sameInput &&
+					memcmp(&iTermBefore, &this->iTerm[i], sizeof(dataType)) == 0 &&
+					memcmp(&outputBefore, &this->prevOutput[i], sizeof(dataType)) == 0 &&
+					!this->GetOverflowed(i))
+				{
+					this->quiescent[i] = 1;
+					this->numQuiescent.fetch_add(1, std::memory_order_relaxed);
+				}
+				else
+					this->activeList[numStillActive++] = i;
+			}
+			this->activeList.resize(numStillActive);
+			return numRun;
+		}
+
+		template <class dataType> size_t PidBank<dataType>::GetNumActive() const
+		{
+			return this->Size() - this->numQuiescent.load(std::memory_order_relaxed);
+		}
+
+		template <class dataType> bool PidBank<dataType>::IsQuiescent(size_t index) const
+		{
+			return this->quiescent[index] != 0;
+		}
+
+		template <class dataType> void PidBank<dataType>::Wake(size_t index)
+		{
+			if(!this->quiescent[index])
+				return;
+			this->quiescent[index] = 0;
+			this->numQuiescent.fetch_sub(1, std::memory_order_relaxed);
+			this->activeList.push_back(index);
+		}
+
+		template <class dataType> void PidBank<dataType>::WakeRange(size_t begin, size_t end, const dataType * inputs)
+		{
+			memcpy(&this->nextInput[begin], &inputs[begin], (end - begin)*sizeof(dataType));
+			if(this->numQuiescent.load(std::memory_order_relaxed) == 0)
+				return;
+
+			size_t numWoken = 0;
+			for(size_t i = begin; i < end; i++)
+			{
+				numWoken += this->quiescent[i];
+				this->quiescent[i] = 0;
+			}
+			if(numWoken > 0)
+			{
+				this->numQuiescent.fetch_sub(numWoken, std::memory_order_relaxed);
+				this->activeListStale.store(true, std::memory_order_relaxed);
+			}
+		}
+
+		template <class dataType> void PidBank<dataType>::StartEventDriven()
+		{
+			if(this->eventDriven)
+				return;
+			this->eventDriven = true;
+			this->nextInput = this->prevInput;
+		}
+
+		template <class dataType> void PidBank<dataType>::WakeAll()
+		{
+			if(this->numQuiescent.load(std::memory_order_relaxed) == 0)
+				return;
+			for(size_t i = 0; i < this->Size(); i++)
+				this->quiescent[i] = 0;
+			this->numQuiescent.store(0, std::memory_order_relaxed);
+			this->activeListStale.store(true, std::memory_order_relaxed);
+		}
+
+		template <class dataType> void PidBank<dataType>::RunRangeUnprimed(
+			size_t begin, size_t end, const dataType * inputs, dataType * outputs)
+		{
+			PidBankArrays<dataType> arrays = this->GetArrays();
+			size_t runBegin = begin;
+			for(size_t i = begin; i < end; i++)
+			{
+				if(this->primed[i])
+					continue;
+				this->kernel(arrays, runBegin, i, inputs, outputs);
+				this->firstRunKernel(arrays, i, i + 1, inputs, outputs);
+				this->primed[i] = 1;
+				this->numUnprimed.fetch_sub(1, std::memory_order_relaxed);
+				runBegin = i + 1;
+			}
+			this->kernel(arrays, runBegin, end, inputs, outputs);
+		}
+
+		template <class dataType> void PidBank<dataType>::SetTunings(size_t index, dataType kp, dataType ki, dataType kd)
+		{
+			if (kp<0 || ki<0 || kd<0)
+				return;
+
+			this->Kp[index] = kp;
+			this->Ki[index] = ki;
+			this->Kd[index] = kd;
+
+			// Same time-step scaling as Pid::SetTunings()
+			dataType zp = kp;
+			dataType zi = PidTraits<dataType>::ScaleKi(ki, this->samplePeriodMs[index]);
+			dataType zd = PidTraits<dataType>::ScaleKd(kd, this->samplePeriodMs[index]);
+
+			if(this->controllerDir[index] == ControllerDirection::PID_REVERSE)
+			{
+				zp = (0 - zp);
+				zi = (0 - zi);
+				zd = (0 - zd);
+			}
+
+			this->Zp[index] = zp;
+			this->Zi[index] = zi;
+			this->Zd[index] = zd;
+			this->Wake(index);
+		}
+
+		template <class dataType> void PidBank<dataType>::SetOutputLimits(size_t index, dataType min, dataType max)
+		{
+			if(min >= max)
+				return;
+			this->outMin[index] = min;
+			this->outMax[index] = max;
+			this->Wake(index);
+		}
+
+		template <class dataType> void PidBank<dataType>::SetControllerDirection(size_t index, ControllerDirection controllerDir)
+		{
+			if(controllerDir != this->controllerDir[index])
+			{
+				// Invert control constants
+				this->Zp[index] = (0 - this->Zp[index]);
+				this->Zi[index] = (0 - this->Zi[index]);
+				this->Zd[index] = (0 - this->Zd[index]);
+			}
+			this->controllerDir[index] = controllerDir;
+			this->Wake(index);
+		}
+
+		template <class dataType> void PidBank<dataType>::SetSamplePeriod(size_t index, uint32_t newSamplePeriodMs)
+		{
+			if (newSamplePeriodMs > 0)
+			{
+				PidTraits<dataType>::RescaleForSamplePeriod(this->Zi[index], this->Zd[index], newSamplePeriodMs, this->samplePeriodMs[index]);
+				this->samplePeriodMs[index] = newSamplePeriodMs;
+				this->Wake(index);
+			}
+		}
+
+		template <class dataType> void PidBank<dataType>::SetSetPoint(size_t index, dataType setPoint)
+		{
+			this->setPoint[index] = setPoint;
+			this->Wake(index);
+		}
+
+		template <class dataType> dataType PidBank<dataType>::GetSetPoint(size_t index) const
+		{
+			return this->setPoint[index];
+		}
+
+		template <class dataType> dataType PidBank<dataType>::GetOutput(size_t index) const
+		{
+			return this->prevOutput[index];
+		}
+
+		template <class dataType> dataType PidBank<dataType>::GetITerm(size_t index) const
+		{
+			return this->iTerm[index];
+		}
+
+		template <class dataType> dataType PidBank<dataType>::GetKp(size_t index) const
+		{
+			return this->Kp[index];
+		}
+
+		template <class dataType> dataType PidBank<dataType>::GetKi(size_t index) const
+		{
+			return this->Ki[index];
+		}
+
+		template <class dataType> dataType PidBank<dataType>::GetKd(size_t index) const
+		{
+			return this->Kd[index];
+		}
+
+		template <class dataType> dataType PidBank<dataType>::GetZp(size_t index) const
+		{
+			return this->Zp[index];
+		}
+
+		template <class dataType> dataType PidBank<dataType>::GetZi(size_t index) const
+		{
+			return this->Zi[index];
+		}
+
+		template <class dataType> dataType PidBank<dataType>::GetZd(size_t index) const
+		{
+			return this->Zd[index];
+		}
+
+		template <class dataType> dataType PidBank<dataType>::GetOutMin(size_t index) const
+		{
+			return this->outMin[index];
+		}
+
+		template <class dataType> dataType PidBank<dataType>::GetOutMax(size_t index) const
+		{
+			return this->outMax[index];
+		}
+
+		template <class dataType>
+		typename PidBank<dataType>::ControllerDirection PidBank<dataType>::GetControllerDirection(size_t index) const
+		{
+			return this->controllerDir[index];
+		}
+
+		template <class dataType>
+		typename PidBank<dataType>::OutputMode PidBank<dataType>::GetOutputMode(size_t index) const
+		{
+			return this->accumulate[index] ? OutputMode::ACCUMULATE_OUTPUT : OutputMode::DONT_ACCUMULATE_OUTPUT;
+		}
+
+		template <class dataType>
+		typename PidBank<dataType>::samplePeriodType PidBank<dataType>::GetSamplePeriod(size_t index) const
+		{
+			return this->samplePeriodMs[index];
+		}
+
+		template <class dataType> PidState<dataType> PidBank<dataType>::GetState(size_t index) const
+		{
+			PidState<dataType> state;
+			state.setPoint = this->setPoint[index];
+			state.prevInput = this->prevInput[index];
+			state.iTerm = this->iTerm[index];
+			state.prevOutput = this->prevOutput[index];
+			state.numTimesRan = this->primed[index];
+			return state;
+		}
+
+		template <class dataType> void PidBank<dataType>::SetState(size_t index, const PidState<dataType> & state)
+		{
+			this->setPoint[index] = state.setPoint;
+			this->prevInput[index] = state.prevInput;
+			this->nextInput[index] = state.prevInput;
+			this->iTerm[index] = state.iTerm;
+			this->prevOutput[index] = state.prevOutput;
+
+			uint8_t wasPrimed = this->primed[index];
+			this->primed[index] = (state.numTimesRan > 0) ? 1 : 0;
+			if(wasPrimed && !this->primed[index])
+				this->numUnprimed.fetch_add(1, std::memory_order_relaxed);
+			else if(!wasPrimed && this->primed[index])
+				this->numUnprimed.fetch_sub(1, std::memory_order_relaxed);
+			this->Wake(index);
+		}
+
+		template <class dataType> void PidBank<dataType>::GetStates(
+			dataType * setPoints, dataType * prevInputs, dataType * iTerms,
+			dataType * prevOutputs, uint32_t * numTimesRan) const
+		{
+			size_t size = this->Size();
+			if(size == 0)
+				return;
+			memcpy(setPoints, this->setPoint.data(), size*sizeof(dataType));
+			memcpy(prevInputs, this->prevInput.data(), size*sizeof(dataType));
+			memcpy(iTerms, this->iTerm.data(), size*sizeof(dataType));
+			memcpy(prevOutputs, this->prevOutput.data(), size*sizeof(dataType));
+			for(size_t i = 0; i < size; i++)
+				numTimesRan[i] = this->primed[i];
+		}
+
+		template <class dataType> void PidBank<dataType>::SetStates(
+			const dataType * setPoints, const dataType * prevInputs, const dataType * iTerms,
+			const dataType * prevOutputs, const uint32_t * numTimesRan)
+		{
+			size_t size = this->Size();
+			if(size == 0)
+				return;
+			memcpy(this->setPoint.data(), setPoints, size*sizeof(dataType));
+			memcpy(this->prevInput.data(), prevInputs, size*sizeof(dataType));
+			memcpy(this->nextInput.data(), prevInputs, size*sizeof(dataType));
+			memcpy(this->iTerm.data(), iTerms, size*sizeof(dataType));
+			memcpy(this->prevOutput.data(), prevOutputs, size*sizeof(dataType));
+
+			size_t numUnprimed = 0;
+			for(size_t i = 0; i < size; i++)
+			{
+				this->primed[i] = (numTimesRan[i] > 0) ? 1 : 0;
+				numUnprimed += 1 - this->primed[i];
+			}
+			this->numUnprimed.store(numUnprimed, std::memory_order_relaxed);
+			this->WakeAll();
+		}
+
+		template <class dataType> bool PidBank<dataType>::GetOverflowed(size_t index) const
+		{
+			return (this->overflow[index/64] >> (index % 64)) & 1;
+		}
+
+		template <class dataType> const uint64_t * PidBank<dataType>::GetOverflowMask() const
+		{
+			return this->overflow.data();
+		}
+
+		template <class dataType> void PidBank<dataType>::ClearOverflow()
+		{
+			for(size_t i = 0; i < this->overflow.size(); i++)
+				this->overflow[i] = 0;
+		}
+
+	} // namespace MPidNs
+} // namespace MbeddedNinja
+
+#endif // #ifndef M_PID_PID_BANK_H
+
+// EOF
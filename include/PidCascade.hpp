@@ -0,0 +1,271 @@
+//!
+//! @file 			PidCascade.hpp
+//! @author 		Geoffrey Hunter <gbmhunter@gmail.com> (www.mbedded.ninja)
+//! @edited 		n/a
+//! @created		2026-10-16
+//! @last-modified 	2026-10-16
+//! @brief			Cascade of PID controllers, evaluated outer to inner in one call.
+//! @details
+//!					See README.rst in repo root dir for more info.
+
+#ifndef __cplusplus
+	#error Please build with C++ compiler
+#endif
+
+//===============================================================================================//
+//====================================== HEADER GUARD ===========================================//
+//===============================================================================================//
+
+#ifndef M_PID_PID_CASCADE_H
+#define M_PID_PID_CASCADE_H
+
+//===== SYSTEM LIBRARIES =====//
+#include <stdint.h>		// uint32_t
+#include <stddef.h>		// size_t
+
+//===== USER SOURCE =====//
+#include "Pid.hpp"
+#include "PidTraits.hpp"
+
+namespace MbeddedNinja
+{
+	namespace MPidNs
+	{
+
+		//===============================================================================================//
+		//===================================== CLASS DEFINITION ========================================//
+		//===============================================================================================//
+
+		//! @brief		numStages PID controllers in cascade (e.g. position -> velocity -> current).
+		//! @details	Stage 0 is the outermost loop and follows setPoint. The output of each stage is the
+		//!				set-point of the next, and the output of the last stage is the cascade's output.
+		//!				Run() is called at the base sample period with one input per stage, and evaluates
+		//!				every stage that is due in one pass, so the stages' state stays in one contiguous
+		//!				block and the set-points are passed along in registers.
+		//!
+		//!				Each stage runs once every rateDivider base ticks (on the first tick, and then
+		//!				every rateDivider ticks after), and holds it's output in between, so an outer loop
+		//!				can run at an integer fraction of the inner loop's rate. The gains of a stage are
+		//!				scaled by it's own sample period (baseSamplePeriodMs*rateDivider).
+		//!
+		//!				The results are exactly the same as chaining numStages Pid objects by hand, copying
+		//!				each output into the next set-point and calling Run() on the stages which are due.
+		template <class dataType, size_t numStages> class PidCascade
+		{
+			static_assert(numStages > 0, "A cascade needs at least one stage.");
+
+			public:
+
+				typedef typename Pid<dataType>::ControllerDirection ControllerDirection;
+				typedef typename Pid<dataType>::OutputMode OutputMode;
+				typedef typename Pid<dataType>::samplePeriodType samplePeriodType;
+
+				//! @brief		Creates a cascade with every stage set to zero gains, a rate divider of 1,
+				//!				and output limits of +/-1. Configure each stage with SetStage().
+				PidCascade(samplePeriodType baseSamplePeriodMs, dataType setPoint);
+
+				//! @brief		Configures a stage. Parameters are the same as for Pid.
+				//! @param		rateDivider		The stage runs every rateDivider calls to Run().
+				//! @returns	false (and leaves the stage unchanged) if stage is out of range, rateDivider
+				//!				is 0, any gain is negative, or minOutput >= maxOutput.
+				bool SetStage(
+					size_t stage,
+					dataType kp,
+					dataType ki,
+					dataType kd,
+					ControllerDirection controllerDir,
+					OutputMode outputMode,
+					uint32_t rateDivider,
+					dataType minOutput,
+					dataType maxOutput);
+
+				//! @brief		Changes the gains of a stage. Same as Pid::SetTunings().
+				void SetTunings(size_t stage, dataType kp, dataType ki, dataType kd);
+
+				//! @brief		Runs one base tick.
+				//! @param		inputs		numStages process variables, outermost stage first.
+				//! @returns	The output of the innermost stage (also stored in output).
+				dataType Run(const dataType * inputs);
+
+				//! @brief		Runs one base tick, with the process variables as arguments, outermost first.
+				template <class... inputTypes> dataType Run(inputTypes... inputs)
+				{
+					static_assert(sizeof...(inputTypes) == numStages, "Pass one input per stage.");
+					const dataType inputArray[numStages] = { dataType(inputs)... };
+					return this->Run(inputArray);
+				}
+
+				//! @brief		Returns the last output of a stage (the set-point of the next stage).
+				dataType GetStageOutput(size_t stage) const;
+
+				//! @brief		Returns the integral term of a stage.
+				dataType GetStageIntegral(size_t stage) const;
+
+				//! @brief		Set-point of the outermost stage.
+				dataType setPoint;
+
+				//! @brief		Output of the innermost stage.
+				dataType output;
+
+			private:
+
+				//! @brief		Everything one stage needs, hot fields first.
+				struct Stage
+				{
+					dataType Zp;
+					dataType Zi;
+					dataType Zd;
+					dataType outMin;
+					dataType outMax;
+					dataType iTerm;
+					dataType prevInput;
+					dataType prevOutput;
+					uint32_t countdown;			//!< Base ticks until the stage next runs.
+					uint32_t rateDivider;
+					uint32_t numTimesRan;		//!< Saturates, only used to skip the first derivative.
+					bool accumulate;
+					bool reverse;
+				};
+
+				samplePeriodType baseSamplePeriodMs;
+				Stage stages[numStages];
+		};
+
+		//===============================================================================================//
+		//============================ TEMPLATE FUNCTION DEFINITIONS ====================================//
+		//===============================================================================================//
+
+		template <class dataType, size_t numStages> PidCascade<dataType, numStages>::PidCascade(
+			samplePeriodType baseSamplePeriodMs, dataType setPoint) :
+			setPoint(setPoint),
+			output(0),
+			baseSamplePeriodMs(baseSamplePeriodMs)
+		{
+			for(size_t s = 0; s < numStages; s++)
+			{
+				Stage & stage = this->stages[s];
+				stage.Zp = 0;
+				stage.Zi = 0;
+				stage.Zd = 0;
+				stage.outMin = dataType(-1);
+				stage.outMax = dataType(1);
+				stage.iTerm = 0;
+				stage.prevInput = 0;
+				stage.prevOutput = 0;
+				stage.countdown = 0;
+				stage.rateDivider = 1;
+				stage.numTimesRan = 0;
+				stage.accumulate = false;
+				stage.reverse = false;
+			}
+		}
+
+		template <class dataType, size_t numStages> bool PidCascade<dataType, numStages>::SetStage(
+			size_t stage,
+			dataType kp,
+			dataType ki,
+			dataType kd,
+			ControllerDirection controllerDir,
+			OutputMode outputMode,
+			uint32_t rateDivider,
+			dataType minOutput,
+			dataType maxOutput)
+		{
+			if(stage >= numStages || rateDivider == 0 || kp < 0 || ki < 0 || kd < 0 || minOutput >= maxOutput)
+				return false;
+
+			Stage & s = this->stages[stage];
+			s.rateDivider = rateDivider;
+			s.outMin = minOutput;
+			s.outMax = maxOutput;
+			s.accumulate = (outputMode == OutputMode::ACCUMULATE_OUTPUT);
+			s.reverse = (controllerDir == ControllerDirection::PID_REVERSE);
+			this->SetTunings(stage, kp, ki, kd);
+			return true;
+		}
+
+		template <class dataType, size_t numStages> void PidCascade<dataType, numStages>::SetTunings(
+			size_t stage, dataType kp, dataType ki, dataType kd)
+		{
+			if(stage >= numStages || kp < 0 || ki < 0 || kd < 0)
+				return;
+
+			Stage & s = this->stages[stage];
+			samplePeriodType stagePeriodMs = (samplePeriodType)(this->baseSamplePeriodMs*s.rateDivider);
+			s.Zp = kp;
+			s.Zi = PidTraits<dataType>::ScaleKi(ki, stagePeriodMs);
+			s.Zd = PidTraits<dataType>::ScaleKd(kd, stagePeriodMs);
+			if(s.reverse)
+			{
+				s.Zp = (0 - s.Zp);
+				s.Zi = (0 - s.Zi);
+				s.Zd = (0 - s.Zd);
+			}
+		}
+
+		template <class dataType, size_t numStages> dataType PidCascade<dataType, numStages>::Run(const dataType * inputs)
+		{
+			dataType stageSetPoint = this->setPoint;
+
+			// Fixed trip count, so the compiler can unroll this for small cascades
+			for(size_t i = 0; i < numStages; i++)
+			{
+				Stage & s = this->stages[i];
+
+				if(s.countdown == 0)
+				{
+					s.countdown = s.rateDivider;
+
+					const dataType input = inputs[i];
+					const dataType error = stageSetPoint - input;
+					const dataType pTerm = s.Zp*error;
+
+					dataType iTerm = s.iTerm + (s.Zi * error);
+					if(iTerm > s.outMax)
+						iTerm = s.outMax;
+					else if(iTerm < s.outMin)
+						iTerm = s.outMin;
+					s.iTerm = iTerm;
+
+					dataType dTerm = 0;
+					if(s.numTimesRan > 0)
+						dTerm = -s.Zd*(input - s.prevInput);
+
+					dataType stageOutput = s.accumulate ?
+						s.prevOutput + pTerm + iTerm + dTerm :
+						pTerm + iTerm + dTerm;
+					if(stageOutput > s.outMax)
+						stageOutput = s.outMax;
+					else if(stageOutput < s.outMin)
+						stageOutput = s.outMin;
+
+					s.prevInput = input;
+					s.prevOutput = stageOutput;
+					if(s.numTimesRan < 0xFFFFFFFF)
+						s.numTimesRan++;
+				}
+				s.countdown--;
+
+				stageSetPoint = s.prevOutput;
+			}
+
+			this->output = stageSetPoint;
+			return stageSetPoint;
+		}
+
+		template <class dataType, size_t numStages> dataType PidCascade<dataType, numStages>::GetStageOutput(size_t stage) const
+		{
+			return this->stages[stage].prevOutput;
+		}
+
+		template <class dataType, size_t numStages> dataType PidCascade<dataType, numStages>::GetStageIntegral(size_t stage) const
+		{
+			return this->stages[stage].iTerm;
+		}
+
+	} // namespace MPidNs
+} // namespace MbeddedNinja
+
+#endif // #ifndef M_PID_PID_CASCADE_H
+
+// EOF
@@ -0,0 +1,346 @@
+//!
+//! @file 			PidCheckpoint.hpp
+//! @author 		Geoffrey Hunter <gbmhunter@gmail.com> (www.mbedded.ninja)
+//! @edited 		n/a
+//! @created		2026-10-16
+//! @last-modified 	2026-10-16
+//! @brief			Binary checkpoints of controller run-time state, for restoring on a standby after failover.
+//! @details
+//!					See README.rst in repo root dir for more info.
+
+#ifndef __cplusplus
+	#error Please build with C++ compiler
+#endif
+
+//===============================================================================================//
+//====================================== HEADER GUARD ===========================================//
+//===============================================================================================//
+
+#ifndef M_PID_PID_CHECKPOINT_H
+#define M_PID_PID_CHECKPOINT_H
+
+//===== SYSTEM LIBRARIES =====//
+#include <stdint.h>		// uint16_t, uint32_t, uint64_t, uintptr_t
+#include <stddef.h>		// size_t
+#include <stdio.h>		// FILE, fopen(), fwrite(), rename()
+#include <string.h>		// memset(), memcmp(), memcpy()
+#include <string>		// std::string
+#include <type_traits>	// std::conditional, std::is_const
+#include <vector>		// std::vector
+
+//===== USER SOURCE =====//
+#include "MappedFile.hpp"
+#include "Pid.hpp"
+#include "PidBank.hpp"
+#include "PidLog.hpp"
+
+namespace MbeddedNinja
+{
+	namespace MPidNs
+	{
+
+		//===============================================================================================//
+		//======================================== FILE FORMAT ==========================================//
+		//===============================================================================================//
+
+		// A checkpoint is laid out as:
+		//
+		//		PidCheckpointHeader								64 bytes
+		//		dataType setPoint[numControllers]				padded to a multiple of 64 bytes
+		//		dataType prevInput[numControllers]				padded to a multiple of 64 bytes
+		//		dataType iTerm[numControllers]					padded to a multiple of 64 bytes
+		//		dataType prevOutput[numControllers]				padded to a multiple of 64 bytes
+		//		uint32_t numTimesRan[numControllers]			padded to a multiple of 64 bytes
+		//
+		// Only run-time state is stored. The settings (gains, limits, direction, ...) come from the
+		// standby's own configuration, which must match the one the checkpoint was taken with. Each
+		// column is a PidState field for every controller, so a PidBank is restored with one memcpy()
+		// per column. Values are in the byte order of the machine that wrote the checkpoint.
+
+		//! @brief		Increment when the layout changes.
+		static const uint16_t pidCheckpointVersion = 1;
+
+		static const uint32_t pidCheckpointNumColumns = 5;
+
+		struct PidCheckpointHeader
+		{
+			char magic[8];					//!< "MPIDCKP" and a null.
+			uint16_t version;				//!< pidCheckpointVersion.
+			uint16_t typeId;				//!< PidLogTypeId of the dataType.
+			uint16_t typeSize;				//!< sizeof(dataType).
+			uint16_t reserved0;
+			uint32_t numControllers;
+			uint32_t byteOrderMark;			//!< pidLogByteOrderMark in the writer's byte order.
+			uint64_t totalBytes;			//!< Size of the whole checkpoint, so a truncated one is rejected.
+			uint64_t sequence;				//!< Free for the caller, e.g. the tick the checkpoint was taken at.
+			uint8_t reserved[24];
+		};
+
+		static_assert(sizeof(PidCheckpointHeader) == 64, "PidCheckpointHeader must be 64 bytes.");
+
+		//! @brief		Returns the number of bytes a checkpoint of numControllers controllers takes.
+		template <class dataType> uint64_t PidCheckpointSize(size_t numControllers);
+
+		//! @brief		Writes a checkpoint of every controller in bank into buffer.
+		//! @param		buffer		Must be 8-byte aligned (e.g. from std::vector or new).
+		//! @param		sequence	Stored in the header, e.g. the tick number.
+		//! @returns	The number of bytes written, or 0 if buffer is too small or misaligned.
+		template <class dataType> size_t SavePidCheckpoint(
+			const PidBank<dataType> & bank, uint8_t * buffer, size_t bufferSize, uint64_t sequence = 0);
+
+		//! @brief		Writes a checkpoint of an array of numPids controllers into buffer.
+		template <class dataType> size_t SavePidCheckpoint(
+			const Pid<dataType> * pids, size_t numPids, uint8_t * buffer, size_t bufferSize, uint64_t sequence = 0);
+
+		//! @brief		Restores every controller in bank from a checkpoint in memory.
+		//! @details	The bank must already hold the same controllers, with the same settings, in the
+		//!				same order as when the checkpoint was taken. Nothing is changed if it fails.
+		//! @param		sequence	If not NULL, set to the sequence stored in the header.
+		//! @returns	false if the checkpoint is invalid, truncated, a different version or dataType,
+		//!				or holds a different number of controllers.
+		template <class dataType> bool RestorePidCheckpoint(
+			const uint8_t * data, size_t size, PidBank<dataType> & bank, uint64_t * sequence = NULL);
+
+		//! @brief		Restores an array of numPids controllers from a checkpoint in memory.
+		template <class dataType> bool RestorePidCheckpoint(
+			const uint8_t * data, size_t size, Pid<dataType> * pids, size_t numPids, uint64_t * sequence = NULL);
+
+		//! @brief		Writes a checkpoint of bank to a file.
+		//! @details	The checkpoint is written to path + ".tmp" and then renamed over path, so a reader
+		//!				never sees a partly written checkpoint.
+		//! @returns	false if the file couldn't be written.
+		template <class dataType> bool SavePidCheckpointFile(
+			const char * path, const PidBank<dataType> & bank, uint64_t sequence = 0);
+
+		//! @brief		Writes a checkpoint of an array of numPids controllers to a file.
+		template <class dataType> bool SavePidCheckpointFile(
+			const char * path, const Pid<dataType> * pids, size_t numPids, uint64_t sequence = 0);
+
+		//! @brief		Memory-maps a checkpoint file and restores bank from it.
+		template <class dataType> bool RestorePidCheckpointFile(
+			const char * path, PidBank<dataType> & bank, uint64_t * sequence = NULL);
+
+		//! @brief		Memory-maps a checkpoint file and restores an array of numPids controllers from it.
+		template <class dataType> bool RestorePidCheckpointFile(
+			const char * path, Pid<dataType> * pids, size_t numPids, uint64_t * sequence = NULL);
+
+		//===============================================================================================//
+		//============================ TEMPLATE FUNCTION DEFINITIONS ====================================//
+		//===============================================================================================//
+
+		//! @brief		Pointers to the columns of a checkpoint.
+		template <class dataType, class byteType> struct PidCheckpointColumns
+		{
+			typedef typename std::conditional<std::is_const<byteType>::value, const dataType, dataType>::type valueType;
+			typedef typename std::conditional<std::is_const<byteType>::value, const uint32_t, uint32_t>::type countType;
+
+			valueType * setPoint;
+			valueType * prevInput;
+			valueType * iTerm;
+			valueType * prevOutput;
+			countType * numTimesRan;
+
+			PidCheckpointColumns(byteType * data, size_t numControllers)
+			{
+				uint64_t columnBytes = PidLogPad((uint64_t)numControllers*sizeof(dataType));
+				uint64_t offset = sizeof(PidCheckpointHeader);
+				this->setPoint = reinterpret_cast<valueType *>(data + offset);
+				offset += columnBytes;
+				this->prevInput = reinterpret_cast<valueType *>(data + offset);
+				offset += columnBytes;
+				this->iTerm = reinterpret_cast<valueType *>(data + offset);
+				offset += columnBytes;
+				this->prevOutput = reinterpret_cast<valueType *>(data + offset);
+				offset += columnBytes;
+				this->numTimesRan = reinterpret_cast<countType *>(data + offset);
+			}
+		};
+
+		template <class dataType> uint64_t PidCheckpointSize(size_t numControllers)
+		{
+			return sizeof(PidCheckpointHeader) +
+				(pidCheckpointNumColumns - 1)*PidLogPad((uint64_t)numControllers*sizeof(dataType)) +
+				PidLogPad((uint64_t)numControllers*sizeof(uint32_t));
+		}
+
+		//! @brief		Fills in the header and zeroes the padding of a checkpoint. Returns it's size, or 0 if
+		//!				it doesn't fit in buffer.
+		template <class dataType> size_t PidCheckpointBegin(
+			size_t numControllers, uint8_t * buffer, size_t bufferSize, uint64_t sequence)
+		{
+			uint64_t totalBytes = PidCheckpointSize<dataType>(numControllers);
+			if(!buffer || totalBytes > bufferSize || ((uintptr_t)buffer & 7) != 0 || numControllers > 0xFFFFFFFF)
+				return 0;
+
+			PidCheckpointHeader header;
+			memset(&header, 0, sizeof(header));
+			memcpy(header.magic, "MPIDCKP", 8);
+			header.version = pidCheckpointVersion;
+			header.typeId = PidLogTypeId<dataType>::value;
+			header.typeSize = (uint16_t)sizeof(dataType);
+			header.numControllers = (uint32_t)numControllers;
+			header.byteOrderMark = pidLogByteOrderMark;
+			header.totalBytes = totalBytes;
+			header.sequence = sequence;
+			memcpy(buffer, &header, sizeof(header));
+
+			// Zero the padding after each column, so checkpoints of the same state are byte-identical
+			uint64_t valueBytes = (uint64_t)numControllers*sizeof(dataType);
+			uint64_t columnBytes = PidLogPad(valueBytes);
+			uint64_t offset = sizeof(PidCheckpointHeader);
+			for(uint32_t c = 0; c < pidCheckpointNumColumns - 1; c++)
+			{
+				memset(buffer + offset + valueBytes, 0, (size_t)(columnBytes - valueBytes));
+				offset += columnBytes;
+			}
+			uint64_t countBytes = (uint64_t)numControllers*sizeof(uint32_t);
+			memset(buffer + offset + countBytes, 0, (size_t)(PidLogPad(countBytes) - countBytes));
+			return (size_t)totalBytes;
+		}
+
+		//! @brief		Checks the header of a checkpoint.
+		template <class dataType> bool PidCheckpointIsValid(const uint8_t * data, size_t size, size_t numControllers)
+		{
+			if(!data || size < sizeof(PidCheckpointHeader) || ((uintptr_t)data & 7) != 0)
+				return false;
+
+			const PidCheckpointHeader * header = reinterpret_cast<const PidCheckpointHeader *>(data);
+			return memcmp(header->magic, "MPIDCKP", 8) == 0 &&
+				header->version == pidCheckpointVersion &&
+				header->byteOrderMark == pidLogByteOrderMark &&
+				header->typeId == PidLogTypeId<dataType>::value &&
+				header->typeSize == sizeof(dataType) &&
+				header->numControllers == numControllers &&
+				header->totalBytes == PidCheckpointSize<dataType>(numControllers) &&
+				header->totalBytes <= size;
+		}
+
+		template <class dataType> size_t SavePidCheckpoint(
+			const PidBank<dataType> & bank, uint8_t * buffer, size_t bufferSize, uint64_t sequence)
+		{
+			size_t totalBytes = PidCheckpointBegin<dataType>(bank.Size(), buffer, bufferSize, sequence);
+			if(!totalBytes)
+				return 0;
+
+			PidCheckpointColumns<dataType, uint8_t> columns(buffer, bank.Size());
+			bank.GetStates(columns.setPoint, columns.prevInput, columns.iTerm, columns.prevOutput, columns.numTimesRan);
+			return totalBytes;
+		}
+
+		template <class dataType> size_t SavePidCheckpoint(
+			const Pid<dataType> * pids, size_t numPids, uint8_t * buffer, size_t bufferSize, uint64_t sequence)
+		{
+			size_t totalBytes = PidCheckpointBegin<dataType>(numPids, buffer, bufferSize, sequence);
+			if(!totalBytes)
+				return 0;
+
+			PidCheckpointColumns<dataType, uint8_t> columns(buffer, numPids);
+			for(size_t i = 0; i < numPids; i++)
+			{
+				PidState<dataType> state = pids[i].GetState();
+				columns.setPoint[i] = state.setPoint;
+				columns.prevInput[i] = state.prevInput;
+				columns.iTerm[i] = state.iTerm;
+				columns.prevOutput[i] = state.prevOutput;
+				columns.numTimesRan[i] = state.numTimesRan;
+			}
+			return totalBytes;
+		}
+
+		template <class dataType> bool RestorePidCheckpoint(
+			const uint8_t * data, size_t size, PidBank<dataType> & bank, uint64_t * sequence)
+		{
+			if(!PidCheckpointIsValid<dataType>(data, size, bank.Size()))
+				return false;
+
+			PidCheckpointColumns<dataType, const uint8_t> columns(data, bank.Size());
+			bank.SetStates(columns.setPoint, columns.prevInput, columns.iTerm, columns.prevOutput, columns.numTimesRan);
+			if(sequence)
+				*sequence = reinterpret_cast<const PidCheckpointHeader *>(data)->sequence;
+			return true;
+		}
+
+		template <class dataType> bool RestorePidCheckpoint(
+			const uint8_t * data, size_t size, Pid<dataType> * pids, size_t numPids, uint64_t * sequence)
+		{
+			if(!PidCheckpointIsValid<dataType>(data, size, numPids))
+				return false;
+
+			PidCheckpointColumns<dataType, const uint8_t> columns(data, numPids);
+			for(size_t i = 0; i < numPids; i++)
+			{
+				PidState<dataType> state;
+				state.setPoint = columns.setPoint[i];
+				state.prevInput = columns.prevInput[i];
+				state.iTerm = columns.iTerm[i];
+				state.prevOutput = columns.prevOutput[i];
+				state.numTimesRan = columns.numTimesRan[i];
+				pids[i].SetState(state);
+			}
+			if(sequence)
+				*sequence = reinterpret_cast<const PidCheckpointHeader *>(data)->sequence;
+			return true;
+		}
+
+		//! @brief		Writes a checkpoint held in memory to path, via a temporary file.
+		inline bool WritePidCheckpointFile(const char * path, const std::vector<uint64_t> & buffer, size_t totalBytes)
+		{
+			if(!totalBytes)
+				return false;
+
+			std::string tempPath = std::string(path) + ".tmp";
+			FILE * file = fopen(tempPath.c_str(), "wb");
+			if(!file)
+				return false;
+			bool ok = fwrite(buffer.data(), totalBytes, 1, file) == 1;
+			ok = (fclose(file) == 0) && ok;
+			if(ok)
+				ok = rename(tempPath.c_str(), path) == 0;
+			if(!ok)
+				remove(tempPath.c_str());
+			return ok;
+		}
+
+		template <class dataType> bool SavePidCheckpointFile(
+			const char * path, const PidBank<dataType> & bank, uint64_t sequence)
+		{
+			// Held as uint64_t so the buffer is 8-byte aligned
+			uint64_t totalBytes = PidCheckpointSize<dataType>(bank.Size());
+			std::vector<uint64_t> buffer((size_t)(totalBytes + 7)/8);
+			return WritePidCheckpointFile(path, buffer,
+				SavePidCheckpoint(bank, reinterpret_cast<uint8_t *>(buffer.data()), (size_t)totalBytes, sequence));
+		}
+
+		template <class dataType> bool SavePidCheckpointFile(
+			const char * path, const Pid<dataType> * pids, size_t numPids, uint64_t sequence)
+		{
+			uint64_t totalBytes = PidCheckpointSize<dataType>(numPids);
+			std::vector<uint64_t> buffer((size_t)(totalBytes + 7)/8);
+			return WritePidCheckpointFile(path, buffer,
+				SavePidCheckpoint(pids, numPids, reinterpret_cast<uint8_t *>(buffer.data()), (size_t)totalBytes, sequence));
+		}
+
+		template <class dataType> bool RestorePidCheckpointFile(
+			const char * path, PidBank<dataType> & bank, uint64_t * sequence)
+		{
+			MappedFile file;
+			if(!file.Open(path))
+				return false;
+			return RestorePidCheckpoint(file.GetData(), file.GetSize(), bank, sequence);
+		}
+
+		template <class dataType> bool RestorePidCheckpointFile(
+			const char * path, Pid<dataType> * pids, size_t numPids, uint64_t * sequence)
+		{
+			MappedFile file;
+			if(!file.Open(path))
+				return false;
+			return RestorePidCheckpoint(file.GetData(), file.GetSize(), pids, numPids, sequence);
+		}
+
+	} // namespace MPidNs
+} // namespace MbeddedNinja
+
+#endif // #ifndef M_PID_PID_CHECKPOINT_H
+
+// EOF
@@ -0,0 +1,356 @@
+//!
+//! @file 			PidExecutor.hpp
+//! @author 		Geoffrey Hunter <gbmhunter@gmail.com> (www.mbedded.ninja)
+//! @edited 		n/a
+//! @created		2026-10-16
+//! @last-modified 	2026-10-17
+//! @brief			Runs a large population of controllers across a pinned pool of worker threads.
+//! @details
+//!					See README.rst in repo root dir for more info.
+
+#ifndef __cplusplus
+	#error Please build with C++ compiler
+#endif
+
+//===============================================================================================//
+//====================================== HEADER GUARD ===========================================//
+//===============================================================================================//
+
+#ifndef M_PID_PID_EXECUTOR_H
+#define M_PID_PID_EXECUTOR_H
+
+//===== SYSTEM LIBRARIES =====//
+#include <stdint.h>		// uint32_t
+#include <stddef.h>		// size_t
+#include <atomic>		// std::atomic
+#include <thread>		// std::thread
+#include <vector>		// std::vector
+
+//===== USER SOURCE =====//
+#include "CpuAffinity.hpp"
+#include "Pid.hpp"
+#include "PidBank.hpp"
+#include "SpinWaiter.hpp"
+
+namespace MbeddedNinja
+{
+	namespace MPidNs
+	{
+
+		//===============================================================================================//
+		//===================================== CLASS DEFINITION ========================================//
+		//===============================================================================================//
+
+		//! @brief		Splits a population of controllers into chunks and runs them on a worker pool.
+		//! @details	Each call to Run() is one tick. The chunks are dealt out to the workers as contiguous
+		//!				ranges, each with an atomic cursor. A worker takes chunks from it's own range first,
+		//!				then steals from the other workers' ranges, and Run() returns once every chunk is done
+		//!				(a per-tick barrier). Every chunk is run exactly once, and controllers don't depend on
+		//!				each other, so the results are identical to a serial run regardless of which worker
+		//!				ran which chunk.
+		//!
+		//!				The thread calling Run() is worker 0. The other workers are pinned to the allowed CPUs
+		//!				in order (worker 1 to the second allowed CPU, and so on). While waiting for the next
+		//!				tick they spin for a few microseconds and then block (see SpinWaiter), so back-to-back
+		//!				ticks start without a system call, but an idle pool leaves it's cores free. A tick
+		//!				which starts after the workers have blocked pays for waking them.
+		class PidExecutor
+		{
+			public:
+
+				//! @brief		Runs items [begin, end) of the job described by context.
+				typedef void (*ChunkFunction)(void * context, size_t begin, size_t end);
+
+				//! @param		numWorkers		Total number of workers, including the thread that calls Run().
+				//!								0 uses one per allowed CPU.
+				//! @param		pinWorkers		Pin the worker threads to CPUs.
+				PidExecutor(size_t numWorkers = 0, bool pinWorkers = true);
+
+				//! @brief		Stops and joins the worker threads.
+				~PidExecutor();
+
+				PidExecutor(const PidExecutor &) = delete;
+				PidExecutor & operator=(const PidExecutor &) = delete;
+
+				//! @brief		Runs function over [0, numItems) in chunks of chunkSize, and waits for it to finish.
+				void Run(size_t numItems, size_t chunkSize, ChunkFunction function, void * context);
+
+				//! @brief		Runs one tick of a PidBank. Same result as bank.RunAll(inputs, outputs).
+				//! @param		chunkSize		Controllers per chunk. 0 picks a size which fits in L1 cache.
+				template <class dataType> void RunBank(
+					PidBank<dataType> & bank, const dataType * inputs, dataType * outputs, size_t chunkSize = 0);
+
+				//! @brief		Calls pids[i].Run(inputs[i]) for every controller.
+				//! @param		chunkSize		Controllers per chunk. 0 picks a size which fits in L1 cache.
+				template <class dataType> void RunPids(
+					Pid<dataType> * pids, const dataType * inputs, size_t numPids, size_t chunkSize = 0);
+
+				//! @brief		Returns the number of workers, including the calling thread.
+				size_t GetNumWorkers() const;
+
+				//! @brief		Returns the number of chunks which were stolen during the last Run().
+				size_t GetNumStolenLastRun() const;
+
+				//! @brief		Returns the number of items per chunk that keeps bytesPerItem*items within
+				//!				targetBytes, rounded down to a multiple of 16 (so SIMD kernels run full width).
+				static size_t ChunkSizeForBytes(size_t bytesPerItem, size_t targetBytes = 16*1024);
+
+			private:
+
+				//! @brief		A worker's range of chunk indexes. Padded so cursors don't share cache lines.
+				struct Cursor
+				{
+					std::atomic<size_t> next;
+					size_t end;
+					char padding[128 - sizeof(std::atomic<size_t>) - sizeof(size_t)];
+				};
+
+				//! @brief		Body of each worker thread.
+				void WorkerLoop(size_t workerIndex);
+
+				//! @brief		Runs this worker's chunks, then steals from the others until none are left.
+				void DoWork(size_t workerIndex);
+
+				//! @brief		Runs one chunk of the current job.
+				void RunChunk(size_t chunkIndex);
+
+				size_t numWorkers;
+				std::vector<std::thread> threads;
+				Cursor * cursors;
+
+				//===== CURRENT JOB (written by Run() before generation is bumped) =====//
+
+				ChunkFunction function;
+				void * context;
+				size_t numItems;
+				size_t chunkSize;
+
+				//! @brief		Bumped by Run() to start a tick.
+				std::atomic<uint32_t> generation;
+
+				//! @brief		Number of background workers still working on the current tick.
+				std::atomic<size_t> numActive;
+
+				std::atomic<size_t> numStolen;
+				std::atomic<bool> stop;
+
+				//! @brief		Idle workers wait on this for generation to be bumped.
+				SpinWaiter workersWaiter;
+
+				//! @brief		Run() waits on this for numActive to reach 0.
+				SpinWaiter runWaiter;
+		};
+
+		//! @brief		Adapts PidBank::RunRange() to a PidExecutor::ChunkFunction.
+		template <class dataType> struct PidBankJob
+		{
+			PidBank<dataType> * bank;
+			const dataType * inputs;
+			dataType * outputs;
+
+			static void RunChunk(void * context, size_t begin, size_t end)
+			{
+				PidBankJob * job = static_cast<PidBankJob *>(context);
+				job->bank->RunRange(begin, end, job->inputs, job->outputs);
+			}
+		};
+
+		//! @brief		Adapts an array of Pid objects to a PidExecutor::ChunkFunction.
+		template <class dataType> struct PidArrayJob
+		{
+			Pid<dataType> * pids;
+			const dataType * inputs;
+
+			static void RunChunk(void * context, size_t begin, size_t end)
+			{
+				PidArrayJob * job = static_cast<PidArrayJob *>(context);
+				for(size_t i = begin; i < end; i++)
+					job->pids[i].Run(job->inputs[i]);
+			}
+		};
+
+		//===============================================================================================//
+		//=================================== FUNCTION DEFINITIONS ======================================//
+		//===============================================================================================//
+
+		inline PidExecutor::PidExecutor(size_t numWorkers, bool pinWorkers) :
+			function(NULL),
+			context(NULL),
+			numItems(0),
+			chunkSize(1),
+			generation(0),
+			numActive(0),
+			numStolen(0),
+			stop(false)
+		{
+			std::vector<size_t> cpus = GetAllowedCpus();
+			this->numWorkers = numWorkers ? numWorkers : cpus.size();
+
+			this->cursors = new Cursor[this->numWorkers];
+			for(size_t i = 0; i < this->numWorkers; i++)
+			{
+				this->cursors[i].next.store(0, std::memory_order_relaxed);
+				this->cursors[i].end = 0;
+			}
+
+			for(size_t i = 1; i < this->numWorkers; i++)
+			{
+				this->threads.push_back(std::thread(&PidExecutor::WorkerLoop, this, i));
+				if(pinWorkers)
+					PinThreadToCpu(this->threads.back(), cpus[i % cpus.size()]);
+			}
+		}
+
+		inline PidExecutor::~PidExecutor()
+		{
+			this->stop.store(true, std::memory_order_relaxed);
+			this->generation.fetch_add(1, std::memory_order_release);
+			this->workersWaiter.Notify();
+			for(size_t i = 0; i < this->threads.size(); i++)
+				this->threads[i].join();
+			delete[] this->cursors;
+		}
+
+		inline void PidExecutor::Run(size_t numItems, size_t chunkSize, ChunkFunction function, void * context)
+		{
+			if(numItems == 0)
+				return;
+			if(chunkSize == 0)
+				chunkSize = 1;
+
+			size_t numChunks = (numItems + chunkSize - 1)/chunkSize;
+
+			// Not worth waking anyone up for
+			if(this->numWorkers == 1 || numChunks == 1)
+			{
+				function(context, 0, numItems);
+				this->numStolen.store(0, std::memory_order_relaxed);
+				return;
+			}
+
+			this->function = function;
+			this->context = context;
+			this->numItems = numItems;
+			this->chunkSize = chunkSize;
+
+			// Deal the chunks out as evenly sized contiguous ranges
+			for(size_t i = 0; i < this->numWorkers; i++)
+			{
+				this->cursors[i].next.store(i*numChunks/this->numWorkers, std::memory_order_relaxed);
+				this->cursors[i].end = (i + 1)*numChunks/this->numWorkers;
+			}
+
+			this->numStolen.store(0, std::memory_order_relaxed);
+			this->numActive.store(this->numWorkers - 1, std::memory_order_relaxed);
+			this->generation.fetch_add(1, std::memory_order_release);
+			this->workersWaiter.Notify();
+
+			this->DoWork(0);
+
+			// Barrier
+			this->runWaiter.Wait([this]() { return this->numActive.load(std::memory_order_acquire) == 0; });
+		}
+
+		template <class dataType> void PidExecutor::RunBank(
+			PidBank<dataType> & bank, const dataType * inputs, dataType * outputs, size_t chunkSize)
+		{
+			// 9 hot columns, the accumulate flag, plus the input and output
+			if(chunkSize == 0)
+				chunkSize = ChunkSizeForBytes(11*sizeof(dataType) + 1);
+
+			PidBankJob<dataType> job;
+			job.bank = &bank;
+			job.inputs = inputs;
+			job.outputs = outputs;
+			this->Run(bank.Size(), chunkSize, &PidBankJob<dataType>::RunChunk, &job);
+		}
+
+		template <class dataType> void PidExecutor::RunPids(
+			Pid<dataType> * pids, const dataType * inputs, size_t numPids, size_t chunkSize)
+		{
+			if(chunkSize == 0)
+				chunkSize = ChunkSizeForBytes(sizeof(Pid<dataType>) + sizeof(dataType));
+
+			PidArrayJob<dataType> job;
+			job.pids = pids;
+			job.inputs = inputs;
+			this->Run(numPids, chunkSize, &PidArrayJob<dataType>::RunChunk, &job);
+		}
+
+		inline size_t PidExecutor::GetNumWorkers() const
+		{
+			return this->numWorkers;
+		}
+
+		inline size_t PidExecutor::GetNumStolenLastRun() const
+		{
+			return this->numStolen.load(std::memory_order_relaxed);
+		}
+
+		inline size_t PidExecutor::ChunkSizeForBytes(size_t bytesPerItem, size_t targetBytes)
+		{
+			size_t items = targetBytes/(bytesPerItem ? bytesPerItem : 1);
+			items -= items % 16;
+			return items ? items : 16;
+		}
+
+		inline void PidExecutor::WorkerLoop(size_t workerIndex)
+		{
+			uint32_t seenGeneration = 0;
+			for(;;)
+			{
+				this->workersWaiter.Wait([this, seenGeneration]() {
+					return this->generation.load(std::memory_order_acquire) != seenGeneration; });
+				seenGeneration = this->generation.load(std::memory_order_acquire);
+
+				if(this->stop.load(std::memory_order_relaxed))
+					return;
+
+				this->DoWork(workerIndex);
+				// The last worker to finish wakes Run()
+				if(this->numActive.fetch_sub(1, std::memory_order_release) == 1)
+					this->runWaiter.Notify();
+			}
+		}
+
+		inline void PidExecutor::DoWork(size_t workerIndex)
+		{
+			Cursor & own = this->cursors[workerIndex];
+			for(;;)
+			{
+				size_t chunk = own.next.fetch_add(1, std::memory_order_relaxed);
+				if(chunk >= own.end)
+					break;
+				this->RunChunk(chunk);
+			}
+
+			// Steal, starting with the next worker along so thieves spread out
+			for(size_t offset = 1; offset < this->numWorkers; offset++)
+			{
+				Cursor & victim = this->cursors[(workerIndex + offset) % this->numWorkers];
+				while(victim.next.load(std::memory_order_relaxed) < victim.end)
+				{
+					size_t chunk = victim.next.fetch_add(1, std::memory_order_relaxed);
+					if(chunk >= victim.end)
+						break;
+					this->RunChunk(chunk);
+					this->numStolen.fetch_add(1, std::memory_order_relaxed);
+				}
+			}
+		}
+
+		inline void PidExecutor::RunChunk(size_t chunkIndex)
+		{
+			size_t begin = chunkIndex*this->chunkSize;
+			size_t end = begin + this->chunkSize;
+			if(end > this->numItems)
+				end = this->numItems;
+			this->function(this->context, begin, end);
+		}
+
+	} // namespace MPidNs
+} // namespace MbeddedNinja
+
+#endif // #ifndef M_PID_PID_EXECUTOR_H
+
+// EOF
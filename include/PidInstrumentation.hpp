@@ -0,0 +1,160 @@
+//!
+//! @file 			PidInstrumentation.hpp
+//! @author 		Geoffrey Hunter <gbmhunter@gmail.com> (www.mbedded.ninja)
+//! @edited 		n/a
+//! @created		2026-10-16
+//! @last-modified 	2026-10-16
+//! @brief			Hot-path event counters and a Run() latency histogram for each controller.
+//! @details
+//!					See README.rst in repo root dir for more info.
+
+#ifndef __cplusplus
+	#error Please build with C++ compiler
+#endif
+
+//===============================================================================================//
+//====================================== HEADER GUARD ===========================================//
+//===============================================================================================//
+
+#ifndef M_PID_PID_INSTRUMENTATION_H
+#define M_PID_PID_INSTRUMENTATION_H
+
+//===== SYSTEM LIBRARIES =====//
+#include <stdint.h>		// uint64_t
+#include <stddef.h>		// size_t
+#include <atomic>		// std::atomic
+
+//===== USER SOURCE =====//
+#include "LogHistogram.hpp"
+
+namespace MbeddedNinja
+{
+	namespace MPidNs
+	{
+
+		//! @brief		A copy of a controller's counters at one point in time.
+		struct PidInstrumentationSnapshot
+		{
+			uint64_t numRuns;				//!< Calls to Run(), plus steps of RunBlock().
+			uint64_t integratorClamps;		//!< Steps where the integral term was clamped to outMin/outMax.
+			uint64_t outputSaturations;		//!< Steps where the output was clamped to outMin/outMax.
+			uint64_t derivativeSkips;		//!< Steps where the derivative was skipped (the first run).
+			uint64_t tuningChanges;			//!< Calls to SetTunings() (not counting the constructor's), plus
+											//!< parameter blocks applied by ConcurrentPid.
+			LogHistogramSnapshot runCycles;	//!< Duration of each Run() call, from ReadCycleCounter().
+
+			PidInstrumentationSnapshot() :
+				numRuns(0), integratorClamps(0), outputSaturations(0), derivativeSkips(0), tuningChanges(0)
+			{
+			}
+
+			//! @brief		Adds the counts of another snapshot to this one.
+			void Add(const PidInstrumentationSnapshot & other)
+			{
+				this->numRuns += other.numRuns;
+				this->integratorClamps += other.integratorClamps;
+				this->outputSaturations += other.outputSaturations;
+				this->derivativeSkips += other.derivativeSkips;
+				this->tuningChanges += other.tuningChanges;
+				this->runCycles.Add(other.runCycles);
+			}
+		};
+
+		//===============================================================================================//
+		//===================================== CLASS DEFINITION ========================================//
+		//===============================================================================================//
+
+		//! @brief		Per-controller counters, compiled into Pid when M_PID_CONFIG_ENABLE_INSTRUMENTATION is 1.
+		//! @details	Only the thread calling Run() writes the counters, so each increment is a relaxed
+		//!				load and store (no locked instructions). GetSnapshot() can be called from any
+		//!				thread while the controller keeps running.
+		class PidInstrumentation
+		{
+			public:
+
+				enum Counter
+				{
+					NUM_RUNS,
+					INTEGRATOR_CLAMPS,
+					OUTPUT_SATURATIONS,
+					DERIVATIVE_SKIPS,
+					TUNING_CHANGES,
+					NUM_COUNTERS
+				};
+
+				constexpr PidInstrumentation() :
+					counters(),
+					runCycles()
+				{
+				}
+
+				PidInstrumentation(const PidInstrumentation & other) :
+					runCycles(other.runCycles)
+				{
+					for(size_t c = 0; c < NUM_COUNTERS; c++)
+						this->counters[c].store(other.counters[c].load(std::memory_order_relaxed), std::memory_order_relaxed);
+				}
+
+				PidInstrumentation & operator=(const PidInstrumentation & other)
+				{
+					for(size_t c = 0; c < NUM_COUNTERS; c++)
+						this->counters[c].store(other.counters[c].load(std::memory_order_relaxed), std::memory_order_relaxed);
+					this->runCycles = other.runCycles;
+					return *this;
+				}
+
+				//! @brief		Adds amount to a counter. Only call from the thread that runs the controller.
+				void Count(Counter counter, uint64_t amount = 1)
+				{
+					std::atomic<uint64_t> & value = this->counters[counter];
+					value.store(value.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+				}
+
+				//! @brief		Records the duration of one Run() call.
+				void RecordRunCycles(uint64_t cycles)
+				{
+					this->runCycles.Record(cycles);
+				}
+
+				//! @brief		Returns a copy of the counters. Safe to call from any thread.
+				PidInstrumentationSnapshot GetSnapshot() const
+				{
+					PidInstrumentationSnapshot snapshot;
+					snapshot.numRuns = this->counters[NUM_RUNS].load(std::memory_order_relaxed);
+					snapshot.integratorClamps = this->counters[INTEGRATOR_CLAMPS].load(std::memory_order_relaxed);
+					snapshot.outputSaturations = this->counters[OUTPUT_SATURATIONS].load(std::memory_order_relaxed);
+					snapshot.derivativeSkips = this->counters[DERIVATIVE_SKIPS].load(std::memory_order_relaxed);
+					snapshot.tuningChanges = this->counters[TUNING_CHANGES].load(std::memory_order_relaxed);
+					snapshot.runCycles = this->runCycles.GetSnapshot();
+					return snapshot;
+				}
+
+				//! @brief		Zeroes every counter. Don't call while the controller is running.
+				void Reset()
+				{
+					for(size_t c = 0; c < NUM_COUNTERS; c++)
+						this->counters[c].store(0, std::memory_order_relaxed);
+					this->runCycles.Reset();
+				}
+
+			private:
+
+				AtomicCounter counters[NUM_COUNTERS];
+				LogHistogram runCycles;
+		};
+
+		//! @brief		Sums the counters of an array of controllers (anything with GetInstrumentation()).
+		template <class pidType> PidInstrumentationSnapshot AggregateInstrumentation(const pidType * pids, size_t numPids)
+		{
+			PidInstrumentationSnapshot total;
+			for(size_t i = 0; i < numPids; i++)
+				total.Add(pids[i].GetInstrumentation());
+			return total;
+		}
+
+	} // namespace MPidNs
+} // namespace MbeddedNinja
+
+#endif // #ifndef M_PID_PID_INSTRUMENTATION_H
+
+// EOF
@@ -0,0 +1,974 @@
+//!
+//! @file 			PidKernels.hpp
+//! @author 		Geoffrey Hunter <gbmhunter@gmail.com> (www.mbedded.ninja)
+//! @edited 		n/a
+//! @created		2026-10-16
+//! @last-modified 	2026-10-16
+//! @brief			Scalar and explicit SIMD kernels used by PidBank to run many controllers at once.
+//! @details
+//!					See README.rst in repo root dir for more info.
+
+#ifndef __cplusplus
+	#error Please build with C++ compiler
+#endif
+
+//===============================================================================================//
+//====================================== HEADER GUARD ===========================================//
+//===============================================================================================//
+
+#ifndef M_PID_PID_KERNELS_H
+#define M_PID_PID_KERNELS_H
+
+//===== SYSTEM LIBRARIES =====//
+#include <stdint.h>		// uint8_t, int32_t
+#include <stddef.h>		// size_t
+#include <string.h>		// memcpy()
+
+//===== USER SOURCE =====//
+#include "FixedQ.hpp"
+
+//===============================================================================================//
+//================================== PRECOMPILER CHECKS =========================================//
+//===============================================================================================//
+
+// The SIMD kernels rely on GCC/Clang function target attributes, so that they can be compiled into
+// the same binary as the scalar fallback and selected at runtime.
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+	#define M_PID_X86_KERNELS 1
+	#include <cpuid.h>
+	#include <immintrin.h>
+#else
+	#define M_PID_X86_KERNELS 0
+#endif
+
+namespace MbeddedNinja
+{
+	namespace MPidNs
+	{
+
+		//===============================================================================================//
+		//======================================= PUBLIC TYPES ==========================================//
+		//===============================================================================================//
+
+		//! @brief		The instruction sets the kernels are written for, from slowest to fastest.
+		enum class SimdLevel
+		{
+			SCALAR,			//!< Portable C++, one controller at a time.
+			SSE2,			//!< 128-bit vectors (4 floats, 2 doubles or 4 int32s).
+			AVX2,			//!< 256-bit vectors (8 floats, 4 doubles or 8 int32s).
+			AVX512			//!< 512-bit vectors (16 floats, 8 doubles or 16 int32s).
+		};
+
+		//! @brief		Pointers to the "hot" arrays of a PidBank, which is everything a kernel needs.
+		template <class dataType> struct PidBankArrays
+		{
+			const dataType * Zp;
+			const dataType * Zi;
+			const dataType * Zd;
+			const dataType * setPoint;
+			const dataType * outMin;
+			const dataType * outMax;
+			const uint8_t * accumulate;
+			dataType * prevInput;
+			dataType * iTerm;
+			dataType * prevOutput;
+
+			//! @brief		Bit (i % 64) of word (i / 64) is set when a step of controller i saturated.
+			//! @details	Only written by the FixedQ kernels.
+			uint64_t * overflow;
+		};
+
+		//! @brief		Signature of a kernel. Runs controllers [begin, end) once.
+		template <class dataType> using PidKernel =
+			void (*)(const PidBankArrays<dataType> & bank, size_t begin, size_t end, const dataType * inputs, dataType * outputs);
+
+		//===============================================================================================//
+		//======================================= SCALAR KERNEL =========================================//
+		//===============================================================================================//
+
+		//! @brief		Portable kernel, works with any dataType that Pid works with.
+		//! @details	Does the same arithmetic, in the same order, as Pid::Run(). Every SIMD kernel falls
+		//!				back to this for the elements left over at the end of a range.
+		//! @tparam		firstRun	Leave the derivative term out (exactly 0), as Pid::Run() does when
+		//!							numTimesRan is 0.
+		template <class dataType, bool firstRun = false> void RunPidKernelScalar(
+			const PidBankArrays<dataType> & bank, size_t begin, size_t end, const dataType * inputs, dataType * outputs)
+		{
+			for(size_t i = begin; i < end; i++)
+			{
+				dataType input = inputs[i];
+				dataType error = bank.setPoint[i] - input;
+				dataType pTerm = bank.Zp[i]*error;
+
+				dataType integral = bank.iTerm[i] + bank.Zi[i]*error;
+				integral = (integral > bank.outMax[i]) ? bank.outMax[i] : integral;
+				integral = (integral < bank.outMin[i]) ? bank.outMin[i] : integral;
+
+				dataType dTerm = firstRun ? dataType(0) : -bank.Zd[i]*(input - bank.prevInput[i]);
+
+				// Adding 0 in non-accumulating mode keeps this select branch-free
+				dataType base = bank.accumulate[i] ? bank.prevOutput[i] : dataType(0);
+				dataType output = base + pTerm + integral + dTerm;
+				output = (output > bank.outMax[i]) ? bank.outMax[i] : output;
+				output = (output < bank.outMin[i]) ? bank.outMin[i] : output;
+
+				bank.iTerm[i] = integral;
+				bank.prevInput[i] = input;
+				bank.prevOutput[i] = output;
+				outputs[i] = output;
+			}
+		}
+
+		//===============================================================================================//
+		//================================ FIXED-POINT SCALAR KERNEL ====================================//
+		//===============================================================================================//
+
+		//! @brief		ORs laneBits into an overflow bitmask, with bit 0 going to controller first.
+		//! @details	Ranges run on different threads can share a word, so the OR is atomic. Overflow
+		//!				is rare, so the branch is almost never taken.
+		inline void MarkOverflow(uint64_t * words, size_t first, uint64_t laneBits)
+		{
+			if(laneBits == 0)
+				return;
+			const size_t shift = first % 64;
+			__atomic_fetch_or(&words[first/64], laneBits << shift, __ATOMIC_RELAXED);
+			if(shift != 0 && (laneBits >> (64 - shift)) != 0)
+				__atomic_fetch_or(&words[first/64 + 1], laneBits >> (64 - shift), __ATOMIC_RELAXED);
+		}
+
+		//! @brief		Same as FixedQ::Saturate(), but also records whether the value had to be clamped.
+		template <class baseType, class wideType> inline baseType SaturateFlagged(wideType value, uint32_t & overflowed)
+		{
+			const baseType result = FixedQ<baseType, 0>::Saturate(value);
+			overflowed |= ((wideType)result != value);
+			return result;
+		}
+
+		//! @brief		Kernel for banks of FixedQ numbers, which also records overflow.
+		//! @details	Works on the raw integers, but does exactly what the FixedQ operators would do
+		//!				in RunPidKernelScalar(), so the results are identical. Every SIMD fixed-point
+		//!				kernel falls back to this for the elements left over at the end of a range.
+		//! @tparam		firstRun	Leave the derivative term out, as in RunPidKernelScalar().
+		template <class baseType, uint8_t numFracBits, bool firstRun = false> void RunPidKernelScalarQ(
+			const PidBankArrays<FixedQ<baseType, numFracBits>> & bank, size_t begin, size_t end,
+			const FixedQ<baseType, numFracBits> * inputs, FixedQ<baseType, numFracBits> * outputs)
+		{
+			typedef FixedQ<baseType, numFracBits> qType;
+			typedef typename qType::wideType wideType;
+
+			for(size_t i = begin; i < end; i++)
+			{
+				uint32_t overflowed = 0;
+				const baseType input = inputs[i].GetRaw();
+				const baseType outMin = bank.outMin[i].GetRaw();
+				const baseType outMax = bank.outMax[i].GetRaw();
+
+				baseType error = SaturateFlagged<baseType>((wideType)bank.setPoint[i].GetRaw() - input, overflowed);
+				baseType pTerm = SaturateFlagged<baseType>(((wideType)bank.Zp[i].GetRaw()*error) >> numFracBits, overflowed);
+
+				baseType iError = SaturateFlagged<baseType>(((wideType)bank.Zi[i].GetRaw()*error) >> numFracBits, overflowed);
+				baseType integral = SaturateFlagged<baseType>((wideType)bank.iTerm[i].GetRaw() + iError, overflowed);
+				integral = (integral > outMax) ? outMax : integral;
+				integral = (integral < outMin) ? outMin : integral;
+
+				baseType dTerm = 0;
+				if(!firstRun)
+				{
+					baseType negZd = SaturateFlagged<baseType>(-(wideType)bank.Zd[i].GetRaw(), overflowed);
+					baseType inputChange = SaturateFlagged<baseType>((wideType)input - bank.prevInput[i].GetRaw(), overflowed);
+					dTerm = SaturateFlagged<baseType>(((wideType)negZd*inputChange) >> numFracBits, overflowed);
+				}
+
+				baseType output = bank.accumulate[i] ? bank.prevOutput[i].GetRaw() : baseType(0);
+				output = SaturateFlagged<baseType>((wideType)output + pTerm, overflowed);
+				output = SaturateFlagged<baseType>((wideType)output + integral, overflowed);
+				output = SaturateFlagged<baseType>((wideType)output + dTerm, overflowed);
+				output = (output > outMax) ? outMax : output;
+				output = (output < outMin) ? outMin : output;
+
+				bank.iTerm[i] = qType::FromRaw(integral);
+				bank.prevInput[i] = qType::FromRaw(input);
+				bank.prevOutput[i] = qType::FromRaw(output);
+				outputs[i] = qType::FromRaw(output);
+				MarkOverflow(bank.overflow, i, overflowed);
+			}
+		}
+
+		//===============================================================================================//
+		//======================================= CPU DETECTION =========================================//
+		//===============================================================================================//
+
+		//! @brief		Queries CPUID (and the OS-enabled register state) for the best supported SimdLevel.
+		inline SimdLevel DetectSimdLevel()
+		{
+			#if M_PID_X86_KERNELS
+				unsigned int eax, ebx, ecx, edx;
+				if(!__get_cpuid(1, &eax, &ebx, &ecx, &edx) || !(edx & bit_SSE2))
+					return SimdLevel::SCALAR;
+
+				SimdLevel level = SimdLevel::SSE2;
+
+				// AVX state must be enabled by the OS, not just present in the CPU
+				if(!(ecx & bit_OSXSAVE))
+					return level;
+				uint32_t xcr0Lo, xcr0Hi;
+				__asm__ __volatile__("xgetbv" : "=a"(xcr0Lo), "=d"(xcr0Hi) : "c"(0));
+				if((xcr0Lo & 0x06) != 0x06)
+					return level;
+
+				if(__get_cpuid_max(0, 0) < 7)
+					return level;
+				__cpuid_count(7, 0, eax, ebx, ecx, edx);
+				if(ebx & bit_AVX2)
+					level = SimdLevel::AVX2;
+				// AVX-512 also needs the opmask and upper ZMM state enabled
+				if((ebx & bit_AVX512F) && (xcr0Lo & 0xE6) == 0xE6)
+					level = SimdLevel::AVX512;
+				return level;
+			#else
+				return SimdLevel::SCALAR;
+			#endif
+		}
+
+		//! @brief		Returns the best SimdLevel for this CPU. Detected once, on first call.
+		inline SimdLevel GetSimdLevel()
+		{
+			static const SimdLevel level = DetectSimdLevel();
+			return level;
+		}
+
+		#if M_PID_X86_KERNELS
+
+		//===============================================================================================//
+		//====================================== SIMD HELPERS ===========================================//
+		//===============================================================================================//
+
+		//! @brief		Loads 4 accumulate flags and expands them into 4 x 32-bit lane masks.
+		__attribute__((target("sse2"))) inline __m128i LoadMask4x32Sse2(const uint8_t * flags)
+		{
+			int32_t packed;
+			memcpy(&packed, flags, sizeof(packed));
+			const __m128i zero = _mm_setzero_si128();
+			__m128i x = _mm_unpacklo_epi8(_mm_cvtsi32_si128(packed), zero);
+			x = _mm_unpacklo_epi16(x, zero);
+			return _mm_cmpgt_epi32(x, zero);
+		}
+
+		//! @brief		Loads 2 accumulate flags and expands them into 2 x 64-bit lane masks.
+		__attribute__((target("sse2"))) inline __m128i LoadMask2x64Sse2(const uint8_t * flags)
+		{
+			int32_t packed = flags[0] | (flags[1] << 8);
+			const __m128i zero = _mm_setzero_si128();
+			__m128i x = _mm_unpacklo_epi8(_mm_cvtsi32_si128(packed), zero);
+			x = _mm_unpacklo_epi16(x, zero);
+			x = _mm_unpacklo_epi32(x, x);
+			return _mm_cmpgt_epi32(x, zero);
+		}
+
+		//! @brief		Low 32 bits of a 32x32-bit multiply (SSE2 has no pmulld).
+		__attribute__((target("sse2"))) inline __m128i MulLo32Sse2(__m128i a, __m128i b)
+		{
+			__m128i even = _mm_mul_epu32(a, b);
+			__m128i odd = _mm_mul_epu32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32));
+			return _mm_unpacklo_epi32(
+				_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)),
+				_mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
+		}
+
+		//! @brief		Returns mask ? a : b, per bit.
+		__attribute__((target("sse2"))) inline __m128i Select128(__m128i mask, __m128i a, __m128i b)
+		{
+			return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+		}
+
+		//===============================================================================================//
+		//======================================== SSE2 KERNELS =========================================//
+		//===============================================================================================//
+
+		__attribute__((target("sse2"))) inline void RunPidKernelSse2(
+			const PidBankArrays<float> & bank, size_t begin, size_t end, const float * inputs, float * outputs)
+		{
+			const __m128 signMask = _mm_set1_ps(-0.0f);
+			size_t i = begin;
+			for(; i + 4 <= end; i += 4)
+			{
+				__m128 input = _mm_loadu_ps(inputs + i);
+				__m128 outMin = _mm_loadu_ps(bank.outMin + i);
+				__m128 outMax = _mm_loadu_ps(bank.outMax + i);
+				__m128 error = _mm_sub_ps(_mm_loadu_ps(bank.setPoint + i), input);
+				__m128 pTerm = _mm_mul_ps(_mm_loadu_ps(bank.Zp + i), error);
+
+				// min(outMax, x) and max(outMin, x) return x when x is NaN, like the scalar compares
+				__m128 integral = _mm_add_ps(_mm_loadu_ps(bank.iTerm + i), _mm_mul_ps(_mm_loadu_ps(bank.Zi + i), error));
+				integral = _mm_max_ps(outMin, _mm_min_ps(outMax, integral));
+
+				__m128 negZd = _mm_xor_ps(_mm_loadu_ps(bank.Zd + i), signMask);
+				__m128 dTerm = _mm_mul_ps(negZd, _mm_sub_ps(input, _mm_loadu_ps(bank.prevInput + i)));
+
+				__m128 base = _mm_and_ps(_mm_castsi128_ps(LoadMask4x32Sse2(bank.accumulate + i)), _mm_loadu_ps(bank.prevOutput + i));
+				__m128 output = _mm_add_ps(_mm_add_ps(_mm_add_ps(base, pTerm), integral), dTerm);
+				output = _mm_max_ps(outMin, _mm_min_ps(outMax, output));
+
+				_mm_storeu_ps(bank.iTerm + i, integral);
+				_mm_storeu_ps(bank.prevInput + i, input);
+				_mm_storeu_ps(bank.prevOutput + i, output);
+				_mm_storeu_ps(outputs + i, output);
+			}
+			RunPidKernelScalar(bank, i, end, inputs, outputs);
+		}
+
+		__attribute__((target("sse2"))) inline void RunPidKernelSse2(
+			const PidBankArrays<double> & bank, size_t begin, size_t end, const double * inputs, double * outputs)
+		{
+			const __m128d signMask = _mm_set1_pd(-0.0);
+			size_t i = begin;
+			for(; i + 2 <= end; i += 2)
+			{
+				__m128d input = _mm_loadu_pd(inputs + i);
+				__m128d outMin = _mm_loadu_pd(bank.outMin + i);
+				__m128d outMax = _mm_loadu_pd(bank.outMax + i);
+				__m128d error = _mm_sub_pd(_mm_loadu_pd(bank.setPoint + i), input);
+				__m128d pTerm = _mm_mul_pd(_mm_loadu_pd(bank.Zp + i), error);
+
+				__m128d integral = _mm_add_pd(_mm_loadu_pd(bank.iTerm + i), _mm_mul_pd(_mm_loadu_pd(bank.Zi + i), error));
+				integral = _mm_max_pd(outMin, _mm_min_pd(outMax, integral));
+
+				__m128d negZd = _mm_xor_pd(_mm_loadu_pd(bank.Zd + i), signMask);
+				__m128d dTerm = _mm_mul_pd(negZd, _mm_sub_pd(input, _mm_loadu_pd(bank.prevInput + i)));
+
+				__m128d base = _mm_and_pd(_mm_castsi128_pd(LoadMask2x64Sse2(bank.accumulate + i)), _mm_loadu_pd(bank.prevOutput + i));
+				__m128d output = _mm_add_pd(_mm_add_pd(_mm_add_pd(base, pTerm), integral), dTerm);
+				output = _mm_max_pd(outMin, _mm_min_pd(outMax, output));
+
+				_mm_storeu_pd(bank.iTerm + i, integral);
+				_mm_storeu_pd(bank.prevInput + i, input);
+				_mm_storeu_pd(bank.prevOutput + i, output);
+				_mm_storeu_pd(outputs + i, output);
+			}
+			RunPidKernelScalar(bank, i, end, inputs, outputs);
+		}
+
+		__attribute__((target("sse2"))) inline void RunPidKernelSse2(
+			const PidBankArrays<int32_t> & bank, size_t begin, size_t end, const int32_t * inputs, int32_t * outputs)
+		{
+			const __m128i zero = _mm_setzero_si128();
+			size_t i = begin;
+			for(; i + 4 <= end; i += 4)
+			{
+				__m128i input = _mm_loadu_si128((const __m128i *)(inputs + i));
+				__m128i outMin = _mm_loadu_si128((const __m128i *)(bank.outMin + i));
+				__m128i outMax = _mm_loadu_si128((const __m128i *)(bank.outMax + i));
+				__m128i error = _mm_sub_epi32(_mm_loadu_si128((const __m128i *)(bank.setPoint + i)), input);
+				__m128i pTerm = MulLo32Sse2(_mm_loadu_si128((const __m128i *)(bank.Zp + i)), error);
+
+				__m128i integral = _mm_add_epi32(
+					_mm_loadu_si128((const __m128i *)(bank.iTerm + i)),
+					MulLo32Sse2(_mm_loadu_si128((const __m128i *)(bank.Zi + i)), error));
+				integral = Select128(_mm_cmpgt_epi32(integral, outMax), outMax, integral);
+				integral = Select128(_mm_cmplt_epi32(integral, outMin), outMin, integral);
+
+				__m128i negZd = _mm_sub_epi32(zero, _mm_loadu_si128((const __m128i *)(bank.Zd + i)));
+				__m128i dTerm = MulLo32Sse2(negZd, _mm_sub_epi32(input, _mm_loadu_si128((const __m128i *)(bank.prevInput + i))));
+
+				__m128i base = _mm_and_si128(LoadMask4x32Sse2(bank.accumulate + i), _mm_loadu_si128((const __m128i *)(bank.prevOutput + i)));
+				__m128i output = _mm_add_epi32(_mm_add_epi32(_mm_add_epi32(base, pTerm), integral), dTerm);
+				output = Select128(_mm_cmpgt_epi32(output, outMax), outMax, output);
+				output = Select128(_mm_cmplt_epi32(output, outMin), outMin, output);
+
+				_mm_storeu_si128((__m128i *)(bank.iTerm + i), integral);
+				_mm_storeu_si128((__m128i *)(bank.prevInput + i), input);
+				_mm_storeu_si128((__m128i *)(bank.prevOutput + i), output);
+				_mm_storeu_si128((__m128i *)(outputs + i), output);
+			}
+			RunPidKernelScalar(bank, i, end, inputs, outputs);
+		}
+
+		//===============================================================================================//
+		//======================================== AVX2 KERNELS =========================================//
+		//===============================================================================================//
+
+		__attribute__((target("avx2"))) inline void RunPidKernelAvx2(
+			const PidBankArrays<float> & bank, size_t begin, size_t end, const float * inputs, float * outputs)
+		{
+			const __m256 signMask = _mm256_set1_ps(-0.0f);
+			const __m256i zero = _mm256_setzero_si256();
+			size_t i = begin;
+			for(; i + 8 <= end; i += 8)
+			{
+				__m256 input = _mm256_loadu_ps(inputs + i);
+				__m256 outMin = _mm256_loadu_ps(bank.outMin + i);
+				__m256 outMax = _mm256_loadu_ps(bank.outMax + i);
+				__m256 error = _mm256_sub_ps(_mm256_loadu_ps(bank.setPoint + i), input);
+				__m256 pTerm = _mm256_mul_ps(_mm256_loadu_ps(bank.Zp + i), error);
+
+				__m256 integral = _mm256_add_ps(_mm256_loadu_ps(bank.iTerm + i), _mm256_mul_ps(_mm256_loadu_ps(bank.Zi + i), error));
+				integral = _mm256_max_ps(outMin, _mm256_min_ps(outMax, integral));
+
+				__m256 negZd = _mm256_xor_ps(_mm256_loadu_ps(bank.Zd + i), signMask);
+				__m256 dTerm = _mm256_mul_ps(negZd, _mm256_sub_ps(input, _mm256_loadu_ps(bank.prevInput + i)));
+
+				__m256i mask = _mm256_cmpgt_epi32(
+					_mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i *)(bank.accumulate + i))), zero);
+				__m256 base = _mm256_and_ps(_mm256_castsi256_ps(mask), _mm256_loadu_ps(bank.prevOutput + i));
+				__m256 output = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(base, pTerm), integral), dTerm);
+				output = _mm256_max_ps(outMin, _mm256_min_ps(outMax, output));
+
+				_mm256_storeu_ps(bank.iTerm + i, integral);
+				_mm256_storeu_ps(bank.prevInput + i, input);
+				_mm256_storeu_ps(bank.prevOutput + i, output);
+				_mm256_storeu_ps(outputs + i, output);
+			}
+			RunPidKernelScalar(bank, i, end, inputs, outputs);
+		}
+
+		__attribute__((target("avx2"))) inline void RunPidKernelAvx2(
+			const PidBankArrays<double> & bank, size_t begin, size_t end, const double * inputs, double * outputs)
+		{
+			const __m256d signMask = _mm256_set1_pd(-0.0);
+			const __m256i zero = _mm256_setzero_si256();
+			size_t i = begin;
+			for(; i + 4 <= end; i += 4)
+			{
+				__m256d input = _mm256_loadu_pd(inputs + i);
+				__m256d outMin = _mm256_loadu_pd(bank.outMin + i);
+				__m256d outMax = _mm256_loadu_pd(bank.outMax + i);
+				__m256d error = _mm256_sub_pd(_mm256_loadu_pd(bank.setPoint + i), input);
+				__m256d pTerm = _mm256_mul_pd(_mm256_loadu_pd(bank.Zp + i), error);
+
+				__m256d integral = _mm256_add_pd(_mm256_loadu_pd(bank.iTerm + i), _mm256_mul_pd(_mm256_loadu_pd(bank.Zi + i), error));
+				integral = _mm256_max_pd(outMin, _mm256_min_pd(outMax, integral));
+
+				__m256d negZd = _mm256_xor_pd(_mm256_loadu_pd(bank.Zd + i), signMask);
+				__m256d dTerm = _mm256_mul_pd(negZd, _mm256_sub_pd(input, _mm256_loadu_pd(bank.prevInput + i)));
+
+				int32_t packed;
+				memcpy(&packed, bank.accumulate + i, sizeof(packed));
+				__m256i mask = _mm256_cmpgt_epi64(_mm256_cvtepu8_epi64(_mm_cvtsi32_si128(packed)), zero);
+				__m256d base = _mm256_and_pd(_mm256_castsi256_pd(mask), _mm256_loadu_pd(bank.prevOutput + i));
+				__m256d output = _mm256_add_pd(_mm256_add_pd(_mm256_add_pd(base, pTerm), integral), dTerm);
+				output = _mm256_max_pd(outMin, _mm256_min_pd(outMax, output));
+
+				_mm256_storeu_pd(bank.iTerm + i, integral);
+				_mm256_storeu_pd(bank.prevInput + i, input);
+				_mm256_storeu_pd(bank.prevOutput + i, output);
+				_mm256_storeu_pd(outputs + i, output);
+			}
+			RunPidKernelScalar(bank, i, end, inputs, outputs);
+		}
+
+		__attribute__((target("avx2"))) inline void RunPidKernelAvx2(
+			const PidBankArrays<int32_t> & bank, size_t begin, size_t end, const int32_t * inputs, int32_t * outputs)
+		{
+			const __m256i zero = _mm256_setzero_si256();
+			size_t i = begin;
+			for(; i + 8 <= end; i += 8)
+			{
+				__m256i input = _mm256_loadu_si256((const __m256i *)(inputs + i));
+				__m256i outMin = _mm256_loadu_si256((const __m256i *)(bank.outMin + i));
+				__m256i outMax = _mm256_loadu_si256((const __m256i *)(bank.outMax + i));
+				__m256i error = _mm256_sub_epi32(_mm256_loadu_si256((const __m256i *)(bank.setPoint + i)), input);
+				__m256i pTerm = _mm256_mullo_epi32(_mm256_loadu_si256((const __m256i *)(bank.Zp + i)), error);
+
+				__m256i integral = _mm256_add_epi32(
+					_mm256_loadu_si256((const __m256i *)(bank.iTerm + i)),
+					_mm256_mullo_epi32(_mm256_loadu_si256((const __m256i *)(bank.Zi + i)), error));
+				integral = _mm256_max_epi32(outMin, _mm256_min_epi32(outMax, integral));
+
+				__m256i negZd = _mm256_sub_epi32(zero, _mm256_loadu_si256((const __m256i *)(bank.Zd + i)));
+				__m256i dTerm = _mm256_mullo_epi32(negZd, _mm256_sub_epi32(input, _mm256_loadu_si256((const __m256i *)(bank.prevInput + i))));
+
+				__m256i mask = _mm256_cmpgt_epi32(
+					_mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i *)(bank.accumulate + i))), zero);
+				__m256i base = _mm256_and_si256(mask, _mm256_loadu_si256((const __m256i *)(bank.prevOutput + i)));
+				__m256i output = _mm256_add_epi32(_mm256_add_epi32(_mm256_add_epi32(base, pTerm), integral), dTerm);
+				output = _mm256_max_epi32(outMin, _mm256_min_epi32(outMax, output));
+
+				_mm256_storeu_si256((__m256i *)(bank.iTerm + i), integral);
+				_mm256_storeu_si256((__m256i *)(bank.prevInput + i), input);
+				_mm256_storeu_si256((__m256i *)(bank.prevOutput + i), output);
+				_mm256_storeu_si256((__m256i *)(outputs + i), output);
+			}
+			RunPidKernelScalar(bank, i, end, inputs, outputs);
+		}
+
+		//===============================================================================================//
+		//======================================= AVX-512 KERNELS =======================================//
+		//===============================================================================================//
+
+		// AVX-512F implies FMA, and with optimisation on GCC would fuse the multiplies and adds below into
+		// FMAs, which round differently to Pid::Run(). GCC also gives false -Wmaybe-uninitialized warnings
+		// from inside avx512fintrin.h for the _mm512_min/max calls (the undefined passthrough operand).
+		#if !defined(__clang__)
+			#pragma GCC push_options
+			#pragma GCC optimize("fp-contract=off")
+			#pragma GCC diagnostic push
+			#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+		#endif
+
+		__attribute__((target("avx512f"))) inline void RunPidKernelAvx512(
+			const PidBankArrays<float> & bank, size_t begin, size_t end, const float * inputs, float * outputs)
+		{
+			const __m512i signMask = _mm512_set1_epi32((int32_t)0x80000000);
+			size_t i = begin;
+			for(; i + 16 <= end; i += 16)
+			{
+				__m512 input = _mm512_loadu_ps(inputs + i);
+				__m512 outMin = _mm512_loadu_ps(bank.outMin + i);
+				__m512 outMax = _mm512_loadu_ps(bank.outMax + i);
+				__m512 error = _mm512_sub_ps(_mm512_loadu_ps(bank.setPoint + i), input);
+				__m512 pTerm = _mm512_mul_ps(_mm512_loadu_ps(bank.Zp + i), error);
+
+				__m512 integral = _mm512_add_ps(_mm512_loadu_ps(bank.iTerm + i), _mm512_mul_ps(_mm512_loadu_ps(bank.Zi + i), error));
+				integral = _mm512_max_ps(outMin, _mm512_min_ps(outMax, integral));
+
+				__m512 negZd = _mm512_castsi512_ps(_mm512_xor_si512(_mm512_castps_si512(_mm512_loadu_ps(bank.Zd + i)), signMask));
+				__m512 dTerm = _mm512_mul_ps(negZd, _mm512_sub_ps(input, _mm512_loadu_ps(bank.prevInput + i)));
+
+				__m512i flags = _mm512_cvtepu8_epi32(_mm_loadu_si128((const __m128i *)(bank.accumulate + i)));
+				__m512 base = _mm512_maskz_mov_ps(_mm512_test_epi32_mask(flags, flags), _mm512_loadu_ps(bank.prevOutput + i));
+				__m512 output = _mm512_add_ps(_mm512_add_ps(_mm512_add_ps(base, pTerm), integral), dTerm);
+				output = _mm512_max_ps(outMin, _mm512_min_ps(outMax, output));
+
+				_mm512_storeu_ps(bank.iTerm + i, integral);
+				_mm512_storeu_ps(bank.prevInput + i, input);
+				_mm512_storeu_ps(bank.prevOutput + i, output);
+				_mm512_storeu_ps(outputs + i, output);
+			}
+			RunPidKernelScalar(bank, i, end, inputs, outputs);
+		}
+
+		__attribute__((target("avx512f"))) inline void RunPidKernelAvx512(
+			const PidBankArrays<double> & bank, size_t begin, size_t end, const double * inputs, double * outputs)
+		{
+			const __m512i signMask = _mm512_set1_epi64((int64_t)0x8000000000000000ULL);
+			size_t i = begin;
+			for(; i + 8 <= end; i += 8)
+			{
+				__m512d input = _mm512_loadu_pd(inputs + i);
+				__m512d outMin = _mm512_loadu_pd(bank.outMin + i);
+				__m512d outMax = _mm512_loadu_pd(bank.outMax + i);
+				__m512d error = _mm512_sub_pd(_mm512_loadu_pd(bank.setPoint + i), input);
+				__m512d pTerm = _mm512_mul_pd(_mm512_loadu_pd(bank.Zp + i), error);
+
+				__m512d integral = _mm512_add_pd(_mm512_loadu_pd(bank.iTerm + i), _mm512_mul_pd(_mm512_loadu_pd(bank.Zi + i), error));
+				integral = _mm512_max_pd(outMin, _mm512_min_pd(outMax, integral));
+
+				__m512d negZd = _mm512_castsi512_pd(_mm512_xor_si512(_mm512_castpd_si512(_mm512_loadu_pd(bank.Zd + i)), signMask));
+				__m512d dTerm = _mm512_mul_pd(negZd, _mm512_sub_pd(input, _mm512_loadu_pd(bank.prevInput + i)));
+
+				__m512i flags = _mm512_cvtepu8_epi64(_mm_loadl_epi64((const __m128i *)(bank.accumulate + i)));
+				__m512d base = _mm512_maskz_mov_pd(_mm512_test_epi64_mask(flags, flags), _mm512_loadu_pd(bank.prevOutput + i));
+				__m512d output = _mm512_add_pd(_mm512_add_pd(_mm512_add_pd(base, pTerm), integral), dTerm);
+				output = _mm512_max_pd(outMin, _mm512_min_pd(outMax, output));
+
+				_mm512_storeu_pd(bank.iTerm + i, integral);
+				_mm512_storeu_pd(bank.prevInput + i, input);
+				_mm512_storeu_pd(bank.prevOutput + i, output);
+				_mm512_storeu_pd(outputs + i, output);
+			}
+			RunPidKernelScalar(bank, i, end, inputs, outputs);
+		}
+
+		__attribute__((target("avx512f"))) inline void RunPidKernelAvx512(
+			const PidBankArrays<int32_t> & bank, size_t begin, size_t end, const int32_t * inputs, int32_t * outputs)
+		{
+			const __m512i zero = _mm512_setzero_si512();
+			size_t i = begin;
+			for(; i + 16 <= end; i += 16)
+			{
+				__m512i input = _mm512_loadu_si512(inputs + i);
+				__m512i outMin = _mm512_loadu_si512(bank.outMin + i);
+				__m512i outMax = _mm512_loadu_si512(bank.outMax + i);
+				__m512i error = _mm512_sub_epi32(_mm512_loadu_si512(bank.setPoint + i), input);
+				__m512i pTerm = _mm512_mullo_epi32(_mm512_loadu_si512(bank.Zp + i), error);
+
+				__m512i integral = _mm512_add_epi32(_mm512_loadu_si512(bank.iTerm + i), _mm512_mullo_epi32(_mm512_loadu_si512(bank.Zi + i), error));
+				integral = _mm512_max_epi32(outMin, _mm512_min_epi32(outMax, integral));
+
+				__m512i negZd = _mm512_sub_epi32(zero, _mm512_loadu_si512(bank.Zd + i));
+				__m512i dTerm = _mm512_mullo_epi32(negZd, _mm512_sub_epi32(input, _mm512_loadu_si512(bank.prevInput + i)));
+
+				__m512i flags = _mm512_cvtepu8_epi32(_mm_loadu_si128((const __m128i *)(bank.accumulate + i)));
+				__m512i base = _mm512_maskz_mov_epi32(_mm512_test_epi32_mask(flags, flags), _mm512_loadu_si512(bank.prevOutput + i));
+				__m512i output = _mm512_add_epi32(_mm512_add_epi32(_mm512_add_epi32(base, pTerm), integral), dTerm);
+				output = _mm512_max_epi32(outMin, _mm512_min_epi32(outMax, output));
+
+				_mm512_storeu_si512(bank.iTerm + i, integral);
+				_mm512_storeu_si512(bank.prevInput + i, input);
+				_mm512_storeu_si512(bank.prevOutput + i, output);
+				_mm512_storeu_si512(outputs + i, output);
+			}
+			RunPidKernelScalar(bank, i, end, inputs, outputs);
+		}
+
+		#if !defined(__clang__)
+			#pragma GCC diagnostic pop
+			#pragma GCC pop_options
+		#endif
+
+		//===============================================================================================//
+		//================================= FIXED-POINT SIMD HELPERS ====================================//
+		//===============================================================================================//
+
+		// Each helper saturates like the matching FixedQ operator, and sets every bit of a lane in
+		// overflow if that lane saturated. The kernels turn overflow into one bit per lane with a movemask.
+
+		//! @brief		Saturating 16-bit add.
+		__attribute__((target("sse2"))) inline __m128i AddSat16Sse2(__m128i a, __m128i b, __m128i & overflow)
+		{
+			__m128i sum = _mm_adds_epi16(a, b);
+			overflow = _mm_or_si128(overflow, _mm_andnot_si128(_mm_cmpeq_epi16(sum, _mm_add_epi16(a, b)), _mm_set1_epi32(-1)));
+			return sum;
+		}
+
+		//! @brief		Saturating 16-bit subtract.
+		__attribute__((target("sse2"))) inline __m128i SubSat16Sse2(__m128i a, __m128i b, __m128i & overflow)
+		{
+			__m128i diff = _mm_subs_epi16(a, b);
+			overflow = _mm_or_si128(overflow, _mm_andnot_si128(_mm_cmpeq_epi16(diff, _mm_sub_epi16(a, b)), _mm_set1_epi32(-1)));
+			return diff;
+		}
+
+		//! @brief		Saturating Q-format multiply of 16-bit lanes, (a*b) >> numFracBits.
+		//! @details	The multiply-high and multiply-low halves are joined into full 32-bit products,
+		//!				shifted, and packed back to 16 bits with signed saturation.
+		template <uint8_t numFracBits> __attribute__((target("sse2"))) inline __m128i MulQ16Sse2(__m128i a, __m128i b, __m128i & overflow)
+		{
+			__m128i lo = _mm_mullo_epi16(a, b);
+			__m128i hi = _mm_mulhi_epi16(a, b);
+			__m128i product0 = _mm_srai_epi32(_mm_unpacklo_epi16(lo, hi), numFracBits);
+			__m128i product1 = _mm_srai_epi32(_mm_unpackhi_epi16(lo, hi), numFracBits);
+			__m128i result = _mm_packs_epi32(product0, product1);
+
+			// Saturated where the packed result, sign-extended again, isn't the shifted product
+			__m128i exact = _mm_packs_epi32(
+				_mm_cmpeq_epi32(product0, _mm_srai_epi32(_mm_unpacklo_epi16(result, result), 16)),
+				_mm_cmpeq_epi32(product1, _mm_srai_epi32(_mm_unpackhi_epi16(result, result), 16)));
+			overflow = _mm_or_si128(overflow, _mm_andnot_si128(exact, _mm_set1_epi32(-1)));
+			return result;
+		}
+
+		//! @brief		Saturating 16-bit add.
+		__attribute__((target("avx2"))) inline __m256i AddSat16Avx2(__m256i a, __m256i b, __m256i & overflow)
+		{
+			__m256i sum = _mm256_adds_epi16(a, b);
+			overflow = _mm256_or_si256(overflow, _mm256_andnot_si256(_mm256_cmpeq_epi16(sum, _mm256_add_epi16(a, b)), _mm256_set1_epi32(-1)));
+			return sum;
+		}
+
+		//! @brief		Saturating 16-bit subtract.
+		__attribute__((target("avx2"))) inline __m256i SubSat16Avx2(__m256i a, __m256i b, __m256i & overflow)
+		{
+			__m256i diff = _mm256_subs_epi16(a, b);
+			overflow = _mm256_or_si256(overflow, _mm256_andnot_si256(_mm256_cmpeq_epi16(diff, _mm256_sub_epi16(a, b)), _mm256_set1_epi32(-1)));
+			return diff;
+		}
+
+		//! @brief		Saturating Q-format multiply of 16-bit lanes, the same way as MulQ16Sse2().
+		//! @details	Unpacking and packing both work within 128-bit halves, so the lanes end up back in order.
+		template <uint8_t numFracBits> __attribute__((target("avx2"))) inline __m256i MulQ16Avx2(__m256i a, __m256i b, __m256i & overflow)
+		{
+			__m256i lo = _mm256_mullo_epi16(a, b);
+			__m256i hi = _mm256_mulhi_epi16(a, b);
+			__m256i product0 = _mm256_srai_epi32(_mm256_unpacklo_epi16(lo, hi), numFracBits);
+			__m256i product1 = _mm256_srai_epi32(_mm256_unpackhi_epi16(lo, hi), numFracBits);
+			__m256i result = _mm256_packs_epi32(product0, product1);
+
+			__m256i exact = _mm256_packs_epi32(
+				_mm256_cmpeq_epi32(product0, _mm256_srai_epi32(_mm256_unpacklo_epi16(result, result), 16)),
+				_mm256_cmpeq_epi32(product1, _mm256_srai_epi32(_mm256_unpackhi_epi16(result, result), 16)));
+			overflow = _mm256_or_si256(overflow, _mm256_andnot_si256(exact, _mm256_set1_epi32(-1)));
+			return result;
+		}
+
+		//! @brief		Saturating 32-bit add (x86 has no saturating 32-bit add instruction).
+		__attribute__((target("avx2"))) inline __m256i AddSat32Avx2(__m256i a, __m256i b, __m256i & overflow)
+		{
+			__m256i sum = _mm256_add_epi32(a, b);
+			// Wrapped if a and b have the same sign, and the sum has the other one
+			__m256i wrapped = _mm256_srai_epi32(_mm256_andnot_si256(_mm256_xor_si256(a, b), _mm256_xor_si256(a, sum)), 31);
+			__m256i limit = _mm256_xor_si256(_mm256_srai_epi32(a, 31), _mm256_set1_epi32(INT32_MAX));
+			overflow = _mm256_or_si256(overflow, wrapped);
+			return _mm256_blendv_epi8(sum, limit, wrapped);
+		}
+
+		//! @brief		Saturating 32-bit subtract.
+		__attribute__((target("avx2"))) inline __m256i SubSat32Avx2(__m256i a, __m256i b, __m256i & overflow)
+		{
+			__m256i diff = _mm256_sub_epi32(a, b);
+			// Wrapped if a and b have different signs, and the difference doesn't have a's
+			__m256i wrapped = _mm256_srai_epi32(_mm256_and_si256(_mm256_xor_si256(a, b), _mm256_xor_si256(a, diff)), 31);
+			__m256i limit = _mm256_xor_si256(_mm256_srai_epi32(a, 31), _mm256_set1_epi32(INT32_MAX));
+			overflow = _mm256_or_si256(overflow, wrapped);
+			return _mm256_blendv_epi8(diff, limit, wrapped);
+		}
+
+		//! @brief		Saturating Q-format multiply of 32-bit lanes, (a*b) >> numFracBits.
+		//! @details	The even and odd lanes are multiplied into full 64-bit products. The low 32 bits of
+		//!				the shifted product are the same for logical and arithmetic shifts (AVX2 has no
+		//!				64-bit arithmetic shift), and the product fits if every bit above them matches.
+		template <uint8_t numFracBits> __attribute__((target("avx2"))) inline __m256i MulQ32Avx2(__m256i a, __m256i b, __m256i & overflow)
+		{
+			const __m256i zero = _mm256_setzero_si256();
+			const __m256i topOnes = _mm256_srli_epi64(_mm256_set1_epi32(-1), numFracBits + 31);
+
+			__m256i even = _mm256_mul_epi32(a, b);
+			__m256i odd = _mm256_mul_epi32(_mm256_srli_epi64(a, 32), _mm256_srli_epi64(b, 32));
+			__m256i result = _mm256_blend_epi32(
+				_mm256_srli_epi64(even, numFracBits),
+				_mm256_slli_epi64(_mm256_srli_epi64(odd, numFracBits), 32), 0xAA);
+
+			__m256i evenTop = _mm256_srli_epi64(even, numFracBits + 31);
+			__m256i oddTop = _mm256_srli_epi64(odd, numFracBits + 31);
+			__m256i fits = _mm256_blend_epi32(
+				_mm256_or_si256(_mm256_cmpeq_epi64(evenTop, zero), _mm256_cmpeq_epi64(evenTop, topOnes)),
+				_mm256_or_si256(_mm256_cmpeq_epi64(oddTop, zero), _mm256_cmpeq_epi64(oddTop, topOnes)), 0xAA);
+			__m256i wrapped = _mm256_andnot_si256(fits, _mm256_set1_epi32(-1));
+
+			// A product too big to fit isn't 0, so it has the sign of a^b
+			__m256i limit = _mm256_xor_si256(_mm256_srai_epi32(_mm256_xor_si256(a, b), 31), _mm256_set1_epi32(INT32_MAX));
+			overflow = _mm256_or_si256(overflow, wrapped);
+			return _mm256_blendv_epi8(result, limit, wrapped);
+		}
+
+		//===============================================================================================//
+		//==================================== FIXED-POINT KERNELS ======================================//
+		//===============================================================================================//
+
+		//! @brief		Runs 8 FixedQ<int16_t, numFracBits> controllers per iteration.
+		template <uint8_t numFracBits> __attribute__((target("sse2"))) inline void RunPidKernelQ16Sse2(
+			const PidBankArrays<FixedQ<int16_t, numFracBits>> & bank, size_t begin, size_t end,
+			const FixedQ<int16_t, numFracBits> * inputs, FixedQ<int16_t, numFracBits> * outputs)
+		{
+			static_assert(sizeof(FixedQ<int16_t, numFracBits>) == sizeof(int16_t), "FixedQ must be stored as its raw integer.");
+			const __m128i zero = _mm_setzero_si128();
+			size_t i = begin;
+			for(; i + 8 <= end; i += 8)
+			{
+				__m128i overflow = zero;
+				__m128i input = _mm_loadu_si128((const __m128i *)(inputs + i));
+				__m128i outMin = _mm_loadu_si128((const __m128i *)(bank.outMin + i));
+				__m128i outMax = _mm_loadu_si128((const __m128i *)(bank.outMax + i));
+				__m128i error = SubSat16Sse2(_mm_loadu_si128((const __m128i *)(bank.setPoint + i)), input, overflow);
+				__m128i pTerm = MulQ16Sse2<numFracBits>(_mm_loadu_si128((const __m128i *)(bank.Zp + i)), error, overflow);
+
+				__m128i integral = AddSat16Sse2(
+					_mm_loadu_si128((const __m128i *)(bank.iTerm + i)),
+					MulQ16Sse2<numFracBits>(_mm_loadu_si128((const __m128i *)(bank.Zi + i)), error, overflow), overflow);
+				integral = _mm_max_epi16(outMin, _mm_min_epi16(outMax, integral));
+
+				__m128i negZd = SubSat16Sse2(zero, _mm_loadu_si128((const __m128i *)(bank.Zd + i)), overflow);
+				__m128i inputChange = SubSat16Sse2(input, _mm_loadu_si128((const __m128i *)(bank.prevInput + i)), overflow);
+				__m128i dTerm = MulQ16Sse2<numFracBits>(negZd, inputChange, overflow);
+
+				__m128i mask = _mm_cmpgt_epi16(_mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)(bank.accumulate + i)), zero), zero);
+				__m128i base = _mm_and_si128(mask, _mm_loadu_si128((const __m128i *)(bank.prevOutput + i)));
+				__m128i output = AddSat16Sse2(AddSat16Sse2(AddSat16Sse2(base, pTerm, overflow), integral, overflow), dTerm, overflow);
+				output = _mm_max_epi16(outMin, _mm_min_epi16(outMax, output));
+
+				_mm_storeu_si128((__m128i *)(bank.iTerm + i), integral);
+				_mm_storeu_si128((__m128i *)(bank.prevInput + i), input);
+				_mm_storeu_si128((__m128i *)(bank.prevOutput + i), output);
+				_mm_storeu_si128((__m128i *)(outputs + i), output);
+				MarkOverflow(bank.overflow, i, (uint32_t)_mm_movemask_epi8(_mm_packs_epi16(overflow, zero)));
+			}
+			RunPidKernelScalarQ(bank, i, end, inputs, outputs);
+		}
+
+		//! @brief		Runs 16 FixedQ<int16_t, numFracBits> controllers per iteration.
+		template <uint8_t numFracBits> __attribute__((target("avx2"))) inline void RunPidKernelQ16Avx2(
+			const PidBankArrays<FixedQ<int16_t, numFracBits>> & bank, size_t begin, size_t end,
+			const FixedQ<int16_t, numFracBits> * inputs, FixedQ<int16_t, numFracBits> * outputs)
+		{
+			static_assert(sizeof(FixedQ<int16_t, numFracBits>) == sizeof(int16_t), "FixedQ must be stored as its raw integer.");
+			const __m256i zero = _mm256_setzero_si256();
+			size_t i = begin;
+			for(; i + 16 <= end; i += 16)
+			{
+				__m256i overflow = zero;
+				__m256i input = _mm256_loadu_si256((const __m256i *)(inputs + i));
+				__m256i outMin = _mm256_loadu_si256((const __m256i *)(bank.outMin + i));
+				__m256i outMax = _mm256_loadu_si256((const __m256i *)(bank.outMax + i));
+				__m256i error = SubSat16Avx2(_mm256_loadu_si256((const __m256i *)(bank.setPoint + i)), input, overflow);
+				__m256i pTerm = MulQ16Avx2<numFracBits>(_mm256_loadu_si256((const __m256i *)(bank.Zp + i)), error, overflow);
+
+				__m256i integral = AddSat16Avx2(
+					_mm256_loadu_si256((const __m256i *)(bank.iTerm + i)),
+					MulQ16Avx2<numFracBits>(_mm256_loadu_si256((const __m256i *)(bank.Zi + i)), error, overflow), overflow);
+				integral = _mm256_max_epi16(outMin, _mm256_min_epi16(outMax, integral));
+
+				__m256i negZd = SubSat16Avx2(zero, _mm256_loadu_si256((const __m256i *)(bank.Zd + i)), overflow);
+				__m256i inputChange = SubSat16Avx2(input, _mm256_loadu_si256((const __m256i *)(bank.prevInput + i)), overflow);
+				__m256i dTerm = MulQ16Avx2<numFracBits>(negZd, inputChange, overflow);
+
+				__m256i mask = _mm256_cmpgt_epi16(
+					_mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i *)(bank.accumulate + i))), zero);
+				__m256i base = _mm256_and_si256(mask, _mm256_loadu_si256((const __m256i *)(bank.prevOutput + i)));
+				__m256i output = AddSat16Avx2(AddSat16Avx2(AddSat16Avx2(base, pTerm, overflow), integral, overflow), dTerm, overflow);
+				output = _mm256_max_epi16(outMin, _mm256_min_epi16(outMax, output));
+
+				_mm256_storeu_si256((__m256i *)(bank.iTerm + i), integral);
+				_mm256_storeu_si256((__m256i *)(bank.prevInput + i), input);
+				_mm256_storeu_si256((__m256i *)(bank.prevOutput + i), output);
+				_mm256_storeu_si256((__m256i *)(outputs + i), output);
+
+				// Packing puts lanes 0-7 in bytes 0-7 and lanes 8-15 in bytes 16-23
+				uint32_t bytes = (uint32_t)_mm256_movemask_epi8(_mm256_packs_epi16(overflow, zero));
+				MarkOverflow(bank.overflow, i, (bytes & 0xFF) | ((bytes >> 8) & 0xFF00));
+			}
+			RunPidKernelScalarQ(bank, i, end, inputs, outputs);
+		}
+
+		//! @brief		Runs 8 FixedQ<int32_t, numFracBits> controllers per iteration.
+		template <uint8_t numFracBits> __attribute__((target("avx2"))) inline void RunPidKernelQ32Avx2(
+			const PidBankArrays<FixedQ<int32_t, numFracBits>> & bank, size_t begin, size_t end,
+			const FixedQ<int32_t, numFracBits> * inputs, FixedQ<int32_t, numFracBits> * outputs)
+		{
+			static_assert(sizeof(FixedQ<int32_t, numFracBits>) == sizeof(int32_t), "FixedQ must be stored as its raw integer.");
+			const __m256i zero = _mm256_setzero_si256();
+			size_t i = begin;
+			for(; i + 8 <= end; i += 8)
+			{
+				__m256i overflow = zero;
+				__m256i input = _mm256_loadu_si256((const __m256i *)(inputs + i));
+				__m256i outMin = _mm256_loadu_si256((const __m256i *)(bank.outMin + i));
+				__m256i outMax = _mm256_loadu_si256((const __m256i *)(bank.outMax + i));
+				__m256i error = SubSat32Avx2(_mm256_loadu_si256((const __m256i *)(bank.setPoint + i)), input, overflow);
+				__m256i pTerm = MulQ32Avx2<numFracBits>(_mm256_loadu_si256((const __m256i *)(bank.Zp + i)), error, overflow);
+
+				__m256i integral = AddSat32Avx2(
+					_mm256_loadu_si256((const __m256i *)(bank.iTerm + i)),
+					MulQ32Avx2<numFracBits>(_mm256_loadu_si256((const __m256i *)(bank.Zi + i)), error, overflow), overflow);
+				integral = _mm256_max_epi32(outMin, _mm256_min_epi32(outMax, integral));
+
+				__m256i negZd = SubSat32Avx2(zero, _mm256_loadu_si256((const __m256i *)(bank.Zd + i)), overflow);
+				__m256i inputChange = SubSat32Avx2(input, _mm256_loadu_si256((const __m256i *)(bank.prevInput + i)), overflow);
+				__m256i dTerm = MulQ32Avx2<numFracBits>(negZd, inputChange, overflow);
+
+				__m256i mask = _mm256_cmpgt_epi32(
+					_mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i *)(bank.accumulate + i))), zero);
+				__m256i base = _mm256_and_si256(mask, _mm256_loadu_si256((const __m256i *)(bank.prevOutput + i)));
+				__m256i output = AddSat32Avx2(AddSat32Avx2(AddSat32Avx2(base, pTerm, overflow), integral, overflow), dTerm, overflow);
+				output = _mm256_max_epi32(outMin, _mm256_min_epi32(outMax, output));
+
+				_mm256_storeu_si256((__m256i *)(bank.iTerm + i), integral);
+				_mm256_storeu_si256((__m256i *)(bank.prevInput + i), input);
+				_mm256_storeu_si256((__m256i *)(bank.prevOutput + i), output);
+				_mm256_storeu_si256((__m256i *)(outputs + i), output);
+				MarkOverflow(bank.overflow, i, (uint32_t)_mm256_movemask_ps(_mm256_castsi256_ps(overflow)));
+			}
+			RunPidKernelScalarQ(bank, i, end, inputs, outputs);
+		}
+
+		#endif // #if M_PID_X86_KERNELS
+
+		//===============================================================================================//
+		//========================================= DISPATCH ============================================//
+		//===============================================================================================//
+
+		//! @brief		Picks the kernel for a dataType. Types without SIMD kernels always get the scalar one.
+		template <class dataType> struct PidKernelSelector
+		{
+			static PidKernel<dataType> Select(SimdLevel level)
+			{
+				(void)level;
+				return &RunPidKernelScalar<dataType>;
+			}
+		};
+
+		//! @brief		FixedQ banks use the fixed-point kernel, so they record overflow at every level.
+		template <class baseType, uint8_t numFracBits> struct PidKernelSelector<FixedQ<baseType, numFracBits>>
+		{
+			static PidKernel<FixedQ<baseType, numFracBits>> Select(SimdLevel level)
+			{
+				(void)level;
+				return &RunPidKernelScalarQ<baseType, numFracBits>;
+			}
+		};
+
+		//! @brief		Picks the kernel for a controller's first run, which has no derivative term.
+		//! @details	There are only scalar versions, as a controller is only run for the first time once.
+		template <class dataType> struct PidFirstRunKernelSelector
+		{
+			static PidKernel<dataType> Select()
+			{
+				return &RunPidKernelScalar<dataType, true>;
+			}
+		};
+
+		template <class baseType, uint8_t numFracBits> struct PidFirstRunKernelSelector<FixedQ<baseType, numFracBits>>
+		{
+			static PidKernel<FixedQ<baseType, numFracBits>> Select()
+			{
+				return &RunPidKernelScalarQ<baseType, numFracBits, true>;
+			}
+		};
+
+		#if M_PID_X86_KERNELS
+
+		//! @brief		Kernel selection for the types which have explicit SIMD kernels.
+		template <class dataType> struct PidKernelSelectorSimd
+		{
+			static PidKernel<dataType> Select(SimdLevel level)
+			{
+				switch(level)
+				{
+					case SimdLevel::AVX512:
+						return &RunPidKernelAvx512;
+					case SimdLevel::AVX2:
+						return &RunPidKernelAvx2;
+					case SimdLevel::SSE2:
+						return &RunPidKernelSse2;
+					default:
+						return &RunPidKernelScalar<dataType>;
+				}
+			}
+		};
+
+		template <> struct PidKernelSelector<float> : PidKernelSelectorSimd<float> {};
+		template <> struct PidKernelSelector<double> : PidKernelSelectorSimd<double> {};
+		template <> struct PidKernelSelector<int32_t> : PidKernelSelectorSimd<int32_t> {};
+
+		//! @brief		16-bit fixed-point banks. AVX-512 uses the AVX2 kernel.
+		template <uint8_t numFracBits> struct PidKernelSelector<FixedQ<int16_t, numFracBits>>
+		{
+			static PidKernel<FixedQ<int16_t, numFracBits>> Select(SimdLevel level)
+			{
+				switch(level)
+				{
+					case SimdLevel::AVX512:
+					case SimdLevel::AVX2:
+						return &RunPidKernelQ16Avx2<numFracBits>;
+					case SimdLevel::SSE2:
+						return &RunPidKernelQ16Sse2<numFracBits>;
+					default:
+						return &RunPidKernelScalarQ<int16_t, numFracBits>;
+				}
+			}
+		};
+
+		//! @brief		32-bit fixed-point banks. SSE2 has no signed 32-bit multiply, so it uses the scalar
+		//!				kernel, and AVX-512 uses the AVX2 kernel.
+		template <uint8_t numFracBits> struct PidKernelSelector<FixedQ<int32_t, numFracBits>>
+		{
+			static PidKernel<FixedQ<int32_t, numFracBits>> Select(SimdLevel level)
+			{
+				switch(level)
+				{
+					case SimdLevel::AVX512:
+					case SimdLevel::AVX2:
+						return &RunPidKernelQ32Avx2<numFracBits>;
+					default:
+						return &RunPidKernelScalarQ<int32_t, numFracBits>;
+				}
+			}
+		};
+
+		#endif // #if M_PID_X86_KERNELS
+
+	} // namespace MPidNs
+} // namespace MbeddedNinja
+
+#endif // #ifndef M_PID_PID_KERNELS_H
+
+// EOF
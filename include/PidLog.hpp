@@ -0,0 +1,707 @@
+//!
+//! @file 			PidLog.hpp
+//! @author 		Geoffrey Hunter <gbmhunter@gmail.com> (www.mbedded.ninja)
+//! @edited 		n/a
+//! @created		2026-10-16
+//! @last-modified 	2026-10-16
+//! @brief			Compact binary columnar log of per-tick controller state, and a replay driver for it.
+//! @details
+//!					See README.rst in repo root dir for more info.
+
+#ifndef __cplusplus
+	#error Please build with C++ compiler
+#endif
+
+//===============================================================================================//
+//====================================== HEADER GUARD ===========================================//
+//===============================================================================================//
+
+#ifndef M_PID_PID_LOG_H
+#define M_PID_PID_LOG_H
+
+//===== SYSTEM LIBRARIES =====//
+#include <stdint.h>		// uint16_t, uint32_t, uint64_t
+#include <stddef.h>		// size_t
+#include <stdio.h>		// FILE, fopen(), fwrite()
+#include <string.h>		// memset(), memcmp(), memcpy()
+#include <vector>		// std::vector
+
+//===== USER SOURCE =====//
+#include "FixedQ.hpp"
+#include "MappedFile.hpp"
+#include "Pid.hpp"
+#include "PidBank.hpp"
+
+namespace MbeddedNinja
+{
+	namespace MPidNs
+	{
+
+		//===============================================================================================//
+		//======================================== FILE FORMAT ==========================================//
+		//===============================================================================================//
+
+		// A log is laid out as:
+		//
+		//		PidLogFileHeader								64 bytes
+		//		PidLogControllerConfig[numControllers]			padded to a multiple of 64 bytes
+		//		block 0:
+		//			PidLogBlockHeader							64 bytes
+		//			one column per bit set in columnMask, in bit order, each
+		//			dataType[numTicks][numControllers]			padded to a multiple of 64 bytes
+		//		block 1:
+		//			...
+		//
+		// Values are stored in the byte order of the machine that wrote the log (checked with
+		// byteOrderMark). Every column starts on a 64 byte boundary, so a mapped log can be read in
+		// place with no copying. A partly written last block (e.g. after a crash) is ignored.
+
+		//! @brief		Increment when the layout changes.
+		static const uint16_t pidLogVersion = 1;
+
+		//! @brief		The columns a log can hold (bits of columnMask).
+		enum PidLogColumn
+		{
+			PID_LOG_INPUT		= 1 << 0,		//!< The input passed to Run().
+			PID_LOG_SET_POINT	= 1 << 1,		//!< The set-point at the time of the Run().
+			PID_LOG_OUTPUT		= 1 << 2,		//!< The output calculated by Run().
+			PID_LOG_I_TERM		= 1 << 3,		//!< The (clamped) integral term after Run().
+			PID_LOG_ALL_COLUMNS	= 0xF
+		};
+
+		static const uint32_t pidLogNumColumns = 4;
+
+		struct PidLogFileHeader
+		{
+			char magic[8];					//!< "MPIDLOG" and a null.
+			uint16_t version;				//!< pidLogVersion.
+			uint16_t typeId;				//!< PidLogTypeId of the dataType.
+			uint16_t typeSize;				//!< sizeof(dataType).
+			uint16_t columnMask;			//!< Bitwise OR of PidLogColumn.
+			uint32_t numControllers;
+			uint32_t byteOrderMark;			//!< 0x01020304 in the writer's byte order.
+			uint64_t configOffset;			//!< Offset of the controller configs from the start of the file.
+			uint64_t firstBlockOffset;		//!< Offset of the first block from the start of the file.
+			uint8_t reserved[24];
+		};
+
+		struct PidLogBlockHeader
+		{
+			uint32_t magic;					//!< pidLogBlockMagic.
+			uint32_t numTicks;
+			uint64_t firstTick;				//!< Tick number of the first row in the block.
+			uint64_t blockBytes;			//!< Size of the block, including this header.
+			uint32_t numControllers;
+			uint8_t reserved[36];
+		};
+
+		static const uint32_t pidLogBlockMagic = 0x4B42504D;	// "MPBK"
+		static const uint32_t pidLogByteOrderMark = 0x01020304;
+
+		static_assert(sizeof(PidLogFileHeader) == 64, "PidLogFileHeader must be 64 bytes.");
+		static_assert(sizeof(PidLogBlockHeader) == 64, "PidLogBlockHeader must be 64 bytes.");
+
+		//! @brief		The settings of one controller, recorded when the log is opened, so the log can be
+		//!				replayed without any other configuration.
+		template <class dataType> struct PidLogControllerConfig
+		{
+			dataType kp;
+			dataType ki;
+			dataType kd;
+			dataType outMin;
+			dataType outMax;
+			dataType setPoint;
+			double samplePeriodMs;
+			uint32_t controllerDir;			//!< 0 for PID_DIRECT, 1 for PID_REVERSE.
+			uint32_t outputMode;			//!< 0 for DONT_ACCUMULATE_OUTPUT, 1 for ACCUMULATE_OUTPUT.
+		};
+
+		//! @brief		Identifies the dataType stored in a log, so a log isn't read back as the wrong type.
+		//! @details	Built-in types have small IDs, FixedQ is (ID of base type << 8) | numFracBits.
+		template <class dataType> struct PidLogTypeId;
+		template <> struct PidLogTypeId<float>		{ static const uint16_t value = 1; };
+		template <> struct PidLogTypeId<double>		{ static const uint16_t value = 2; };
+		template <> struct PidLogTypeId<int16_t>	{ static const uint16_t value = 3; };
+		template <> struct PidLogTypeId<int32_t>	{ static const uint16_t value = 4; };
+		template <> struct PidLogTypeId<int64_t>	{ static const uint16_t value = 5; };
+		template <class baseType, uint8_t numFracBits> struct PidLogTypeId<FixedQ<baseType, numFracBits>>
+		{
+			static const uint16_t value = (uint16_t)((PidLogTypeId<baseType>::value << 8) | numFracBits);
+		};
+
+		//! @brief		Reads just the file header of a log, e.g. to find out which dataType it holds.
+		//! @returns	false if the file couldn't be read or isn't a log.
+		inline bool ReadPidLogHeader(const char * path, PidLogFileHeader & header)
+		{
+			FILE * file = fopen(path, "rb");
+			if(!file)
+				return false;
+			bool ok = fread(&header, sizeof(header), 1, file) == 1;
+			fclose(file);
+			return ok && memcmp(header.magic, "MPIDLOG", 8) == 0;
+		}
+
+		//! @brief		Rounds a size up to the next multiple of 64 bytes.
+		inline uint64_t PidLogPad(uint64_t bytes)
+		{
+			return (bytes + 63) & ~(uint64_t)63;
+		}
+
+		//===============================================================================================//
+		//========================================== WRITER =============================================//
+		//===============================================================================================//
+
+		//! @brief		Appends per-tick controller state to a log.
+		//! @details	Ticks are buffered in memory, column by column, and written out one whole block at
+		//!				a time (one fwrite() per column).
+		template <class dataType> class PidLogWriter
+		{
+			public:
+
+				PidLogWriter();
+
+				//! @brief		Closes the log, writing any buffered ticks.
+				~PidLogWriter();
+
+				PidLogWriter(const PidLogWriter &) = delete;
+				PidLogWriter & operator=(const PidLogWriter &) = delete;
+
+				//! @brief		Creates (or overwrites) a log for the controllers in bank.
+				//! @details	The bank's current settings are recorded in the log, so for an exact replay,
+				//!				open the log before the bank is first run and don't re-tune it while logging.
+				//! @param		columnMask		Which columns to record (bitwise OR of PidLogColumn).
+				//! @param		ticksPerBlock	How many ticks are buffered before a block is written.
+				//! @returns	false if the file couldn't be created.
+				bool Open(
+					const char * path,
+					const PidBank<dataType> & bank,
+					uint16_t columnMask = PID_LOG_ALL_COLUMNS,
+					uint32_t ticksPerBlock = 1024);
+
+				//! @brief		Appends one tick. Each array holds one value per controller. Arrays for columns
+				//!				that aren't being recorded are ignored (and can be NULL).
+				void AppendTick(const dataType * inputs, const dataType * setPoints, const dataType * outputs, const dataType * iTerms);
+
+				//! @brief		Appends one tick, taking the set-points, outputs and integral terms from a bank
+				//!				which has just been run with inputs.
+				void AppendTick(const PidBank<dataType> & bank, const dataType * inputs);
+
+				//! @brief		Writes any buffered ticks to the file as a (short) block.
+				//! @returns	false if any write so far has failed.
+				bool Flush();
+
+				//! @brief		Flushes and closes the file.
+				//! @returns	false if any write has failed.
+				bool Close();
+
+				//! @brief		Returns the number of ticks appended so far.
+				uint64_t GetNumTicks() const;
+
+			private:
+
+				//! @brief		Copies one value per controller into the current row of column (if it's being recorded).
+				void BufferColumn(uint32_t column, const dataType * values);
+
+				FILE * file;
+				bool ok;
+				uint32_t numControllers;
+				uint16_t columnMask;
+				uint32_t ticksPerBlock;
+				uint32_t numBufferedTicks;
+				uint64_t numTicks;
+
+				std::vector<dataType> columns[pidLogNumColumns];
+
+				//! @brief		Scratch space for AppendTick(bank, inputs).
+				std::vector<dataType> gathered[pidLogNumColumns];
+		};
+
+		//===============================================================================================//
+		//========================================== READER =============================================//
+		//===============================================================================================//
+
+		//! @brief		One block of a mapped log. The column pointers point straight into the mapping.
+		template <class dataType> struct PidLogBlock
+		{
+			uint64_t firstTick;
+			uint32_t numTicks;
+			uint32_t numControllers;
+
+			//! @brief		Indexed by column bit number. NULL for columns which aren't in the log.
+			const dataType * columns[pidLogNumColumns];
+
+			//! @brief		Returns the values of column for every controller at tick (relative to firstTick),
+			//!				or NULL if the column isn't in the log.
+			const dataType * GetRow(PidLogColumn column, uint32_t tick) const
+			{
+				uint32_t bit = 0;
+				while((1u << bit) != (uint32_t)column)
+					bit++;
+				const dataType * values = this->columns[bit];
+				return values ? values + (size_t)tick*this->numControllers : NULL;
+			}
+		};
+
+		//! @brief		Memory-maps a log and gives zero-copy access to it's blocks.
+		template <class dataType> class PidLogReader
+		{
+			public:
+
+				PidLogReader();
+
+				//! @brief		Maps a log and indexes it's blocks.
+				//! @details	A block that runs past the end of the file (e.g. the writer crashed part way
+				//!				through it) ends the log, and the blocks before it are still read.
+				//! @returns	false if the file can't be mapped, isn't a log, is a different version,
+				//!				holds a different dataType, or has a block whose size doesn't match it's
+				//!				number of ticks.
+				bool Open(const char * path);
+
+				//! @brief		Unmaps the log. Blocks taken from it become invalid.
+				void Close();
+
+				uint32_t GetNumControllers() const;		//!< Returns the number of controllers in the log.
+				uint16_t GetColumnMask() const;			//!< Returns which columns the log holds.
+				uint64_t GetNumTicks() const;			//!< Returns the number of (complete) ticks in the log.
+				size_t GetNumBlocks() const;			//!< Returns the number of (complete) blocks in the log.
+
+				//! @brief		Returns a block. The pointers in it are valid until the log is closed.
+				PidLogBlock<dataType> GetBlock(size_t index) const;
+
+				//! @brief		Returns the settings recorded for a controller when the log was opened.
+				const PidLogControllerConfig<dataType> & GetControllerConfig(size_t index) const;
+
+				//! @brief		Adds every controller in the log to bank, with the recorded settings.
+				void CreateBank(PidBank<dataType> & bank) const;
+
+			private:
+
+				MappedFile file;
+				const PidLogFileHeader * header;
+				const PidLogControllerConfig<dataType> * configs;
+				std::vector<uint64_t> blockOffsets;
+				uint64_t numTicks;
+		};
+
+		//===============================================================================================//
+		//========================================== REPLAY =============================================//
+		//===============================================================================================//
+
+		//! @brief		Result of replaying a log.
+		struct PidLogReplayResult
+		{
+			uint64_t numTicks;				//!< Number of ticks replayed.
+			uint64_t numOutputMismatches;	//!< Outputs which differ from the logged output (0 if the log has no outputs).
+		};
+
+		//! @brief		Feeds every tick of a log into a bank (e.g. one made with PidLogReader::CreateBank()).
+		//! @details	Inputs are read straight out of the mapped log. If the log has set-points they are
+		//!				applied before each tick, and if it has outputs they are compared with the bank's.
+		template <class dataType> PidLogReplayResult ReplayPidLog(const PidLogReader<dataType> & log, PidBank<dataType> & bank);
+
+		//! @brief		Same as ReplayPidLog() for a bank, but calls Run() on an array of Pid objects (one
+		//!				per controller in the log).
+		template <class dataType> PidLogReplayResult ReplayPidLog(const PidLogReader<dataType> & log, Pid<dataType> * pids);
+
+		//===============================================================================================//
+		//============================ TEMPLATE FUNCTION DEFINITIONS ====================================//
+		//===============================================================================================//
+
+		template <class dataType> PidLogWriter<dataType>::PidLogWriter() :
+			file(NULL),
+			ok(false),
+			numControllers(0),
+			columnMask(0),
+			ticksPerBlock(0),
+			numBufferedTicks(0),
+			numTicks(0)
+		{
+		}
+
+		template <class dataType> PidLogWriter<dataType>::~PidLogWriter()
+		{
+			this->Close();
+		}
+
+		template <class dataType> bool PidLogWriter<dataType>::Open(
+			const char * path, const PidBank<dataType> & bank, uint16_t columnMask, uint32_t ticksPerBlock)
+		{
+			this->Close();
+
+			this->file = fopen(path, "wb");
+			if(!this->file)
+				return false;
+
+			this->ok = true;
+			this->numControllers = (uint32_t)bank.Size();
+			this->columnMask = columnMask & PID_LOG_ALL_COLUMNS;
+			this->ticksPerBlock = ticksPerBlock ? ticksPerBlock : 1;
+			this->numBufferedTicks = 0;
+			this->numTicks = 0;
+
+			for(uint32_t c = 0; c < pidLogNumColumns; c++)
+			{
+				this->columns[c].clear();
+				if(this->columnMask & (1u << c))
+					this->columns[c].resize((size_t)this->ticksPerBlock*this->numControllers);
+			}
+
+			uint64_t configBytes = PidLogPad((uint64_t)this->numControllers*sizeof(PidLogControllerConfig<dataType>));
+
+			PidLogFileHeader header;
+			memset(&header, 0, sizeof(header));
+			memcpy(header.magic, "MPIDLOG", 8);
+			header.version = pidLogVersion;
+			header.typeId = PidLogTypeId<dataType>::value;
+			header.typeSize = (uint16_t)sizeof(dataType);
+			header.columnMask = this->columnMask;
+			header.numControllers = this->numControllers;
+			header.byteOrderMark = pidLogByteOrderMark;
+			header.configOffset = sizeof(PidLogFileHeader);
+			header.firstBlockOffset = sizeof(PidLogFileHeader) + configBytes;
+			this->ok = this->ok && fwrite(&header, sizeof(header), 1, this->file) == 1;
+
+			std::vector<uint8_t> configs((size_t)configBytes, 0);
+			for(uint32_t i = 0; i < this->numControllers; i++)
+			{
+				PidLogControllerConfig<dataType> config;
+				memset(&config, 0, sizeof(config));
+				config.kp = bank.GetKp(i);
+				config.ki = bank.GetKi(i);
+				config.kd = bank.GetKd(i);
+				config.outMin = bank.GetOutMin(i);
+				config.outMax = bank.GetOutMax(i);
+				config.setPoint = bank.GetSetPoint(i);
+				config.samplePeriodMs = (double)bank.GetSamplePeriod(i);
+				config.controllerDir = (bank.GetControllerDirection(i) == PidBank<dataType>::ControllerDirection::PID_REVERSE) ? 1 : 0;
+				config.outputMode = (bank.GetOutputMode(i) == PidBank<dataType>::OutputMode::ACCUMULATE_OUTPUT) ? 1 : 0;
+				memcpy(&configs[i*sizeof(config)], &config, sizeof(config));
+			}
+			if(configBytes)
+				this->ok = this->ok && fwrite(configs.data(), configs.size(), 1, this->file) == 1;
+
+			return this->ok;
+		}
+
+		template <class dataType> void PidLogWriter<dataType>::BufferColumn(uint32_t column, const dataType * values)
+		{
+			if(!(this->columnMask & (1u << column)) || this->numControllers == 0)
+				return;
+			memcpy(&this->columns[column][(size_t)this->numBufferedTicks*this->numControllers], values,
+				this->numControllers*sizeof(dataType));
+		}
+
+		template <class dataType> void PidLogWriter<dataType>::AppendTick(
+			const dataType * inputs, const dataType * setPoints, const dataType * outputs, const dataType * iTerms)
+		{
+			if(!this->file)
+				return;
+
+			this->BufferColumn(0, inputs);
+			this->BufferColumn(1, setPoints);
+			this->BufferColumn(2, outputs);
+			this->BufferColumn(3, iTerms);
+
+			this->numTicks++;
+			if(++this->numBufferedTicks == this->ticksPerBlock)
+				this->Flush();
+		}
+
+		template <class dataType> void PidLogWriter<dataType>::AppendTick(const PidBank<dataType> & bank, const dataType * inputs)
+		{
+			for(uint32_t c = 1; c < pidLogNumColumns; c++)
+				this->gathered[c].resize(this->numControllers);
+
+			for(uint32_t i = 0; i < this->numControllers; i++)
+			{
+				this->gathered[1][i] = bank.GetSetPoint(i);
+				this->gathered[2][i] = bank.GetOutput(i);
+				this->gathered[3][i] = bank.GetITerm(i);
+			}
+
+			this->AppendTick(inputs, this->gathered[1].data(), this->gathered[2].data(), this->gathered[3].data());
+		}
+
+		template <class dataType> bool PidLogWriter<dataType>::Flush()
+		{
+			if(!this->file)
+				return false;
+			if(this->numBufferedTicks == 0)
+				return this->ok;
+
+			uint64_t columnBytes = (uint64_t)this->numBufferedTicks*this->numControllers*sizeof(dataType);
+			uint64_t paddedBytes = PidLogPad(columnBytes);
+
+			uint32_t numColumns = 0;
+			for(uint32_t c = 0; c < pidLogNumColumns; c++)
+				if(this->columnMask & (1u << c))
+					numColumns++;
+
+			PidLogBlockHeader header;
+			memset(&header, 0, sizeof(header));
+			header.magic = pidLogBlockMagic;
+			header.numTicks = this->numBufferedTicks;
+			header.firstTick = this->numTicks - this->numBufferedTicks;
+			header.blockBytes = sizeof(PidLogBlockHeader) + numColumns*paddedBytes;
+			header.numControllers = this->numControllers;
+			this->ok = this->ok && fwrite(&header, sizeof(header), 1, this->file) == 1;
+
+			static const uint8_t zeros[64] = {};
+			for(uint32_t c = 0; c < pidLogNumColumns; c++)
+			{
+				if(!(this->columnMask & (1u << c)))
+					continue;
+				if(columnBytes)
+					this->ok = this->ok && fwrite(this->columns[c].data(), (size_t)columnBytes, 1, this->file) == 1;
+				if(paddedBytes != columnBytes)
+					this->ok = this->ok && fwrite(zeros, (size_t)(paddedBytes - columnBytes), 1, this->file) == 1;
+			}
+
+			this->numBufferedTicks = 0;
+			return this->ok;
+		}
+
+		template <class dataType> bool PidLogWriter<dataType>::Close()
+		{
+			if(!this->file)
+				return false;
+			this->Flush();
+			this->ok = (fclose(this->file) == 0) && this->ok;
+			this->file = NULL;
+			return this->ok;
+		}
+
+		template <class dataType> uint64_t PidLogWriter<dataType>::GetNumTicks() const
+		{
+			return this->numTicks;
+		}
+
+		template <class dataType> PidLogReader<dataType>::PidLogReader() :
+			header(NULL),
+			configs(NULL),
+			numTicks(0)
+		{
+		}
+
+		template <class dataType> bool PidLogReader<dataType>::Open(const char * path)
+		{
+			this->Close();
+
+			if(!this->file.Open(path))
+				return false;
+
+			const uint8_t * data = this->file.GetData();
+			uint64_t size = this->file.GetSize();
+			if(size < sizeof(PidLogFileHeader))
+			{
+				this->Close();
+				return false;
+			}
+
+			const PidLogFileHeader * header = reinterpret_cast<const PidLogFileHeader *>(data);
+			uint64_t configBytes = (uint64_t)header->numControllers*sizeof(PidLogControllerConfig<dataType>);
+			if(memcmp(header->magic, "MPIDLOG", 8) != 0 ||
+				header->version != pidLogVersion ||
+				header->byteOrderMark != pidLogByteOrderMark ||
+				header->typeId != PidLogTypeId<dataType>::value ||
+				header->typeSize != sizeof(dataType) ||
+				header->configOffset + configBytes > size ||
+				header->firstBlockOffset > size)
+			{
+				this->Close();
+				return false;
+			}
+
+			this->header = header;
+			this->configs = reinterpret_cast<const PidLogControllerConfig<dataType> *>(data + header->configOffset);
+
+			uint32_t numColumns = 0;
+			for(uint32_t c = 0; c < pidLogNumColumns; c++)
+				if(header->columnMask & (1u << c))
+					numColumns++;
+
+			// Walk the block headers. Only the headers are touched, not the columns.
+			uint64_t offset = header->firstBlockOffset;
+			while(offset + sizeof(PidLogBlockHeader) <= size)
+			{
+				const PidLogBlockHeader * block = reinterpret_cast<const PidLogBlockHeader *>(data + offset);
+				if(block->magic != pidLogBlockMagic ||
+					block->numControllers != header->numControllers ||
+					block->blockBytes < sizeof(PidLogBlockHeader) ||
+					offset + block->blockBytes > size)
+					break;
+
+				// GetBlock() finds the columns from numTicks, so it must agree with blockBytes, or the
+				// columns would run past the block (and the mapping). Checked against the file size
+				// first, so the multiply can't overflow.
+				uint64_t numValues = (uint64_t)block->numTicks*block->numControllers;
+				if(numValues > size/sizeof(dataType) ||
+					block->blockBytes != sizeof(PidLogBlockHeader) + numColumns*PidLogPad(numValues*sizeof(dataType)))
+				{
+					this->Close();
+					return false;
+				}
+
+				this->blockOffsets.push_back(offset);
+				this->numTicks += block->numTicks;
+				offset += block->blockBytes;
+			}
+
+			return true;
+		}
+
+		template <class dataType> void PidLogReader<dataType>::Close()
+		{
+			this->file.Close();
+			this->header = NULL;
+			this->configs = NULL;
+			this->blockOffsets.clear();
+			this->numTicks = 0;
+		}
+
+		template <class dataType> uint32_t PidLogReader<dataType>::GetNumControllers() const
+		{
+			return this->header ? this->header->numControllers : 0;
+		}
+
+		template <class dataType> uint16_t PidLogReader<dataType>::GetColumnMask() const
+		{
+			return this->header ? this->header->columnMask : 0;
+		}
+
+		template <class dataType> uint64_t PidLogReader<dataType>::GetNumTicks() const
+		{
+			return this->numTicks;
+		}
+
+		template <class dataType> size_t PidLogReader<dataType>::GetNumBlocks() const
+		{
+			return this->blockOffsets.size();
+		}
+
+		template <class dataType> PidLogBlock<dataType> PidLogReader<dataType>::GetBlock(size_t index) const
+		{
+			const uint8_t * start = this->file.GetData() + this->blockOffsets[index];
+			const PidLogBlockHeader * blockHeader = reinterpret_cast<const PidLogBlockHeader *>(start);
+
+			PidLogBlock<dataType> block;
+			block.firstTick = blockHeader->firstTick;
+			block.numTicks = blockHeader->numTicks;
+			block.numControllers = blockHeader->numControllers;
+
+			uint64_t paddedBytes = PidLogPad((uint64_t)block.numTicks*block.numControllers*sizeof(dataType));
+			const uint8_t * column = start + sizeof(PidLogBlockHeader);
+			for(uint32_t c = 0; c < pidLogNumColumns; c++)
+			{
+				if(this->header->columnMask & (1u << c))
+				{
+					block.columns[c] = reinterpret_cast<const dataType *>(column);
+					column += paddedBytes;
+				}
+				else
+					block.columns[c] = NULL;
+			}
+			return block;
+		}
+
+		template <class dataType>
+		const PidLogControllerConfig<dataType> & PidLogReader<dataType>::GetControllerConfig(size_t index) const
+		{
+			return this->configs[index];
+		}
+
+		template <class dataType> void PidLogReader<dataType>::CreateBank(PidBank<dataType> & bank) const
+		{
+			typedef typename PidBank<dataType>::ControllerDirection ControllerDirection;
+			typedef typename PidBank<dataType>::OutputMode OutputMode;
+			typedef typename PidBank<dataType>::samplePeriodType samplePeriodType;
+
+			bank.Reserve(bank.Size() + this->GetNumControllers());
+			for(uint32_t i = 0; i < this->GetNumControllers(); i++)
+			{
+				const PidLogControllerConfig<dataType> & config = this->configs[i];
+				bank.Add(
+					config.kp,
+					config.ki,
+					config.kd,
+					config.controllerDir ? ControllerDirection::PID_REVERSE : ControllerDirection::PID_DIRECT,
+					config.outputMode ? OutputMode::ACCUMULATE_OUTPUT : OutputMode::DONT_ACCUMULATE_OUTPUT,
+					(samplePeriodType)config.samplePeriodMs,
+					config.outMin,
+					config.outMax,
+					config.setPoint);
+			}
+		}
+
+		template <class dataType> PidLogReplayResult ReplayPidLog(const PidLogReader<dataType> & log, PidBank<dataType> & bank)
+		{
+			PidLogReplayResult result;
+			result.numTicks = 0;
+			result.numOutputMismatches = 0;
+
+			const uint32_t numControllers = log.GetNumControllers();
+			if(!(log.GetColumnMask() & PID_LOG_INPUT) || bank.Size() != numControllers)
+				return result;
+
+			std::vector<dataType> outputs(numControllers);
+			for(size_t b = 0; b < log.GetNumBlocks(); b++)
+			{
+				PidLogBlock<dataType> block = log.GetBlock(b);
+				for(uint32_t t = 0; t < block.numTicks; t++)
+				{
+					const dataType * setPoints = block.GetRow(PID_LOG_SET_POINT, t);
+					if(setPoints)
+						for(uint32_t i = 0; i < numControllers; i++)
+							bank.SetSetPoint(i, setPoints[i]);
+
+					bank.RunAll(block.GetRow(PID_LOG_INPUT, t), outputs.data());
+
+					const dataType * logged = block.GetRow(PID_LOG_OUTPUT, t);
+					if(logged)
+						for(uint32_t i = 0; i < numControllers; i++)
+							if(!(outputs[i] == logged[i]))
+								result.numOutputMismatches++;
+				}
+				result.numTicks += block.numTicks;
+			}
+			return result;
+		}
+
+		template <class dataType> PidLogReplayResult ReplayPidLog(const PidLogReader<dataType> & log, Pid<dataType> * pids)
+		{
+			PidLogReplayResult result;
+			result.numTicks = 0;
+			result.numOutputMismatches = 0;
+
+			const uint32_t numControllers = log.GetNumControllers();
+			if(!(log.GetColumnMask() & PID_LOG_INPUT))
+				return result;
+
+			for(size_t b = 0; b < log.GetNumBlocks(); b++)
+			{
+				PidLogBlock<dataType> block = log.GetBlock(b);
+				for(uint32_t t = 0; t < block.numTicks; t++)
+				{
+					const dataType * inputs = block.GetRow(PID_LOG_INPUT, t);
+					const dataType * setPoints = block.GetRow(PID_LOG_SET_POINT, t);
+					const dataType * logged = block.GetRow(PID_LOG_OUTPUT, t);
+					for(uint32_t i = 0; i < numControllers; i++)
+					{
+						if(setPoints)
+							pids[i].setPoint = setPoints[i];
+						pids[i].Run(inputs[i]);
+						if(logged && !(pids[i].output == logged[i]))
+							result.numOutputMismatches++;
+					}
+				}
+				result.numTicks += block.numTicks;
+			}
+			return result;
+		}
+
+	} // namespace MPidNs
+} // namespace MbeddedNinja
+
+#endif // #ifndef M_PID_PID_LOG_H
+
+// EOF
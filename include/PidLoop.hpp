@@ -0,0 +1,423 @@
+//!
+//! @file 			PidLoop.hpp
+//! @author 		Geoffrey Hunter <gbmhunter@gmail.com> (www.mbedded.ninja)
+//! @edited 		n/a
+//! @created		2026-10-16
+//! @last-modified 	2026-10-16
+//! @brief			Runs controllers at a fixed period, and measures how well the period is kept.
+//! @details
+//!					See README.rst in repo root dir for more info.
+
+#ifndef __cplusplus
+	#error Please build with C++ compiler
+#endif
+
+//===============================================================================================//
+//====================================== HEADER GUARD ===========================================//
+//===============================================================================================//
+
+#ifndef M_PID_PID_LOOP_H
+#define M_PID_PID_LOOP_H
+
+//===== SYSTEM LIBRARIES =====//
+#include <stdint.h>		// uint64_t
+#include <stddef.h>		// size_t
+#include <stdio.h>		// fopen(), fgets(), snprintf()
+#include <string.h>		// memset()
+#include <atomic>		// std::atomic
+#include <chrono>		// std::chrono::steady_clock
+#include <string>		// std::string
+#include <thread>		// std::thread
+#include <vector>		// std::vector
+
+#if defined(__linux__)
+	#include <errno.h>		// EINTR
+	#include <pthread.h>	// pthread_setschedparam()
+	#include <sched.h>		// SCHED_FIFO
+	#include <sys/mman.h>	// mlockall()
+	#include <time.h>		// clock_nanosleep(), clock_gettime()
+#endif
+
+//===== USER SOURCE =====//
+#include "CpuAffinity.hpp"
+#include "LogHistogram.hpp"
+
+namespace MbeddedNinja
+{
+	namespace MPidNs
+	{
+
+		//! @brief		How a PidLoop runs.
+		struct PidLoopSettings
+		{
+			double periodMs;		//!< The period, normally the sample period the controllers were created with.
+			bool realTime;			//!< Run the loop thread with SCHED_FIFO.
+			int priority;			//!< SCHED_FIFO priority, 1 to 99.
+			bool lockMemory;		//!< mlockall() the process and pre-fault the loop thread's stack, so ticks never page fault.
+			int cpu;				//!< Pin the loop thread to this CPU. -1 doesn't pin.
+
+			explicit PidLoopSettings(double periodMs) :
+				periodMs(periodMs), realTime(false), priority(80), lockMemory(false), cpu(-1)
+			{
+			}
+		};
+
+		//! @brief		Timing of a PidLoop, as returned by PidLoop::GetStats(). All times are in nanoseconds.
+		struct PidLoopStats
+		{
+			LogHistogramSnapshot wakeLatencyNs;		//!< How late each tick woke up, after it's deadline.
+			LogHistogramSnapshot computeNs;			//!< How long each call to the tick function took.
+			LogHistogramSnapshot overrunNs;			//!< For each missed deadline, how far past it the tick finished.
+			uint64_t numTicks;						//!< Ticks run.
+			uint64_t numMisses;						//!< Ticks which finished after the next tick's deadline.
+			uint64_t numSkipped;					//!< Periods skipped to get back in phase after misses.
+		};
+
+		//! @brief		Returns hints on what could stop the given CPU (-1 for any) from running a real-time
+		//!				loop on time. Empty if nothing was found.
+		//! @details	Checks the kernel's isolated CPUs and nohz_full list, the CPU frequency governor, and
+		//!				real-time throttling. Linux only.
+		inline std::vector<std::string> GetRealTimeHints(int cpu);
+
+		//===============================================================================================//
+		//===================================== CLASS DEFINITION ========================================//
+		//===============================================================================================//
+
+		//! @brief		Calls a tick function once per period, and records when each tick woke and how long it took.
+		//! @details	The loop sleeps with clock_nanosleep() until an absolute deadline on CLOCK_MONOTONIC,
+		//!				and each deadline is the last plus the period, so errors don't build up. The time from
+		//!				each deadline to the thread actually waking is the wake-up jitter. A tick which
+		//!				finishes after the next deadline is a miss: the loop then skips the deadlines it has
+		//!				already passed (rather than running a burst of late ticks) so it stays in phase.
+		//!
+		//!				The loop thread can run with SCHED_FIFO, be pinned to a CPU, and lock the process in
+		//!				memory. None of these are required: if one fails (usually for lack of permissions)
+		//!				the loop still runs, and GetHints() says what failed, along with GetRealTimeHints().
+		//!				Other platforms sleep with std::this_thread::sleep_until().
+		class PidLoop
+		{
+			public:
+
+				//! @brief		Called once per period. tick counts from 0.
+				typedef void (*TickFunction)(void * context, uint64_t tick);
+
+				explicit PidLoop(const PidLoopSettings & settings);
+
+				//! @brief		Stops the loop thread, if Start() was called.
+				~PidLoop();
+
+				PidLoop(const PidLoop &) = delete;
+				PidLoop & operator=(const PidLoop &) = delete;
+
+				//! @brief		Sets up the calling thread, then runs the loop on it.
+				//! @param		numTicks	Ticks to run. 0 runs until Stop() is called.
+				void Run(TickFunction function, void * context, uint64_t numTicks = 0);
+
+				//! @brief		Runs the loop on a new thread, until Stop() is called. Returns once the thread is set up.
+				void Start(TickFunction function, void * context);
+
+				//! @brief		Stops the loop after the current tick, and joins the thread if Start() made one.
+				void Stop();
+
+				//! @brief		Returns the timing so far. Safe to call from any thread.
+				PidLoopStats GetStats() const;
+
+				//! @brief		Zeroes the timing. Don't call while the loop is running.
+				void ResetStats();
+
+				//! @brief		Returns the settings which failed to apply, and GetRealTimeHints() for the loop's CPU.
+				//! @details	Filled in when the loop thread is set up.
+				const std::vector<std::string> & GetHints() const;
+
+				bool IsRealTime() const;		//!< Returns true if the loop thread got SCHED_FIFO.
+				bool IsMemoryLocked() const;	//!< Returns true if mlockall() succeeded.
+				bool IsPinned() const;			//!< Returns true if the loop thread was pinned to settings.cpu.
+
+			private:
+
+				//! @brief		Applies the settings to the calling thread, and fills in hints.
+				void SetUpThread();
+
+				//! @brief		Returns CLOCK_MONOTONIC (or steady_clock) in nanoseconds.
+				static uint64_t NowNs();
+
+				//! @brief		Sleeps until the absolute time deadlineNs on the same clock as NowNs().
+				static void SleepUntil(uint64_t deadlineNs);
+
+				PidLoopSettings settings;
+				uint64_t periodNs;
+
+				std::vector<std::string> hints;
+				bool realTime;
+				bool memoryLocked;
+				bool pinned;
+
+				std::thread thread;
+				std::atomic<bool> stop;
+				std::atomic<bool> setUp;
+
+				LogHistogram wakeLatencyNs;
+				LogHistogram computeNs;
+				LogHistogram overrunNs;
+				std::atomic<uint64_t> numTicks;
+				std::atomic<uint64_t> numMisses;
+				std::atomic<uint64_t> numSkipped;
+		};
+
+		//===============================================================================================//
+		//=================================== FUNCTION DEFINITIONS ======================================//
+		//===============================================================================================//
+
+		//! @brief		Reads the first line of a file, without the newline. Empty if it can't be read.
+		inline std::string ReadFirstLine(const char * path)
+		{
+			std::string text;
+			FILE * file = fopen(path, "r");
+			if(!file)
+				return text;
+			char line[4096];
+			if(fgets(line, sizeof(line), file))
+				text = line;
+			fclose(file);
+			while(!text.empty() && (text[text.size() - 1] == '\n' || text[text.size() - 1] == '\r'))
+				text.erase(text.size() - 1);
+			return text;
+		}
+
+		inline std::vector<std::string> GetRealTimeHints(int cpu)
+		{
+			std::vector<std::string> hints;
+			#if defined(__linux__)
+				char text[256];
+				if(cpu >= 0)
+				{
+					std::vector<size_t> isolated = ParseCpuList(ReadFirstLine("/sys/devices/system/cpu/isolated").c_str());
+					bool isIsolated = false;
+					for(size_t i = 0; i < isolated.size(); i++)
+						isIsolated = isIsolated || (isolated[i] == (size_t)cpu);
+					if(!isIsolated)
+					{
+						snprintf(text, sizeof(text), "CPU %d is not isolated. Add isolcpus=%d to the kernel command line.", cpu, cpu);
+						hints.push_back(text);
+					}
+
+					if(ReadFirstLine("/proc/cmdline").find("nohz_full=") == std::string::npos)
+					{
+						snprintf(text, sizeof(text), "The scheduler tick still runs on CPU %d. Add nohz_full=%d rcu_nocbs=%d to the kernel command line.", cpu, cpu, cpu);
+						hints.push_back(text);
+					}
+
+					snprintf(text, sizeof(text), "/sys/devices/system/cpu/cpu%d/cpufreq/scaling_governor", cpu);
+					std::string governor = ReadFirstLine(text);
+					if(!governor.empty() && governor != "performance")
+					{
+						snprintf(text, sizeof(text), "CPU %d uses the '%s' frequency governor, so compute time varies with load. Use 'performance'.", cpu, governor.c_str());
+						hints.push_back(text);
+					}
+				}
+
+				std::string runtime = ReadFirstLine("/proc/sys/kernel/sched_rt_runtime_us");
+				if(!runtime.empty() && runtime != "-1")
+				{
+					snprintf(text, sizeof(text), "Real-time throttling is on (sched_rt_runtime_us = %s), so a SCHED_FIFO loop which overruns can be paused.", runtime.c_str());
+					hints.push_back(text);
+				}
+			#else
+				(void)cpu;
+			#endif
+			return hints;
+		}
+
+		inline PidLoop::PidLoop(const PidLoopSettings & settings) :
+			settings(settings),
+			periodNs((uint64_t)(settings.periodMs*1.0e6)),
+			realTime(false),
+			memoryLocked(false),
+			pinned(false),
+			stop(false),
+			setUp(false),
+			numTicks(0),
+			numMisses(0),
+			numSkipped(0)
+		{
+			if(this->periodNs == 0)
+				this->periodNs = 1;
+		}
+
+		inline PidLoop::~PidLoop()
+		{
+			this->Stop();
+		}
+
+		inline void PidLoop::Run(TickFunction function, void * context, uint64_t numTicks)
+		{
+			this->stop.store(false, std::memory_order_relaxed);
+			this->SetUpThread();
+
+			uint64_t deadline = NowNs() + this->periodNs;
+			for(uint64_t tick = 0; numTicks == 0 || tick < numTicks; tick++)
+			{
+				if(this->stop.load(std::memory_order_relaxed))
+					break;
+
+				SleepUntil(deadline);
+				uint64_t woke = NowNs();
+				this->wakeLatencyNs.Record(woke > deadline ? woke - deadline : 0);
+
+				function(context, tick);
+
+				uint64_t done = NowNs();
+				this->computeNs.Record(done - woke);
+				this->numTicks.store(this->numTicks.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+
+				deadline += this->periodNs;
+				if(done > deadline)
+				{
+					this->overrunNs.Record(done - deadline);
+					this->numMisses.store(this->numMisses.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+
+					// Get back in phase, rather than running the missed ticks back-to-back
+					uint64_t numBehind = (done - deadline)/this->periodNs + 1;
+					deadline += numBehind*this->periodNs;
+					this->numSkipped.store(this->numSkipped.load(std::memory_order_relaxed) + numBehind, std::memory_order_relaxed);
+				}
+			}
+		}
+
+		inline void PidLoop::Start(TickFunction function, void * context)
+		{
+			this->setUp.store(false, std::memory_order_relaxed);
+			this->thread = std::thread(&PidLoop::Run, this, function, context, (uint64_t)0);
+
+			// So GetHints() and the Is...() functions are ready when this returns
+			while(!this->setUp.load(std::memory_order_acquire))
+				std::this_thread::yield();
+		}
+
+		inline void PidLoop::Stop()
+		{
+			this->stop.store(true, std::memory_order_relaxed);
+			if(this->thread.joinable())
+				this->thread.join();
+		}
+
+		inline PidLoopStats PidLoop::GetStats() const
+		{
+			PidLoopStats stats;
+			stats.wakeLatencyNs = this->wakeLatencyNs.GetSnapshot();
+			stats.computeNs = this->computeNs.GetSnapshot();
+			stats.overrunNs = this->overrunNs.GetSnapshot();
+			stats.numTicks = this->numTicks.load(std::memory_order_relaxed);
+			stats.numMisses = this->numMisses.load(std::memory_order_relaxed);
+			stats.numSkipped = this->numSkipped.load(std::memory_order_relaxed);
+			return stats;
+		}
+
+		inline void PidLoop::ResetStats()
+		{
+			this->wakeLatencyNs.Reset();
+			this->computeNs.Reset();
+			this->overrunNs.Reset();
+			this->numTicks.store(0, std::memory_order_relaxed);
+			this->numMisses.store(0, std::memory_order_relaxed);
+			this->numSkipped.store(0, std::memory_order_relaxed);
+		}
+
+		inline const std::vector<std::string> & PidLoop::GetHints() const
+		{
+			return this->hints;
+		}
+
+		inline bool PidLoop::IsRealTime() const
+		{
+			return this->realTime;
+		}
+
+		inline bool PidLoop::IsMemoryLocked() const
+		{
+			return this->memoryLocked;
+		}
+
+		inline bool PidLoop::IsPinned() const
+		{
+			return this->pinned;
+		}
+
+		inline void PidLoop::SetUpThread()
+		{
+			this->hints.clear();
+
+			if(this->settings.cpu >= 0)
+			{
+				this->pinned = PinCurrentThreadToCpu((size_t)this->settings.cpu);
+				if(!this->pinned)
+					this->hints.push_back("Could not pin the loop thread to CPU " + std::to_string(this->settings.cpu) + ".");
+			}
+
+			#if defined(__linux__)
+				if(this->settings.lockMemory)
+				{
+					this->memoryLocked = (mlockall(MCL_CURRENT | MCL_FUTURE) == 0);
+					if(this->memoryLocked)
+					{
+						// Fault the stack in now, rather than on the first deep call in a tick
+						volatile char stack[64*1024];
+						for(size_t i = 0; i < sizeof(stack); i += 4096)
+							stack[i] = 0;
+					}
+					else
+						this->hints.push_back("mlockall() failed. It needs CAP_IPC_LOCK, or a big enough memlock limit (ulimit -l).");
+				}
+
+				if(this->settings.realTime)
+				{
+					struct sched_param param;
+					memset(&param, 0, sizeof(param));
+					param.sched_priority = this->settings.priority;
+					this->realTime = (pthread_setschedparam(pthread_self(), SCHED_FIFO, &param) == 0);
+					if(!this->realTime)
+						this->hints.push_back("SCHED_FIFO was refused. It needs CAP_SYS_NICE, or an rtprio limit (ulimit -r).");
+				}
+			#else
+				if(this->settings.lockMemory)
+					this->hints.push_back("Memory locking is only supported on Linux.");
+				if(this->settings.realTime)
+					this->hints.push_back("SCHED_FIFO is only supported on Linux.");
+			#endif
+
+			std::vector<std::string> systemHints = GetRealTimeHints(this->settings.cpu);
+			this->hints.insert(this->hints.end(), systemHints.begin(), systemHints.end());
+
+			this->setUp.store(true, std::memory_order_release);
+		}
+
+		inline uint64_t PidLoop::NowNs()
+		{
+			#if defined(__linux__)
+				struct timespec now;
+				clock_gettime(CLOCK_MONOTONIC, &now);
+				return (uint64_t)now.tv_sec*1000000000ull + (uint64_t)now.tv_nsec;
+			#else
+				return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+					std::chrono::steady_clock::now().time_since_epoch()).count();
+			#endif
+		}
+
+		inline void PidLoop::SleepUntil(uint64_t deadlineNs)
+		{
+			#if defined(__linux__)
+				struct timespec deadline;
+				deadline.tv_sec = (time_t)(deadlineNs/1000000000ull);
+				deadline.tv_nsec = (long)(deadlineNs%1000000000ull);
+				while(clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &deadline, NULL) == EINTR) {}
+			#else
+				std::this_thread::sleep_until(std::chrono::steady_clock::time_point(std::chrono::nanoseconds(deadlineNs)));
+			#endif
+		}
+
+	} // namespace MPidNs
+} // namespace MbeddedNinja
+
+#endif // #ifndef M_PID_PID_LOOP_H
+
+// EOF
@@ -0,0 +1,287 @@
+//!
+//! @file 			PidScheduler.hpp
+//! @author 		Geoffrey Hunter <gbmhunter@gmail.com> (www.mbedded.ninja)
+//! @edited 		n/a
+//! @created		2026-10-16
+//! @last-modified 	2026-10-16
+//! @brief			Runs many controllers with different sample periods from one base tick.
+//! @details
+//!					See README.rst in repo root dir for more info.
+
+#ifndef __cplusplus
+	#error Please build with C++ compiler
+#endif
+
+//===============================================================================================//
+//====================================== HEADER GUARD ===========================================//
+//===============================================================================================//
+
+#ifndef M_PID_PID_SCHEDULER_H
+#define M_PID_PID_SCHEDULER_H
+
+//===== SYSTEM LIBRARIES =====//
+#include <stdint.h>		// uint32_t, uint64_t, int32_t
+#include <stddef.h>		// size_t
+#include <vector>		// std::vector
+
+//===== USER SOURCE =====//
+#include "Pid.hpp"
+
+namespace MbeddedNinja
+{
+	namespace MPidNs
+	{
+
+		//===============================================================================================//
+		//===================================== CLASS DEFINITION ========================================//
+		//===============================================================================================//
+
+		//! @brief		Multi-rate scheduler for Pid controllers.
+		//! @details	Controllers are registered with their sample period, and grouped with every other
+		//!				controller that has the same period. Each group is a timer in a hierarchical timing
+		//!				wheel (4 levels of 64 slots). Tick() is called once per base tick; it only visits the
+		//!				slot that is due (plus an occasional cascade from a higher level), so the cost per tick
+		//!				depends on the number of controllers which are due, not the number registered.
+		//!				A group with a period of N ticks runs on every tick which is a multiple of N.
+		template <class dataType> class PidScheduler
+		{
+			public:
+
+				//! @brief		The longest supported sample period, in base ticks (64^4 - 1).
+				static const uint32_t maxPeriodTicks = (1u << 24) - 1;
+
+				//! @param		baseTickMs		The period (in milliseconds) at which Tick() will be called.
+				PidScheduler(uint32_t baseTickMs);
+
+				//! @brief		Registers a controller.
+				//! @param		pid				The controller. Must outlive the scheduler (or be unregistered).
+				//! @param		input			Where to read the controller's input from when it is run.
+				//! @param		samplePeriodMs	How often to run the controller. Should match the sample
+				//!								period the controller was created with.
+				//! @returns	false if samplePeriodMs is not a (non-zero) multiple of the base tick, or too long.
+				bool Register(Pid<dataType> * pid, const dataType * input, uint32_t samplePeriodMs);
+
+				//! @brief		Removes a controller.
+				//! @returns	false if the controller was not registered.
+				bool Unregister(Pid<dataType> * pid);
+
+				//! @brief		Runs every controller which is due on this tick, then advances to the next tick.
+				void Tick();
+
+				//! @brief		Returns the number of times Tick() has been called.
+				uint64_t GetTickCount() const;
+
+				//! @brief		Returns the number of distinct sample periods (groups).
+				size_t GetNumGroups() const;
+
+				//! @brief		Returns the number of registered controllers.
+				size_t GetNumRegistered() const;
+
+				//! @brief		Returns the number of controllers run by the last call to Tick().
+				size_t GetNumRunLastTick() const;
+
+			private:
+
+				static const uint32_t slotBits = 6;
+				static const uint32_t numSlots = 1u << slotBits;
+				static const uint32_t slotMask = numSlots - 1;
+				static const uint32_t numLevels = 4;
+
+				//! @brief		A controller and where to get it's input from.
+				struct Entry
+				{
+					Pid<dataType> * pid;
+					const dataType * input;
+				};
+
+				//! @brief		All the controllers which share a sample period.
+				struct RateGroup
+				{
+					uint32_t periodTicks;			//!< Sample period, in base ticks.
+					uint64_t expiry;				//!< The tick the group next runs on.
+					int32_t next;					//!< Next group in the same wheel slot, or -1.
+					std::vector<Entry> entries;		//!< Stored contiguously, run in order.
+				};
+
+				//! @brief		Adds a group to the wheel slot for it's expiry.
+				void Insert(int32_t groupIndex);
+
+				//! @brief		Moves every group in a higher level slot down towards level 0.
+				void Cascade(uint32_t level);
+
+				uint32_t baseTickMs;
+				uint64_t now;
+				size_t numRegistered;
+				size_t numRunLastTick;
+
+				std::vector<RateGroup> groups;
+
+				//! @brief		Head of the list of groups in each slot (index into groups), or -1.
+				int32_t slots[numLevels][numSlots];
+		};
+
+		//===============================================================================================//
+		//============================ TEMPLATE FUNCTION DEFINITIONS ====================================//
+		//===============================================================================================//
+
+		template <class dataType> PidScheduler<dataType>::PidScheduler(uint32_t baseTickMs) :
+			baseTickMs(baseTickMs),
+			now(0),
+			numRegistered(0),
+			numRunLastTick(0)
+		{
+			for(uint32_t level = 0; level < numLevels; level++)
+				for(uint32_t slot = 0; slot < numSlots; slot++)
+					this->slots[level][slot] = -1;
+		}
+
+		template <class dataType> bool PidScheduler<dataType>::Register(
+			Pid<dataType> * pid, const dataType * input, uint32_t samplePeriodMs)
+		{
+			if(this->baseTickMs == 0 || samplePeriodMs == 0 || samplePeriodMs % this->baseTickMs != 0)
+				return false;
+
+			uint32_t periodTicks = samplePeriodMs/this->baseTickMs;
+			if(periodTicks > maxPeriodTicks)
+				return false;
+
+			Entry entry;
+			entry.pid = pid;
+			entry.input = input;
+
+			for(size_t i = 0; i < this->groups.size(); i++)
+			{
+				if(this->groups[i].periodTicks == periodTicks)
+				{
+					this->groups[i].entries.push_back(entry);
+					this->numRegistered++;
+					return true;
+				}
+			}
+
+			// First controller with this period, create a group which runs on the next multiple of it
+			RateGroup group;
+			group.periodTicks = periodTicks;
+			group.expiry = ((this->now + periodTicks - 1)/periodTicks)*periodTicks;
+			group.next = -1;
+			group.entries.push_back(entry);
+			this->groups.push_back(group);
+			this->numRegistered++;
+
+			this->Insert((int32_t)this->groups.size() - 1);
+			return true;
+		}
+
+		template <class dataType> bool PidScheduler<dataType>::Unregister(Pid<dataType> * pid)
+		{
+			for(size_t i = 0; i < this->groups.size(); i++)
+			{
+				std::vector<Entry> & entries = this->groups[i].entries;
+				for(size_t j = 0; j < entries.size(); j++)
+				{
+					if(entries[j].pid == pid)
+					{
+						// Empty groups are left in the wheel, they cost one visit per period
+						entries.erase(entries.begin() + j);
+						this->numRegistered--;
+						return true;
+					}
+				}
+			}
+			return false;
+		}
+
+		template <class dataType> void PidScheduler<dataType>::Tick()
+		{
+			// When a level wraps, bring the groups in the next level's current slot down
+			if(this->now != 0 && (this->now & slotMask) == 0)
+			{
+				for(uint32_t level = 1; level < numLevels; level++)
+				{
+					this->Cascade(level);
+					if(((this->now >> (slotBits*level)) & slotMask) != 0)
+						break;
+				}
+			}
+
+			uint32_t slot = (uint32_t)(this->now & slotMask);
+			int32_t groupIndex = this->slots[0][slot];
+			this->slots[0][slot] = -1;
+
+			size_t numRun = 0;
+			while(groupIndex != -1)
+			{
+				RateGroup & group = this->groups[groupIndex];
+				int32_t next = group.next;
+
+				const Entry * entries = group.entries.data();
+				size_t numEntries = group.entries.size();
+				for(size_t i = 0; i < numEntries; i++)
+					entries[i].pid->Run(*entries[i].input);
+				numRun += numEntries;
+
+				group.expiry += group.periodTicks;
+				this->Insert(groupIndex);
+
+				groupIndex = next;
+			}
+
+			this->numRunLastTick = numRun;
+			this->now++;
+		}
+
+		template <class dataType> void PidScheduler<dataType>::Insert(int32_t groupIndex)
+		{
+			RateGroup & group = this->groups[groupIndex];
+			uint64_t delta = group.expiry - this->now;
+
+			// The lowest level whose span covers the delay
+			uint32_t level = 0;
+			while(level < numLevels - 1 && delta >= ((uint64_t)1 << (slotBits*(level + 1))))
+				level++;
+
+			uint32_t slot = (uint32_t)((group.expiry >> (slotBits*level)) & slotMask);
+			group.next = this->slots[level][slot];
+			this->slots[level][slot] = groupIndex;
+		}
+
+		template <class dataType> void PidScheduler<dataType>::Cascade(uint32_t level)
+		{
+			uint32_t slot = (uint32_t)((this->now >> (slotBits*level)) & slotMask);
+			int32_t groupIndex = this->slots[level][slot];
+			this->slots[level][slot] = -1;
+
+			while(groupIndex != -1)
+			{
+				int32_t next = this->groups[groupIndex].next;
+				this->Insert(groupIndex);
+				groupIndex = next;
+			}
+		}
+
+		template <class dataType> uint64_t PidScheduler<dataType>::GetTickCount() const
+		{
+			return this->now;
+		}
+
+		template <class dataType> size_t PidScheduler<dataType>::GetNumGroups() const
+		{
+			return this->groups.size();
+		}
+
+		template <class dataType> size_t PidScheduler<dataType>::GetNumRegistered() const
+		{
+			return this->numRegistered;
+		}
+
+		template <class dataType> size_t PidScheduler<dataType>::GetNumRunLastTick() const
+		{
+			return this->numRunLastTick;
+		}
+
+	} // namespace MPidNs
+} // namespace MbeddedNinja
+
+#endif // #ifndef M_PID_PID_SCHEDULER_H
+
+// EOF
@@ -0,0 +1,519 @@
+//!
+//! @file 			PidShards.hpp
+//! @author 		Geoffrey Hunter <gbmhunter@gmail.com> (www.mbedded.ninja)
+//! @edited 		n/a
+//! @created		2026-10-16
+//! @last-modified 	2026-10-17
+//! @brief			Splits a population of controllers into NUMA-local shards, each owned by a pinned worker.
+//! @details
+//!					See README.rst in repo root dir for more info.
+
+#ifndef __cplusplus
+	#error Please build with C++ compiler
+#endif
+
+//===============================================================================================//
+//====================================== HEADER GUARD ===========================================//
+//===============================================================================================//
+
+#ifndef M_PID_PID_SHARDS_H
+#define M_PID_PID_SHARDS_H
+
+//===== SYSTEM LIBRARIES =====//
+#include <stdint.h>		// uint32_t, uint64_t
+#include <stddef.h>		// size_t
+#include <algorithm>	// std::sort(), std::upper_bound()
+#include <atomic>		// std::atomic
+#include <chrono>		// std::chrono::steady_clock
+#include <thread>		// std::thread
+#include <utility>		// std::pair
+#include <vector>		// std::vector
+
+//===== USER SOURCE =====//
+#include "CpuAffinity.hpp"
+#include "PidBank.hpp"
+#include "SpinWaiter.hpp"
+
+namespace MbeddedNinja
+{
+	namespace MPidNs
+	{
+
+		//===============================================================================================//
+		//===================================== CLASS DEFINITION ========================================//
+		//===============================================================================================//
+
+		//! @brief		Throughput of the shards on one NUMA node, as returned by PidShards::GetNodeStats().
+		struct PidNodeStats
+		{
+			size_t node;				//!< NUMA node ID.
+			size_t numShards;			//!< Number of shards (and workers) on the node.
+			size_t numControllers;		//!< Number of controllers in those shards.
+			uint64_t numRuns;			//!< Controller runs since the last ResetStats().
+			uint64_t busyNs;			//!< Time the node's workers spent running controllers, summed over the workers.
+
+			//! @brief		Controller runs per second of worker time. Compare nodes with this to spot one
+			//!				which is slowed down by remote memory.
+			double GetRunsPerWorkerSecond() const
+			{
+				return this->busyNs ? (double)this->numRuns*1e9/(double)this->busyNs : 0.0;
+			}
+		};
+
+		//! @brief		A population of controllers split into shards, each a PidBank owned by one worker thread.
+		//! @details	Each worker is pinned to a CPU, and builds it's own shard (the PidBank and the
+		//!				shard's input and output buffers), so the pages are first touched, and therefore
+		//!				placed, on that CPU's NUMA node. After that the worker is the only thread that runs
+		//!				the shard, so the controller state never crosses between sockets. Shards never steal
+		//!				from each other (unlike PidExecutor), as that would bring the remote traffic back.
+		//!
+		//!				Controllers are given global indexes in the order they are added, and each shard owns
+		//!				a contiguous range of them. Shards are ordered by node, so each node also owns a
+		//!				contiguous range. Sensor code should write inputs straight into
+		//!				GetShardInputs(shard) and call Tick(), so the inputs are local too. RunAll() takes
+		//!				global arrays instead, at the cost of reading them from whichever node they are on.
+		//!
+		//!				First-touch placement needs the default (local) memory policy, and pinning to work.
+		//!				Without pinning the results are still correct, just not necessarily local.
+		//!
+		//!				Idle workers, and the thread waiting in Tick() or RunAll(), spin for a few
+		//!				microseconds and then block (see SpinWaiter). Ticks which follow each other closely
+		//!				are handed over without a system call. After a longer gap each tick pays for waking
+		//!				the workers, but idle workers leave their CPUs free.
+		template <class dataType> class PidShards
+		{
+			public:
+
+				//===============================================================================================//
+				//=================================== PUBLIC TYPEDEFS ===========================================//
+				//===============================================================================================//
+
+				typedef typename PidBank<dataType>::ControllerDirection ControllerDirection;
+				typedef typename PidBank<dataType>::OutputMode OutputMode;
+				typedef typename PidBank<dataType>::samplePeriodType samplePeriodType;
+
+				//! @param		numShards		Number of shards, each with it's own worker thread. 0 uses one per
+				//!								allowed CPU. Fewer shards than CPUs are spread evenly over the
+				//!								CPUs (and so over the nodes).
+				//! @param		pinWorkers		Pin each worker thread to it's CPU.
+				PidShards(size_t numShards = 0, bool pinWorkers = true);
+
+				//! @brief		Stops and joins the worker threads.
+				~PidShards();
+
+				PidShards(const PidShards &) = delete;
+				PidShards & operator=(const PidShards &) = delete;
+
+				//! @brief		Adds a controller. Parameters are identical to those of the Pid constructor.
+				//! @details	The controller only takes part once Build() has been called.
+				//! @returns	The global index of the new controller.
+				size_t Add(
+					dataType kp,
+					dataType ki,
+					dataType kd,
+					ControllerDirection controllerDir,
+					OutputMode outputMode,
+					samplePeriodType samplePeriodMs,
+					dataType minOutput,
+					dataType maxOutput,
+					dataType setPoint);
+
+				//! @brief		Splits the added controllers into shards, and has each worker build it's own.
+				//! @details	Calling this again rebuilds every shard, which resets every controller.
+				void Build();
+
+				//! @brief		Returns the number of controllers in the shards (those added before the last Build()).
+				size_t Size() const;
+
+				//! @brief		Runs every shard once, on it's own input buffer, writing it's own output buffer.
+				void Tick();
+
+				//! @brief		Runs every shard once, with inputs and outputs in global arrays of Size() elements.
+				//! @details	Same result as PidBank::RunAll() with the same controllers.
+				void RunAll(const dataType * inputs, dataType * outputs);
+
+				size_t GetNumShards() const;		//!< Returns the number of shards.
+				size_t GetNumNodes() const;			//!< Returns the number of NUMA nodes the shards are spread over.
+
+				size_t GetShardOf(size_t index) const;		//!< Returns the shard that owns the controller with global index.
+				size_t GetShardBegin(size_t shard) const;	//!< Returns the global index of the shard's first controller.
+				size_t GetShardSize(size_t shard) const;	//!< Returns the number of controllers in the shard.
+				size_t GetShardCpu(size_t shard) const;		//!< Returns the CPU the shard's worker runs on.
+				size_t GetShardNode(size_t shard) const;	//!< Returns the NUMA node the shard's memory is on.
+
+				//! @brief		Returns the shard's input buffer (GetShardSize() elements, in global index order),
+				//!				which Tick() reads.
+				dataType * GetShardInputs(size_t shard);
+
+				//! @brief		Returns the shard's output buffer, which Tick() writes.
+				const dataType * GetShardOutputs(size_t shard) const;
+
+				//! @brief		Returns the shard's bank, for re-tuning. Bank indexes are relative to GetShardBegin().
+				PidBank<dataType> & GetShardBank(size_t shard);
+
+				//! @brief		Writes the input of the controller with global index into it's shard's input buffer.
+				void SetInput(size_t index, dataType input);
+
+				//! @brief		Returns the output of the controller with global index from the last Tick() or RunAll().
+				dataType GetOutput(size_t index) const;
+
+				//! @brief		Returns the throughput of each node, in ascending node order.
+				//! @details	Call between ticks.
+				std::vector<PidNodeStats> GetNodeStats() const;
+
+				//! @brief		Zeroes the run counts and busy times.
+				void ResetStats();
+
+			private:
+
+				//! @brief		The controller settings given to Add(), kept until Build() deals them out.
+				struct Settings
+				{
+					dataType kp;
+					dataType ki;
+					dataType kd;
+					ControllerDirection controllerDir;
+					OutputMode outputMode;
+					samplePeriodType samplePeriodMs;
+					dataType minOutput;
+					dataType maxOutput;
+					dataType setPoint;
+				};
+
+				//! @brief		Everything a worker owns. Allocated by the worker itself.
+				struct Shard
+				{
+					PidBank<dataType> bank;
+					std::vector<dataType> inputs;
+					std::vector<dataType> outputs;
+					uint64_t numRuns;
+					uint64_t busyNs;
+				};
+
+				//! @brief		What the workers do when generation is bumped.
+				enum class Job
+				{
+					BUILD,
+					TICK,
+					RUN_ALL
+				};
+
+				//! @brief		Body of each worker thread.
+				void WorkerLoop(size_t shardIndex);
+
+				//! @brief		Starts job on every worker, and waits for them all to finish (a per-tick barrier).
+				void Dispatch(Job job);
+
+				//! @brief		Builds a shard. Called by the shard's worker.
+				void BuildShard(size_t shardIndex);
+
+				//! @brief		Runs a shard and times it. Called by the shard's worker.
+				void RunShard(size_t shardIndex, const dataType * inputs, dataType * outputs);
+
+				std::vector<Settings> settings;
+				std::vector<Shard *> shards;
+				std::vector<size_t> shardBegin;		//!< Global index of each shard's first controller, then Size().
+				std::vector<size_t> shardCpu;
+				std::vector<size_t> shardNode;
+				std::vector<std::thread> threads;
+
+				//===== CURRENT JOB (written by Dispatch() before generation is bumped) =====//
+
+				Job job;
+				const dataType * globalInputs;
+				dataType * globalOutputs;
+
+				//! @brief		Bumped by Dispatch() to start a job.
+				std::atomic<uint32_t> generation;
+
+				//! @brief		Number of workers still working on the current job.
+				std::atomic<size_t> numActive;
+
+				std::atomic<bool> stop;
+
+				//! @brief		Idle workers wait on this for generation to be bumped. They spin briefly,
+				//!				then block, so a PidShards between ticks doesn't keep every CPU busy.
+				SpinWaiter workersWaiter;
+
+				//! @brief		Dispatch() waits on this for numActive to reach 0.
+				SpinWaiter dispatchWaiter;
+		};
+
+		//===============================================================================================//
+		//============================ TEMPLATE FUNCTION DEFINITIONS ====================================//
+		//===============================================================================================//
+
+		template <class dataType> PidShards<dataType>::PidShards(size_t numShards, bool pinWorkers) :
+			job(Job::TICK),
+			globalInputs(NULL),
+			globalOutputs(NULL),
+			generation(0),
+			numActive(0),
+			stop(false)
+		{
+			// Sort the allowed CPUs by node, so shards on the same node sit next to each other
+			std::vector<size_t> cpus = GetAllowedCpus();
+			std::vector<size_t> nodes = GetCpuNodes(cpus);
+			std::vector<std::pair<size_t, size_t>> byNode;
+			for(size_t i = 0; i < cpus.size(); i++)
+				byNode.push_back(std::make_pair(nodes[i], cpus[i]));
+			std::sort(byNode.begin(), byNode.end());
+
+			if(numShards == 0)
+				numShards = byNode.size();
+			for(size_t s = 0; s < numShards; s++)
+			{
+				// Spread evenly when there are fewer shards than CPUs, and wrap around when there are more
+				size_t c = (numShards <= byNode.size()) ? s*byNode.size()/numShards : s % byNode.size();
+				this->shardNode.push_back(byNode[c].first);
+				this->shardCpu.push_back(byNode[c].second);
+			}
+
+			this->shards.resize(numShards, NULL);
+			this->shardBegin.resize(numShards + 1, 0);
+
+			for(size_t s = 0; s < numShards; s++)
+			{
+				this->threads.push_back(std::thread(&PidShards::WorkerLoop, this, s));
+				if(pinWorkers)
+					PinThreadToCpu(this->threads.back(), this->shardCpu[s]);
+			}
+
+			// Start with empty shards, so every other function works before the first real Build()
+			this->Build();
+		}
+
+		template <class dataType> PidShards<dataType>::~PidShards()
+		{
+			this->stop.store(true, std::memory_order_relaxed);
+			this->generation.fetch_add(1, std::memory_order_release);
+			this->workersWaiter.Notify();
+			for(size_t i = 0; i < this->threads.size(); i++)
+				this->threads[i].join();
+			for(size_t s = 0; s < this->shards.size(); s++)
+				delete this->shards[s];
+		}
+
+		template <class dataType> size_t PidShards<dataType>::Add(
+			dataType kp,
+			dataType ki,
+			dataType kd,
+			ControllerDirection controllerDir,
+			OutputMode outputMode,
+			samplePeriodType samplePeriodMs,
+			dataType minOutput,
+			dataType maxOutput,
+			dataType setPoint)
+		{
+			Settings controller = { kp, ki, kd, controllerDir, outputMode, samplePeriodMs, minOutput, maxOutput, setPoint };
+			this->settings.push_back(controller);
+			return this->settings.size() - 1;
+		}
+
+		template <class dataType> void PidShards<dataType>::Build()
+		{
+			size_t numShards = this->shards.size();
+			for(size_t s = 0; s <= numShards; s++)
+				this->shardBegin[s] = s*this->settings.size()/numShards;
+			this->Dispatch(Job::BUILD);
+		}
+
+		template <class dataType> size_t PidShards<dataType>::Size() const
+		{
+			return this->shardBegin.back();
+		}
+
+		template <class dataType> void PidShards<dataType>::Tick()
+		{
+			this->Dispatch(Job::TICK);
+		}
+
+		template <class dataType> void PidShards<dataType>::RunAll(const dataType * inputs, dataType * outputs)
+		{
+			this->globalInputs = inputs;
+			this->globalOutputs = outputs;
+			this->Dispatch(Job::RUN_ALL);
+		}
+
+		template <class dataType> size_t PidShards<dataType>::GetNumShards() const
+		{
+			return this->shards.size();
+		}
+
+		template <class dataType> size_t PidShards<dataType>::GetNumNodes() const
+		{
+			std::vector<size_t> nodes = this->shardNode;
+			std::sort(nodes.begin(), nodes.end());
+			return std::unique(nodes.begin(), nodes.end()) - nodes.begin();
+		}
+
+		template <class dataType> size_t PidShards<dataType>::GetShardOf(size_t index) const
+		{
+			// The last shard whose first controller is at or before index (empty shards are skipped over)
+			return std::upper_bound(this->shardBegin.begin(), this->shardBegin.end() - 1, index) - this->shardBegin.begin() - 1;
+		}
+
+		template <class dataType> size_t PidShards<dataType>::GetShardBegin(size_t shard) const
+		{
+			return this->shardBegin[shard];
+		}
+
+		template <class dataType> size_t PidShards<dataType>::GetShardSize(size_t shard) const
+		{
+			return this->shardBegin[shard + 1] - this->shardBegin[shard];
+		}
+
+		template <class dataType> size_t PidShards<dataType>::GetShardCpu(size_t shard) const
+		{
+			return this->shardCpu[shard];
+		}
+
+		template <class dataType> size_t PidShards<dataType>::GetShardNode(size_t shard) const
+		{
+			return this->shardNode[shard];
+		}
+
+		template <class dataType> dataType * PidShards<dataType>::GetShardInputs(size_t shard)
+		{
+			return this->shards[shard]->inputs.data();
+		}
+
+		template <class dataType> const dataType * PidShards<dataType>::GetShardOutputs(size_t shard) const
+		{
+			return this->shards[shard]->outputs.data();
+		}
+
+		template <class dataType> PidBank<dataType> & PidShards<dataType>::GetShardBank(size_t shard)
+		{
+			return this->shards[shard]->bank;
+		}
+
+		template <class dataType> void PidShards<dataType>::SetInput(size_t index, dataType input)
+		{
+			size_t shard = this->GetShardOf(index);
+			this->shards[shard]->inputs[index - this->shardBegin[shard]] = input;
+		}
+
+		template <class dataType> dataType PidShards<dataType>::GetOutput(size_t index) const
+		{
+			size_t shard = this->GetShardOf(index);
+			return this->shards[shard]->bank.GetOutput(index - this->shardBegin[shard]);
+		}
+
+		template <class dataType> std::vector<PidNodeStats> PidShards<dataType>::GetNodeStats() const
+		{
+			std::vector<PidNodeStats> stats;
+			for(size_t s = 0; s < this->shards.size(); s++)
+			{
+				size_t n = 0;
+				while(n < stats.size() && stats[n].node != this->shardNode[s])
+					n++;
+				if(n == stats.size())
+				{
+					PidNodeStats node = { this->shardNode[s], 0, 0, 0, 0 };
+					stats.push_back(node);
+				}
+				stats[n].numShards++;
+				stats[n].numControllers += this->GetShardSize(s);
+				if(this->shards[s])
+				{
+					stats[n].numRuns += this->shards[s]->numRuns;
+					stats[n].busyNs += this->shards[s]->busyNs;
+				}
+			}
+			return stats;
+		}
+
+		template <class dataType> void PidShards<dataType>::ResetStats()
+		{
+			for(size_t s = 0; s < this->shards.size(); s++)
+			{
+				if(this->shards[s])
+				{
+					this->shards[s]->numRuns = 0;
+					this->shards[s]->busyNs = 0;
+				}
+			}
+		}
+
+		template <class dataType> void PidShards<dataType>::Dispatch(Job job)
+		{
+			this->job = job;
+			this->numActive.store(this->shards.size(), std::memory_order_relaxed);
+			this->generation.fetch_add(1, std::memory_order_release);
+			this->workersWaiter.Notify();
+
+			// Barrier
+			this->dispatchWaiter.Wait([this]() { return this->numActive.load(std::memory_order_acquire) == 0; });
+		}
+
+		template <class dataType> void PidShards<dataType>::WorkerLoop(size_t shardIndex)
+		{
+			uint32_t seenGeneration = 0;
+			for(;;)
+			{
+				this->workersWaiter.Wait([this, seenGeneration]() {
+					return this->generation.load(std::memory_order_acquire) != seenGeneration; });
+				seenGeneration = this->generation.load(std::memory_order_acquire);
+
+				if(this->stop.load(std::memory_order_relaxed))
+					return;
+
+				Shard * shard = this->shards[shardIndex];
+				size_t begin = this->shardBegin[shardIndex];
+				switch(this->job)
+				{
+					case Job::BUILD:
+						this->BuildShard(shardIndex);
+						break;
+					case Job::TICK:
+						this->RunShard(shardIndex, shard->inputs.data(), shard->outputs.data());
+						break;
+					case Job::RUN_ALL:
+						this->RunShard(shardIndex, this->globalInputs + begin, this->globalOutputs + begin);
+						break;
+				}
+				// The last worker to finish wakes Dispatch()
+				if(this->numActive.fetch_sub(1, std::memory_order_release) == 1)
+					this->dispatchWaiter.Notify();
+			}
+		}
+
+		template <class dataType> void PidShards<dataType>::BuildShard(size_t shardIndex)
+		{
+			delete this->shards[shardIndex];
+
+			// Everything below is allocated and first written by this (pinned) thread
+			size_t begin = this->shardBegin[shardIndex];
+			size_t end = this->shardBegin[shardIndex + 1];
+			Shard * shard = new Shard();
+			shard->bank.Reserve(end - begin);
+			for(size_t i = begin; i < end; i++)
+			{
+				const Settings & c = this->settings[i];
+				shard->bank.Add(c.kp, c.ki, c.kd, c.controllerDir, c.outputMode, c.samplePeriodMs, c.minOutput, c.maxOutput, c.setPoint);
+			}
+			shard->inputs.assign(end - begin, dataType(0));
+			shard->outputs.assign(end - begin, dataType(0));
+			shard->numRuns = 0;
+			shard->busyNs = 0;
+			this->shards[shardIndex] = shard;
+		}
+
+		template <class dataType> void PidShards<dataType>::RunShard(
+			size_t shardIndex, const dataType * inputs, dataType * outputs)
+		{
+			Shard * shard = this->shards[shardIndex];
+			std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+			shard->bank.RunAll(inputs, outputs);
+			shard->busyNs += std::chrono::duration_cast<std::chrono::nanoseconds>(
+				std::chrono::steady_clock::now() - start).count();
+			shard->numRuns += shard->bank.Size();
+		}
+
+	} // namespace MPidNs
+} // namespace MbeddedNinja
+
+#endif // #ifndef M_PID_PID_SHARDS_H
+
+// EOF
@@ -0,0 +1,228 @@
+//!
+//! @file 			PidTrace.hpp
+//! @author 		Geoffrey Hunter <gbmhunter@gmail.com> (www.mbedded.ninja)
+//! @edited 		n/a
+//! @created		2026-10-16
+//! @last-modified 	2026-10-16
+//! @brief			Binary trace records of Pid::Run() calls, and a background thread that drains them.
+//! @details
+//!					See README.rst in repo root dir for more info.
+
+#ifndef __cplusplus
+	#error Please build with C++ compiler
+#endif
+
+//===============================================================================================//
+//====================================== HEADER GUARD ===========================================//
+//===============================================================================================//
+
+#ifndef M_PID_PID_TRACE_H
+#define M_PID_PID_TRACE_H
+
+//===== SYSTEM LIBRARIES =====//
+#include <stdint.h>		// uint32_t
+#include <stddef.h>		// size_t
+#include <atomic>		// std::atomic
+#include <chrono>		// std::chrono::microseconds
+#include <mutex>		// std::mutex, std::lock_guard
+#include <thread>		// std::thread
+#include <vector>		// std::vector
+
+//===== USER SOURCE =====//
+#include "SpscRing.hpp"
+
+namespace MbeddedNinja
+{
+	namespace MPidNs
+	{
+
+		//! @brief		Saturation flags in PidTraceRecord::flags.
+		enum PidTraceFlags
+		{
+			PID_TRACE_I_TERM_AT_MAX = 1 << 0,		//!< Integral term is at the maximum output.
+			PID_TRACE_I_TERM_AT_MIN = 1 << 1,		//!< Integral term is at the minimum output.
+			PID_TRACE_OUTPUT_AT_MAX = 1 << 2,		//!< Output is at the maximum output.
+			PID_TRACE_OUTPUT_AT_MIN = 1 << 3		//!< Output is at the minimum output.
+		};
+
+		//! @brief		Everything calculated by one call to Pid::Run().
+		template <class dataType> struct PidTraceRecord
+		{
+			uint32_t tick;			//!< How many times the controller had been run before this call.
+			uint32_t flags;			//!< Bitwise OR of PidTraceFlags.
+			dataType input;
+			dataType error;
+			dataType pTerm;
+			dataType iTerm;
+			dataType dTerm;
+			dataType output;
+		};
+
+		//! @brief		The ring a Pid pushes it's trace records into.
+		template <class dataType> using PidTraceRing = SpscRing<PidTraceRecord<dataType>>;
+
+		//! @brief		Returns the saturation flags for a set of terms.
+		template <class dataType> uint32_t GetPidTraceFlags(dataType iTerm, dataType output, dataType outMin, dataType outMax)
+		{
+			uint32_t flags = 0;
+			if(!(iTerm < outMax))
+				flags |= PID_TRACE_I_TERM_AT_MAX;
+			if(!(iTerm > outMin))
+				flags |= PID_TRACE_I_TERM_AT_MIN;
+			if(!(output < outMax))
+				flags |= PID_TRACE_OUTPUT_AT_MAX;
+			if(!(output > outMin))
+				flags |= PID_TRACE_OUTPUT_AT_MIN;
+			return flags;
+		}
+
+		//===============================================================================================//
+		//===================================== CLASS DEFINITION ========================================//
+		//===============================================================================================//
+
+		//! @brief		Drains the trace rings of any number of controllers on a background thread.
+		//! @details	Records are passed to the sink function on the consumer thread, so the sink can
+		//!				format, log or store them without affecting the controllers' timing.
+		template <class dataType> class PidTraceConsumer
+		{
+			public:
+
+				//! @brief		Called once for each record drained.
+				//! @param		ringId		The ID the ring was added with.
+				typedef void (*SinkFunction)(void * context, size_t ringId, const PidTraceRecord<dataType> & record);
+
+				//! @param		pollPeriodUs	How long the thread sleeps when every ring is empty.
+				PidTraceConsumer(SinkFunction sink, void * context, uint32_t pollPeriodUs = 1000);
+
+				//! @brief		Stops the thread, after draining every ring.
+				~PidTraceConsumer();
+
+				PidTraceConsumer(const PidTraceConsumer &) = delete;
+				PidTraceConsumer & operator=(const PidTraceConsumer &) = delete;
+
+				//! @brief		Adds a ring to drain. Can be called while the thread is running.
+				void AddRing(PidTraceRing<dataType> * ring, size_t ringId);
+
+				//! @brief		Starts the background thread.
+				void Start();
+
+				//! @brief		Stops the background thread, after draining every ring.
+				void Stop();
+
+				//! @brief		Drains every ring once, on the calling thread.
+				//! @details	Use this instead of Start() to drain from your own thread. Don't do both.
+				//! @returns	The number of records drained.
+				size_t Drain();
+
+				//! @brief		Returns the total number of records drained so far.
+				uint64_t GetNumDrained() const;
+
+			private:
+
+				//! @brief		Body of the background thread.
+				void ThreadLoop();
+
+				struct RingEntry
+				{
+					PidTraceRing<dataType> * ring;
+					size_t id;
+				};
+
+				SinkFunction sink;
+				void * context;
+				uint32_t pollPeriodUs;
+
+				//! @brief		Protects rings. Only ever taken by AddRing() and the consumer, never by a producer.
+				std::mutex ringsMutex;
+				std::vector<RingEntry> rings;
+
+				std::thread thread;
+				std::atomic<bool> running;
+				std::atomic<uint64_t> numDrained;
+		};
+
+		//===============================================================================================//
+		//============================ TEMPLATE FUNCTION DEFINITIONS ====================================//
+		//===============================================================================================//
+
+		template <class dataType> PidTraceConsumer<dataType>::PidTraceConsumer(
+			SinkFunction sink, void * context, uint32_t pollPeriodUs) :
+				sink(sink),
+				context(context),
+				pollPeriodUs(pollPeriodUs),
+				running(false),
+				numDrained(0)
+		{
+		}
+
+		template <class dataType> PidTraceConsumer<dataType>::~PidTraceConsumer()
+		{
+			this->Stop();
+		}
+
+		template <class dataType> void PidTraceConsumer<dataType>::AddRing(PidTraceRing<dataType> * ring, size_t ringId)
+		{
+			RingEntry entry;
+			entry.ring = ring;
+			entry.id = ringId;
+
+			std::lock_guard<std::mutex> lock(this->ringsMutex);
+			this->rings.push_back(entry);
+		}
+
+		template <class dataType> void PidTraceConsumer<dataType>::Start()
+		{
+			if(this->running.load(std::memory_order_relaxed))
+				return;
+			this->running.store(true, std::memory_order_relaxed);
+			this->thread = std::thread(&PidTraceConsumer::ThreadLoop, this);
+		}
+
+		template <class dataType> void PidTraceConsumer<dataType>::Stop()
+		{
+			if(!this->running.load(std::memory_order_relaxed))
+				return;
+			this->running.store(false, std::memory_order_relaxed);
+			this->thread.join();
+			this->Drain();
+		}
+
+		template <class dataType> size_t PidTraceConsumer<dataType>::Drain()
+		{
+			std::lock_guard<std::mutex> lock(this->ringsMutex);
+
+			size_t count = 0;
+			PidTraceRecord<dataType> record;
+			for(size_t i = 0; i < this->rings.size(); i++)
+			{
+				while(this->rings[i].ring->TryPop(record))
+				{
+					this->sink(this->context, this->rings[i].id, record);
+					count++;
+				}
+			}
+
+			this->numDrained.fetch_add(count, std::memory_order_relaxed);
+			return count;
+		}
+
+		template <class dataType> uint64_t PidTraceConsumer<dataType>::GetNumDrained() const
+		{
+			return this->numDrained.load(std::memory_order_relaxed);
+		}
+
+		template <class dataType> void PidTraceConsumer<dataType>::ThreadLoop()
+		{
+			while(this->running.load(std::memory_order_relaxed))
+			{
+				if(this->Drain() == 0)
+					std::this_thread::sleep_for(std::chrono::microseconds(this->pollPeriodUs));
+			}
+		}
+
+	} // namespace MPidNs
+} // namespace MbeddedNinja
+
+#endif // #ifndef M_PID_PID_TRACE_H
+
+// EOF
@@ -0,0 +1,184 @@
+//!
+//! @file 			PidTraits.hpp
+//! @author 		Geoffrey Hunter <gbmhunter@gmail.com> (www.mbedded.ninja)
+//! @edited 		n/a
+//! @created		2026-10-16
+//! @last-modified 	2026-10-17
+//! @brief			Per-dataType sample period storage and time-scaling of the PID gains.
+//! @details
+//!					See README.rst in repo root dir for more info.
+
+#ifndef __cplusplus
+	#error Please build with C++ compiler
+#endif
+
+//===============================================================================================//
+//====================================== HEADER GUARD ===========================================//
+//===============================================================================================//
+
+#ifndef M_PID_PID_TRAITS_H
+#define M_PID_PID_TRAITS_H
+
+//===== SYSTEM LIBRARIES =====//
+#include <stdint.h>		// uint32_t, uint64_t
+#include <limits>		// std::numeric_limits
+
+//===== USER SOURCE =====//
+#include "FixedQ.hpp"
+
+namespace MbeddedNinja
+{
+	namespace MPidNs
+	{
+
+		//! @brief		Describes how the controllers store the sample period, and how the gains are
+		//!				scaled by it, for a particular dataType.
+		//! @details	The default works for any type which can be cast to and from double.
+		template <class dataType> struct PidTraits
+		{
+			//! @brief		The type used to store the sample period (in milliseconds).
+			typedef double samplePeriodType;
+
+			//! @brief		Converts Ki into the time-step scaled Zi.
+			static constexpr dataType ScaleKi(dataType ki, samplePeriodType samplePeriodMs)
+			{
+				// This requires double->dataType casting functionality.
+				return ki * (dataType)(samplePeriodMs/1000.0);
+			}
+
+			//! @brief		Converts Kd into the time-step scaled Zd.
+			static constexpr dataType ScaleKd(dataType kd, samplePeriodType samplePeriodMs)
+			{
+				return kd / (dataType)(samplePeriodMs/1000.0);
+			}
+
+			//! @brief		Rescales existing Zi and Zd when the sample period changes.
+			static void RescaleForSamplePeriod(dataType & zi, dataType & zd, uint32_t newSamplePeriodMs, samplePeriodType oldSamplePeriodMs)
+			{
+				dataType ratio  = (dataType)newSamplePeriodMs
+								/ (double)oldSamplePeriodMs;
+				zi *= ratio;
+				zd /= ratio;
+			}
+
+			//! @brief		Converts a sample period to whole nanoseconds (0 if it is negative).
+			static constexpr uint64_t ToNanoseconds(samplePeriodType samplePeriodMs)
+			{
+				return samplePeriodMs > 0 ? (uint64_t)(samplePeriodMs*1.0e6 + 0.5) : 0;
+			}
+
+			//! @brief		Calculates dtNs/samplePeriodNs and samplePeriodNs/dtNs, which scale Zi and Zd
+			//!				to a time-step of dtNs. Both are 0 if dtNs is 0.
+			static void TimestepRatios(uint64_t dtNs, uint64_t samplePeriodNs, dataType & ratio, dataType & invRatio)
+			{
+				if(dtNs == 0 || samplePeriodNs == 0)
+				{
+					ratio = 0;
+					invRatio = 0;
+					return;
+				}
+				ratio = (dataType)((double)dtNs/(double)samplePeriodNs);
+				invRatio = (dataType)((double)samplePeriodNs/(double)dtNs);
+			}
+		};
+
+		//! @brief		Integer-only traits for Q-format fixed-point numbers.
+		//! @details	The sample period is kept as a whole number of milliseconds, and the gains are
+		//!				scaled with wide integer multiplies and divides, so no floating-point instruction
+		//!				is used anywhere in Pid<FixedQ<...>>.
+		template <class baseType, uint8_t numFracBits> struct PidTraits<FixedQ<baseType, numFracBits>>
+		{
+			typedef FixedQ<baseType, numFracBits> dataType;
+			typedef typename dataType::wideType wideType;
+
+			typedef uint32_t samplePeriodType;
+
+			//! @details	Zi = Ki * T / 1000
+			static constexpr dataType ScaleKi(dataType ki, samplePeriodType samplePeriodMs)
+			{
+				return dataType::FromRaw(dataType::Saturate((wideType)ki.GetRaw() * (wideType)samplePeriodMs / 1000));
+			}
+
+			//! @details	Zd = Kd * 1000 / T. A zero sample period saturates, the same as dividing by zero.
+			static constexpr dataType ScaleKd(dataType kd, samplePeriodType samplePeriodMs)
+			{
+				return (samplePeriodMs == 0) ? kd / dataType(0) :
+					dataType::FromRaw(dataType::Saturate((wideType)kd.GetRaw() * 1000 / (wideType)samplePeriodMs));
+			}
+
+			//! @details	Zi *= new/old and Zd *= old/new, done as a multiply then divide so the ratio
+			//!				doesn't have to be representable in Q-format.
+			static void RescaleForSamplePeriod(dataType & zi, dataType & zd, uint32_t newSamplePeriodMs, samplePeriodType oldSamplePeriodMs)
+			{
+				if(oldSamplePeriodMs == 0)
+					return;
+				zi = dataType::FromRaw(dataType::Saturate((wideType)zi.GetRaw() * (wideType)newSamplePeriodMs / (wideType)oldSamplePeriodMs));
+				zd = dataType::FromRaw(dataType::Saturate((wideType)zd.GetRaw() * (wideType)oldSamplePeriodMs / (wideType)newSamplePeriodMs));
+			}
+
+			static constexpr uint64_t ToNanoseconds(samplePeriodType samplePeriodMs)
+			{
+				return (uint64_t)samplePeriodMs*1000000;
+			}
+
+			//! @details	Integer divides of the nanosecond counts, so time-steps shorter than a millisecond
+			//!				aren't rounded.
+			static void TimestepRatios(uint64_t dtNs, uint64_t samplePeriodNs, dataType & ratio, dataType & invRatio)
+			{
+				if(dtNs == 0 || samplePeriodNs == 0)
+				{
+					ratio = dataType::FromRaw(0);
+					invRatio = dataType::FromRaw(0);
+					return;
+				}
+				ratio = dataType::FromRaw(ScaledRatio(dtNs, samplePeriodNs));
+				invRatio = dataType::FromRaw(ScaledRatio(samplePeriodNs, dtNs));
+			}
+
+			//! @brief		Returns (num << numFracBits)/den, clamped to the largest value of dataType.
+			//! @details	64-bit bases use a 128-bit divide where the compiler has one. Everything else
+			//!				(and so every 32-bit target) only needs 64-bit arithmetic: the shift is done
+			//!				directly when it can't overflow, otherwise the whole part is divided first and
+			//!				the fractional bits are found one at a time by long division.
+			static baseType ScaledRatio(uint64_t num, uint64_t den)
+			{
+				const uint64_t maxRaw = (uint64_t)std::numeric_limits<baseType>::max();
+#if defined(__SIZEOF_INT128__)
+				if(sizeof(baseType) > sizeof(uint32_t))
+				{
+					unsigned __int128 raw = ((unsigned __int128)num << numFracBits)/den;
+					return raw > maxRaw ? (baseType)maxRaw : (baseType)raw;
+				}
+#endif
+				if(num <= (std::numeric_limits<uint64_t>::max() >> numFracBits))
+				{
+					uint64_t raw = (num << numFracBits)/den;
+					return raw > maxRaw ? (baseType)maxRaw : (baseType)raw;
+				}
+
+				uint64_t raw = num/den;
+				if(raw > (maxRaw >> numFracBits))
+					return (baseType)maxRaw;
+				uint64_t remainder = num % den;
+				for(uint8_t bit = 0; bit < numFracBits; bit++)
+				{
+					// remainder*2 >= den, written so remainder*2 can't overflow
+					raw <<= 1;
+					if(remainder >= den - remainder)
+					{
+						remainder -= den - remainder;
+						raw |= 1;
+					}
+					else
+						remainder <<= 1;
+				}
+				return raw > maxRaw ? (baseType)maxRaw : (baseType)raw;
+			}
+		};
+
+	} // namespace MPidNs
+} // namespace MbeddedNinja
+
+#endif // #ifndef M_PID_PID_TRAITS_H
+
+// EOF
@@ -0,0 +1,523 @@
+//!
+//! @file 			PlantSimulator.hpp
+//! @author 		Geoffrey Hunter <gbmhunter@gmail.com> (www.mbedded.ninja)
+//! @edited 		n/a
+//! @created		2026-10-16
+//! @last-modified 	2026-10-17
+//! @brief			Closed-loop simulation of many plant/controller pairs in lockstep.
+//! @details
+//!					See README.rst in repo root dir for more info.
+
+#ifndef __cplusplus
+	#error Please build with C++ compiler
+#endif
+
+//===============================================================================================//
+//====================================== HEADER GUARD ===========================================//
+//===============================================================================================//
+
+#ifndef M_PID_PLANT_SIMULATOR_H
+#define M_PID_PLANT_SIMULATOR_H
+
+//===== SYSTEM LIBRARIES =====//
+#include <stdint.h>			// uint32_t
+#include <stddef.h>			// size_t
+#include <math.h>			// fabs(), ceil(), log2()
+#include <type_traits>		// std::is_floating_point
+#include <vector>			// std::vector
+
+//===== USER SOURCE =====//
+#include "PidBank.hpp"
+
+namespace MbeddedNinja
+{
+	namespace MPidNs
+	{
+
+		//! @brief		The kinds of plant the simulator can model.
+		enum class PlantType
+		{
+			FIRST_ORDER,		//!< K/(tau*s + 1), with optional dead time (FOPDT).
+			SECOND_ORDER,		//!< K*wn^2/(s^2 + 2*zeta*wn*s + wn^2), with optional dead time.
+			INTEGRATING			//!< K/s, with optional dead time.
+		};
+
+		//! @brief		Continuous-time description of a plant. Use the static functions to create one.
+		struct PlantModel
+		{
+			PlantType type;
+			double gain;				//!< Steady-state gain K (or the rate gain, for an integrating plant).
+			double timeConstantS;		//!< tau, first-order plants only.
+			double naturalFreqRadS;		//!< wn, second-order plants only.
+			double dampingRatio;		//!< zeta, second-order plants only.
+			double deadTimeS;			//!< Pure delay between the controller output and the plant.
+
+			static PlantModel FirstOrder(double gain, double timeConstantS, double deadTimeS = 0)
+			{
+				PlantModel model = { PlantType::FIRST_ORDER, gain, timeConstantS, 0, 0, deadTimeS };
+				return model;
+			}
+
+			static PlantModel SecondOrder(double gain, double naturalFreqRadS, double dampingRatio, double deadTimeS = 0)
+			{
+				PlantModel model = { PlantType::SECOND_ORDER, gain, 0, naturalFreqRadS, dampingRatio, deadTimeS };
+				return model;
+			}
+
+			static PlantModel Integrating(double gain, double deadTimeS = 0)
+			{
+				PlantModel model = { PlantType::INTEGRATING, gain, 0, 0, 0, deadTimeS };
+				return model;
+			}
+		};
+
+		//! @brief		Step response metrics of one plant/controller pair.
+		template <class dataType> struct PlantMetrics
+		{
+			dataType overshoot;			//!< Largest excursion past the set-point, as a fraction of the step size.
+			dataType settlingTimeS;		//!< Time after which the output stayed within the settling band.
+			dataType iae;				//!< Integral of absolute error.
+			dataType ise;				//!< Integral of squared error.
+			dataType saturationTimeS;	//!< Total time the controller output was at a limit.
+		};
+
+		//! @brief		A plant discretised with a zero-order hold, in the two-state form PlantSimulator uses.
+		struct DiscretePlant
+		{
+			double a11, a12, a21, a22;
+			double b1, b2;
+			uint32_t delaySamples;		//!< Dead time, rounded to a whole number of samples.
+		};
+
+		//! @brief		Discretises a plant for the given sample period (exactly, via the matrix exponential).
+		inline DiscretePlant DiscretisePlant(const PlantModel & plant, double samplePeriodMs);
+
+		//===============================================================================================//
+		//===================================== CLASS DEFINITION ========================================//
+		//===============================================================================================//
+
+		//! @brief		Steps N plant/controller pairs in lockstep, all with the same sample period.
+		//! @details	Every plant is discretised exactly (zero-order hold, via the matrix exponential)
+		//!				into the same two-state form:
+		//!
+		//!					x1' = a11*x1 + a12*x2 + b1*u,	x2' = a21*x1 + a22*x2 + b2*u,	y = x1
+		//!
+		//!				so one loop over structure-of-arrays coefficients steps every kind of plant, and
+		//!				the compiler can vectorise it. Dead time is rounded to a whole number of samples,
+		//!				and held in a ring buffer per pair. The controllers are a PidBank.
+		//!				Each pair is a step response from it's initial output to it's set-point, and
+		//!				the metrics are accumulated as the simulation runs.
+		template <class dataType> class PlantSimulator
+		{
+			static_assert(std::is_floating_point<dataType>::value, "PlantSimulator only supports float and double.");
+
+			public:
+
+				typedef typename PidBank<dataType>::ControllerDirection ControllerDirection;
+				typedef typename PidBank<dataType>::OutputMode OutputMode;
+
+				//! @param		samplePeriodMs		Sample period of every plant and controller.
+				//! @param		settlingBand		Settling band, as a fraction of the step size.
+				PlantSimulator(double samplePeriodMs, double settlingBand = 0.02);
+
+				//! @brief		Adds a plant and the controller that drives it.
+				//! @details	The controller parameters are the same as for Pid. The plant starts at rest at
+				//!				initialOutput: it's delay line is filled with the input that holds it there
+				//!				(initialOutput/gain, or 0 for an integrating plant), and the controller starts
+				//!				from that output, so a controller with no gains leaves the plant where it is.
+				//!				The set-point should not be changed while simulating.
+				//! @returns	The index of the pair.
+				size_t Add(
+					const PlantModel & plant,
+					dataType kp,
+					dataType ki,
+					dataType kd,
+					ControllerDirection controllerDir,
+					OutputMode outputMode,
+					dataType minOutput,
+					dataType maxOutput,
+					dataType setPoint,
+					dataType initialOutput = 0);
+
+				//! @brief		Advances every pair by one sample period.
+				void Step();
+
+				//! @brief		Advances every pair by numSteps sample periods.
+				void Run(uint32_t numSteps);
+
+				//! @brief		Returns the number of pairs.
+				size_t Size() const;
+
+				//! @brief		Returns the number of steps simulated so far.
+				uint32_t GetNumSteps() const;
+
+				//! @brief		Returns the current output of a plant.
+				dataType GetPlantOutput(size_t index) const;
+
+				//! @brief		Returns the output of a controller the last time it was run.
+				dataType GetControllerOutput(size_t index) const;
+
+				//! @brief		Returns the metrics of a pair, over the steps simulated so far.
+				PlantMetrics<dataType> GetMetrics(size_t index) const;
+
+				//! @brief		The controllers, e.g. to re-tune them between runs.
+				PidBank<dataType> & GetBank();
+
+			private:
+
+				//! @brief		Adds a delay line for the newest pair, filled with restInput, lengthening them
+				//!				all if it needs more than delayLength - 1 samples.
+				void AddDelayLine(uint32_t delay, dataType restInput);
+
+				double samplePeriodS;
+				double settlingBand;
+				uint32_t numSteps;
+
+				PidBank<dataType> bank;
+
+				//===== PLANT STATE AND COEFFICIENTS (one entry per pair) =====//
+
+				std::vector<dataType> a11, a12, a21, a22, b1, b2;
+				std::vector<dataType> x1, x2;
+				std::vector<uint32_t> delay;
+
+				//! @brief		One ring of delayLength controller outputs per pair, all sharing delayHead.
+				std::vector<dataType> delayLine;
+				uint32_t delayLength;
+				uint32_t delayHead;
+
+				//===== SCRATCH =====//
+
+				std::vector<dataType> plantOutputs;
+				std::vector<dataType> controllerOutputs;
+				std::vector<dataType> delayedOutputs;
+
+				//===== METRICS (one entry per pair) =====//
+
+				std::vector<dataType> setPoint;
+				std::vector<dataType> stepDirection;		//!< +1 or -1, the direction of the step.
+				std::vector<dataType> stepSize;				//!< |setPoint - initialOutput|
+				std::vector<dataType> band;					//!< Settling band, in output units.
+				std::vector<dataType> outMin, outMax;
+				std::vector<dataType> maxExcursion;
+				std::vector<dataType> lastOutsideStep;		//!< Last step (+1) the output was outside the band.
+				std::vector<dataType> absErrorSum;
+				std::vector<dataType> squaredErrorSum;
+				std::vector<dataType> saturatedSteps;
+		};
+
+		//===============================================================================================//
+		//============================ TEMPLATE FUNCTION DEFINITIONS ====================================//
+		//===============================================================================================//
+
+		template <class dataType> PlantSimulator<dataType>::PlantSimulator(double samplePeriodMs, double settlingBand) :
+			samplePeriodS(samplePeriodMs/1000.0),
+			settlingBand(settlingBand),
+			numSteps(0),
+			delayLength(1),
+			delayHead(0)
+		{
+		}
+
+		template <class dataType> size_t PlantSimulator<dataType>::Add(
+			const PlantModel & plant,
+			dataType kp,
+			dataType ki,
+			dataType kd,
+			ControllerDirection controllerDir,
+			OutputMode outputMode,
+			dataType minOutput,
+			dataType maxOutput,
+			dataType setPoint,
+			dataType initialOutput)
+		{
+			size_t index = this->bank.Add(kp, ki, kd, controllerDir, outputMode,
+				(typename PidBank<dataType>::samplePeriodType)(this->samplePeriodS*1000.0), minOutput, maxOutput, setPoint);
+
+			// The input that holds the plant at initialOutput. Any input is at rest for an integrating
+			// plant, so it's 0 there (and for a plant with no gain, which can't be held anywhere else).
+			dataType restInput = (plant.type == PlantType::INTEGRATING || plant.gain == 0) ?
+				dataType(0) : initialOutput/(dataType)plant.gain;
+
+			// Start the controller from restInput. An accumulating controller adds it's integral term to
+			// the previous output every run, so that has to start at 0.
+			bool accumulate = (outputMode == OutputMode::ACCUMULATE_OUTPUT);
+			PidState<dataType> state = { setPoint, initialOutput, accumulate ? dataType(0) : restInput, restInput, 0 };
+			this->bank.SetState(index, state);
+
+			DiscretePlant discrete = DiscretisePlant(plant, this->samplePeriodS*1000.0);
+			this->a11.push_back((dataType)discrete.a11);
+			this->a12.push_back((dataType)discrete.a12);
+			this->a21.push_back((dataType)discrete.a21);
+			this->a22.push_back((dataType)discrete.a22);
+			this->b1.push_back((dataType)discrete.b1);
+			this->b2.push_back((dataType)discrete.b2);
+			// x2 is dx1/dt for a second-order plant, so 0 at rest
+			this->x1.push_back(initialOutput);
+			this->x2.push_back(0);
+			this->delay.push_back(discrete.delaySamples);
+			this->AddDelayLine(discrete.delaySamples, restInput);
+
+			this->plantOutputs.push_back(initialOutput);
+			this->controllerOutputs.push_back(restInput);
+			this->delayedOutputs.push_back(restInput);
+
+			dataType step = setPoint - initialOutput;
+			dataType stepSize = step < 0 ? -step : step;
+			this->setPoint.push_back(setPoint);
+			this->stepDirection.push_back(step < 0 ? dataType(-1) : dataType(1));
+			this->stepSize.push_back(stepSize);
+			this->band.push_back(stepSize*(dataType)this->settlingBand);
+			this->outMin.push_back(minOutput);
+			this->outMax.push_back(maxOutput);
+			this->maxExcursion.push_back(initialOutput - setPoint);
+			this->lastOutsideStep.push_back(0);
+			this->absErrorSum.push_back(0);
+			this->squaredErrorSum.push_back(0);
+			this->saturatedSteps.push_back(0);
+
+			return index;
+		}
+
+		template <class dataType> void PlantSimulator<dataType>::AddDelayLine(uint32_t delay, dataType restInput)
+		{
+			const size_t numPairs = this->Size();
+			uint32_t newLength = this->delayLength;
+			while(newLength < delay + 1)
+				newLength *= 2;
+
+			if(newLength == this->delayLength)
+			{
+				this->delayLine.resize((size_t)numPairs*this->delayLength, restInput);
+				return;
+			}
+
+			// Every line gets longer. Re-lay them out so the output from r samples ago is still r
+			// samples behind the head. The new pair's line is all restInput, so it doesn't need
+			// re-laying out.
+			std::vector<dataType> newLine((size_t)numPairs*newLength, dataType(0));
+			for(uint32_t r = 0; r < newLength; r++)
+				newLine[(numPairs - 1)*newLength + r] = restInput;
+			for(size_t i = 0; i + 1 < numPairs; i++)
+			{
+				for(uint32_t r = 0; r < this->delayLength; r++)
+				{
+					uint32_t oldSlot = (this->delayHead - r) & (this->delayLength - 1);
+					uint32_t newSlot = (0 - r) & (newLength - 1);
+					newLine[i*newLength + newSlot] = this->delayLine[i*this->delayLength + oldSlot];
+				}
+			}
+
+			this->delayLine.swap(newLine);
+			this->delayLength = newLength;
+			this->delayHead = 0;
+		}
+
+		template <class dataType> void PlantSimulator<dataType>::Step()
+		{
+			const size_t n = this->Size();
+			if(n == 0)
+				return;
+
+			dataType * y = this->plantOutputs.data();
+			dataType * u = this->controllerOutputs.data();
+			dataType * ud = this->delayedOutputs.data();
+
+			for(size_t i = 0; i < n; i++)
+				y[i] = this->x1[i];
+
+			this->bank.RunAll(y, u);
+
+			// Push the new outputs into the delay line, and pull out the ones that reach the plants now
+			this->delayHead = (this->delayHead + 1) & (this->delayLength - 1);
+			const uint32_t length = this->delayLength;
+			const uint32_t head = this->delayHead;
+			dataType * line = this->delayLine.data();
+			const uint32_t * delay = this->delay.data();
+			for(size_t i = 0; i < n; i++)
+			{
+				line[i*length + head] = u[i];
+				ud[i] = line[i*length + ((head - delay[i]) & (length - 1))];
+			}
+
+			// Step the plants. No branches, so this vectorises.
+			dataType * x1 = this->x1.data();
+			dataType * x2 = this->x2.data();
+			const dataType * a11 = this->a11.data();
+			const dataType * a12 = this->a12.data();
+			const dataType * a21 = this->a21.data();
+			const dataType * a22 = this->a22.data();
+			const dataType * b1 = this->b1.data();
+			const dataType * b2 = this->b2.data();
+			for(size_t i = 0; i < n; i++)
+			{
+				dataType nx1 = a11[i]*x1[i] + a12[i]*x2[i] + b1[i]*ud[i];
+				dataType nx2 = a21[i]*x1[i] + a22[i]*x2[i] + b2[i]*ud[i];
+				x1[i] = nx1;
+				x2[i] = nx2;
+			}
+
+			// Metrics, for the plant output the controllers just saw
+			const dataType stepNumber = (dataType)(this->numSteps + 1);
+			const dataType * setPoint = this->setPoint.data();
+			const dataType * direction = this->stepDirection.data();
+			const dataType * band = this->band.data();
+			const dataType * outMin = this->outMin.data();
+			const dataType * outMax = this->outMax.data();
+			dataType * maxExcursion = this->maxExcursion.data();
+			dataType * lastOutside = this->lastOutsideStep.data();
+			dataType * absErrorSum = this->absErrorSum.data();
+			dataType * squaredErrorSum = this->squaredErrorSum.data();
+			dataType * saturated = this->saturatedSteps.data();
+			for(size_t i = 0; i < n; i++)
+			{
+				dataType error = setPoint[i] - y[i];
+				dataType absError = error < 0 ? -error : error;
+				dataType excursion = -error*direction[i];
+				maxExcursion[i] = excursion > maxExcursion[i] ? excursion : maxExcursion[i];
+				lastOutside[i] = absError > band[i] ? stepNumber : lastOutside[i];
+				absErrorSum[i] += absError;
+				squaredErrorSum[i] += error*error;
+				saturated[i] += (u[i] >= outMax[i] || u[i] <= outMin[i]) ? dataType(1) : dataType(0);
+			}
+
+			this->numSteps++;
+		}
+
+		template <class dataType> void PlantSimulator<dataType>::Run(uint32_t numSteps)
+		{
+			for(uint32_t s = 0; s < numSteps; s++)
+				this->Step();
+		}
+
+		template <class dataType> size_t PlantSimulator<dataType>::Size() const
+		{
+			return this->x1.size();
+		}
+
+		template <class dataType> uint32_t PlantSimulator<dataType>::GetNumSteps() const
+		{
+			return this->numSteps;
+		}
+
+		template <class dataType> dataType PlantSimulator<dataType>::GetPlantOutput(size_t index) const
+		{
+			return this->x1[index];
+		}
+
+		template <class dataType> dataType PlantSimulator<dataType>::GetControllerOutput(size_t index) const
+		{
+			return this->bank.GetOutput(index);
+		}
+
+		template <class dataType> PlantMetrics<dataType> PlantSimulator<dataType>::GetMetrics(size_t index) const
+		{
+			const dataType T = (dataType)this->samplePeriodS;
+
+			PlantMetrics<dataType> metrics;
+			metrics.overshoot = 0;
+			if(this->stepSize[index] > 0 && this->maxExcursion[index] > 0)
+				metrics.overshoot = this->maxExcursion[index]/this->stepSize[index];
+			metrics.settlingTimeS = this->lastOutsideStep[index]*T;
+			metrics.iae = this->absErrorSum[index]*T;
+			metrics.ise = this->squaredErrorSum[index]*T;
+			metrics.saturationTimeS = this->saturatedSteps[index]*T;
+			return metrics;
+		}
+
+		template <class dataType> PidBank<dataType> & PlantSimulator<dataType>::GetBank()
+		{
+			return this->bank;
+		}
+
+		//===============================================================================================//
+		//=================================== FUNCTION DEFINITIONS ======================================//
+		//===============================================================================================//
+
+		inline DiscretePlant DiscretisePlant(const PlantModel & plant, double samplePeriodMs)
+		{
+			const double T = samplePeriodMs/1000.0;
+
+			double A[2][2] = { { 0, 0 }, { 0, 0 } };
+			double B[2] = { 0, 0 };
+			switch(plant.type)
+			{
+				case PlantType::FIRST_ORDER:
+					A[0][0] = -1.0/plant.timeConstantS;
+					B[0] = plant.gain/plant.timeConstantS;
+					break;
+				case PlantType::SECOND_ORDER:
+				{
+					double wn = plant.naturalFreqRadS;
+					A[0][1] = 1.0;
+					A[1][0] = -wn*wn;
+					A[1][1] = -2.0*plant.dampingRatio*wn;
+					B[1] = plant.gain*wn*wn;
+					break;
+				}
+				case PlantType::INTEGRATING:
+					B[0] = plant.gain;
+					break;
+			}
+
+			// exp([A B; 0 0]*T) = [Ad Bd; 0 1]. Scaling and squaring with a Taylor series.
+			double M[3][3] = {
+				{ A[0][0]*T, A[0][1]*T, B[0]*T },
+				{ A[1][0]*T, A[1][1]*T, B[1]*T },
+				{ 0, 0, 0 } };
+			double norm = 0;
+			for(int r = 0; r < 3; r++)
+			{
+				double rowSum = fabs(M[r][0]) + fabs(M[r][1]) + fabs(M[r][2]);
+				norm = rowSum > norm ? rowSum : norm;
+			}
+			int numSquarings = norm > 0.5 ? (int)ceil(log2(norm/0.5)) : 0;
+			double scale = 1.0/(double)(1 << numSquarings);
+			for(int r = 0; r < 3; r++)
+				for(int c = 0; c < 3; c++)
+					M[r][c] *= scale;
+
+			double E[3][3] = { { 1, 0, 0 }, { 0, 1, 0 }, { 0, 0, 1 } };
+			double term[3][3] = { { 1, 0, 0 }, { 0, 1, 0 }, { 0, 0, 1 } };
+			for(int k = 1; k <= 16; k++)
+			{
+				double next[3][3];
+				for(int r = 0; r < 3; r++)
+					for(int c = 0; c < 3; c++)
+						next[r][c] = (term[r][0]*M[0][c] + term[r][1]*M[1][c] + term[r][2]*M[2][c])/k;
+				for(int r = 0; r < 3; r++)
+					for(int c = 0; c < 3; c++)
+					{
+						term[r][c] = next[r][c];
+						E[r][c] += next[r][c];
+					}
+			}
+
+			for(int s = 0; s < numSquarings; s++)
+			{
+				double squared[3][3];
+				for(int r = 0; r < 3; r++)
+					for(int c = 0; c < 3; c++)
+						squared[r][c] = E[r][0]*E[0][c] + E[r][1]*E[1][c] + E[r][2]*E[2][c];
+				for(int r = 0; r < 3; r++)
+					for(int c = 0; c < 3; c++)
+						E[r][c] = squared[r][c];
+			}
+
+			DiscretePlant discrete;
+			discrete.a11 = E[0][0];
+			discrete.a12 = E[0][1];
+			discrete.a21 = E[1][0];
+			discrete.a22 = E[1][1];
+			discrete.b1 = E[0][2];
+			discrete.b2 = E[1][2];
+			discrete.delaySamples = (uint32_t)(plant.deadTimeS/T + 0.5);
+			return discrete;
+		}
+
+	} // namespace MPidNs
+} // namespace MbeddedNinja
+
+#endif // #ifndef M_PID_PLANT_SIMULATOR_H
+
+// EOF
@@ -0,0 +1,113 @@
+//!
+//! @file 			SeqLock.hpp
+//! @author 		Geoffrey Hunter <gbmhunter@gmail.com> (www.mbedded.ninja)
+//! @edited 		n/a
+//! @created		2026-10-16
+//! @last-modified 	2026-10-16
+//! @brief			Sequence lock for publishing a small block of data to a reader which must never wait.
+//! @details
+//!					See README.rst in repo root dir for more info.
+
+#ifndef __cplusplus
+	#error Please build with C++ compiler
+#endif
+
+//===============================================================================================//
+//====================================== HEADER GUARD ===========================================//
+//===============================================================================================//
+
+#ifndef M_PID_SEQ_LOCK_H
+#define M_PID_SEQ_LOCK_H
+
+//===== SYSTEM LIBRARIES =====//
+#include <stdint.h>		// uint32_t, uint64_t
+#include <stddef.h>		// size_t
+#include <string.h>		// memcpy()
+#include <atomic>		// std::atomic, std::atomic_thread_fence
+
+namespace MbeddedNinja
+{
+	namespace MPidNs
+	{
+
+		//===============================================================================================//
+		//===================================== CLASS DEFINITION ========================================//
+		//===============================================================================================//
+
+		//! @brief		Publishes copies of a trivially-copyable dataType from a writer to a reader.
+		//! @details	Write() bumps the sequence number to odd, copies the data in, then bumps it to even.
+		//!				TryRead() copies the data out and checks the sequence number didn't change
+		//!				while it was copying. A reader never blocks or retries; if it races with a
+		//!				writer it is told the read failed, and can keep using it's last good copy.
+		//!				The data is stored as relaxed atomic words, so there are no data races.
+		//! @warning	Only one thread may call Write() at a time. Serialise writers externally.
+		template <class dataType> class SeqLock
+		{
+			public:
+
+				SeqLock() :
+					sequence(0)
+				{
+					for(size_t i = 0; i < numWords; i++)
+						this->words[i].store(0, std::memory_order_relaxed);
+				}
+
+				//! @brief		Publishes a new value. Never blocks.
+				void Write(const dataType & value)
+				{
+					uint64_t copy[numWords] = {};
+					memcpy(copy, &value, sizeof(dataType));
+
+					uint32_t seq = this->sequence.load(std::memory_order_relaxed);
+					this->sequence.store(seq + 1, std::memory_order_relaxed);
+					std::atomic_thread_fence(std::memory_order_release);
+
+					for(size_t i = 0; i < numWords; i++)
+						this->words[i].store(copy[i], std::memory_order_relaxed);
+
+					this->sequence.store(seq + 2, std::memory_order_release);
+				}
+
+				//! @brief		Attempts to copy out the latest value. Never blocks or spins.
+				//! @returns	true if value now holds a consistent copy, false if a write was in progress
+				//!				(value is then unspecified and should be discarded).
+				bool TryRead(dataType & value, uint32_t & sequenceRead) const
+				{
+					uint32_t seqBefore = this->sequence.load(std::memory_order_acquire);
+					if(seqBefore & 1)
+						return false;
+
+					uint64_t copy[numWords];
+					for(size_t i = 0; i < numWords; i++)
+						copy[i] = this->words[i].load(std::memory_order_relaxed);
+
+					std::atomic_thread_fence(std::memory_order_acquire);
+					if(this->sequence.load(std::memory_order_relaxed) != seqBefore)
+						return false;
+
+					memcpy(&value, copy, sizeof(dataType));
+					sequenceRead = seqBefore;
+					return true;
+				}
+
+				//! @brief		Returns the current sequence number. It changes every time Write() is called,
+				//!				so a reader can cheaply check if there is anything new to read.
+				uint32_t GetSequence() const
+				{
+					return this->sequence.load(std::memory_order_acquire);
+				}
+
+			private:
+
+				static const size_t numWords = (sizeof(dataType) + sizeof(uint64_t) - 1)/sizeof(uint64_t);
+
+				std::atomic<uint32_t> sequence;
+				std::atomic<uint64_t> words[numWords];
+		};
+
+	} // namespace MPidNs
+} // namespace MbeddedNinja
+
+#endif // #ifndef M_PID_SEQ_LOCK_H
+
+// EOF
@@ -0,0 +1,110 @@
+//!
+//! @file 			SpinWaiter.hpp
+//! @author 		Geoffrey Hunter <gbmhunter@gmail.com> (www.mbedded.ninja)
+//! @edited 		n/a
+//! @created		2026-10-17
+//! @last-modified 	2026-10-17
+//! @brief			Lets a thread wait for a condition by spinning for a while, then blocking.
+//! @details
+//!					See README.rst in repo root dir for more info.
+
+#ifndef __cplusplus
+	#error Please build with C++ compiler
+#endif
+
+//===============================================================================================//
+//====================================== HEADER GUARD ===========================================//
+//===============================================================================================//
+
+#ifndef M_PID_SPIN_WAITER_H
+#define M_PID_SPIN_WAITER_H
+
+//===== SYSTEM LIBRARIES =====//
+#include <stdint.h>					// uint32_t
+#include <atomic>					// std::atomic, std::atomic_thread_fence
+#include <condition_variable>		// std::condition_variable
+#include <mutex>					// std::mutex, std::unique_lock, std::lock_guard
+
+namespace MbeddedNinja
+{
+	namespace MPidNs
+	{
+
+		//===============================================================================================//
+		//===================================== CLASS DEFINITION ========================================//
+		//===============================================================================================//
+
+		//! @brief		Waits for a condition which another thread makes true, e.g. a worker waiting for
+		//!				the next tick, or a barrier waiting for the workers to finish it.
+		//! @details	Wait() checks the condition spinLimit times (a few microseconds) before blocking on a
+		//!				condition variable, so back-to-back ticks are handed over without a system call,
+		//!				but idle threads don't burn a CPU each. The cost is latency: a thread which has
+		//!				blocked needs a wake-up from the kernel (typically tens of microseconds, more if
+		//!				it's CPU has been given to another thread) before it sees the condition.
+		//!				Notify() is a fence and a load when nothing is blocked, so is cheap enough to call
+		//!				every tick.
+		class SpinWaiter
+		{
+			public:
+
+				SpinWaiter() :
+					numBlocked(0)
+				{
+				}
+
+				SpinWaiter(const SpinWaiter &) = delete;
+				SpinWaiter & operator=(const SpinWaiter &) = delete;
+
+				//! @brief		Returns once isDone() returns true.
+				//! @details	isDone() must only read state which the other thread changes before it calls
+				//!				Notify() (with release or stronger atomics), and must be safe to call
+				//!				repeatedly.
+				template <class predicateType> void Wait(predicateType isDone)
+				{
+					for(uint32_t spins = 0; spins < spinLimit; spins++)
+					{
+						if(isDone())
+							return;
+					}
+
+					std::unique_lock<std::mutex> lock(this->mutex);
+					this->numBlocked.fetch_add(1, std::memory_order_relaxed);
+					// Pairs with the fence in Notify(): either Notify() sees this thread is blocked, or
+					// isDone() sees the change Notify() was called for
+					std::atomic_thread_fence(std::memory_order_seq_cst);
+					while(!isDone())
+						this->condition.wait(lock);
+					this->numBlocked.fetch_sub(1, std::memory_order_relaxed);
+				}
+
+				//! @brief		Wakes every thread blocked in Wait(). Call after making their condition true.
+				void Notify()
+				{
+					std::atomic_thread_fence(std::memory_order_seq_cst);
+					if(this->numBlocked.load(std::memory_order_relaxed) == 0)
+						return;
+
+					// A blocked thread holds the mutex from incrementing numBlocked until it is waiting on
+					// the condition variable, so taking it here means the notify can't be missed
+					{
+						std::lock_guard<std::mutex> lock(this->mutex);
+					}
+					this->condition.notify_all();
+				}
+
+			private:
+
+				//! @brief		Number of times Wait() checks the condition before blocking.
+				static const uint32_t spinLimit = 4096;
+
+				std::mutex mutex;
+				std::condition_variable condition;
+				std::atomic<uint32_t> numBlocked;
+		};
+
+	} // namespace MPidNs
+} // namespace MbeddedNinja
+
+#endif // #ifndef M_PID_SPIN_WAITER_H
+
+// EOF
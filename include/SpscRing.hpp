@@ -0,0 +1,137 @@
+//!
+//! @file 			SpscRing.hpp
+//! @author 		Geoffrey Hunter <gbmhunter@gmail.com> (www.mbedded.ninja)
+//! @edited 		n/a
+//! @created		2026-10-16
+//! @last-modified 	2026-10-16
+//! @brief			Lock-free single-producer, single-consumer ring buffer.
+//! @details
+//!					See README.rst in repo root dir for more info.
+
+#ifndef __cplusplus
+	#error Please build with C++ compiler
+#endif
+
+//===============================================================================================//
+//====================================== HEADER GUARD ===========================================//
+//===============================================================================================//
+
+#ifndef M_PID_SPSC_RING_H
+#define M_PID_SPSC_RING_H
+
+//===== SYSTEM LIBRARIES =====//
+#include <stddef.h>		// size_t
+#include <atomic>		// std::atomic
+#include <vector>		// std::vector
+
+namespace MbeddedNinja
+{
+	namespace MPidNs
+	{
+
+		//===============================================================================================//
+		//===================================== CLASS DEFINITION ========================================//
+		//===============================================================================================//
+
+		//! @brief		Fixed-capacity queue of recordType between exactly one producer and one consumer thread.
+		//! @details	TryPush() and TryPop() never block, allocate or spin, so the producer can be a
+		//!				real-time thread. When the ring is full TryPush() drops the record and counts it.
+		//!				Each side keeps a cached copy of the other side's index, so in the common case a
+		//!				push or pop only touches it's own cache line.
+		template <class recordType> class SpscRing
+		{
+			public:
+
+				//! @param		capacity		Rounded up to a power of two.
+				SpscRing(size_t capacity) :
+					head(0),
+					numDropped(0),
+					cachedTail(0),
+					tail(0),
+					cachedHead(0)
+				{
+					size_t size = 2;
+					while(size < capacity)
+						size <<= 1;
+					this->buffer.resize(size);
+					this->mask = size - 1;
+				}
+
+				SpscRing(const SpscRing &) = delete;
+				SpscRing & operator=(const SpscRing &) = delete;
+
+				//! @brief		Adds a record. Only call from the producer thread.
+				//! @returns	false (and the record is dropped) if the ring is full.
+				bool TryPush(const recordType & record)
+				{
+					size_t currentHead = this->head.load(std::memory_order_relaxed);
+					if(currentHead - this->cachedTail > this->mask)
+					{
+						this->cachedTail = this->tail.load(std::memory_order_acquire);
+						if(currentHead - this->cachedTail > this->mask)
+						{
+							this->numDropped.store(this->numDropped.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+							return false;
+						}
+					}
+
+					this->buffer[currentHead & this->mask] = record;
+					this->head.store(currentHead + 1, std::memory_order_release);
+					return true;
+				}
+
+				//! @brief		Removes the oldest record. Only call from the consumer thread.
+				//! @returns	false if the ring is empty.
+				bool TryPop(recordType & record)
+				{
+					size_t currentTail = this->tail.load(std::memory_order_relaxed);
+					if(currentTail == this->cachedHead)
+					{
+						this->cachedHead = this->head.load(std::memory_order_acquire);
+						if(currentTail == this->cachedHead)
+							return false;
+					}
+
+					record = this->buffer[currentTail & this->mask];
+					this->tail.store(currentTail + 1, std::memory_order_release);
+					return true;
+				}
+
+				//! @brief		Returns the number of records dropped because the ring was full.
+				size_t GetNumDropped() const
+				{
+					return this->numDropped.load(std::memory_order_relaxed);
+				}
+
+				//! @brief		Returns the number of records the ring can hold.
+				size_t GetCapacity() const
+				{
+					return this->mask + 1;
+				}
+
+			private:
+
+				std::vector<recordType> buffer;
+				size_t mask;
+				char sharedPadding[128];
+
+				//===== PRODUCER =====//
+
+				std::atomic<size_t> head;
+				std::atomic<size_t> numDropped;
+				size_t cachedTail;
+				char producerPadding[128];
+
+				//===== CONSUMER =====//
+
+				std::atomic<size_t> tail;
+				size_t cachedHead;
+				char consumerPadding[128];
+		};
+
+	} // namespace MPidNs
+} // namespace MbeddedNinja
+
+#endif // #ifndef M_PID_SPSC_RING_H
+
+// EOF
@@ -0,0 +1,311 @@
+//!
+//! @file 			StaticPid.hpp
+//! @author 		Geoffrey Hunter <gbmhunter@gmail.com> (www.mbedded.ninja)
+//! @edited 		n/a
+//! @created		2026-10-16
+//! @last-modified 	2026-10-16
+//! @brief			PID controller whose direction and modes are fixed at compile time with policy classes.
+//! @details
+//!					See README.rst in repo root dir for more info.
+
+#ifndef __cplusplus
+	#error Please build with C++ compiler
+#endif
+
+//===============================================================================================//
+//====================================== HEADER GUARD ===========================================//
+//===============================================================================================//
+
+#ifndef M_PID_STATIC_PID_H
+#define M_PID_STATIC_PID_H
+
+//===== SYSTEM LIBRARIES =====//
+#include <stdint.h>		// uint32_t
+
+//===== USER SOURCE =====//
+#include "PidTraits.hpp"
+
+namespace MbeddedNinja
+{
+	namespace MPidNs
+	{
+
+		//===============================================================================================//
+		//========================================= POLICIES ============================================//
+		//===============================================================================================//
+
+		//! @brief		Direction policy. +error gives +output (same as ControllerDirection::PID_DIRECT).
+		template <class dataType> struct DirectAction
+		{
+			static constexpr dataType ApplyToGain(dataType gain) { return gain; }
+		};
+
+		//! @brief		Direction policy. +error gives -output (same as ControllerDirection::PID_REVERSE).
+		//! @details	The gains are negated once when they are set, rather than in Run().
+		template <class dataType> struct ReverseAction
+		{
+			static constexpr dataType ApplyToGain(dataType gain) { return (0 - gain); }
+		};
+
+		//! @brief		Output mode policy. Same as OutputMode::DONT_ACCUMULATE_OUTPUT (distance control).
+		template <class dataType> struct DontAccumulateOutput
+		{
+			static dataType Combine(dataType prevOutput, dataType pTerm, dataType iTerm, dataType dTerm)
+			{
+				(void)prevOutput;
+				return pTerm + iTerm + dTerm;
+			}
+		};
+
+		//! @brief		Output mode policy. Same as OutputMode::ACCUMULATE_OUTPUT (velocity control).
+		template <class dataType> struct AccumulateOutput
+		{
+			static dataType Combine(dataType prevOutput, dataType pTerm, dataType iTerm, dataType dTerm)
+			{
+				return prevOutput + pTerm + iTerm + dTerm;
+			}
+		};
+
+		//! @brief		Derivative policy. Derivative on measurement, ignored on the first call to Run()
+		//!				(the same as Pid).
+		template <class dataType> class DerivativeOnMeasurement
+		{
+			public:
+				constexpr DerivativeOnMeasurement() : prevInput(0), primed(false) {}
+
+				dataType Compute(dataType zd, dataType input)
+				{
+					// The derivative term is exactly 0 on the first run, as in Pid::Run() (-zd*0 would be
+					// -0.0, or NaN if zd is infinite). This is the only data-dependent choice left in Run(),
+					// and is always predicted correctly after the first call.
+					bool wasPrimed = this->primed;
+					dataType prev = this->prevInput;
+					this->prevInput = input;
+					this->primed = true;
+					if(!wasPrimed)
+						return dataType(0);
+					return -zd*(input - prev);
+				}
+
+			private:
+				dataType prevInput;
+				bool primed;
+		};
+
+		//! @brief		Derivative policy. No derivative term, and no previous input is stored.
+		template <class dataType> class NoDerivative
+		{
+			public:
+				dataType Compute(dataType zd, dataType input)
+				{
+					(void)zd;
+					(void)input;
+					return 0;
+				}
+		};
+
+		//! @brief		Clamp policy. The integral term is limited to the output limits (the same as Pid).
+		template <class dataType> struct IntegralClamp
+		{
+			static dataType Clamp(dataType iTerm, dataType outMin, dataType outMax)
+			{
+				iTerm = (iTerm > outMax) ? outMax : iTerm;
+				return (iTerm < outMin) ? outMin : iTerm;
+			}
+		};
+
+		//! @brief		Clamp policy. The integral term is not limited (only the output is).
+		template <class dataType> struct NoIntegralClamp
+		{
+			static dataType Clamp(dataType iTerm, dataType outMin, dataType outMax)
+			{
+				(void)outMin;
+				(void)outMax;
+				return iTerm;
+			}
+		};
+
+		//===============================================================================================//
+		//===================================== CLASS DEFINITION ========================================//
+		//===============================================================================================//
+
+		//! @brief		PID controller with the direction, output mode, derivative and integral clamp
+		//!				chosen at compile time.
+		//! @details	Gives the same results as a Pid configured the same way, but Run() contains no
+		//!				checks of the configuration, so each instantiation compiles to just the maths it needs.
+		//!				e.g. StaticPid<float, ReverseAction, AccumulateOutput, DerivativeOnMeasurement, IntegralClamp>
+		template <
+			class dataType,
+			template <class> class DirectionPolicy = DirectAction,
+			template <class> class OutputModePolicy = DontAccumulateOutput,
+			template <class> class DerivativePolicy = DerivativeOnMeasurement,
+			template <class> class ClampPolicy = IntegralClamp>
+		class StaticPid
+		{
+			public:
+
+				typedef typename PidTraits<dataType>::samplePeriodType samplePeriodType;
+
+				//! @brief 		Init function.
+				//! @details	Same as the Pid constructor, minus the direction and output mode, which are
+				//!				template parameters. Like the Pid constructor, it is constexpr.
+				constexpr StaticPid(
+					dataType kp,
+					dataType ki,
+					dataType kd,
+					samplePeriodType samplePeriodMs,
+					dataType minOutput,
+					dataType maxOutput,
+					dataType setPoint);
+
+				//! @brief 		Computes new PID values. Call once per sample period.
+				void Run(dataType input);
+
+				void SetOutputLimits(dataType min, dataType max);
+
+				//! @brief		Changes the sample time
+				void SetSamplePeriod(uint32_t newSamplePeriodMs);
+
+				//! @brief		Sets the PID tunings. Negative values are ignored.
+				void SetTunings(dataType kp, dataType ki, dataType kd);
+
+				constexpr dataType GetKp() const;		//!< Returns the actual (not time-scaled) proportional constant.
+				constexpr dataType GetKi() const;		//!< Returns the actual (not time-scaled) integral constant.
+				constexpr dataType GetKd() const;		//!< Returns the actual (not time-scaled) derivative constant.
+				constexpr dataType GetZp() const;		//!< Returns the time-scaled proportional constant.
+				constexpr dataType GetZi() const;		//!< Returns the time-scaled integral constant.
+				constexpr dataType GetZd() const;		//!< Returns the time-scaled derivative constant.
+
+				//! @brief 		The set-point the PID control is trying to make the output converge to.
+				dataType setPoint;
+
+				//! @brief		The control output. Also used as the previous output in accumulating mode.
+				dataType output;
+
+			private:
+
+				//! @brief		true if none of the gains are negative.
+				static constexpr bool TuningsAreValid(dataType kp, dataType ki, dataType kd);
+
+				dataType Zp;				//!< Time-scaled proportional constant (direction applied).
+				dataType Zi;				//!< Time-scaled integral constant (direction applied).
+				dataType Zd;				//!< Time-scaled derivative constant (direction applied).
+				dataType iTerm;				//!< The integral term.
+				dataType outMin;			//!< The minimum output value.
+				dataType outMax;			//!< The maximum output value.
+
+				//! @brief		Holds the previous input, if the derivative policy needs it.
+				DerivativePolicy<dataType> derivative;
+
+				dataType Kp;				//!< Actual (non-scaled) proportional constant
+				dataType Ki;				//!< Actual (non-scaled) integral constant
+				dataType Kd;				//!< Actual (non-scaled) derivative constant
+
+				//! @brief		The sample period (in milliseconds) between successive Run() calls.
+				samplePeriodType samplePeriodMs;
+		};
+
+		//===============================================================================================//
+		//============================ TEMPLATE FUNCTION DEFINITIONS ====================================//
+		//===============================================================================================//
+
+		#define M_PID_STATIC_PID_TEMPLATE template <class dataType, template <class> class DirectionPolicy, \
+			template <class> class OutputModePolicy, template <class> class DerivativePolicy, template <class> class ClampPolicy>
+		#define M_PID_STATIC_PID StaticPid<dataType, DirectionPolicy, OutputModePolicy, DerivativePolicy, ClampPolicy>
+
+		M_PID_STATIC_PID_TEMPLATE constexpr bool M_PID_STATIC_PID::TuningsAreValid(dataType kp, dataType ki, dataType kd)
+		{
+			return !(kp < 0 || ki < 0 || kd < 0);
+		}
+
+		// Same checks and scaling as SetOutputLimits() and SetTunings(), written as initialisers so the
+		// constructor can be constexpr
+		M_PID_STATIC_PID_TEMPLATE constexpr M_PID_STATIC_PID::StaticPid(
+			dataType kp,
+			dataType ki,
+			dataType kd,
+			samplePeriodType samplePeriodMs,
+			dataType minOutput,
+			dataType maxOutput,
+			dataType setPoint) :
+				setPoint(setPoint),
+				output(0),
+				Zp(TuningsAreValid(kp, ki, kd) ? DirectionPolicy<dataType>::ApplyToGain(kp) : dataType(0)),
+				Zi(TuningsAreValid(kp, ki, kd) ? DirectionPolicy<dataType>::ApplyToGain(PidTraits<dataType>::ScaleKi(ki, samplePeriodMs)) : dataType(0)),
+				Zd(TuningsAreValid(kp, ki, kd) ? DirectionPolicy<dataType>::ApplyToGain(PidTraits<dataType>::ScaleKd(kd, samplePeriodMs)) : dataType(0)),
+				iTerm(0),
+				outMin((minOutput < maxOutput) ? minOutput : dataType(0)),
+				outMax((minOutput < maxOutput) ? maxOutput : dataType(0)),
+				derivative(),
+				Kp(TuningsAreValid(kp, ki, kd) ? kp : dataType(0)),
+				Ki(TuningsAreValid(kp, ki, kd) ? ki : dataType(0)),
+				Kd(TuningsAreValid(kp, ki, kd) ? kd : dataType(0)),
+				samplePeriodMs(samplePeriodMs)
+		{
+		}
+
+		M_PID_STATIC_PID_TEMPLATE void M_PID_STATIC_PID::Run(dataType input)
+		{
+			dataType error = this->setPoint - input;
+
+			dataType pTerm = this->Zp*error;
+
+			this->iTerm = ClampPolicy<dataType>::Clamp(this->iTerm + this->Zi*error, this->outMin, this->outMax);
+
+			dataType dTerm = this->derivative.Compute(this->Zd, input);
+
+			dataType out = OutputModePolicy<dataType>::Combine(this->output, pTerm, this->iTerm, dTerm);
+
+			// Limit output
+			out = (out > this->outMax) ? this->outMax : out;
+			out = (out < this->outMin) ? this->outMin : out;
+			this->output = out;
+		}
+
+		M_PID_STATIC_PID_TEMPLATE void M_PID_STATIC_PID::SetTunings(dataType kp, dataType ki, dataType kd)
+		{
+			if (kp<0 || ki<0 || kd<0)
+				return;
+
+			this->Kp = kp;
+			this->Ki = ki;
+			this->Kd = kd;
+
+			this->Zp = DirectionPolicy<dataType>::ApplyToGain(kp);
+			this->Zi = DirectionPolicy<dataType>::ApplyToGain(PidTraits<dataType>::ScaleKi(ki, this->samplePeriodMs));
+			this->Zd = DirectionPolicy<dataType>::ApplyToGain(PidTraits<dataType>::ScaleKd(kd, this->samplePeriodMs));
+		}
+
+		M_PID_STATIC_PID_TEMPLATE void M_PID_STATIC_PID::SetSamplePeriod(uint32_t newSamplePeriodMs)
+		{
+			if (newSamplePeriodMs > 0)
+			{
+				PidTraits<dataType>::RescaleForSamplePeriod(this->Zi, this->Zd, newSamplePeriodMs, this->samplePeriodMs);
+				this->samplePeriodMs = newSamplePeriodMs;
+			}
+		}
+
+		M_PID_STATIC_PID_TEMPLATE void M_PID_STATIC_PID::SetOutputLimits(dataType min, dataType max)
+		{
+			if(min >= max)
+				return;
+			this->outMin = min;
+			this->outMax = max;
+		}
+
+		M_PID_STATIC_PID_TEMPLATE constexpr dataType M_PID_STATIC_PID::GetKp() const { return this->Kp; }
+		M_PID_STATIC_PID_TEMPLATE constexpr dataType M_PID_STATIC_PID::GetKi() const { return this->Ki; }
+		M_PID_STATIC_PID_TEMPLATE constexpr dataType M_PID_STATIC_PID::GetKd() const { return this->Kd; }
+		M_PID_STATIC_PID_TEMPLATE constexpr dataType M_PID_STATIC_PID::GetZp() const { return this->Zp; }
+		M_PID_STATIC_PID_TEMPLATE constexpr dataType M_PID_STATIC_PID::GetZi() const { return this->Zi; }
+		M_PID_STATIC_PID_TEMPLATE constexpr dataType M_PID_STATIC_PID::GetZd() const { return this->Zd; }
+
+		#undef M_PID_STATIC_PID_TEMPLATE
+		#undef M_PID_STATIC_PID
+
+	} // namespace MPidNs
+} // namespace MbeddedNinja
+
+#endif // #ifndef M_PID_STATIC_PID_H
+
+// EOF
@@ -0,0 +1,326 @@
+//!
+//! @file 			MPidC.cpp
+//! @author 		Geoffrey Hunter <gbmhunter@gmail.com> (www.mbedded.ninja)
+//! @edited 		n/a
+//! @created		2026-10-16
+//! @last-modified 	2026-10-16
+//! @brief 			Implementation of the C interface (api/MPidC.h) to the MPid shared library.
+//! @details
+//!					See README.rst in repo root dir for more info.
+
+#ifndef __cplusplus
+	#error Please build with C++ compiler
+#endif
+
+//===============================================================================================//
+//========================================= INCLUDES ============================================//
+//===============================================================================================//
+
+//===== SYSTEM LIBRARIES =====//
+#include <stdint.h>		// int32_t, uint32_t
+#include <stddef.h>		// size_t
+#include <new>			// std::bad_alloc
+
+//===== USER SOURCE =====//
+#include "../api/MPidC.h"
+#include "../include/FixedQ.hpp"
+#include "../include/PidBank.hpp"
+
+using namespace MbeddedNinja::MPidNs;
+
+//===============================================================================================//
+//===================================== CLASS DEFINITION ========================================//
+//===============================================================================================//
+
+//! @brief		The opaque handle. Each number type implements it with a PidBank of that type, so every
+//!				C function is one virtual call, and then a loop over the batch.
+struct MPidBank
+{
+	explicit MPidBank(MPidType type) : type(type) {}
+	virtual ~MPidBank() {}
+
+	virtual size_t Size() const = 0;
+	virtual MPidStatus Add(
+		size_t count, const void * kp, const void * ki, const void * kd,
+		const int32_t * directions, const int32_t * outputModes, const double * samplePeriodsMs,
+		const void * minOutputs, const void * maxOutputs, const void * setPoints) = 0;
+	virtual void SetTunings(size_t first, size_t count, const void * kp, const void * ki, const void * kd) = 0;
+	virtual void SetOutputLimits(size_t first, size_t count, const void * minOutputs, const void * maxOutputs) = 0;
+	virtual void SetSetPoints(size_t first, size_t count, const void * setPoints) = 0;
+	virtual void RunAll(const void * inputs, void * outputs) = 0;
+	virtual void GetStates(size_t first, size_t count,
+		void * setPoints, void * prevInputs, void * iTerms, void * prevOutputs, uint32_t * numTimesRan) const = 0;
+	virtual void SetStates(size_t first, size_t count,
+		const void * setPoints, const void * prevInputs, const void * iTerms, const void * prevOutputs,
+		const uint32_t * numTimesRan) = 0;
+
+	const MPidType type;
+};
+
+namespace
+{
+
+	//! @brief		An MPidBank holding controllers of one number type.
+	template <class dataType> class MPidBankOf : public MPidBank
+	{
+		public:
+
+			typedef typename PidBank<dataType>::ControllerDirection ControllerDirection;
+			typedef typename PidBank<dataType>::OutputMode OutputMode;
+			typedef typename PidBank<dataType>::samplePeriodType samplePeriodType;
+
+			MPidBankOf(MPidType type, size_t capacity) :
+				MPidBank(type)
+			{
+				this->bank.Reserve(capacity);
+			}
+
+			size_t Size() const
+			{
+				return this->bank.Size();
+			}
+
+			MPidStatus Add(
+				size_t count, const void * kp, const void * ki, const void * kd,
+				const int32_t * directions, const int32_t * outputModes, const double * samplePeriodsMs,
+				const void * minOutputs, const void * maxOutputs, const void * setPoints)
+			{
+				// Check everything first, so a bad argument doesn't leave half the batch added
+				for(size_t i = 0; i < count; i++)
+				{
+					if((directions[i] != MPID_DIRECT && directions[i] != MPID_REVERSE) ||
+						(outputModes[i] != MPID_DONT_ACCUMULATE_OUTPUT && outputModes[i] != MPID_ACCUMULATE_OUTPUT) ||
+						!(samplePeriodsMs[i] > 0))
+						return MPID_ERROR_ARGUMENT;
+				}
+
+				// Reserving is the only step that can fail, after which the adds can't
+				try
+				{
+					this->bank.Reserve(this->bank.Size() + count);
+				}
+				catch(const std::bad_alloc &)
+				{
+					return MPID_ERROR_NO_MEMORY;
+				}
+
+				for(size_t i = 0; i < count; i++)
+				{
+					this->bank.Add(
+						Values(kp)[i], Values(ki)[i], Values(kd)[i],
+						(directions[i] == MPID_REVERSE) ? ControllerDirection::PID_REVERSE : ControllerDirection::PID_DIRECT,
+						(outputModes[i] == MPID_ACCUMULATE_OUTPUT) ? OutputMode::ACCUMULATE_OUTPUT : OutputMode::DONT_ACCUMULATE_OUTPUT,
+						(samplePeriodType)samplePeriodsMs[i],
+						Values(minOutputs)[i], Values(maxOutputs)[i], Values(setPoints)[i]);
+				}
+				return MPID_OK;
+			}
+
+			void SetTunings(size_t first, size_t count, const void * kp, const void * ki, const void * kd)
+			{
+				for(size_t i = 0; i < count; i++)
+					this->bank.SetTunings(first + i, Values(kp)[i], Values(ki)[i], Values(kd)[i]);
+			}
+
+			void SetOutputLimits(size_t first, size_t count, const void * minOutputs, const void * maxOutputs)
+			{
+				for(size_t i = 0; i < count; i++)
+					this->bank.SetOutputLimits(first + i, Values(minOutputs)[i], Values(maxOutputs)[i]);
+			}
+
+			void SetSetPoints(size_t first, size_t count, const void * setPoints)
+			{
+				for(size_t i = 0; i < count; i++)
+					this->bank.SetSetPoint(first + i, Values(setPoints)[i]);
+			}
+
+			void RunAll(const void * inputs, void * outputs)
+			{
+				this->bank.RunAll(Values(inputs), Values(outputs));
+			}
+
+			void GetStates(size_t first, size_t count,
+				void * setPoints, void * prevInputs, void * iTerms, void * prevOutputs, uint32_t * numTimesRan) const
+			{
+				for(size_t i = 0; i < count; i++)
+				{
+					PidState<dataType> state = this->bank.GetState(first + i);
+					if(setPoints)
+						Values(setPoints)[i] = state.setPoint;
+					if(prevInputs)
+						Values(prevInputs)[i] = state.prevInput;
+					if(iTerms)
+						Values(iTerms)[i] = state.iTerm;
+					if(prevOutputs)
+						Values(prevOutputs)[i] = state.prevOutput;
+					if(numTimesRan)
+						numTimesRan[i] = state.numTimesRan;
+				}
+			}
+
+			void SetStates(size_t first, size_t count,
+				const void * setPoints, const void * prevInputs, const void * iTerms, const void * prevOutputs,
+				const uint32_t * numTimesRan)
+			{
+				for(size_t i = 0; i < count; i++)
+				{
+					PidState<dataType> state;
+					state.setPoint = Values(setPoints)[i];
+					state.prevInput = Values(prevInputs)[i];
+					state.iTerm = Values(iTerms)[i];
+					state.prevOutput = Values(prevOutputs)[i];
+					state.numTimesRan = numTimesRan[i];
+					this->bank.SetState(first + i, state);
+				}
+			}
+
+		private:
+
+			//! @brief		Views a C value array as an array of dataType.
+			static const dataType * Values(const void * values) { return static_cast<const dataType *>(values); }
+			static dataType * Values(void * values) { return static_cast<dataType *>(values); }
+
+			PidBank<dataType> bank;
+	};
+
+	static_assert(sizeof(Q16_16) == sizeof(int32_t), "Q16_16 values are passed as their raw int32_t.");
+
+	//! @brief		true if [first, first + count) is inside the bank.
+	bool InRange(const MPidBank * bank, size_t first, size_t count)
+	{
+		return first <= bank->Size() && count <= bank->Size() - first;
+	}
+
+} // namespace
+
+//===============================================================================================//
+//===================================== FUNCTION DEFINITIONS ====================================//
+//===============================================================================================//
+
+uint32_t MPid_GetAbiVersion(void)
+{
+	return M_PID_C_ABI_VERSION;
+}
+
+MPidBank * MPid_CreateBank(MPidType type, size_t capacity)
+{
+	// No exception may cross into the caller's language
+	try
+	{
+		switch(type)
+		{
+			case MPID_TYPE_FLOAT:
+				return new MPidBankOf<float>(type, capacity);
+			case MPID_TYPE_DOUBLE:
+				return new MPidBankOf<double>(type, capacity);
+			case MPID_TYPE_Q16_16:
+				return new MPidBankOf<Q16_16>(type, capacity);
+			default:
+				return NULL;
+		}
+	}
+	catch(const std::bad_alloc &)
+	{
+		return NULL;
+	}
+}
+
+void MPid_DestroyBank(MPidBank * bank)
+{
+	delete bank;
+}
+
+MPidType MPid_GetType(const MPidBank * bank)
+{
+	return bank->type;
+}
+
+size_t MPid_GetSize(const MPidBank * bank)
+{
+	return bank ? bank->Size() : 0;
+}
+
+MPidStatus MPid_AddControllers(
+	MPidBank * bank, size_t count,
+	const void * kp, const void * ki, const void * kd,
+	const int32_t * directions, const int32_t * outputModes, const double * samplePeriodsMs,
+	const void * minOutputs, const void * maxOutputs, const void * setPoints,
+	size_t * firstIndex)
+{
+	if(!bank || (count > 0 && (!kp || !ki || !kd || !directions || !outputModes || !samplePeriodsMs ||
+		!minOutputs || !maxOutputs || !setPoints)))
+		return MPID_ERROR_NULL;
+
+	size_t first = bank->Size();
+	MPidStatus status = bank->Add(count, kp, ki, kd, directions, outputModes, samplePeriodsMs, minOutputs, maxOutputs, setPoints);
+	if(status == MPID_OK && firstIndex)
+		*firstIndex = first;
+	return status;
+}
+
+MPidStatus MPid_SetTunings(
+	MPidBank * bank, size_t first, size_t count, const void * kp, const void * ki, const void * kd)
+{
+	if(!bank || (count > 0 && (!kp || !ki || !kd)))
+		return MPID_ERROR_NULL;
+	if(!InRange(bank, first, count))
+		return MPID_ERROR_RANGE;
+	bank->SetTunings(first, count, kp, ki, kd);
+	return MPID_OK;
+}
+
+MPidStatus MPid_SetOutputLimits(
+	MPidBank * bank, size_t first, size_t count, const void * minOutputs, const void * maxOutputs)
+{
+	if(!bank || (count > 0 && (!minOutputs || !maxOutputs)))
+		return MPID_ERROR_NULL;
+	if(!InRange(bank, first, count))
+		return MPID_ERROR_RANGE;
+	bank->SetOutputLimits(first, count, minOutputs, maxOutputs);
+	return MPID_OK;
+}
+
+MPidStatus MPid_SetSetPoints(MPidBank * bank, size_t first, size_t count, const void * setPoints)
+{
+	if(!bank || (count > 0 && !setPoints))
+		return MPID_ERROR_NULL;
+	if(!InRange(bank, first, count))
+		return MPID_ERROR_RANGE;
+	bank->SetSetPoints(first, count, setPoints);
+	return MPID_OK;
+}
+
+MPidStatus MPid_RunAll(MPidBank * bank, const void * inputs, void * outputs)
+{
+	if(!bank || (bank->Size() > 0 && (!inputs || !outputs)))
+		return MPID_ERROR_NULL;
+	bank->RunAll(inputs, outputs);
+	return MPID_OK;
+}
+
+MPidStatus MPid_GetStates(
+	const MPidBank * bank, size_t first, size_t count,
+	void * setPoints, void * prevInputs, void * iTerms, void * prevOutputs, uint32_t * numTimesRan)
+{
+	if(!bank)
+		return MPID_ERROR_NULL;
+	if(!InRange(bank, first, count))
+		return MPID_ERROR_RANGE;
+	bank->GetStates(first, count, setPoints, prevInputs, iTerms, prevOutputs, numTimesRan);
+	return MPID_OK;
+}
+
+MPidStatus MPid_SetStates(
+	MPidBank * bank, size_t first, size_t count,
+	const void * setPoints, const void * prevInputs, const void * iTerms, const void * prevOutputs,
+	const uint32_t * numTimesRan)
+{
+	if(!bank || (count > 0 && (!setPoints || !prevInputs || !iTerms || !prevOutputs || !numTimesRan)))
+		return MPID_ERROR_NULL;
+	if(!InRange(bank, first, count))
+		return MPID_ERROR_RANGE;
+	bank->SetStates(first, count, setPoints, prevInputs, iTerms, prevOutputs, numTimesRan);
+	return MPID_OK;
+}
+
+// EOF
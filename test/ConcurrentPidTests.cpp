@@ -0,0 +1,96 @@
+//!
+//! @file 			ConcurrentPidTests.cpp
+//! @author 		Geoffrey Hunter <gbmhunter@gmail.com> (www.mbedded.ninja)
+//! @edited 		n/a
+//! @created		2026-10-16
+//! @last-modified 	2026-10-16
+//! @brief 			Unit tests for SeqLock and ConcurrentPid.
+//! @details
+//!					See README.rst in repo root dir for more info.
+
+//===== SYSTEM LIBRARIES =====//
+#include <atomic>
+#include <thread>
+
+//====== USER LIBRARIES =====//
+#include "MUnitTest/MUnitTestApi.hpp"
+
+//===== USER SOURCE =====//
+#include "../api/MPidApi.hpp"
+
+using namespace MbeddedNinja::MPidNs;
+
+namespace MPidTests
+{
+
+	MTEST(ConcurrentPidAppliesOnNextRunTest)
+	{
+		ConcurrentPid<double> pidTest(
+			1.0,									//!< Kp
+			0.0,									//!< Ki
+			0.0,									//!< Kd
+			ConcurrentPid<double>::ControllerDirection::PID_DIRECT,		//!< Control type
+			ConcurrentPid<double>::OutputMode::DONT_ACCUMULATE_OUTPUT,	//!< Control type
+			1000.0,								//!< Update rate (ms)
+			-100.0,									//!< Min output
+			100.0,								//!< Max output
+			0.0									//!< Initial set-point
+		);
+
+		pidTest.Run(1.0);
+		CHECK_CLOSE(pidTest.GetOutput(), -1.0, 0.0001);
+
+		// Nothing changes until the next Run()
+		pidTest.SetParameters(2.0, 0.0, 0.0, -100.0, 100.0, 5.0);
+		CHECK_CLOSE(pidTest.GetOutput(), -1.0, 0.0001);
+		CHECK_CLOSE(pidTest.GetPid().GetKp(), 1.0, 0.0001);
+
+		pidTest.Run(1.0);
+		CHECK_CLOSE(pidTest.GetOutput(), 8.0, 0.0001);
+		CHECK_CLOSE(pidTest.GetPid().GetKp(), 2.0, 0.0001);
+
+		// Reversing the direction negates the time-scaled gains
+		pidTest.SetControllerDirection(ConcurrentPid<double>::ControllerDirection::PID_REVERSE);
+		pidTest.Run(1.0);
+		CHECK_CLOSE(pidTest.GetPid().GetZp(), -2.0, 0.0001);
+		CHECK_CLOSE(pidTest.GetOutput(), -8.0, 0.0001);
+	}
+
+	MTEST(ConcurrentPidNoTornParametersTest)
+	{
+		ConcurrentPid<double> pidTest(
+			1.0, 1.0, 1.0,
+			ConcurrentPid<double>::ControllerDirection::PID_DIRECT,
+			ConcurrentPid<double>::OutputMode::DONT_ACCUMULATE_OUTPUT,
+			1000.0, -2.0, 2.0, 1.0);
+
+		std::atomic<bool> stop(false);
+
+		// Every block the writer publishes has all values derived from the same k, so any
+		// mix of old and new values is detectable
+		std::thread writer([&]()
+		{
+			for(int k = 1; !stop.load(); k = (k % 1000) + 1)
+				pidTest.SetParameters((double)k, (double)k, (double)k, (double)-k - 1.0, (double)k + 1.0, (double)k);
+		});
+
+		bool consistent = true;
+		for(int i = 0; i < 200000 && consistent; i++)
+		{
+			pidTest.Run(0.0);
+			Pid<double> & pid = pidTest.GetPid();
+			double k = pid.GetKp();
+			consistent = (pid.GetKi() == k) && (pid.GetKd() == k) && (pid.GetZi() == k) &&
+				(pid.setPoint == k) && (pidTest.GetOutput() <= k + 1.0) && (pidTest.GetOutput() >= -k - 1.0);
+		}
+
+		stop.store(true);
+		writer.join();
+
+		CHECK(consistent);
+		CHECK(pidTest.GetNumPublished() > 1);
+	}
+
+} // namespace MPidTests
+
+// EOF
@@ -0,0 +1,76 @@
+//!
+//! @file 			ConstexprTests.cpp
+//! @author 		Geoffrey Hunter <gbmhunter@gmail.com> (www.mbedded.ninja)
+//! @edited 		n/a
+//! @created		2026-10-16
+//! @last-modified 	2026-10-16
+//! @brief 			Unit tests for building controllers at compile time.
+//! @details
+//!					See README.rst in repo root dir for more info.
+
+//===== SYSTEM LIBRARIES =====//
+#include <stdint.h>
+
+//====== USER LIBRARIES =====//
+#include "MUnitTest/MUnitTestApi.hpp"
+
+//===== USER SOURCE =====//
+#include "../api/MPidApi.hpp"
+
+using namespace MbeddedNinja::MPidNs;
+
+namespace MPidTests
+{
+
+	typedef Pid<float>::ControllerDirection ConstexprDir;
+	typedef Pid<float>::OutputMode ConstexprMode;
+
+	//===== Checked by the compiler =====//
+
+	static constexpr Pid<float> constexprPid(
+		2.0f, 0.5f, 0.1f, ConstexprDir::PID_REVERSE, ConstexprMode::DONT_ACCUMULATE_OUTPUT, 10.0, -1.0f, 1.0f, 0.0f);
+	static_assert(constexprPid.GetKi() == 0.5f, "Gains are stored at compile time.");
+	static_assert(constexprPid.GetZp() == -2.0f, "The direction is applied at compile time.");
+	static_assert(constexprPid.GetZi() == -PidTraits<float>::ScaleKi(0.5f, 10.0), "Zi is scaled at compile time.");
+	static_assert(constexprPid.GetZd() == -PidTraits<float>::ScaleKd(0.1f, 10.0), "Zd is scaled at compile time.");
+
+	static constexpr Pid<float> constexprInvalidPid(
+		2.0f, -0.5f, 0.1f, ConstexprDir::PID_DIRECT, ConstexprMode::DONT_ACCUMULATE_OUTPUT, 10.0, -1.0f, 1.0f, 0.0f);
+	static_assert(constexprInvalidPid.GetKp() == 0.0f && constexprInvalidPid.GetZd() == 0.0f, "A negative gain zeroes the gains.");
+
+	static constexpr Pid<Q16_16> constexprFixedPid(
+		Q16_16(1), Q16_16(2), Q16_16(3), Pid<Q16_16>::ControllerDirection::PID_DIRECT,
+		Pid<Q16_16>::OutputMode::DONT_ACCUMULATE_OUTPUT, 100, Q16_16(-10), Q16_16(10), Q16_16(0));
+	static_assert(constexprFixedPid.GetZi() == Q16_16(0.2), "Fixed-point gains are scaled at compile time.");
+	static_assert(constexprFixedPid.GetZd() == Q16_16(30), "Fixed-point gains are scaled at compile time.");
+
+	static constexpr StaticPid<double, ReverseAction> constexprStaticPid(1.0, 4.0, 0.0, 20.0, -5.0, 5.0, 0.0);
+	static_assert(constexprStaticPid.GetZi() == -0.08, "StaticPid gains are scaled at compile time.");
+
+	//===== A table of controllers, constant-initialised (no code runs at startup) =====//
+
+	static Pid<float> constexprTable[] = {
+		{ 1.0f, 0.0f, 0.0f, ConstexprDir::PID_DIRECT, ConstexprMode::DONT_ACCUMULATE_OUTPUT, 10.0, -10.0f, 10.0f, 1.0f },
+		{ 3.0f, 0.0f, 0.0f, ConstexprDir::PID_REVERSE, ConstexprMode::DONT_ACCUMULATE_OUTPUT, 10.0, -10.0f, 10.0f, 1.0f },
+	};
+
+	MTEST(ConstexprTableRunsTest)
+	{
+		constexprTable[0].Run(0.0f);
+		constexprTable[1].Run(0.0f);
+		CHECK_CLOSE(constexprTable[0].output, 1.0f, 1e-6f);
+		CHECK_CLOSE(constexprTable[1].output, -3.0f, 1e-6f);
+	}
+
+	MTEST(ConstexprConstructorMatchesSetTuningsTest)
+	{
+		// Built at run time, with the same arguments as constexprPid, then re-tuned the old way
+		Pid<float> pid(2.0f, 0.5f, 0.1f, ConstexprDir::PID_REVERSE, ConstexprMode::DONT_ACCUMULATE_OUTPUT, 10.0, -1.0f, 1.0f, 0.0f);
+		CHECK_EQUAL(pid.GetZi(), constexprPid.GetZi());
+		pid.SetTunings(2.0f, 0.5f, 0.1f);
+		CHECK_EQUAL(pid.GetZp(), constexprPid.GetZp());
+		CHECK_EQUAL(pid.GetZi(), constexprPid.GetZi());
+		CHECK_EQUAL(pid.GetZd(), constexprPid.GetZd());
+	}
+
+} // namespace MPidTests
@@ -0,0 +1,130 @@
+//!
+//! @file 			FixedQTests.cpp
+//! @author 		Geoffrey Hunter <gbmhunter@gmail.com> (www.mbedded.ninja)
+//! @edited 		n/a
+//! @created		2026-10-16
+//! @last-modified 	2026-10-16
+//! @brief 			Unit tests for the FixedQ number type and Pid<FixedQ<...>>.
+//! @details
+//!					See README.rst in repo root dir for more info.
+
+//===== SYSTEM LIBRARIES =====//
+#include <stdint.h>
+#include <limits>
+
+//====== USER LIBRARIES =====//
+#include "MUnitTest/MUnitTestApi.hpp"
+
+//===== USER SOURCE =====//
+#include "../api/MPidApi.hpp"
+
+using namespace MbeddedNinja::MPidNs;
+
+namespace MPidTests
+{
+
+	MTEST(FixedQArithmeticTest)
+	{
+		Q16_16 a(1.5);
+		Q16_16 b(2.25);
+
+		CHECK_CLOSE((a + b).ToDouble(), 3.75, 0.0001);
+		CHECK_CLOSE((a - b).ToDouble(), -0.75, 0.0001);
+		CHECK_CLOSE((a * b).ToDouble(), 3.375, 0.0001);
+		CHECK_CLOSE((b / a).ToDouble(), 1.5, 0.0001);
+		CHECK_CLOSE((-a).ToDouble(), -1.5, 0.0001);
+		CHECK_CLOSE(Q16_16(-3).ToDouble(), -3.0, 0.0001);
+		CHECK(Q16_16(2) > a);
+		CHECK(0 < a);
+	}
+
+	MTEST(FixedQSaturationTest)
+	{
+		const Q16_16 max = Q16_16::FromRaw(std::numeric_limits<int32_t>::max());
+		const Q16_16 min = Q16_16::FromRaw(std::numeric_limits<int32_t>::min());
+
+		// Results saturate instead of wrapping
+		CHECK(max + Q16_16(1) == max);
+		CHECK(min - Q16_16(1) == min);
+		CHECK(-min == max);
+		CHECK(Q16_16(1000)*Q16_16(1000) == max);
+		CHECK(Q16_16(-1000)*Q16_16(1000) == min);
+		CHECK(Q16_16(100000) == max);
+		CHECK(Q16_16(1)/Q16_16(0) == max);
+		CHECK(Q16_16(-1)/Q16_16(0) == min);
+	}
+
+	MTEST(FixedQPidGainScalingTest)
+	{
+		// Sample period is an integer number of milliseconds for fixed-point types
+		Pid<Q16_16> pidTest(
+			Q16_16(1),									//!< Kp
+			Q16_16(5),									//!< Ki
+			Q16_16(6),									//!< Kd
+			Pid<Q16_16>::ControllerDirection::PID_DIRECT,		//!< Control type
+			Pid<Q16_16>::OutputMode::DONT_ACCUMULATE_OUTPUT,	//!< Control type
+			10,											//!< Update rate (ms)
+			Q16_16(-100),								//!< Min output
+			Q16_16(100),								//!< Max output
+			Q16_16(0)									//!< Initial set-point
+		);
+
+		// Zi = 5*10/1000, Zd = 6*1000/10, both computed with integer maths
+		CHECK_EQUAL(pidTest.GetZp().GetRaw(), 65536);
+		CHECK_EQUAL(pidTest.GetZi().GetRaw(), 5*65536*10/1000);
+		CHECK_EQUAL(pidTest.GetZd().GetRaw(), 600*65536);
+
+		// Doubling the sample period doubles Zi and halves Zd
+		pidTest.SetSamplePeriod(20);
+		CHECK_EQUAL(pidTest.GetZi().GetRaw(), 2*(5*65536*10/1000));
+		CHECK_EQUAL(pidTest.GetZd().GetRaw(), 300*65536);
+	}
+
+	MTEST(FixedQPidIOnlyTest)
+	{
+		Pid<Q8_24> pidTest(
+			Q8_24(0),									//!< Kp
+			Q8_24(10),									//!< Ki
+			Q8_24(0),									//!< Kd
+			Pid<Q8_24>::ControllerDirection::PID_DIRECT,		//!< Control type
+			Pid<Q8_24>::OutputMode::DONT_ACCUMULATE_OUTPUT,	//!< Control type
+			1000,										//!< Update rate (ms)
+			Q8_24(-100),								//!< Min output
+			Q8_24(100),									//!< Max output
+			Q8_24(0)									//!< Initial set-point
+		);
+
+		pidTest.Run(Q8_24(-1));
+		CHECK_CLOSE(pidTest.output.ToDouble(), 10.0, 0.0001);
+
+		pidTest.Run(Q8_24(-1));
+		CHECK_CLOSE(pidTest.output.ToDouble(), 20.0, 0.0001);
+	}
+
+#if defined(__SIZEOF_INT128__)
+	MTEST(FixedQPidMatchesDoubleTest)
+	{
+		Pid<Q32_32> pidFixed(
+			Q32_32(2), Q32_32(1), Q32_32(0.5),
+			Pid<Q32_32>::ControllerDirection::PID_REVERSE,
+			Pid<Q32_32>::OutputMode::ACCUMULATE_OUTPUT,
+			100, Q32_32(-50), Q32_32(50), Q32_32(3));
+		Pid<double> pidDouble(
+			2.0, 1.0, 0.5,
+			Pid<double>::ControllerDirection::PID_REVERSE,
+			Pid<double>::OutputMode::ACCUMULATE_OUTPUT,
+			100.0, -50.0, 50.0, 3.0);
+
+		const double inputs[] = { 0.0, 0.5, 1.25, 2.0, 2.5, 3.5, 3.0, 2.75 };
+		for(size_t i = 0; i < sizeof(inputs)/sizeof(inputs[0]); i++)
+		{
+			pidFixed.Run(Q32_32(inputs[i]));
+			pidDouble.Run(inputs[i]);
+			CHECK_CLOSE(pidFixed.output.ToDouble(), pidDouble.output, 0.0001);
+		}
+	}
+#endif
+
+} // namespace MPidTests
+
+// EOF
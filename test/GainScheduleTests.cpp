@@ -0,0 +1,95 @@
+//!
+//! @file 			GainScheduleTests.cpp
+//! @author 		Geoffrey Hunter <gbmhunter@gmail.com> (www.mbedded.ninja)
+//! @edited 		n/a
+//! @created		2026-10-16
+//! @last-modified 	2026-10-16
+//! @brief 			Unit tests for GainSchedule and Pid::RunScheduled().
+//! @details
+//!					See README.rst in repo root dir for more info.
+
+//===== SYSTEM LIBRARIES =====//
+#include <stdint.h>
+
+//====== USER LIBRARIES =====//
+#include "MUnitTest/MUnitTestApi.hpp"
+
+//===== USER SOURCE =====//
+#include "../api/MPidApi.hpp"
+
+using namespace MbeddedNinja::MPidNs;
+
+namespace MPidTests
+{
+
+	MTEST(GainScheduleOneVariableTest)
+	{
+		// Kp = 1, 2, 4 at x = 0, 10, 20. Ki = 2*Kp, Kd = Kp/10. 100ms sample period.
+		GainSchedule<double> schedule(100.0, 0.0, 20.0, 3);
+		CHECK(schedule.SetTunings(0, 1.0, 2.0, 0.1));
+		CHECK(schedule.SetTunings(1, 2.0, 4.0, 0.2));
+		CHECK(schedule.SetTunings(2, 4.0, 8.0, 0.4));
+		CHECK(!schedule.SetTunings(3, 1.0, 1.0, 1.0));
+		CHECK(!schedule.SetTunings(0, -1.0, 1.0, 1.0));
+
+		double zp, zi, zd;
+		schedule.Lookup(10.0, 0.0, zp, zi, zd);
+		CHECK_EQUAL(zp, 2.0);
+		CHECK_CLOSE(zi, 0.4, 1e-12);
+		CHECK_CLOSE(zd, 2.0, 1e-12);
+
+		schedule.Lookup(15.0, 0.0, zp, zi, zd);
+		CHECK_CLOSE(zp, 3.0, 1e-12);
+
+		// Clamped at both ends
+		schedule.Lookup(-100.0, 0.0, zp, zi, zd);
+		CHECK_EQUAL(zp, 1.0);
+		schedule.Lookup(100.0, 0.0, zp, zi, zd);
+		CHECK_EQUAL(zp, 4.0);
+	}
+
+	MTEST(GainScheduleTwoVariableTest)
+	{
+		GainSchedule<float> schedule(10.0, 0.0f, 1.0f, 2, 0.0f, 2.0f, 3);
+		for(size_t iy = 0; iy < 3; iy++)
+			for(size_t ix = 0; ix < 2; ix++)
+				CHECK(schedule.SetTunings(ix, iy, (float)(ix + 10*iy), 0.0f, 0.0f));
+
+		float zp, zi, zd;
+		schedule.Lookup(0.5f, 1.5f, zp, zi, zd);
+		CHECK_CLOSE(zp, 15.5f, 1e-5f);
+		schedule.Lookup(1.0f, 2.0f, zp, zi, zd);
+		CHECK_EQUAL(zp, 21.0f);
+	}
+
+	MTEST(RunScheduledMatchesSetTuningsTest)
+	{
+		typedef Pid<double>::ControllerDirection Dir;
+		typedef Pid<double>::OutputMode Mode;
+
+		GainSchedule<double> schedule(10.0, 0.0, 3.0, 4);
+		for(size_t ix = 0; ix < 4; ix++)
+			schedule.SetTunings(ix, 1.0 + ix, 0.5*ix, 0.01*ix);
+
+		const Dir dirs[2] = { Dir::PID_DIRECT, Dir::PID_REVERSE };
+		for(int d = 0; d < 2; d++)
+		{
+			Pid<double> scheduled(1.0, 0.0, 0.0, dirs[d], Mode::DONT_ACCUMULATE_OUTPUT, 10.0, -100.0, 100.0, 5.0);
+			Pid<double> tuned(1.0, 0.0, 0.0, dirs[d], Mode::DONT_ACCUMULATE_OUTPUT, 10.0, -100.0, 100.0, 5.0);
+
+			bool same = true;
+			for(uint32_t tick = 0; tick < 100; tick++)
+			{
+				// Operating point on the grid points, so no interpolation
+				size_t ix = (tick/7) % 4;
+				double input = (double)(tick % 13);
+				scheduled.RunScheduled(input, schedule, (double)ix);
+				tuned.SetTunings(1.0 + ix, 0.5*ix, 0.01*ix);
+				tuned.Run(input);
+				same = same && scheduled.output == tuned.output;
+			}
+			CHECK(same);
+		}
+	}
+
+} // namespace MPidTests
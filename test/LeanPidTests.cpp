@@ -0,0 +1,106 @@
+//!
+//! @file 			LeanPidTests.cpp
+//! @author 		Geoffrey Hunter <gbmhunter@gmail.com> (www.mbedded.ninja)
+//! @edited 		n/a
+//! @created		2026-10-16
+//! @last-modified 	2026-10-16
+//! @brief 			Unit tests for the LeanPid class.
+//! @details
+//!					See README.rst in repo root dir for more info.
+
+//===== SYSTEM LIBRARIES =====//
+#include <stdint.h>
+#include <vector>
+
+//====== USER LIBRARIES =====//
+#include "MUnitTest/MUnitTestApi.hpp"
+
+//===== USER SOURCE =====//
+#include "../api/MPidApi.hpp"
+
+using namespace MbeddedNinja::MPidNs;
+
+namespace MPidTests
+{
+
+	typedef LeanPidParams<float>::ControllerDirection LeanDir;
+	typedef LeanPidParams<float>::OutputMode LeanMode;
+
+	//===== Checked by the compiler =====//
+
+	static constexpr LeanPidParams<float> constexprLeanParams(
+		2.0f, 0.5f, 0.1f, LeanDir::PID_REVERSE, LeanMode::DONT_ACCUMULATE_OUTPUT, 10.0, -1.0f, 1.0f);
+	static_assert(constexprLeanParams.GetZp() == -2.0f, "The direction is applied at compile time.");
+	static_assert(constexprLeanParams.GetZi() == -PidTraits<float>::ScaleKi(0.5f, 10.0), "Zi is scaled at compile time.");
+
+	//! @brief		Checks a LeanPid primed with the first input gives exactly the same outputs as a Pid.
+	template <class dataType> static bool LeanPidMatchesPid(
+		typename Pid<dataType>::ControllerDirection dir, typename Pid<dataType>::OutputMode mode)
+	{
+		const dataType setPoint = dataType(3);
+		Pid<dataType> pid(dataType(2), dataType(3), dataType(1), dir, mode, 10, dataType(-100), dataType(100), setPoint);
+		LeanPidParams<dataType> params(dataType(2), dataType(3), dataType(1), dir, mode, 10, dataType(-100), dataType(100));
+		LeanPid<dataType> lean(dataType(-6));
+
+		for(int i = 0; i < 100; i++)
+		{
+			dataType input = dataType(i % 13) - dataType(6);
+			pid.Run(input);
+			if(!(lean.Run(params, setPoint, input) == pid.output) || !(lean.GetOutput() == pid.output))
+				return false;
+		}
+		return true;
+	}
+
+	MTEST(LeanPidMatchesPidTest)
+	{
+		typedef Pid<double>::ControllerDirection Dir;
+		typedef Pid<double>::OutputMode Mode;
+		CHECK(LeanPidMatchesPid<double>(Dir::PID_DIRECT, Mode::DONT_ACCUMULATE_OUTPUT));
+		CHECK(LeanPidMatchesPid<double>(Dir::PID_REVERSE, Mode::ACCUMULATE_OUTPUT));
+		CHECK(LeanPidMatchesPid<float>(Pid<float>::ControllerDirection::PID_REVERSE, Pid<float>::OutputMode::DONT_ACCUMULATE_OUTPUT));
+		CHECK(LeanPidMatchesPid<Q16_16>(Pid<Q16_16>::ControllerDirection::PID_DIRECT, Pid<Q16_16>::OutputMode::ACCUMULATE_OUTPUT));
+	}
+
+	MTEST(LeanPidSharedParamsTest)
+	{
+		LeanPidParams<float> params(1.0f, 0.0f, 0.0f, LeanDir::PID_DIRECT, LeanMode::DONT_ACCUMULATE_OUTPUT, 10.0, -10.0f, 10.0f);
+		std::vector<LeanPid<float>> pids(64);
+		std::vector<float> setPoints(64, 2.0f);
+		std::vector<float> inputs(64);
+		std::vector<float> outputs(64);
+		for(size_t i = 0; i < inputs.size(); i++)
+			inputs[i] = (float)(i % 4);
+
+		RunLeanPids(params, pids.data(), setPoints.data(), inputs.data(), outputs.data(), pids.size());
+		CHECK_CLOSE(outputs[0], 2.0f, 1e-6f);
+		CHECK_CLOSE(outputs[3], -1.0f, 1e-6f);
+		CHECK_EQUAL(pids[3].GetOutput(), outputs[3]);
+
+		// Re-tuning the shared parameters changes every controller
+		params.SetTunings(3.0f, 0.0f, 0.0f);
+		params.SetOutputLimits(-2.0f, 2.0f);
+		RunLeanPids(params, pids.data(), setPoints.data(), inputs.data(), outputs.data(), pids.size());
+		CHECK_CLOSE(outputs[0], 2.0f, 1e-6f);
+		CHECK_CLOSE(outputs[1], 2.0f, 1e-6f);
+		CHECK_CLOSE(outputs[3], -2.0f, 1e-6f);
+
+		// Invalid tunings and limits are ignored, like Pid
+		params.SetTunings(-1.0f, 0.0f, 0.0f);
+		params.SetOutputLimits(1.0f, -1.0f);
+		CHECK_EQUAL(params.GetKp(), 3.0f);
+		CHECK_EQUAL(params.GetOutMax(), 2.0f);
+
+		pids[0].Reset(0.0f);
+		CHECK_EQUAL(pids[0].GetOutput(), 0.0f);
+		CHECK_EQUAL(pids[0].GetITerm(), 0.0f);
+	}
+
+	MTEST(LeanPidSizeTest)
+	{
+		CHECK_EQUAL(sizeof(LeanPid<float>), 3*sizeof(float));
+		CHECK_EQUAL(sizeof(LeanPid<double>), 3*sizeof(double));
+		CHECK(sizeof(LeanPid<float>) < sizeof(Pid<float>));
+	}
+
+} // namespace MPidTests
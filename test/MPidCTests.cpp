@@ -0,0 +1,187 @@
+//!
+//! @file 			MPidCTests.cpp
+//! @author 		Geoffrey Hunter <gbmhunter@gmail.com> (www.mbedded.ninja)
+//! @edited 		n/a
+//! @created		2026-10-16
+//! @last-modified 	2026-10-16
+//! @brief 			Unit tests for the C interface to the MPid shared library.
+//! @details
+//!					See README.rst in repo root dir for more info.
+
+//===== SYSTEM LIBRARIES =====//
+#include <stdint.h>
+#include <vector>
+
+//====== USER LIBRARIES =====//
+#include "MUnitTest/MUnitTestApi.hpp"
+
+//===== USER SOURCE =====//
+#include "../api/MPidApi.hpp"
+#include "../api/MPidC.h"
+
+using namespace MbeddedNinja::MPidNs;
+
+namespace MPidTests
+{
+
+	//! @brief		Parameters for numControllers controllers, as the C interface takes them.
+	template <class dataType> struct CBatch
+	{
+		explicit CBatch(size_t numControllers)
+		{
+			for(size_t i = 0; i < numControllers; i++)
+			{
+				kp.push_back(dataType(1 + i % 4));
+				ki.push_back(dataType(i % 5));
+				kd.push_back(dataType(0.5*(double)(i % 3)));
+				directions.push_back((i % 3 == 0) ? MPID_REVERSE : MPID_DIRECT);
+				outputModes.push_back((i % 2 == 0) ? MPID_ACCUMULATE_OUTPUT : MPID_DONT_ACCUMULATE_OUTPUT);
+				samplePeriodsMs.push_back(100.0);
+				minOutputs.push_back(dataType(-50));
+				maxOutputs.push_back(dataType(50));
+				setPoints.push_back(dataType(i % 7));
+			}
+		}
+
+		MPidStatus AddTo(MPidBank * bank, size_t * firstIndex)
+		{
+			return MPid_AddControllers(bank, kp.size(), kp.data(), ki.data(), kd.data(),
+				directions.data(), outputModes.data(), samplePeriodsMs.data(),
+				minOutputs.data(), maxOutputs.data(), setPoints.data(), firstIndex);
+		}
+
+		std::vector<dataType> kp, ki, kd, minOutputs, maxOutputs, setPoints;
+		std::vector<int32_t> directions, outputModes;
+		std::vector<double> samplePeriodsMs;
+	};
+
+	MTEST(MPidCMatchesPidTest)
+	{
+		const size_t numControllers = 37;
+		MPidBank * bank = MPid_CreateBank(MPID_TYPE_DOUBLE, numControllers);
+		CHECK(bank != NULL);
+		CHECK_EQUAL(MPid_GetType(bank), MPID_TYPE_DOUBLE);
+
+		CBatch<double> batch(numControllers);
+		size_t first = 99;
+		CHECK_EQUAL(batch.AddTo(bank, &first), MPID_OK);
+		CHECK_EQUAL(first, 0);
+		CHECK_EQUAL(MPid_GetSize(bank), numControllers);
+
+		std::vector<Pid<double>> pids;
+		for(size_t i = 0; i < numControllers; i++)
+			pids.push_back(Pid<double>(batch.kp[i], batch.ki[i], batch.kd[i],
+				(i % 3 == 0) ? Pid<double>::ControllerDirection::PID_REVERSE : Pid<double>::ControllerDirection::PID_DIRECT,
+				(i % 2 == 0) ? Pid<double>::OutputMode::ACCUMULATE_OUTPUT : Pid<double>::OutputMode::DONT_ACCUMULATE_OUTPUT,
+				100.0, -50.0, 50.0, batch.setPoints[i]));
+
+		std::vector<double> inputs(numControllers);
+		std::vector<double> outputs(numControllers);
+		bool identical = true;
+		for(int tick = 0; tick < 20; tick++)
+		{
+			for(size_t i = 0; i < numControllers; i++)
+				inputs[i] = (double)((tick*7 + (int)i) % 11) - 5.0;
+			CHECK_EQUAL(MPid_RunAll(bank, inputs.data(), outputs.data()), MPID_OK);
+			for(size_t i = 0; i < numControllers; i++)
+			{
+				pids[i].Run(inputs[i]);
+				identical = identical && (pids[i].output == outputs[i]);
+			}
+		}
+		CHECK(identical);
+
+		// Read back part of the state, skipping the set-points
+		std::vector<double> iTerms(10);
+		std::vector<uint32_t> numTimesRan(10);
+		CHECK_EQUAL(MPid_GetStates(bank, 20, 10, NULL, NULL, iTerms.data(), NULL, numTimesRan.data()), MPID_OK);
+		CHECK_EQUAL(iTerms[3], pids[23].GetState().iTerm);
+		CHECK_EQUAL(numTimesRan[3], 1);
+
+		// Re-tune a batch, in the middle of the bank
+		std::vector<double> gains(5, 2.0);
+		CHECK_EQUAL(MPid_SetTunings(bank, 30, 5, gains.data(), gains.data(), gains.data()), MPID_OK);
+		std::vector<double> setPoints(5, 1.0);
+		CHECK_EQUAL(MPid_SetSetPoints(bank, 30, 5, setPoints.data()), MPID_OK);
+		for(size_t i = 30; i < 35; i++)
+		{
+			pids[i].SetTunings(2.0, 2.0, 2.0);
+			pids[i].setPoint = 1.0;
+		}
+		CHECK_EQUAL(MPid_RunAll(bank, inputs.data(), outputs.data()), MPID_OK);
+		pids[32].Run(inputs[32]);
+		CHECK_EQUAL(outputs[32], pids[32].output);
+
+		MPid_DestroyBank(bank);
+	}
+
+	MTEST(MPidCStatesRoundTripTest)
+	{
+		const size_t numControllers = 50;
+		MPidBank * primary = MPid_CreateBank(MPID_TYPE_Q16_16, 0);
+		MPidBank * standby = MPid_CreateBank(MPID_TYPE_Q16_16, 0);
+		CBatch<Q16_16> batch(numControllers);
+		CHECK_EQUAL(batch.AddTo(primary, NULL), MPID_OK);
+		CHECK_EQUAL(batch.AddTo(standby, NULL), MPID_OK);
+
+		// Q16_16 values are raw int32_t on the C side
+		std::vector<int32_t> inputs(numControllers);
+		std::vector<int32_t> primaryOutputs(numControllers);
+		std::vector<int32_t> standbyOutputs(numControllers);
+		for(int tick = 0; tick < 10; tick++)
+		{
+			for(size_t i = 0; i < numControllers; i++)
+				inputs[i] = (int32_t)(((tick + i) % 9)*65536) - 4*65536;
+			MPid_RunAll(primary, inputs.data(), primaryOutputs.data());
+		}
+
+		std::vector<int32_t> setPoints(numControllers), prevInputs(numControllers), iTerms(numControllers), prevOutputs(numControllers);
+		std::vector<uint32_t> numTimesRan(numControllers);
+		CHECK_EQUAL(MPid_GetStates(primary, 0, numControllers,
+			setPoints.data(), prevInputs.data(), iTerms.data(), prevOutputs.data(), numTimesRan.data()), MPID_OK);
+		CHECK_EQUAL(MPid_SetStates(standby, 0, numControllers,
+			setPoints.data(), prevInputs.data(), iTerms.data(), prevOutputs.data(), numTimesRan.data()), MPID_OK);
+
+		bool identical = true;
+		for(int tick = 0; tick < 10; tick++)
+		{
+			for(size_t i = 0; i < numControllers; i++)
+				inputs[i] = (int32_t)(((tick*3 + i) % 7)*32768) - 2*65536;
+			MPid_RunAll(primary, inputs.data(), primaryOutputs.data());
+			MPid_RunAll(standby, inputs.data(), standbyOutputs.data());
+			identical = identical && (primaryOutputs == standbyOutputs);
+		}
+		CHECK(identical);
+
+		MPid_DestroyBank(primary);
+		MPid_DestroyBank(standby);
+	}
+
+	MTEST(MPidCErrorsTest)
+	{
+		CHECK_EQUAL(MPid_GetAbiVersion(), M_PID_C_ABI_VERSION);
+		CHECK(MPid_CreateBank((MPidType)7, 10) == NULL);
+		MPid_DestroyBank(NULL);
+
+		MPidBank * bank = MPid_CreateBank(MPID_TYPE_FLOAT, 4);
+		CBatch<float> batch(4);
+		CHECK_EQUAL(batch.AddTo(NULL, NULL), MPID_ERROR_NULL);
+
+		// A bad direction rejects the whole batch
+		batch.directions[2] = 5;
+		CHECK_EQUAL(batch.AddTo(bank, NULL), MPID_ERROR_ARGUMENT);
+		CHECK_EQUAL(MPid_GetSize(bank), 0);
+		batch.directions[2] = MPID_DIRECT;
+		CHECK_EQUAL(batch.AddTo(bank, NULL), MPID_OK);
+
+		std::vector<float> values(4, 1.0f);
+		CHECK_EQUAL(MPid_SetTunings(bank, 2, 3, values.data(), values.data(), values.data()), MPID_ERROR_RANGE);
+		CHECK_EQUAL(MPid_SetSetPoints(bank, 5, 0, values.data()), MPID_ERROR_RANGE);
+		CHECK_EQUAL(MPid_SetOutputLimits(bank, 0, 1, NULL, values.data()), MPID_ERROR_NULL);
+		CHECK_EQUAL(MPid_RunAll(bank, NULL, values.data()), MPID_ERROR_NULL);
+		CHECK_EQUAL(MPid_GetStates(bank, 4, 0, NULL, NULL, NULL, NULL, NULL), MPID_OK);
+
+		MPid_DestroyBank(bank);
+	}
+
+} // namespace MPidTests
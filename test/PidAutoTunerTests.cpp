@@ -0,0 +1,115 @@
+//!
+//! @file 			PidAutoTunerTests.cpp
+//! @author 		Geoffrey Hunter <gbmhunter@gmail.com> (www.mbedded.ninja)
+//! @edited 		n/a
+//! @created		2026-10-16
+//! @last-modified 	2026-10-16
+//! @brief 			Unit tests for the relay experiment, tuning rules and PidAutoTuner.
+//! @details
+//!					See README.rst in repo root dir for more info.
+
+//===== SYSTEM LIBRARIES =====//
+#include <math.h>
+#include <vector>
+
+//====== USER LIBRARIES =====//
+#include "MUnitTest/MUnitTestApi.hpp"
+
+//===== USER SOURCE =====//
+#include "../api/MPidApi.hpp"
+
+using namespace MbeddedNinja::MPidNs;
+
+namespace MPidTests
+{
+
+	MTEST(RelayIdentifiesIntegratorWithDeadTimeTest)
+	{
+		// An integrator with dead time theta under relay control makes a triangle wave with period
+		// 4*theta and amplitude K*d*theta, so the describing function gives Ku = 4/(pi*K*theta)
+		UltimateGain ultimate;
+		CHECK(IdentifyUltimateGain(PlantModel::Integrating(2.0, 0.2), 1.0, 1.0, 0.0, 100000, ultimate));
+		CHECK_CLOSE(ultimate.tuS, 0.8, 0.0021);
+		CHECK_CLOSE(ultimate.ku, 4.0/(M_PI*2.0*0.2), 0.05);
+	}
+
+	MTEST(TuningRulesTest)
+	{
+		UltimateGain ultimate = { 10.0, 2.0 };
+		PidGains gains = ZieglerNicholsPid(ultimate);
+		CHECK_CLOSE(gains.kp, 6.0, 1e-12);
+		CHECK_CLOSE(gains.ki, 6.0, 1e-12);
+		CHECK_CLOSE(gains.kd, 1.5, 1e-12);
+
+		gains = ZieglerNicholsPi(ultimate);
+		CHECK_CLOSE(gains.kp, 4.5, 1e-12);
+		CHECK_CLOSE(gains.ki, 2.7, 1e-12);
+		CHECK_CLOSE(gains.kd, 0.0, 1e-12);
+
+		// Kp = tau/(K*(tauC + theta)), Ti = min(tau, 4*(tauC + theta))
+		CHECK(SimcPi(PlantModel::FirstOrder(2.0, 1.0, 0.1), 0.0, gains));
+		CHECK_CLOSE(gains.kp, 2.5, 1e-12);
+		CHECK_CLOSE(gains.ki, 2.5/0.8, 1e-12);
+
+		// A plant with tau = 1 crosses over at w = 2 when theta = (pi - atan(2))/2
+		double theta = (M_PI - atan(2.0))/2.0;
+		ultimate.ku = sqrt(5.0)/3.0;
+		ultimate.tuS = M_PI;
+		PlantModel model;
+		CHECK(FitFirstOrderPlusDeadTime(3.0, ultimate, model));
+		CHECK_CLOSE(model.timeConstantS, 1.0, 1e-9);
+		CHECK_CLOSE(model.deadTimeS, theta, 1e-9);
+	}
+
+	MTEST(AutoTunerSearchTest)
+	{
+		PlantModel plant = PlantModel::FirstOrder(2.0, 1.0, 0.1);
+		PidGains initial;
+		CHECK(SimcPi(plant, 0.0, initial));
+
+		PidAutoTuner<double> tuner(plant, 10.0, -10.0, 10.0, 1.0, 500);
+		std::vector<PidGains> candidates(1, initial);
+		double initialCost = tuner.Evaluate(candidates)[0].cost;
+
+		std::vector<TuningResult<double>> ranked = tuner.Search(initial, 5, 4.0, 2, 10);
+		CHECK_EQUAL(ranked.size(), 10u);
+		for(size_t i = 1; i < ranked.size(); i++)
+			CHECK(ranked[i - 1].cost <= ranked[i].cost);
+		// The starting point is in the first grid, so the search can only improve on it
+		CHECK(ranked[0].cost <= initialCost);
+		CHECK_CLOSE(ranked[0].cost, ranked[0].metrics.iae, 1e-9);
+
+		// Points shared between grids (e.g. each grid's centre) are only returned once
+		bool unique = true;
+		for(size_t i = 0; i < ranked.size(); i++)
+			for(size_t j = i + 1; j < ranked.size(); j++)
+				unique = unique && !(fabs(ranked[i].gains.kp - ranked[j].gains.kp) < 1e-6 &&
+					fabs(ranked[i].gains.ki - ranked[j].gains.ki) < 1e-6 &&
+					fabs(ranked[i].gains.kd - ranked[j].gains.kd) < 1e-6);
+		CHECK(unique);
+	}
+
+	MTEST(AutoTunerParallelMatchesSerialTest)
+	{
+		PlantModel plant = PlantModel::SecondOrder(1.0, 5.0, 0.3, 0.05);
+		std::vector<PidGains> candidates;
+		for(int i = 0; i < 300; i++)
+		{
+			PidGains gains = { 0.5 + 0.01*i, 1.0, 0.001*(i % 7) };
+			candidates.push_back(gains);
+		}
+
+		PidExecutor executor(2, false);
+		PidAutoTuner<float> serial(plant, 10.0, -5.0f, 5.0f, 1.0f, 200);
+		PidAutoTuner<float> parallel(plant, 10.0, -5.0f, 5.0f, 1.0f, 200, &executor);
+		parallel.SetChunkSize(16);
+
+		std::vector<TuningResult<float>> a = serial.Evaluate(candidates);
+		std::vector<TuningResult<float>> b = parallel.Evaluate(candidates);
+		bool same = true;
+		for(size_t i = 0; i < candidates.size(); i++)
+			same = same && a[i].cost == b[i].cost && b[i].gains.kp == candidates[i].kp;
+		CHECK(same);
+	}
+
+} // namespace MPidTests
@@ -0,0 +1,79 @@
+//!
+//! @file 			PidBankOptimisedTests.cpp
+//! @author 		Geoffrey Hunter <gbmhunter@gmail.com> (www.mbedded.ninja)
+//! @edited 		n/a
+//! @created		2026-10-17
+//! @last-modified 	2026-10-17
+//! @brief 			Unit tests for the PidBank kernels, built with optimisation on.
+//! @details
+//!					See README.rst in repo root dir for more info.
+//!					test/CMakeLists.txt builds this file with -O2, as the compiler is free to fuse
+//!					multiplies and adds into FMAs then, which the -O0 tests in PidBankTests.cpp can't catch.
+
+//===== SYSTEM LIBRARIES =====//
+#include <stdint.h>
+#include <vector>
+
+//====== USER LIBRARIES =====//
+#include "MUnitTest/MUnitTestApi.hpp"
+
+//===== USER SOURCE =====//
+#include "../api/MPidApi.hpp"
+#include "TestPopulation.hpp"
+
+using namespace MbeddedNinja::MPidNs;
+
+namespace MPidTests
+{
+
+	//! @brief		Runs a bank and a matching vector of Pid objects on the same inputs. Neither the
+	//!				inputs nor Zi (with a 10ms sample period) are exactly representable, so any change in
+	//!				rounding shows up.
+	template <class dataType> static bool OptimisedBankMatchesPid(SimdLevel level)
+	{
+		const size_t numControllers = 67;
+		PidBank<dataType> bank;
+		bank.SetSimdLevel(level);
+		std::vector<Pid<dataType>> pids;
+		pids.reserve(numControllers);
+
+		AddMixedControllers(bank, numControllers, 10);
+		AddMixedControllers(pids, numControllers, 10);
+
+		std::vector<dataType> inputs(numControllers);
+		std::vector<dataType> outputs(numControllers);
+		uint32_t seed = 54321;
+
+		for(size_t tick = 0; tick < 40; tick++)
+		{
+			for(size_t i = 0; i < numControllers; i++)
+			{
+				inputs[i] = (dataType)NextTestInt(seed, 1000)/(dataType)97;
+			}
+
+			bank.RunAll(inputs.data(), outputs.data());
+
+			for(size_t i = 0; i < numControllers; i++)
+			{
+				pids[i].Run(inputs[i]);
+				if(!(pids[i].output == outputs[i]))
+					return false;
+			}
+		}
+		return true;
+	}
+
+	//! @brief		Every kernel the CPU supports must still match Pid::Run() exactly when optimised.
+	MTEST(PidBankOptimisedKernelsMatchPidTest)
+	{
+		const SimdLevel levels[] = { SimdLevel::SCALAR, SimdLevel::SSE2, SimdLevel::AVX2, SimdLevel::AVX512 };
+		for(size_t i = 0; i < sizeof(levels)/sizeof(levels[0]); i++)
+		{
+			if(levels[i] > GetSimdLevel())
+				break;
+			CHECK(OptimisedBankMatchesPid<float>(levels[i]));
+			CHECK(OptimisedBankMatchesPid<double>(levels[i]));
+		}
+	}
+
+} // namespace MPidTests
@@ -0,0 +1,158 @@
+//!
+//! @file 			PidBankOverflowTests.cpp
+//! @author 		Geoffrey Hunter <gbmhunter@gmail.com> (www.mbedded.ninja)
+//! @edited 		n/a
+//! @created		2026-10-16
+//! @last-modified 	2026-10-16
+//! @brief 			Unit tests for the saturating fixed-point PidBank kernels and their overflow flags.
+//! @details
+//!					See README.rst in repo root dir for more info.
+
+//===== SYSTEM LIBRARIES =====//
+#include <stdint.h>
+#include <vector>
+
+//====== USER LIBRARIES =====//
+#include "MUnitTest/MUnitTestApi.hpp"
+
+//===== USER SOURCE =====//
+#include "../api/MPidApi.hpp"
+
+using namespace MbeddedNinja::MPidNs;
+
+namespace MPidTests
+{
+
+	//! @brief		Returns a repeatable pseudo-random raw value, covering the whole range of baseType.
+	template <class baseType> static baseType OverflowRandomRaw(uint64_t & seed)
+	{
+		seed = seed*6364136223846793005ull + 1442695040888963407ull;
+		return (baseType)(seed >> 32);
+	}
+
+	//! @brief		Fills a bank with random gains, limits and set-points, many of them big enough to overflow.
+	template <class baseType, uint8_t numFracBits> static void FillOverflowBank(
+		PidBank<FixedQ<baseType, numFracBits>> & bank, size_t numControllers, uint64_t seed)
+	{
+		typedef FixedQ<baseType, numFracBits> qType;
+		typedef typename PidBank<qType>::ControllerDirection Dir;
+		typedef typename PidBank<qType>::OutputMode Mode;
+
+		for(size_t i = 0; i < numControllers; i++)
+		{
+			// Every other controller has small (but still Q-format) gains, so not everything overflows
+			baseType shift = (i % 2 == 0) ? 0 : sizeof(baseType)*8/2;
+			qType kp = qType::FromRaw((baseType)((OverflowRandomRaw<baseType>(seed) >> shift) & std::numeric_limits<baseType>::max()));
+			qType ki = qType::FromRaw((baseType)((OverflowRandomRaw<baseType>(seed) >> shift) & std::numeric_limits<baseType>::max()));
+			qType kd = qType::FromRaw((baseType)((OverflowRandomRaw<baseType>(seed) >> shift) & std::numeric_limits<baseType>::max()));
+			qType limit = qType::FromRaw((baseType)(OverflowRandomRaw<baseType>(seed) & std::numeric_limits<baseType>::max()));
+			bank.Add(kp, ki, kd, (i % 3 == 0) ? Dir::PID_REVERSE : Dir::PID_DIRECT,
+				(i % 4 < 2) ? Mode::ACCUMULATE_OUTPUT : Mode::DONT_ACCUMULATE_OUTPUT,
+				1000, qType(0) - limit, limit, qType::FromRaw(OverflowRandomRaw<baseType>(seed)));
+		}
+	}
+
+	//! @brief		Runs the same random banks with the scalar kernel and with level, over the whole
+	//!				raw range, and checks the outputs, integral terms and overflow flags all match.
+	template <class baseType, uint8_t numFracBits> static bool OverflowKernelMatchesScalar(SimdLevel level)
+	{
+		typedef FixedQ<baseType, numFracBits> qType;
+		const size_t numControllers = 203;
+
+		PidBank<qType> scalar;
+		PidBank<qType> simd;
+		scalar.SetSimdLevel(SimdLevel::SCALAR);
+		simd.SetSimdLevel(level);
+		FillOverflowBank(scalar, numControllers, 99);
+		FillOverflowBank(simd, numControllers, 99);
+
+		std::vector<qType> inputs(numControllers);
+		std::vector<qType> scalarOutputs(numControllers);
+		std::vector<qType> simdOutputs(numControllers);
+		uint64_t seed = 7;
+		for(int tick = 0; tick < 40; tick++)
+		{
+			for(size_t i = 0; i < numControllers; i++)
+			{
+				baseType raw = OverflowRandomRaw<baseType>(seed);
+				inputs[i] = qType::FromRaw((tick % 2 == 0) ? raw : (baseType)(raw >> (sizeof(baseType)*8/2)));
+			}
+
+			// An unaligned split, so the ranges share overflow words and end in scalar tails
+			scalar.RunAll(inputs.data(), scalarOutputs.data());
+			simd.RunRange(0, 69, inputs.data(), simdOutputs.data());
+			simd.RunRange(69, numControllers, inputs.data(), simdOutputs.data());
+
+			for(size_t i = 0; i < numControllers; i++)
+			{
+				if(!(scalarOutputs[i] == simdOutputs[i]) || !(scalar.GetITerm(i) == simd.GetITerm(i)))
+					return false;
+				if(scalar.GetOverflowed(i) != simd.GetOverflowed(i))
+					return false;
+			}
+
+			if(tick % 10 == 9)
+			{
+				scalar.ClearOverflow();
+				simd.ClearOverflow();
+			}
+		}
+		return true;
+	}
+
+	MTEST(PidBankOverflowAllSimdLevelsMatchScalarTest)
+	{
+		const SimdLevel levels[] = { SimdLevel::SSE2, SimdLevel::AVX2, SimdLevel::AVX512 };
+		for(size_t i = 0; i < sizeof(levels)/sizeof(levels[0]); i++)
+		{
+			if(levels[i] > GetSimdLevel())
+				break;
+			CHECK((OverflowKernelMatchesScalar<int32_t, 16>(levels[i])));
+			CHECK((OverflowKernelMatchesScalar<int32_t, 24>(levels[i])));
+			CHECK((OverflowKernelMatchesScalar<int16_t, 8>(levels[i])));
+			CHECK((OverflowKernelMatchesScalar<int16_t, 12>(levels[i])));
+		}
+	}
+
+	MTEST(PidBankOverflowFlagsTest)
+	{
+		typedef PidBank<Q16_16>::ControllerDirection Dir;
+		typedef PidBank<Q16_16>::OutputMode Mode;
+
+		PidBank<Q16_16> bank;
+		for(int i = 0; i < 70; i++)
+			bank.Add(Q16_16(1), Q16_16(0), Q16_16(0), Dir::PID_DIRECT, Mode::DONT_ACCUMULATE_OUTPUT,
+				1000, Q16_16(-100), Q16_16(100), Q16_16(0));
+		// A gain of 30000 times an error of 2 doesn't fit in Q16_16
+		bank.SetTunings(65, Q16_16(30000), Q16_16(0), Q16_16(0));
+
+		std::vector<Q16_16> inputs(70, Q16_16(-2));
+		std::vector<Q16_16> outputs(70);
+		bank.RunAll(inputs.data(), outputs.data());
+
+		CHECK(bank.GetOverflowed(65));
+		CHECK(!bank.GetOverflowed(64));
+		CHECK_EQUAL(bank.GetOverflowMask()[0], 0);
+		CHECK_EQUAL(bank.GetOverflowMask()[1], 2);
+
+		// Saturated, then clamped, rather than wrapped to a negative number
+		CHECK(outputs[65] == Q16_16(100));
+		CHECK(outputs[64] == Q16_16(2));
+
+		// Flags are sticky until cleared
+		std::vector<Q16_16> zeros(70, Q16_16(0));
+		bank.RunAll(zeros.data(), outputs.data());
+		CHECK(bank.GetOverflowed(65));
+		bank.ClearOverflow();
+		CHECK(!bank.GetOverflowed(65));
+
+		// Banks of other types never set them
+		PidBank<float> floatBank;
+		floatBank.Add(1e30f, 0.0f, 0.0f, PidBank<float>::ControllerDirection::PID_DIRECT, PidBank<float>::OutputMode::DONT_ACCUMULATE_OUTPUT, 1000, -1.0f, 1.0f, 1e30f);
+		float floatInput = -1e30f;
+		float floatOutput;
+		floatBank.RunAll(&floatInput, &floatOutput);
+		CHECK(!floatBank.GetOverflowed(0));
+	}
+
+} // namespace MPidTests
@@ -0,0 +1,189 @@
+//!
+//! @file 			PidBankQuiescenceTests.cpp
+//! @author 		Geoffrey Hunter <gbmhunter@gmail.com> (www.mbedded.ninja)
+//! @edited 		n/a
+//! @created		2026-10-16
+//! @last-modified 	2026-10-17
+//! @brief 			Unit tests for PidBank::RunActive(), which skips quiescent controllers.
+//! @details
+//!					See README.rst in repo root dir for more info.
+
+//===== SYSTEM LIBRARIES =====//
+#include <stdint.h>
+#include <string.h>
+#include <vector>
+
+//====== USER LIBRARIES =====//
+#include "MUnitTest/MUnitTestApi.hpp"
+
+//===== USER SOURCE =====//
+#include "../api/MPidApi.hpp"
+#include "TestPopulation.hpp"
+
+using namespace MbeddedNinja::MPidNs;
+
+namespace MPidTests
+{
+
+	//! @brief		true if a and b have the same bits.
+	template <class dataType> static bool SameBits(const dataType & a, const dataType & b)
+	{
+		return memcmp(&a, &b, sizeof(dataType)) == 0;
+	}
+
+	//! @brief		Runs one bank with RunAll() every tick, and another with RunActive(), giving the
+	//!				second only the inputs that changed. Checks every output and state is bit-for-bit
+	//!				the same, and that RunActive() ends up running only the controllers that changed.
+	template <class dataType> static bool RunActiveMatchesRunAll()
+	{
+		const size_t numControllers = 97;
+		PidBank<dataType> everyTick;
+		PidBank<dataType> lazy;
+		AddMixedControllers(everyTick, numControllers);
+		AddMixedControllers(lazy, numControllers);
+
+		std::vector<dataType> inputs(numControllers, (dataType)0);
+		std::vector<dataType> everyTickOutputs(numControllers);
+		std::vector<dataType> lazyOutputs(numControllers);
+		uint32_t seed = 4321;
+
+		for(int tick = 0; tick < 300; tick++)
+		{
+			// Long quiet spells, broken by a few inputs and set-points changing
+			for(size_t i = 0; i < numControllers; i++)
+			{
+				NextTestSeed(seed);
+				if((seed >> 16) % 40 != 0 || tick > 150)
+					continue;
+				inputs[i] = (dataType)((int32_t)((seed >> 8) % 9) - 4);
+				lazy.SetInput(i, inputs[i]);
+				if((seed >> 4) % 4 == 0)
+				{
+					everyTick.SetSetPoint(i, inputs[i]);
+					lazy.SetSetPoint(i, inputs[i]);
+				}
+			}
+
+			everyTick.RunAll(inputs.data(), everyTickOutputs.data());
+			lazy.RunActive(lazyOutputs.data());
+
+			for(size_t i = 0; i < numControllers; i++)
+			{
+				PidState<dataType> a = everyTick.GetState(i);
+				PidState<dataType> b = lazy.GetState(i);
+				if(!SameBits(everyTickOutputs[i], lazyOutputs[i]) || !SameBits(a.iTerm, b.iTerm) ||
+					!SameBits(a.prevOutput, b.prevOutput) || !SameBits(a.prevInput, b.prevInput))
+					return false;
+			}
+		}
+
+		// Nothing has changed for 150 ticks, by which time every controller has settled (the slowest
+		// ramp at 1 per tick from one output limit to the other)
+		return lazy.GetNumActive() == 0 && lazy.RunActive(lazyOutputs.data()) == 0;
+	}
+
+	MTEST(PidBankRunActiveMatchesRunAllTest)
+	{
+		CHECK(RunActiveMatchesRunAll<float>());
+		CHECK(RunActiveMatchesRunAll<double>());
+		CHECK(RunActiveMatchesRunAll<Q16_16>());
+	}
+
+	MTEST(PidBankRunActiveWakesTest)
+	{
+		typedef PidBank<float>::ControllerDirection Dir;
+		typedef PidBank<float>::OutputMode Mode;
+
+		PidBank<float> bank;
+		bank.Add(1.0f, 1.0f, 0.0f, Dir::PID_DIRECT, Mode::DONT_ACCUMULATE_OUTPUT, 1000, -10.0f, 10.0f, 5.0f);
+		bank.Add(1.0f, 0.0f, 0.0f, Dir::PID_DIRECT, Mode::ACCUMULATE_OUTPUT, 1000, -10.0f, 10.0f, 5.0f);
+		float outputs[2] = { 0.0f, 0.0f };
+
+		// At the set-point the first settles on it's second run (a first run never counts, as the
+		// derivative term is left out). The second keeps adding it's P term to it's output until it
+		// clamps at 10.
+		bank.SetInput(0, 5.0f);
+		bank.SetInput(1, 4.0f);
+		CHECK_EQUAL(bank.RunActive(outputs), 2);
+		CHECK_EQUAL(bank.RunActive(outputs), 2);
+		CHECK_EQUAL(bank.RunActive(outputs), 1);
+		CHECK(bank.IsQuiescent(0));
+		CHECK(!bank.IsQuiescent(1));
+		for(int i = 0; i < 20; i++)
+			bank.RunActive(outputs);
+		CHECK(bank.IsQuiescent(1));
+		CHECK_CLOSE(outputs[1], 10.0f, 0.0001f);
+		CHECK_EQUAL(bank.GetNumActive(), 0);
+
+		// A new set-point wakes the first controller, and the integral term carries on from where it was
+		bank.SetSetPoint(0, 6.0f);
+		CHECK_EQUAL(bank.RunActive(outputs), 1);
+		CHECK_CLOSE(outputs[0], 2.0f, 0.0001f);
+
+		// Setting the same input doesn't keep a controller awake
+		bank.SetInput(1, 4.0f);
+		CHECK_EQUAL(bank.RunActive(outputs), 2);
+		CHECK(bank.IsQuiescent(1));
+
+		// RunAll() wakes the controllers it runs, and it's inputs carry on into RunActive()
+		for(int i = 0; i < 5; i++)
+			bank.RunActive(outputs);
+		float inputs[2] = { 7.0f, 4.0f };
+		bank.RunAll(inputs, outputs);
+		CHECK_EQUAL(bank.GetNumActive(), 2);
+		float allOutputs[2];
+		PidBank<float> reference;
+		reference.Add(1.0f, 1.0f, 0.0f, Dir::PID_DIRECT, Mode::DONT_ACCUMULATE_OUTPUT, 1000, -10.0f, 10.0f, 6.0f);
+		reference.SetState(0, bank.GetState(0));
+		reference.RunAll(inputs, allOutputs);
+		bank.RunActive(outputs);
+		CHECK_EQUAL(outputs[0], allOutputs[0]);
+	}
+
+	//! @brief		A bank run with RunAll() can switch to SetInput()/RunActive() at any point, and the
+	//!				controllers it doesn't set an input for carry on with their last input. The same goes
+	//!				for a bank whose state was restored with SetState()/SetStates().
+	MTEST(PidBankRunActiveAfterRunAllTest)
+	{
+		const size_t numControllers = 13;
+		PidBank<float> everyTick;
+		PidBank<float> switched;
+		PidBank<float> restored;
+		PidBank<float> restoredOne;
+		AddMixedControllers(everyTick, numControllers);
+		AddMixedControllers(switched, numControllers);
+		AddMixedControllers(restored, numControllers);
+		AddMixedControllers(restoredOne, numControllers);
+
+		std::vector<float> inputs(numControllers);
+		std::vector<float> everyTickOutputs(numControllers);
+		std::vector<float> outputs(numControllers);
+		for(int tick = 0; tick < 5; tick++)
+		{
+			for(size_t i = 0; i < numControllers; i++)
+				inputs[i] = 0.25f*(float)(tick + (int)i);
+			everyTick.RunAll(inputs.data(), everyTickOutputs.data());
+			switched.RunAll(inputs.data(), outputs.data());
+		}
+
+		std::vector<float> setPoints(numControllers), prevInputs(numControllers), iTerms(numControllers), prevOutputs(numControllers);
+		std::vector<uint32_t> numTimesRan(numControllers);
+		everyTick.GetStates(setPoints.data(), prevInputs.data(), iTerms.data(), prevOutputs.data(), numTimesRan.data());
+		restored.SetStates(setPoints.data(), prevInputs.data(), iTerms.data(), prevOutputs.data(), numTimesRan.data());
+		for(size_t i = 0; i < numControllers; i++)
+			restoredOne.SetState(i, everyTick.GetState(i));
+
+		// Only controller 3's input changes
+		inputs[3] = -2.0f;
+		everyTick.RunAll(inputs.data(), everyTickOutputs.data());
+		PidBank<float> * banks[3] = { &switched, &restored, &restoredOne };
+		for(size_t b = 0; b < 3; b++)
+		{
+			std::vector<float> bankOutputs(numControllers);
+			banks[b]->SetInput(3, inputs[3]);
+			CHECK_EQUAL(banks[b]->RunActive(bankOutputs.data()), numControllers);
+			CHECK(memcmp(bankOutputs.data(), everyTickOutputs.data(), numControllers*sizeof(float)) == 0);
+		}
+	}
+
+} // namespace MPidTests
@@ -0,0 +1,199 @@
+//!
+//! @file 			PidBankTests.cpp
+//! @author 		Geoffrey Hunter <gbmhunter@gmail.com> (www.mbedded.ninja)
+//! @edited 		n/a
+//! @created		2026-10-16
+//! @last-modified 	2026-10-17
+//! @brief 			Unit tests for the PidBank class.
+//! @details
+//!					See README.rst in repo root dir for more info.
+
+//===== SYSTEM LIBRARIES =====//
+#include <stdint.h>
+#include <string.h>
+#include <vector>
+
+//====== USER LIBRARIES =====//
+#include "MUnitTest/MUnitTestApi.hpp"
+
+//===== USER SOURCE =====//
+#include "../api/MPidApi.hpp"
+#include "TestPopulation.hpp"
+
+using namespace MbeddedNinja::MPidNs;
+
+namespace MPidTests
+{
+
+	//! @brief		Builds a bank and a matching vector of Pid objects with a mix of
+	//!				directions, output modes and gains, runs both on the same pseudo-random
+	//!				inputs and checks every output is identical.
+	template <class dataType> static bool BankMatchesPid(size_t numControllers, size_t numTicks, SimdLevel level)
+	{
+		PidBank<dataType> bank;
+		bank.SetSimdLevel(level);
+		std::vector<Pid<dataType>> pids;
+		bank.Reserve(numControllers);
+		pids.reserve(numControllers);
+
+		AddMixedControllers(bank, numControllers);
+		AddMixedControllers(pids, numControllers);
+
+		std::vector<dataType> inputs(numControllers);
+		std::vector<dataType> outputs(numControllers);
+		uint32_t seed = 12345;
+
+		for(size_t tick = 0; tick < numTicks; tick++)
+		{
+			for(size_t i = 0; i < numControllers; i++)
+			{
+				inputs[i] = (dataType)NextTestInt(seed, 10);
+			}
+
+			bank.RunAll(inputs.data(), outputs.data());
+
+			for(size_t i = 0; i < numControllers; i++)
+			{
+				pids[i].Run(inputs[i]);
+				if(!(pids[i].output == outputs[i]) || !(bank.GetOutput(i) == outputs[i]))
+					return false;
+			}
+		}
+		return true;
+	}
+
+	MTEST(PidBankMatchesPidDoubleTest)
+	{
+		CHECK(BankMatchesPid<double>(101, 50, GetSimdLevel()));
+	}
+
+	MTEST(PidBankMatchesPidFloatTest)
+	{
+		CHECK(BankMatchesPid<float>(101, 50, GetSimdLevel()));
+	}
+
+	MTEST(PidBankMatchesPidInt32Test)
+	{
+		CHECK(BankMatchesPid<int32_t>(101, 50, GetSimdLevel()));
+	}
+
+	MTEST(PidBankMatchesPidFixedQTest)
+	{
+		CHECK(BankMatchesPid<Q16_16>(101, 50, GetSimdLevel()));
+	}
+
+	//! @brief		Every kernel the CPU supports must give exactly the same results as Pid::Run().
+	MTEST(PidBankAllSimdLevelsMatchPidTest)
+	{
+		const SimdLevel levels[] = { SimdLevel::SCALAR, SimdLevel::SSE2, SimdLevel::AVX2, SimdLevel::AVX512 };
+		for(size_t i = 0; i < sizeof(levels)/sizeof(levels[0]); i++)
+		{
+			if(levels[i] > GetSimdLevel())
+				break;
+			CHECK(BankMatchesPid<float>(77, 30, levels[i]));
+			CHECK(BankMatchesPid<double>(77, 30, levels[i]));
+			CHECK(BankMatchesPid<int32_t>(77, 30, levels[i]));
+			CHECK(BankMatchesPid<Q16_16>(77, 30, levels[i]));
+			CHECK(BankMatchesPid<Q8_24>(77, 30, levels[i]));
+			CHECK(BankMatchesPid<Q8_8>(77, 30, levels[i]));
+		}
+	}
+
+	MTEST(PidBankNoDerivativeOnFirstRunTest)
+	{
+		PidBank<double> bank;
+		bank.Add(
+			0.0,									//!< Kp
+			0.0,									//!< Ki
+			1.0,									//!< Kd
+			PidBank<double>::ControllerDirection::PID_DIRECT,		//!< Control type
+			PidBank<double>::OutputMode::DONT_ACCUMULATE_OUTPUT,		//!< Control type
+			1000.0,								//!< Update rate (ms)
+			-100.0,									//!< Min output
+			100.0,								//!< Max output
+			0.0									//!< Initial set-point
+		);
+
+		double input = 5.0;
+		double output = 99.0;
+
+		// No derivative kick on the first run
+		bank.RunAll(&input, &output);
+		CHECK_CLOSE(output, 0.0, 0.0001);
+
+		input = 4.0;
+		bank.RunAll(&input, &output);
+		CHECK_CLOSE(output, 1.0, 0.0001);
+	}
+
+	//! @brief		The first run has no derivative term at all, like Pid::Run(), so it matches bit-for-bit even
+	//!				where -Zd*0 wouldn't: an infinite Zd (sample period of 0) and a -0.0 sum.
+	MTEST(PidBankFirstRunMatchesPidExactlyTest)
+	{
+		typedef PidBank<float>::ControllerDirection Dir;
+		typedef PidBank<float>::OutputMode Mode;
+		const Dir dirs[2] = { Dir::PID_DIRECT, Dir::PID_REVERSE };
+		const Mode modes[2] = { Mode::DONT_ACCUMULATE_OUTPUT, Mode::ACCUMULATE_OUTPUT };
+		const double samplePeriodsMs[2] = { 0.0, 10.0 };
+		const float setPoints[2] = { 1.0f, 3.0f };
+		float inputs[2] = { 0.25f, 3.0f };
+
+		// Every term of the second controller's first run is -0.0
+		PidState<float> state = { 3.0f, 0.0f, -0.0f, -0.0f, 0 };
+
+		for(int useRunActive = 0; useRunActive < 2; useRunActive++)
+		{
+			PidBank<float> bank;
+			std::vector<Pid<float>> pids;
+			for(size_t i = 0; i < 2; i++)
+			{
+				bank.Add(1.0f, 0.5f, 2.0f, dirs[i], modes[i], samplePeriodsMs[i], -10.0f, 10.0f, setPoints[i]);
+				pids.push_back(Pid<float>(1.0f, 0.5f, 2.0f, dirs[i], modes[i], samplePeriodsMs[i], -10.0f, 10.0f, setPoints[i]));
+			}
+			bank.SetState(1, state);
+			pids[1].SetState(state);
+
+			float outputs[2];
+			if(useRunActive)
+			{
+				bank.SetInput(0, inputs[0]);
+				bank.SetInput(1, inputs[1]);
+				bank.RunActive(outputs);
+			}
+			else
+				bank.RunAll(inputs, outputs);
+
+			for(size_t i = 0; i < 2; i++)
+			{
+				pids[i].Run(inputs[i]);
+				CHECK(memcmp(&outputs[i], &pids[i].output, sizeof(float)) == 0);
+			}
+		}
+	}
+
+	MTEST(PidBankRunRangeTest)
+	{
+		PidBank<double> bank;
+		for(int i = 0; i < 4; i++)
+		{
+			bank.Add(1.0, 0.0, 0.0,
+				PidBank<double>::ControllerDirection::PID_DIRECT,
+				PidBank<double>::OutputMode::DONT_ACCUMULATE_OUTPUT,
+				1000.0, -100.0, 100.0, 10.0);
+		}
+
+		double inputs[4] = { 1.0, 2.0, 3.0, 4.0 };
+		double outputs[4] = { 0.0, 0.0, 0.0, 0.0 };
+
+		// Only run the middle two controllers
+		bank.RunRange(1, 3, inputs, outputs);
+
+		CHECK_CLOSE(outputs[0], 0.0, 0.0001);
+		CHECK_CLOSE(outputs[1], 8.0, 0.0001);
+		CHECK_CLOSE(outputs[2], 7.0, 0.0001);
+		CHECK_CLOSE(outputs[3], 0.0, 0.0001);
+	}
+
+} // namespace MPidTests
+
+// EOF
@@ -0,0 +1,94 @@
+//!
+//! @file 			PidCascadeTests.cpp
+//! @author 		Geoffrey Hunter <gbmhunter@gmail.com> (www.mbedded.ninja)
+//! @edited 		n/a
+//! @created		2026-10-16
+//! @last-modified 	2026-10-16
+//! @brief 			Unit tests for PidCascade.
+//! @details
+//!					See README.rst in repo root dir for more info.
+
+//===== SYSTEM LIBRARIES =====//
+#include <stdint.h>
+
+//====== USER LIBRARIES =====//
+#include "MUnitTest/MUnitTestApi.hpp"
+
+//===== USER SOURCE =====//
+#include "../api/MPidApi.hpp"
+
+using namespace MbeddedNinja::MPidNs;
+
+namespace MPidTests
+{
+
+	//! @brief		Runs a 3 stage cascade (outer stage every 4 ticks, middle every 2, inner every tick)
+	//!				against the same three Pid objects chained by hand, closing the loop around a crude
+	//!				plant, and checks every output is identical.
+	template <class dataType> static bool CascadeMatchesChainedPids()
+	{
+		typedef typename Pid<dataType>::ControllerDirection Dir;
+		typedef typename Pid<dataType>::OutputMode Mode;
+
+		const uint32_t dividers[3] = { 4, 2, 1 };
+		Pid<dataType> pids[3] = {
+			Pid<dataType>(dataType(2), dataType(0.5), dataType(0.1), Dir::PID_DIRECT, Mode::DONT_ACCUMULATE_OUTPUT, 40, dataType(-10), dataType(10), dataType(5)),
+			Pid<dataType>(dataType(1), dataType(2), dataType(0.05), Dir::PID_REVERSE, Mode::ACCUMULATE_OUTPUT, 20, dataType(-10), dataType(10), dataType(0)),
+			Pid<dataType>(dataType(3), dataType(1), dataType(0), Dir::PID_DIRECT, Mode::DONT_ACCUMULATE_OUTPUT, 10, dataType(-2), dataType(2), dataType(0)) };
+
+		PidCascade<dataType, 3> cascade(10, dataType(5));
+		cascade.SetStage(0, dataType(2), dataType(0.5), dataType(0.1), Dir::PID_DIRECT, Mode::DONT_ACCUMULATE_OUTPUT, 4, dataType(-10), dataType(10));
+		cascade.SetStage(1, dataType(1), dataType(2), dataType(0.05), Dir::PID_REVERSE, Mode::ACCUMULATE_OUTPUT, 2, dataType(-10), dataType(10));
+		cascade.SetStage(2, dataType(3), dataType(1), dataType(0), Dir::PID_DIRECT, Mode::DONT_ACCUMULATE_OUTPUT, 1, dataType(-2), dataType(2));
+
+		// Position, velocity and current of a crude plant
+		dataType state[3] = { dataType(0), dataType(0), dataType(0) };
+		for(uint32_t tick = 0; tick < 400; tick++)
+		{
+			for(size_t s = 0; s < 3; s++)
+			{
+				if(s > 0)
+					pids[s].setPoint = pids[s - 1].output;
+				if(tick % dividers[s] == 0)
+					pids[s].Run(state[s]);
+			}
+
+			dataType output = cascade.Run(state[0], state[1], state[2]);
+			if(!(output == pids[2].output) || !(cascade.GetStageOutput(0) == pids[0].output))
+				return false;
+
+			state[2] = state[2] + (output - state[2])/dataType(4);
+			state[1] = state[1] + state[2]/dataType(8);
+			state[0] = state[0] + state[1]/dataType(16);
+		}
+		return true;
+	}
+
+	MTEST(CascadeMatchesChainedPidsDoubleTest)
+	{
+		CHECK(CascadeMatchesChainedPids<double>());
+	}
+
+	MTEST(CascadeMatchesChainedPidsFloatTest)
+	{
+		CHECK(CascadeMatchesChainedPids<float>());
+	}
+
+	MTEST(CascadeMatchesChainedPidsFixedPointTest)
+	{
+		CHECK(CascadeMatchesChainedPids<Q16_16>());
+	}
+
+	MTEST(CascadeRejectsBadStageTest)
+	{
+		typedef Pid<double>::ControllerDirection Dir;
+		typedef Pid<double>::OutputMode Mode;
+		PidCascade<double, 2> cascade(10.0, 1.0);
+		CHECK(!cascade.SetStage(2, 1.0, 0.0, 0.0, Dir::PID_DIRECT, Mode::DONT_ACCUMULATE_OUTPUT, 1, -1.0, 1.0));
+		CHECK(!cascade.SetStage(0, 1.0, 0.0, 0.0, Dir::PID_DIRECT, Mode::DONT_ACCUMULATE_OUTPUT, 0, -1.0, 1.0));
+		CHECK(!cascade.SetStage(0, -1.0, 0.0, 0.0, Dir::PID_DIRECT, Mode::DONT_ACCUMULATE_OUTPUT, 1, -1.0, 1.0));
+		CHECK(!cascade.SetStage(0, 1.0, 0.0, 0.0, Dir::PID_DIRECT, Mode::DONT_ACCUMULATE_OUTPUT, 1, 1.0, 1.0));
+		CHECK(cascade.SetStage(1, 1.0, 0.0, 0.0, Dir::PID_DIRECT, Mode::DONT_ACCUMULATE_OUTPUT, 1, -1.0, 1.0));
+	}
+
+} // namespace MPidTests
@@ -0,0 +1,151 @@
+//!
+//! @file 			PidCheckpointTests.cpp
+//! @author 		Geoffrey Hunter <gbmhunter@gmail.com> (www.mbedded.ninja)
+//! @edited 		n/a
+//! @created		2026-10-16
+//! @last-modified 	2026-10-17
+//! @brief 			Unit tests for checkpointing and restoring controller state.
+//! @details
+//!					See README.rst in repo root dir for more info.
+
+//===== SYSTEM LIBRARIES =====//
+#include <stdint.h>
+#include <stdio.h>
+#include <vector>
+
+//====== USER LIBRARIES =====//
+#include "MUnitTest/MUnitTestApi.hpp"
+
+//===== USER SOURCE =====//
+#include "../api/MPidApi.hpp"
+#include "TestPopulation.hpp"
+
+using namespace MbeddedNinja::MPidNs;
+
+namespace MPidTests
+{
+
+	static const char * testCheckpointPath = "MPidTests_PidCheckpoint.bin";
+
+	//! @brief		Runs an array of Pids, checkpoints them into a buffer, restores the checkpoint into
+	//!				freshly constructed Pids, and checks both sets give identical outputs from then on.
+	template <class dataType> static bool PidsResumeExactly(size_t numPids)
+	{
+		std::vector<Pid<dataType>> primary;
+		AddMixedControllers(primary, numPids);
+		std::vector<Pid<dataType>> standby(primary);
+
+		uint32_t seed = 42;
+		for(int t = 0; t < 50; t++)
+			for(size_t i = 0; i < numPids; i++)
+				primary[i].Run(NextTestInput<dataType>(seed));
+		primary[0].setPoint = dataType(-3);
+
+		std::vector<uint64_t> buffer((size_t)(PidCheckpointSize<dataType>(numPids) + 7)/8);
+		uint8_t * bytes = reinterpret_cast<uint8_t *>(buffer.data());
+		size_t size = SavePidCheckpoint(primary.data(), numPids, bytes, buffer.size()*8, 50);
+		if(size != PidCheckpointSize<dataType>(numPids))
+			return false;
+
+		uint64_t sequence = 0;
+		if(!RestorePidCheckpoint(bytes, size, standby.data(), numPids, &sequence) || sequence != 50)
+			return false;
+
+		for(int t = 0; t < 50; t++)
+		{
+			for(size_t i = 0; i < numPids; i++)
+			{
+				dataType input = NextTestInput<dataType>(seed);
+				primary[i].Run(input);
+				standby[i].Run(input);
+				if(!(primary[i].output == standby[i].output))
+					return false;
+			}
+		}
+		return true;
+	}
+
+	MTEST(PidCheckpointResumesPidsExactlyTest)
+	{
+		CHECK(PidsResumeExactly<double>(33));
+		CHECK(PidsResumeExactly<float>(7));
+		CHECK(PidsResumeExactly<Q16_16>(12));
+	}
+
+	MTEST(PidCheckpointFileResumesBankExactlyTest)
+	{
+		const size_t numControllers = 101;
+		PidBank<float> primary;
+		PidBank<float> standby;
+		AddMixedControllers(primary, numControllers);
+		AddMixedControllers(standby, numControllers);
+
+		std::vector<float> inputs(numControllers);
+		std::vector<float> primaryOutputs(numControllers);
+		std::vector<float> standbyOutputs(numControllers);
+		uint32_t seed = 7;
+		for(int t = 0; t < 20; t++)
+		{
+			for(size_t i = 0; i < numControllers; i++)
+				inputs[i] = NextTestInput<float>(seed);
+			primary.RunAll(inputs.data(), primaryOutputs.data());
+		}
+
+		CHECK(SavePidCheckpointFile(testCheckpointPath, primary, 20));
+		uint64_t sequence = 0;
+		CHECK(RestorePidCheckpointFile(testCheckpointPath, standby, &sequence));
+		CHECK_EQUAL(sequence, 20);
+		CHECK_EQUAL(standby.GetITerm(5), primary.GetITerm(5));
+
+		bool identical = true;
+		for(int t = 0; t < 20; t++)
+		{
+			for(size_t i = 0; i < numControllers; i++)
+				inputs[i] = NextTestInput<float>(seed);
+			primary.RunAll(inputs.data(), primaryOutputs.data());
+			standby.RunAll(inputs.data(), standbyOutputs.data());
+			for(size_t i = 0; i < numControllers; i++)
+				identical = identical && (primaryOutputs[i] == standbyOutputs[i]);
+		}
+		CHECK(identical);
+
+		// A bank that has never been run restores as never run
+		PidBank<float> fresh;
+		AddMixedControllers(fresh, numControllers);
+		CHECK(SavePidCheckpointFile(testCheckpointPath, fresh));
+		CHECK(RestorePidCheckpointFile(testCheckpointPath, standby));
+		CHECK_EQUAL(standby.GetState(0).numTimesRan, 0);
+		CHECK_EQUAL(standby.GetOutput(0), 0.0f);
+
+		remove(testCheckpointPath);
+	}
+
+	MTEST(PidCheckpointRejectsMismatchesTest)
+	{
+		PidBank<double> bank;
+		AddMixedControllers(bank, 10);
+
+		std::vector<uint64_t> buffer((size_t)(PidCheckpointSize<double>(10) + 7)/8);
+		uint8_t * bytes = reinterpret_cast<uint8_t *>(buffer.data());
+
+		// Too small a buffer
+		CHECK_EQUAL(SavePidCheckpoint(bank, bytes, 64), 0);
+
+		size_t size = SavePidCheckpoint(bank, bytes, buffer.size()*8);
+		CHECK(size > 0);
+
+		// Wrong type, wrong number of controllers, truncated
+		PidBank<float> floatBank;
+		AddMixedControllers(floatBank, 10);
+		CHECK(!RestorePidCheckpoint(bytes, size, floatBank));
+		PidBank<double> smallBank;
+		AddMixedControllers(smallBank, 9);
+		CHECK(!RestorePidCheckpoint(bytes, size, smallBank));
+		CHECK(!RestorePidCheckpoint(bytes, size - 1, bank));
+		CHECK(RestorePidCheckpoint(bytes, size, bank));
+
+		// Missing file
+		CHECK(!RestorePidCheckpointFile("MPidTests_NoSuchCheckpoint.bin", bank));
+	}
+
+} // namespace MPidTests
@@ -0,0 +1,125 @@
+//!
+//! @file 			PidExecutorTests.cpp
+//! @author 		Geoffrey Hunter <gbmhunter@gmail.com> (www.mbedded.ninja)
+//! @edited 		n/a
+//! @created		2026-10-16
+//! @last-modified 	2026-10-17
+//! @brief 			Unit tests for the PidExecutor class.
+//! @details
+//!					See README.rst in repo root dir for more info.
+
+//===== SYSTEM LIBRARIES =====//
+#include <stdint.h>
+#include <string.h>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+//====== USER LIBRARIES =====//
+#include "MUnitTest/MUnitTestApi.hpp"
+
+//===== USER SOURCE =====//
+#include "../api/MPidApi.hpp"
+#include "TestPopulation.hpp"
+
+using namespace MbeddedNinja::MPidNs;
+
+namespace MPidTests
+{
+
+	//! @brief		Adds one to every item of a vector it is run over.
+	static void CountChunk(void * context, size_t begin, size_t end)
+	{
+		std::vector<int> & counts = *static_cast<std::vector<int> *>(context);
+		for(size_t i = begin; i < end; i++)
+			counts[i]++;
+	}
+
+	MTEST(PidExecutorRunsEveryItemOnceTest)
+	{
+		PidExecutor executor(4, false);
+		CHECK_EQUAL(executor.GetNumWorkers(), 4);
+
+		std::vector<int> counts(10007, 0);
+		for(int tick = 0; tick < 100; tick++)
+			executor.Run(counts.size(), 7, &CountChunk, &counts);
+
+		bool allHundred = true;
+		for(size_t i = 0; i < counts.size(); i++)
+			allHundred = allHundred && (counts[i] == 100);
+		CHECK(allHundred);
+	}
+
+	//! @brief		Ticks with idle gaps in between, long enough for the workers and the thread calling
+	//!				Run() to block, still run every item once.
+	MTEST(PidExecutorRunAfterIdleTest)
+	{
+		PidExecutor executor(4, false);
+		std::vector<int> counts(1001, 0);
+		for(int tick = 0; tick < 10; tick++)
+		{
+			std::this_thread::sleep_for(std::chrono::milliseconds(2));
+			executor.Run(counts.size(), 7, &CountChunk, &counts);
+		}
+
+		bool allTen = true;
+		for(size_t i = 0; i < counts.size(); i++)
+			allTen = allTen && (counts[i] == 10);
+		CHECK(allTen);
+	}
+
+	MTEST(PidExecutorBankMatchesSerialRunTest)
+	{
+		const size_t numControllers = 20000;
+		PidBank<float> serial;
+		PidBank<float> parallel;
+		AddMixedControllers(serial, numControllers);
+		AddMixedControllers(parallel, numControllers);
+
+		PidExecutor executor(4);
+		std::vector<float> inputs(numControllers);
+		std::vector<float> serialOutputs(numControllers);
+		std::vector<float> parallelOutputs(numControllers);
+		uint32_t seed = 12345;
+
+		bool identical = true;
+		for(int tick = 0; tick < 50; tick++)
+		{
+			for(size_t i = 0; i < numControllers; i++)
+			{
+				inputs[i] = NextTestInput<float>(seed);
+			}
+
+			serial.RunAll(inputs.data(), serialOutputs.data());
+			executor.RunBank(parallel, inputs.data(), parallelOutputs.data(), 64);
+			identical = identical && memcmp(serialOutputs.data(), parallelOutputs.data(), numControllers*sizeof(float)) == 0;
+		}
+		CHECK(identical);
+	}
+
+	MTEST(PidExecutorPidArrayMatchesSerialRunTest)
+	{
+		const size_t numControllers = 5000;
+		std::vector<Pid<double>> serial;
+		AddMixedControllers(serial, numControllers);
+		std::vector<Pid<double>> parallel(serial);
+
+		PidExecutor executor(3);
+		std::vector<double> inputs(numControllers);
+		bool identical = true;
+		for(int tick = 0; tick < 20; tick++)
+		{
+			for(size_t i = 0; i < numControllers; i++)
+				inputs[i] = (double)((i*7 + (size_t)tick*13) % 100)/10.0 - 5.0;
+
+			for(size_t i = 0; i < numControllers; i++)
+				serial[i].Run(inputs[i]);
+			executor.RunPids(parallel.data(), inputs.data(), numControllers);
+
+			for(size_t i = 0; i < numControllers; i++)
+				identical = identical && memcmp(&serial[i].output, &parallel[i].output, sizeof(double)) == 0;
+		}
+		CHECK(identical);
+	}
+
+} // namespace MPidTests
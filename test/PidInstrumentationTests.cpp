@@ -0,0 +1,117 @@
+//!
+//! @file 			PidInstrumentationTests.cpp
+//! @author 		Geoffrey Hunter <gbmhunter@gmail.com> (www.mbedded.ninja)
+//! @edited 		n/a
+//! @created		2026-10-16
+//! @last-modified 	2026-10-16
+//! @brief 			Unit tests for the instrumentation counters and LogHistogram.
+//! @details
+//!					See README.rst in repo root dir for more info.
+
+//===== SYSTEM LIBRARIES =====//
+#include <stdint.h>
+#include <vector>
+
+//====== USER LIBRARIES =====//
+#include "MUnitTest/MUnitTestApi.hpp"
+
+//===== USER SOURCE =====//
+#include "../api/MPidApi.hpp"
+
+using namespace MbeddedNinja::MPidNs;
+
+namespace MPidTests
+{
+
+	MTEST(LogHistogramTest)
+	{
+		CHECK_EQUAL(LogHistogram::BucketOf(0), 0u);
+		CHECK_EQUAL(LogHistogram::BucketOf(1), 1u);
+		CHECK_EQUAL(LogHistogram::BucketOf(7), 3u);
+		CHECK_EQUAL(LogHistogram::BucketOf(8), 4u);
+		CHECK_EQUAL(LogHistogram::BucketOf(UINT64_MAX), 64u);
+
+		LogHistogram histogram;
+		for(uint64_t i = 0; i < 99; i++)
+			histogram.Record(100);
+		histogram.Record(5000);
+
+		LogHistogramSnapshot snapshot = histogram.GetSnapshot();
+		CHECK_EQUAL(snapshot.total, 100u);
+		CHECK_EQUAL(snapshot.max, 5000u);
+		CHECK_EQUAL(snapshot.Percentile(0.5), 127u);
+		CHECK_EQUAL(snapshot.Percentile(1.0), 8191u);
+		CHECK_CLOSE(snapshot.Mean(), (99.0*100.0 + 5000.0)/100.0, 1e-9);
+
+		snapshot.Add(histogram.GetSnapshot());
+		CHECK_EQUAL(snapshot.total, 200u);
+	}
+
+	MTEST(InstrumentationCountsRunEventsTest)
+	{
+		Pid<double> pid(
+			1.0,									//!< Kp
+			1.0,									//!< Ki
+			0.0,									//!< Kd
+			Pid<double>::ControllerDirection::PID_DIRECT,		//!< Control type
+			Pid<double>::OutputMode::DONT_ACCUMULATE_OUTPUT,	//!< Control type
+			1000.0,								//!< Update rate (ms)
+			-10.0,									//!< Min output
+			10.0,								//!< Max output
+			0.0									//!< Initial set-point
+		);
+
+		// The constructor's SetTunings() call isn't counted
+		CHECK_EQUAL(pid.GetInstrumentation().tuningChanges, 0u);
+
+		// Error -1: iTerm = -1, output = -2, nothing clamped
+		pid.Run(1.0);
+		// Error -8: iTerm = -9, output = -17 which saturates
+		pid.Run(8.0);
+		// Error -8: iTerm = -17 which clamps, and the output saturates
+		pid.Run(8.0);
+		pid.SetTunings(1.0, 1.0, 0.1);
+
+		PidInstrumentationSnapshot snapshot = pid.GetInstrumentation();
+		CHECK_EQUAL(snapshot.numRuns, 3u);
+		CHECK_EQUAL(snapshot.derivativeSkips, 1u);
+		CHECK_EQUAL(snapshot.integratorClamps, 1u);
+		CHECK_EQUAL(snapshot.outputSaturations, 2u);
+		CHECK_EQUAL(snapshot.tuningChanges, 1u);
+		CHECK_EQUAL(snapshot.runCycles.total, 3u);
+
+		pid.ResetInstrumentation();
+		CHECK_EQUAL(pid.GetInstrumentation().numRuns, 0u);
+	}
+
+	MTEST(InstrumentationRunBlockMatchesRunTest)
+	{
+		typedef Pid<float>::ControllerDirection Dir;
+		typedef Pid<float>::OutputMode Mode;
+		Pid<float> pids[2] = {
+			Pid<float>(2.0f, 1.0f, 0.5f, Dir::PID_DIRECT, Mode::ACCUMULATE_OUTPUT, 100.0, -5.0f, 5.0f, 1.0f),
+			Pid<float>(2.0f, 1.0f, 0.5f, Dir::PID_DIRECT, Mode::ACCUMULATE_OUTPUT, 100.0, -5.0f, 5.0f, 1.0f) };
+
+		std::vector<float> inputs(200);
+		for(size_t i = 0; i < inputs.size(); i++)
+			inputs[i] = (float)((i*37) % 11) - 5.0f;
+		std::vector<float> outputs(inputs.size());
+
+		for(size_t i = 0; i < inputs.size(); i++)
+			pids[0].Run(inputs[i]);
+		pids[1].RunBlock(inputs.data(), outputs.data(), inputs.size());
+
+		PidInstrumentationSnapshot run = pids[0].GetInstrumentation();
+		PidInstrumentationSnapshot block = pids[1].GetInstrumentation();
+		CHECK_EQUAL(run.numRuns, block.numRuns);
+		CHECK_EQUAL(run.integratorClamps, block.integratorClamps);
+		CHECK_EQUAL(run.outputSaturations, block.outputSaturations);
+		CHECK_EQUAL(run.derivativeSkips, block.derivativeSkips);
+		CHECK(run.outputSaturations > 0);
+
+		PidInstrumentationSnapshot total = AggregateInstrumentation(pids, 2);
+		CHECK_EQUAL(total.numRuns, 400u);
+		CHECK_EQUAL(total.outputSaturations, 2*run.outputSaturations);
+	}
+
+} // namespace MPidTests
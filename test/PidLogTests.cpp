@@ -0,0 +1,180 @@
+//!
+//! @file 			PidLogTests.cpp
+//! @author 		Geoffrey Hunter <gbmhunter@gmail.com> (www.mbedded.ninja)
+//! @edited 		n/a
+//! @created		2026-10-16
+//! @last-modified 	2026-10-17
+//! @brief 			Unit tests for the binary log writer, reader and replay driver.
+//! @details
+//!					See README.rst in repo root dir for more info.
+
+//===== SYSTEM LIBRARIES =====//
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+
+//====== USER LIBRARIES =====//
+#include "MUnitTest/MUnitTestApi.hpp"
+
+//===== USER SOURCE =====//
+#include "../api/MPidApi.hpp"
+#include "TestPopulation.hpp"
+
+using namespace MbeddedNinja::MPidNs;
+
+namespace MPidTests
+{
+
+	static const char * testLogPath = "MPidTests_PidLog.bin";
+
+	//! @brief		Runs a bank for numTicks, logging every tick, then replays the log into a new bank made
+	//!				from the log and checks the outputs are identical.
+	template <class dataType> static bool LogReplaysExactly(size_t numControllers, uint32_t numTicks, uint32_t ticksPerBlock)
+	{
+		PidBank<dataType> bank;
+		AddMixedControllers(bank, numControllers);
+
+		PidLogWriter<dataType> writer;
+		if(!writer.Open(testLogPath, bank, PID_LOG_ALL_COLUMNS, ticksPerBlock))
+			return false;
+
+		std::vector<dataType> inputs(numControllers);
+		std::vector<dataType> outputs(numControllers);
+		uint32_t seed = 12345;
+		for(uint32_t t = 0; t < numTicks; t++)
+		{
+			for(size_t i = 0; i < numControllers; i++)
+			{
+				inputs[i] = NextTestInput<dataType>(seed);
+			}
+			// Change a set-point part way through, it should be replayed too
+			if(t == numTicks/2)
+				bank.SetSetPoint(0, dataType(-3));
+
+			bank.RunAll(inputs.data(), outputs.data());
+			writer.AppendTick(bank, inputs.data());
+		}
+		if(!writer.Close())
+			return false;
+
+		PidLogReader<dataType> reader;
+		if(!reader.Open(testLogPath))
+			return false;
+		if(reader.GetNumTicks() != numTicks || reader.GetNumControllers() != numControllers)
+			return false;
+		if(reader.GetNumBlocks() != (numTicks + ticksPerBlock - 1)/ticksPerBlock)
+			return false;
+
+		PidBank<dataType> replayBank;
+		reader.CreateBank(replayBank);
+		PidLogReplayResult result = ReplayPidLog(reader, replayBank);
+
+		return result.numTicks == numTicks && result.numOutputMismatches == 0 &&
+			replayBank.GetITerm(numControllers - 1) == bank.GetITerm(numControllers - 1);
+	}
+
+	MTEST(PidLogReplaysBankExactlyTest)
+	{
+		CHECK(LogReplaysExactly<double>(37, 500, 64));
+		CHECK(LogReplaysExactly<float>(100, 130, 128));
+		CHECK(LogReplaysExactly<Q16_16>(9, 300, 1000));
+		remove(testLogPath);
+	}
+
+	MTEST(PidLogColumnsAreReadInPlaceTest)
+	{
+		PidBank<float> bank;
+		AddMixedControllers(bank, 3);
+
+		{
+			PidLogWriter<float> writer;
+			CHECK(writer.Open(testLogPath, bank, PID_LOG_INPUT | PID_LOG_OUTPUT, 4));
+			for(int t = 0; t < 10; t++)
+			{
+				float inputs[3] = { (float)t, (float)(10*t), (float)(100*t) };
+				float outputs[3] = { -(float)t, 0.0f, 1.0f };
+				writer.AppendTick(inputs, NULL, outputs, NULL);
+			}
+			CHECK_EQUAL(writer.GetNumTicks(), 10);
+		}
+
+		PidLogReader<float> reader;
+		CHECK(reader.Open(testLogPath));
+		CHECK_EQUAL(reader.GetColumnMask(), PID_LOG_INPUT | PID_LOG_OUTPUT);
+		CHECK_EQUAL(reader.GetNumBlocks(), 3);
+
+		// Ticks 4 to 7 are in the second block
+		PidLogBlock<float> block = reader.GetBlock(1);
+		CHECK_EQUAL(block.firstTick, 4);
+		CHECK_EQUAL(block.numTicks, 4);
+		CHECK(block.GetRow(PID_LOG_SET_POINT, 0) == NULL);
+		CHECK_CLOSE(block.GetRow(PID_LOG_INPUT, 1)[2], 500.0f, 0.001f);
+		CHECK_CLOSE(block.GetRow(PID_LOG_OUTPUT, 3)[0], -7.0f, 0.001f);
+		CHECK_EQUAL(((uintptr_t)block.GetRow(PID_LOG_OUTPUT, 0)) % 64, 0);
+
+		CHECK_CLOSE(reader.GetControllerConfig(1).kp, 2.0f, 0.001f);
+
+		// Can't be read back as the wrong type
+		PidLogReader<double> wrongType;
+		CHECK(!wrongType.Open(testLogPath));
+
+		reader.Close();
+		remove(testLogPath);
+	}
+
+	MTEST(PidLogRejectsBlockSizeMismatchTest)
+	{
+		PidBank<float> bank;
+		AddMixedControllers(bank, 3);
+		{
+			PidLogWriter<float> writer;
+			CHECK(writer.Open(testLogPath, bank, PID_LOG_ALL_COLUMNS, 4));
+			for(int t = 0; t < 8; t++)
+			{
+				float inputs[3] = { (float)t, 0.0f, 1.0f };
+				writer.AppendTick(bank, inputs);
+			}
+		}
+
+		FILE * file = fopen(testLogPath, "rb");
+		std::vector<uint8_t> bytes;
+		uint8_t buffer[4096];
+		size_t numRead;
+		while((numRead = fread(buffer, 1, sizeof(buffer), file)) > 0)
+			bytes.insert(bytes.end(), buffer, buffer + numRead);
+		fclose(file);
+
+		PidLogFileHeader header;
+		memcpy(&header, bytes.data(), sizeof(header));
+		PidLogBlockHeader block;
+		memcpy(&block, bytes.data() + header.firstBlockOffset, sizeof(block));
+		CHECK_EQUAL(block.numTicks, 4);
+
+		// A truncated last block is just left out
+		file = fopen(testLogPath, "wb");
+		fwrite(bytes.data(), 1, bytes.size() - 1, file);
+		fclose(file);
+		{
+			PidLogReader<float> reader;
+			CHECK(reader.Open(testLogPath));
+			CHECK_EQUAL(reader.GetNumBlocks(), 1);
+		}
+
+		// The first block's numTicks is too large for it's blockBytes, so it's columns would run
+		// past the end of the file
+		block.numTicks = 4000;
+		memcpy(bytes.data() + header.firstBlockOffset, &block, sizeof(block));
+		file = fopen(testLogPath, "wb");
+		fwrite(bytes.data(), 1, bytes.size(), file);
+		fclose(file);
+		{
+			PidLogReader<float> reader;
+			CHECK(!reader.Open(testLogPath));
+			CHECK_EQUAL(reader.GetNumBlocks(), 0);
+		}
+
+		remove(testLogPath);
+	}
+
+} // namespace MPidTests
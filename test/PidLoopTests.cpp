@@ -0,0 +1,125 @@
+//!
+//! @file 			PidLoopTests.cpp
+//! @author 		Geoffrey Hunter <gbmhunter@gmail.com> (www.mbedded.ninja)
+//! @edited 		n/a
+//! @created		2026-10-16
+//! @last-modified 	2026-10-16
+//! @brief 			Unit tests for the PidLoop class.
+//! @details
+//!					See README.rst in repo root dir for more info.
+
+//===== SYSTEM LIBRARIES =====//
+#include <stdint.h>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+//====== USER LIBRARIES =====//
+#include "MUnitTest/MUnitTestApi.hpp"
+
+//===== USER SOURCE =====//
+#include "../api/MPidApi.hpp"
+
+using namespace MbeddedNinja::MPidNs;
+
+namespace MPidTests
+{
+
+	//! @brief		Runs a bank once per tick, and records the tick numbers it was given.
+	struct LoopBankJob
+	{
+		PidBank<float> * bank;
+		float input;
+		float output;
+		std::vector<uint64_t> ticks;
+		uint64_t slowEvery;		//!< Every slowEvery'th tick takes 3 ms. 0 for never.
+
+		static void Tick(void * context, uint64_t tick)
+		{
+			LoopBankJob * job = static_cast<LoopBankJob *>(context);
+			job->bank->RunAll(&job->input, &job->output);
+			job->ticks.push_back(tick);
+			if(job->slowEvery && tick % job->slowEvery == job->slowEvery - 1)
+				std::this_thread::sleep_for(std::chrono::milliseconds(3));
+		}
+	};
+
+	MTEST(PidLoopRunsAtPeriodTest)
+	{
+		PidBank<float> bank;
+		bank.Add(1.0f, 0.0f, 0.0f, PidBank<float>::ControllerDirection::PID_DIRECT,
+			PidBank<float>::OutputMode::DONT_ACCUMULATE_OUTPUT, 2.0, -10.0f, 10.0f, 1.0f);
+		LoopBankJob job;
+		job.bank = &bank;
+		job.input = 0.0f;
+		job.slowEvery = 0;
+
+		PidLoop loop(PidLoopSettings(2.0));
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		loop.Run(&LoopBankJob::Tick, &job, 25);
+		double elapsedMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+		// Every tick, in order, each after it's deadline
+		CHECK_EQUAL(job.ticks.size(), 25);
+		CHECK_EQUAL(job.ticks[24], 24);
+		CHECK(elapsedMs >= 50.0);
+		CHECK_CLOSE(job.output, 1.0f, 0.0001f);
+
+		PidLoopStats stats = loop.GetStats();
+		CHECK_EQUAL(stats.numTicks, 25);
+		CHECK_EQUAL(stats.wakeLatencyNs.total, 25);
+		CHECK_EQUAL(stats.computeNs.total, 25);
+		CHECK_EQUAL(stats.overrunNs.total, stats.numMisses);
+
+		loop.ResetStats();
+		CHECK_EQUAL(loop.GetStats().numTicks, 0);
+	}
+
+	MTEST(PidLoopCountsDeadlineMissesTest)
+	{
+		PidBank<float> bank;
+		bank.Add(1.0f, 0.0f, 0.0f, PidBank<float>::ControllerDirection::PID_DIRECT,
+			PidBank<float>::OutputMode::DONT_ACCUMULATE_OUTPUT, 1.0, -10.0f, 10.0f, 1.0f);
+		LoopBankJob job;
+		job.bank = &bank;
+		job.input = 0.0f;
+		job.slowEvery = 5;
+
+		// Every 5th tick takes 3 periods, so misses the next deadline and skips at least 2
+		PidLoop loop(PidLoopSettings(1.0));
+		loop.Run(&LoopBankJob::Tick, &job, 20);
+		PidLoopStats stats = loop.GetStats();
+		CHECK(stats.numMisses >= 4);
+		CHECK(stats.numSkipped >= 2*4);
+		CHECK(stats.overrunNs.max >= 1000000);
+		CHECK(stats.computeNs.max >= 3000000);
+	}
+
+	MTEST(PidLoopStartStopTest)
+	{
+		PidBank<float> bank;
+		bank.Add(1.0f, 0.0f, 0.0f, PidBank<float>::ControllerDirection::PID_DIRECT,
+			PidBank<float>::OutputMode::DONT_ACCUMULATE_OUTPUT, 1.0, -10.0f, 10.0f, 1.0f);
+		LoopBankJob job;
+		job.bank = &bank;
+		job.input = 0.0f;
+		job.slowEvery = 0;
+
+		// Asking for SCHED_FIFO without permission still runs, with a hint saying why. (Memory locking
+		// isn't tried, as it would lock the rest of the test run in memory too.)
+		PidLoopSettings settings(1.0);
+		settings.realTime = true;
+		settings.cpu = (int)GetAllowedCpus()[0];
+		PidLoop loop(settings);
+		loop.Start(&LoopBankJob::Tick, &job);
+		CHECK(loop.IsRealTime() || loop.GetHints().size() > 0);
+		CHECK(loop.IsPinned());
+		std::this_thread::sleep_for(std::chrono::milliseconds(20));
+		loop.Stop();
+
+		uint64_t numTicks = loop.GetStats().numTicks;
+		CHECK(numTicks > 0);
+		CHECK_EQUAL(job.ticks.size(), numTicks);
+	}
+
+} // namespace MPidTests
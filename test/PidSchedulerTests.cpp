@@ -0,0 +1,122 @@
+//!
+//! @file 			PidSchedulerTests.cpp
+//! @author 		Geoffrey Hunter <gbmhunter@gmail.com> (www.mbedded.ninja)
+//! @edited 		n/a
+//! @created		2026-10-16
+//! @last-modified 	2026-10-16
+//! @brief 			Unit tests for PidScheduler.
+//! @details
+//!					See README.rst in repo root dir for more info.
+
+//===== SYSTEM LIBRARIES =====//
+#include <vector>
+
+//====== USER LIBRARIES =====//
+#include "MUnitTest/MUnitTestApi.hpp"
+
+//===== USER SOURCE =====//
+#include "../api/MPidApi.hpp"
+
+using namespace MbeddedNinja::MPidNs;
+
+namespace MPidTests
+{
+
+	//! @brief		An integral-only controller whose output counts the number of times it has been run
+	//!				(error is always 1, Zi is 1).
+	static Pid<double> MakeCountingPid()
+	{
+		return Pid<double>(
+			0.0,									//!< Kp
+			1.0,									//!< Ki
+			0.0,									//!< Kd
+			Pid<double>::ControllerDirection::PID_DIRECT,		//!< Control type
+			Pid<double>::OutputMode::DONT_ACCUMULATE_OUTPUT,	//!< Control type
+			1000.0,								//!< Update rate (ms)
+			-1.0e9,									//!< Min output
+			1.0e9,								//!< Max output
+			1.0									//!< Initial set-point
+		);
+	}
+
+	MTEST(PidSchedulerRunsEachRateGroupAtItsPeriodTest)
+	{
+		const double input = 0.0;
+		std::vector<Pid<double>> pids(9, MakeCountingPid());
+
+		PidScheduler<double> scheduler(1);
+		const uint32_t periods[3] = { 1, 10, 100 };
+		for(size_t i = 0; i < pids.size(); i++)
+			CHECK(scheduler.Register(&pids[i], &input, periods[i % 3]));
+
+		CHECK_EQUAL(scheduler.GetNumGroups(), 3);
+		CHECK_EQUAL(scheduler.GetNumRegistered(), 9);
+
+		for(int tick = 0; tick < 1000; tick++)
+			scheduler.Tick();
+
+		CHECK_EQUAL(scheduler.GetTickCount(), 1000);
+		for(size_t i = 0; i < pids.size(); i++)
+			CHECK_CLOSE(pids[i].output, 1000.0/periods[i % 3], 0.001);
+	}
+
+	MTEST(PidSchedulerOnlyRunsDueControllersTest)
+	{
+		const double input = 0.0;
+		std::vector<Pid<double>> pids(3, MakeCountingPid());
+
+		PidScheduler<double> scheduler(1);
+		scheduler.Register(&pids[0], &input, 1);
+		scheduler.Register(&pids[1], &input, 10);
+		scheduler.Register(&pids[2], &input, 100);
+
+		// Tick 0 is a multiple of every period
+		scheduler.Tick();
+		CHECK_EQUAL(scheduler.GetNumRunLastTick(), 3);
+		scheduler.Tick();
+		CHECK_EQUAL(scheduler.GetNumRunLastTick(), 1);
+
+		for(int tick = 2; tick < 10; tick++)
+			scheduler.Tick();
+		scheduler.Tick();
+		CHECK_EQUAL(scheduler.GetNumRunLastTick(), 2);
+	}
+
+	MTEST(PidSchedulerCascadesLongPeriodsTest)
+	{
+		// Periods longer than 64 and 64^2 ticks start in the higher levels of the wheel
+		const double input = 0.0;
+		std::vector<Pid<double>> pids(3, MakeCountingPid());
+
+		PidScheduler<double> scheduler(2);
+		CHECK(scheduler.Register(&pids[0], &input, 2*70));
+		CHECK(scheduler.Register(&pids[1], &input, 2*5000));
+		CHECK(scheduler.Register(&pids[2], &input, 2*65));
+
+		for(int tick = 0; tick < 20000; tick++)
+			scheduler.Tick();
+
+		CHECK_CLOSE(pids[0].output, (double)((20000 + 69)/70), 0.001);
+		CHECK_CLOSE(pids[1].output, 4.0, 0.001);
+		CHECK_CLOSE(pids[2].output, (double)((20000 + 64)/65), 0.001);
+	}
+
+	MTEST(PidSchedulerRejectsBadPeriodsTest)
+	{
+		const double input = 0.0;
+		Pid<double> pid = MakeCountingPid();
+		pid.Run(input);
+
+		PidScheduler<double> scheduler(10);
+		CHECK(!scheduler.Register(&pid, &input, 0));
+		CHECK(!scheduler.Register(&pid, &input, 15));
+		CHECK(scheduler.Register(&pid, &input, 20));
+
+		CHECK(scheduler.Unregister(&pid));
+		CHECK(!scheduler.Unregister(&pid));
+		scheduler.Tick();
+		CHECK_EQUAL(scheduler.GetNumRunLastTick(), 0);
+		CHECK_CLOSE(pid.output, 1.0, 0.001);
+	}
+
+} // namespace MPidTests
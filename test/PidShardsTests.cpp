@@ -0,0 +1,148 @@
+//!
+//! @file 			PidShardsTests.cpp
+//! @author 		Geoffrey Hunter <gbmhunter@gmail.com> (www.mbedded.ninja)
+//! @edited 		n/a
+//! @created		2026-10-16
+//! @last-modified 	2026-10-17
+//! @brief 			Unit tests for the PidShards class and the NUMA helpers in CpuAffinity.hpp.
+//! @details
+//!					See README.rst in repo root dir for more info.
+
+//===== SYSTEM LIBRARIES =====//
+#include <stdint.h>
+#include <string.h>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+//====== USER LIBRARIES =====//
+#include "MUnitTest/MUnitTestApi.hpp"
+
+//===== USER SOURCE =====//
+#include "../api/MPidApi.hpp"
+#include "TestPopulation.hpp"
+#include "../include/CpuAffinity.hpp"
+
+using namespace MbeddedNinja::MPidNs;
+
+namespace MPidTests
+{
+
+	MTEST(ParseCpuListTest)
+	{
+		std::vector<size_t> ids = ParseCpuList("0-3,8,10-11\n");
+		CHECK_EQUAL(ids.size(), 7);
+		CHECK_EQUAL(ids[3], 3);
+		CHECK_EQUAL(ids[4], 8);
+		CHECK_EQUAL(ids[6], 11);
+		CHECK_EQUAL(ParseCpuList("").size(), 0);
+
+		std::vector<size_t> cpus = GetAllowedCpus();
+		CHECK_EQUAL(GetCpuNodes(cpus).size(), cpus.size());
+	}
+
+	MTEST(PidShardsMatchesBankTest)
+	{
+		const size_t numControllers = 10001;
+
+		PidBank<float> bank;
+		PidShards<float> shards(4, false);
+		CHECK_EQUAL(shards.GetNumShards(), 4);
+		CHECK_EQUAL(shards.Size(), 0);
+		for(size_t i = 0; i < numControllers; i++)
+		{
+			AddMixedController(bank, i);
+			CHECK_EQUAL(AddMixedController(shards, i), i);
+		}
+		shards.Build();
+		CHECK_EQUAL(shards.Size(), numControllers);
+
+		// The shards cover every controller exactly once, in order
+		size_t covered = 0;
+		for(size_t s = 0; s < shards.GetNumShards(); s++)
+		{
+			CHECK_EQUAL(shards.GetShardBegin(s), covered);
+			CHECK_EQUAL(shards.GetShardBank(s).Size(), shards.GetShardSize(s));
+			covered += shards.GetShardSize(s);
+		}
+		CHECK_EQUAL(covered, numControllers);
+		CHECK_EQUAL(shards.GetShardOf(0), 0);
+		CHECK_EQUAL(shards.GetShardOf(numControllers - 1), 3);
+		CHECK_EQUAL(shards.GetShardOf(shards.GetShardBegin(2)), 2);
+		CHECK_EQUAL(shards.GetShardOf(shards.GetShardBegin(2) - 1), 1);
+
+		std::vector<float> inputs(numControllers);
+		std::vector<float> bankOutputs(numControllers);
+		std::vector<float> shardOutputs(numControllers);
+		uint32_t seed = 12345;
+		bool identical = true;
+		for(int tick = 0; tick < 20; tick++)
+		{
+			for(size_t i = 0; i < numControllers; i++)
+			{
+				inputs[i] = NextTestInput<float>(seed);
+			}
+			bank.RunAll(inputs.data(), bankOutputs.data());
+
+			// Alternate between routing through the shard buffers and global arrays
+			if(tick % 2 == 0)
+			{
+				for(size_t i = 0; i < numControllers; i++)
+					shards.SetInput(i, inputs[i]);
+				shards.Tick();
+				for(size_t s = 0; s < shards.GetNumShards(); s++)
+					memcpy(&shardOutputs[shards.GetShardBegin(s)], shards.GetShardOutputs(s), shards.GetShardSize(s)*sizeof(float));
+			}
+			else
+				shards.RunAll(inputs.data(), shardOutputs.data());
+
+			identical = identical && memcmp(bankOutputs.data(), shardOutputs.data(), numControllers*sizeof(float)) == 0;
+			identical = identical && (shards.GetOutput(numControllers/2) == bankOutputs[numControllers/2]);
+		}
+		CHECK(identical);
+
+		// Every shard is on some node, and the stats add up to every run
+		std::vector<PidNodeStats> stats = shards.GetNodeStats();
+		CHECK_EQUAL(stats.size(), shards.GetNumNodes());
+		uint64_t numRuns = 0;
+		size_t numShards = 0;
+		for(size_t n = 0; n < stats.size(); n++)
+		{
+			numRuns += stats[n].numRuns;
+			numShards += stats[n].numShards;
+		}
+		CHECK_EQUAL(numRuns, 20*numControllers);
+		CHECK_EQUAL(numShards, 4);
+		shards.ResetStats();
+		CHECK_EQUAL(shards.GetNodeStats()[0].numRuns, 0);
+	}
+
+	//! @brief		Ticks with idle gaps in between, long enough for the workers and the waiting thread to
+	//!				block, still run every controller.
+	MTEST(PidShardsTickAfterIdleTest)
+	{
+		const size_t numControllers = 1001;
+		PidBank<float> bank;
+		PidShards<float> shards(3, false);
+		AddMixedControllers(bank, numControllers);
+		AddMixedControllers(shards, numControllers);
+		shards.Build();
+
+		std::vector<float> inputs(numControllers);
+		std::vector<float> bankOutputs(numControllers);
+		std::vector<float> shardOutputs(numControllers);
+		uint32_t seed = 99;
+		bool identical = true;
+		for(int tick = 0; tick < 10; tick++)
+		{
+			std::this_thread::sleep_for(std::chrono::milliseconds(2));
+			for(size_t i = 0; i < numControllers; i++)
+				inputs[i] = NextTestInput<float>(seed);
+			bank.RunAll(inputs.data(), bankOutputs.data());
+			shards.RunAll(inputs.data(), shardOutputs.data());
+			identical = identical && memcmp(bankOutputs.data(), shardOutputs.data(), numControllers*sizeof(float)) == 0;
+		}
+		CHECK(identical);
+	}
+
+} // namespace MPidTests
@@ -0,0 +1,134 @@
+//!
+//! @file 			PidTraceTests.cpp
+//! @author 		Geoffrey Hunter <gbmhunter@gmail.com> (www.mbedded.ninja)
+//! @edited 		n/a
+//! @created		2026-10-16
+//! @last-modified 	2026-10-16
+//! @brief 			Unit tests for the trace facility (built with M_PID_CONFIG_ENABLE_TRACE=1).
+//! @details
+//!					See README.rst in repo root dir for more info.
+
+//===== SYSTEM LIBRARIES =====//
+#include <vector>
+
+//====== USER LIBRARIES =====//
+#include "MUnitTest/MUnitTestApi.hpp"
+
+//===== USER SOURCE =====//
+#include "../api/MPidApi.hpp"
+
+using namespace MbeddedNinja::MPidNs;
+
+namespace MPidTests
+{
+
+	//! @brief		Stores every record drained by a PidTraceConsumer.
+	static void StoreRecord(void * context, size_t ringId, const PidTraceRecord<double> & record)
+	{
+		(void)ringId;
+		static_cast<std::vector<PidTraceRecord<double>> *>(context)->push_back(record);
+	}
+
+	static Pid<double> MakeTracedPid()
+	{
+		return Pid<double>(
+			2.0,									//!< Kp
+			1.0,									//!< Ki
+			0.0,									//!< Kd
+			Pid<double>::ControllerDirection::PID_DIRECT,		//!< Control type
+			Pid<double>::OutputMode::DONT_ACCUMULATE_OUTPUT,	//!< Control type
+			1000.0,								//!< Update rate (ms)
+			-10.0,									//!< Min output
+			10.0,								//!< Max output
+			5.0									//!< Initial set-point
+		);
+	}
+
+	MTEST(PidTraceRecordsEveryRunTest)
+	{
+		Pid<double> pid = MakeTracedPid();
+		PidTraceRing<double> ring(64);
+		pid.SetTraceRing(&ring);
+
+		std::vector<PidTraceRecord<double>> records;
+		std::vector<double> outputs;
+		{
+			PidTraceConsumer<double> consumer(&StoreRecord, &records, 100);
+			consumer.AddRing(&ring, 0);
+			consumer.Start();
+
+			const double inputs[4] = { 4.0, 3.0, 0.0, 0.0 };
+			for(int i = 0; i < 4; i++)
+			{
+				pid.Run(inputs[i]);
+				outputs.push_back(pid.output);
+			}
+			consumer.Stop();
+			CHECK_EQUAL(consumer.GetNumDrained(), 4);
+		}
+
+		CHECK_EQUAL(records.size(), 4);
+		for(size_t i = 0; i < records.size(); i++)
+		{
+			CHECK_EQUAL(records[i].tick, i);
+			CHECK_CLOSE(records[i].output, outputs[i], 0.0001);
+		}
+		CHECK_CLOSE(records[1].output, records[1].pTerm + records[1].iTerm + records[1].dTerm, 0.0001);
+		CHECK_CLOSE(records[1].error, 2.0, 0.0001);
+		CHECK_EQUAL(records[0].flags, 0);
+		// Error of 5 twice, so the output (and then the integral) hit the top
+		CHECK_EQUAL(records[2].flags, (uint32_t)PID_TRACE_OUTPUT_AT_MAX);
+		CHECK_EQUAL(records[3].flags, (uint32_t)(PID_TRACE_OUTPUT_AT_MAX | PID_TRACE_I_TERM_AT_MAX));
+	}
+
+	MTEST(PidTraceRunBlockMatchesRunTest)
+	{
+		Pid<double> single = MakeTracedPid();
+		Pid<double> block = MakeTracedPid();
+		PidTraceRing<double> singleRing(64);
+		PidTraceRing<double> blockRing(64);
+		single.SetTraceRing(&singleRing);
+		block.SetTraceRing(&blockRing);
+
+		const double inputs[8] = { 4.0, 3.0, 6.0, 1.0, -2.0, 5.0, 5.0, 7.0 };
+		double outputs[8];
+		for(int i = 0; i < 8; i++)
+			single.Run(inputs[i]);
+		block.RunBlock(inputs, outputs, 8);
+
+		bool same = true;
+		PidTraceRecord<double> a;
+		PidTraceRecord<double> b;
+		for(int i = 0; i < 8; i++)
+		{
+			same = same && singleRing.TryPop(a) && blockRing.TryPop(b);
+			same = same && a.tick == b.tick && a.flags == b.flags && a.output == b.output && a.iTerm == b.iTerm;
+		}
+		CHECK(same);
+		CHECK(!blockRing.TryPop(b));
+	}
+
+	MTEST(PidTraceDropsWhenFullTest)
+	{
+		Pid<double> pid = MakeTracedPid();
+		PidTraceRing<double> ring(4);
+		pid.SetTraceRing(&ring);
+
+		for(int i = 0; i < 10; i++)
+			pid.Run(1.0);
+
+		CHECK_EQUAL(ring.GetCapacity(), 4);
+		CHECK_EQUAL(ring.GetNumDropped(), 6);
+
+		// The oldest records are kept
+		PidTraceRecord<double> record;
+		CHECK(ring.TryPop(record));
+		CHECK_EQUAL(record.tick, 0);
+
+		// Tracing can be turned off again
+		pid.SetTraceRing(NULL);
+		pid.Run(1.0);
+		CHECK_EQUAL(ring.GetNumDropped(), 6);
+	}
+
+} // namespace MPidTests
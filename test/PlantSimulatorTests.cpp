@@ -0,0 +1,148 @@
+//!
+//! @file 			PlantSimulatorTests.cpp
+//! @author 		Geoffrey Hunter <gbmhunter@gmail.com> (www.mbedded.ninja)
+//! @edited 		n/a
+//! @created		2026-10-16
+//! @last-modified 	2026-10-17
+//! @brief 			Unit tests for PlantSimulator.
+//! @details
+//!					See README.rst in repo root dir for more info.
+
+//===== SYSTEM LIBRARIES =====//
+#include <math.h>
+
+//====== USER LIBRARIES =====//
+#include "MUnitTest/MUnitTestApi.hpp"
+
+//===== USER SOURCE =====//
+#include "../api/MPidApi.hpp"
+
+using namespace MbeddedNinja::MPidNs;
+
+namespace MPidTests
+{
+
+	typedef PlantSimulator<double>::ControllerDirection SimDir;
+	typedef PlantSimulator<double>::OutputMode SimMode;
+
+	MTEST(PlantSimulatorFirstOrderTest)
+	{
+		// P-only control of 2/(0.5s + 1), checked against the closed form discretisation
+		PlantSimulator<double> sim(10.0);
+		sim.Add(PlantModel::FirstOrder(2.0, 0.5), 1.0, 0.0, 0.0,
+			SimDir::PID_DIRECT, SimMode::DONT_ACCUMULATE_OUTPUT, -100.0, 100.0, 1.0);
+
+		const double a = exp(-0.01/0.5);
+		double y = 0;
+		for(int step = 0; step < 300; step++)
+		{
+			double u = 1.0 - y;
+			y = a*y + 2.0*(1.0 - a)*u;
+			sim.Step();
+		}
+
+		CHECK_CLOSE(sim.GetPlantOutput(0), y, 1e-9);
+		// Steady state is K*Kp/(1 + K*Kp)
+		CHECK_CLOSE(sim.GetPlantOutput(0), 2.0/3.0, 0.001);
+	}
+
+	MTEST(PlantSimulatorSecondOrderTest)
+	{
+		// Undamped 1Hz plant driven by a unit step from rest follows 1 - cos(2*pi*t). The set-point
+		// is far away, so the integral term is held at the output limit of 1 from the first step.
+		PlantSimulator<double> sim(10.0);
+		sim.Add(PlantModel::SecondOrder(1.0, 2.0*M_PI, 0.0), 0.0, 1000.0, 0.0,
+			SimDir::PID_DIRECT, SimMode::DONT_ACCUMULATE_OUTPUT, -1.0, 1.0, 1000.0);
+
+		sim.Run(25);
+		CHECK_CLOSE(sim.GetPlantOutput(0), 1.0, 1e-9);
+		sim.Run(25);
+		CHECK_CLOSE(sim.GetPlantOutput(0), 2.0, 1e-9);
+	}
+
+	MTEST(PlantSimulatorStartsAtRestTest)
+	{
+		// Controllers with no gains hold every kind of plant where it started, including through
+		// dead time and in both output modes
+		PlantSimulator<double> sim(10.0);
+		sim.Add(PlantModel::FirstOrder(2.0, 0.5, 0.05), 0.0, 0.0, 0.0,
+			SimDir::PID_DIRECT, SimMode::DONT_ACCUMULATE_OUTPUT, -100.0, 100.0, 0.0, 3.0);
+		sim.Add(PlantModel::FirstOrder(-0.5, 0.2), 0.0, 0.0, 0.0,
+			SimDir::PID_REVERSE, SimMode::ACCUMULATE_OUTPUT, -100.0, 100.0, 0.0, 3.0);
+		sim.Add(PlantModel::SecondOrder(2.0, 10.0, 0.3, 0.02), 0.0, 0.0, 0.0,
+			SimDir::PID_DIRECT, SimMode::DONT_ACCUMULATE_OUTPUT, -100.0, 100.0, 0.0, -3.0);
+		sim.Add(PlantModel::Integrating(4.0), 0.0, 0.0, 0.0,
+			SimDir::PID_DIRECT, SimMode::ACCUMULATE_OUTPUT, -100.0, 100.0, 0.0, 3.0);
+
+		sim.Run(200);
+
+		CHECK_CLOSE(sim.GetPlantOutput(0), 3.0, 1e-9);
+		CHECK_CLOSE(sim.GetControllerOutput(0), 1.5, 1e-12);
+		CHECK_CLOSE(sim.GetPlantOutput(1), 3.0, 1e-9);
+		CHECK_CLOSE(sim.GetControllerOutput(1), -6.0, 1e-12);
+		CHECK_CLOSE(sim.GetPlantOutput(2), -3.0, 1e-9);
+		CHECK_CLOSE(sim.GetPlantOutput(3), 3.0, 1e-12);
+	}
+
+	MTEST(PlantSimulatorDeadTimeTest)
+	{
+		// Adding a pair with a longer dead time lengthens every delay line, which must not
+		// disturb the pairs already added
+		PlantSimulator<double> sim(10.0);
+		sim.Add(PlantModel::FirstOrder(1.0, 1.0), 1.0, 0.0, 0.0,
+			SimDir::PID_DIRECT, SimMode::DONT_ACCUMULATE_OUTPUT, -100.0, 100.0, 1.0);
+		sim.Add(PlantModel::FirstOrder(1.0, 1.0, 0.05), 1.0, 0.0, 0.0,
+			SimDir::PID_DIRECT, SimMode::DONT_ACCUMULATE_OUTPUT, -100.0, 100.0, 1.0);
+		sim.Add(PlantModel::FirstOrder(1.0, 1.0, 0.02), 1.0, 0.0, 0.0,
+			SimDir::PID_DIRECT, SimMode::DONT_ACCUMULATE_OUTPUT, -100.0, 100.0, 1.0);
+
+		PlantSimulator<double> reference(10.0);
+		reference.Add(PlantModel::FirstOrder(1.0, 1.0), 1.0, 0.0, 0.0,
+			SimDir::PID_DIRECT, SimMode::DONT_ACCUMULATE_OUTPUT, -100.0, 100.0, 1.0);
+
+		// 5 and 2 samples of dead time
+		sim.Run(2);
+		CHECK_EQUAL(sim.GetPlantOutput(2), 0.0);
+		sim.Step();
+		CHECK(sim.GetPlantOutput(2) > 0.0);
+		sim.Run(2);
+		CHECK_EQUAL(sim.GetPlantOutput(1), 0.0);
+		sim.Step();
+		CHECK(sim.GetPlantOutput(1) > 0.0);
+
+		reference.Run(6);
+		CHECK_EQUAL(sim.GetPlantOutput(0), reference.GetPlantOutput(0));
+	}
+
+	MTEST(PlantSimulatorMetricsTest)
+	{
+		// P-only control of an integrating plant, so the error decays by (1 - K*Kp*T) = 0.98 per step
+		PlantSimulator<double> sim(10.0);
+		sim.Add(PlantModel::Integrating(1.0), 2.0, 0.0, 0.0,
+			SimDir::PID_DIRECT, SimMode::DONT_ACCUMULATE_OUTPUT, -100.0, 100.0, 1.0);
+		// Same loop, with an output limit that is hit the whole time
+		sim.Add(PlantModel::Integrating(1.0), 2.0, 0.0, 0.0,
+			SimDir::PID_DIRECT, SimMode::DONT_ACCUMULATE_OUTPUT, -0.1, 0.1, 1.0);
+		// Lightly damped plant under PI control overshoots
+		sim.Add(PlantModel::SecondOrder(1.0, 10.0, 0.1), 1.0, 2.0, 0.0,
+			SimDir::PID_DIRECT, SimMode::DONT_ACCUMULATE_OUTPUT, -100.0, 100.0, 1.0);
+
+		sim.Run(500);
+
+		PlantMetrics<double> metrics = sim.GetMetrics(0);
+		CHECK_CLOSE(metrics.overshoot, 0.0, 1e-12);
+		CHECK_CLOSE(metrics.iae, 0.01/0.02, 0.001);
+		CHECK_CLOSE(metrics.ise, 0.01/(1.0 - 0.98*0.98), 0.001);
+		// The error is first within 2% on step 195
+		CHECK_CLOSE(metrics.settlingTimeS, 1.94, 1e-9);
+		CHECK_CLOSE(metrics.saturationTimeS, 0.0, 1e-12);
+
+		metrics = sim.GetMetrics(1);
+		CHECK_CLOSE(metrics.saturationTimeS, 5.0, 1e-9);
+
+		metrics = sim.GetMetrics(2);
+		CHECK(metrics.overshoot > 0.1);
+		CHECK_EQUAL(sim.GetNumSteps(), 500u);
+	}
+
+} // namespace MPidTests
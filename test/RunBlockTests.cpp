@@ -0,0 +1,126 @@
+//!
+//! @file 			RunBlockTests.cpp
+//! @author 		Geoffrey Hunter <gbmhunter@gmail.com> (www.mbedded.ninja)
+//! @edited 		n/a
+//! @created		2026-10-16
+//! @last-modified 	2026-10-17
+//! @brief 			Unit tests for Pid::RunBlock().
+//! @details
+//!					See README.rst in repo root dir for more info.
+
+//===== SYSTEM LIBRARIES =====//
+#include <stdint.h>
+#include <vector>
+
+//====== USER LIBRARIES =====//
+#include "MUnitTest/MUnitTestApi.hpp"
+
+//===== USER SOURCE =====//
+#include "../api/MPidApi.hpp"
+#include "TestPopulation.hpp"
+
+using namespace MbeddedNinja::MPidNs;
+
+namespace MPidTests
+{
+
+	//! @brief		Runs one controller with Run() and a copy of it with RunBlock() (in several blocks,
+	//!				so state is carried between blocks), and checks every output is identical.
+	template <class dataType> static bool RunBlockMatchesRun(
+		typename Pid<dataType>::ControllerDirection dir, typename Pid<dataType>::OutputMode mode)
+	{
+		Pid<dataType> single(dataType(2), dataType(1), dataType(0.5), dir, mode, 100, dataType(-20), dataType(20), dataType(3));
+		Pid<dataType> block(single);
+
+		const size_t numInputs = 1000;
+		std::vector<dataType> inputs(numInputs);
+		uint32_t seed = 12345;
+		for(size_t i = 0; i < numInputs; i++)
+		{
+			inputs[i] = NextTestInput<dataType>(seed);
+		}
+
+		std::vector<dataType> outputs(numInputs);
+		const size_t blockSizes[4] = { 1, 7, 256, numInputs - 264 };
+		size_t start = 0;
+		for(size_t b = 0; b < 4; b++)
+		{
+			block.RunBlock(&inputs[start], &outputs[start], blockSizes[b]);
+			start += blockSizes[b];
+		}
+
+		for(size_t i = 0; i < numInputs; i++)
+		{
+			single.Run(inputs[i]);
+			if(!(single.output == outputs[i]))
+				return false;
+		}
+
+		// Both controllers must also be left in the same state
+		single.Run(dataType(1));
+		block.Run(dataType(1));
+		return single.output == block.output;
+	}
+
+	template <class dataType> static bool RunBlockMatchesRunAllModes()
+	{
+		typedef typename Pid<dataType>::ControllerDirection Dir;
+		typedef typename Pid<dataType>::OutputMode Mode;
+		return RunBlockMatchesRun<dataType>(Dir::PID_DIRECT, Mode::DONT_ACCUMULATE_OUTPUT) &&
+			RunBlockMatchesRun<dataType>(Dir::PID_DIRECT, Mode::ACCUMULATE_OUTPUT) &&
+			RunBlockMatchesRun<dataType>(Dir::PID_REVERSE, Mode::DONT_ACCUMULATE_OUTPUT) &&
+			RunBlockMatchesRun<dataType>(Dir::PID_REVERSE, Mode::ACCUMULATE_OUTPUT);
+	}
+
+	MTEST(RunBlockMatchesRunDoubleTest)
+	{
+		CHECK(RunBlockMatchesRunAllModes<double>());
+	}
+
+	MTEST(RunBlockMatchesRunFloatTest)
+	{
+		CHECK(RunBlockMatchesRunAllModes<float>());
+	}
+
+	MTEST(RunBlockMatchesRunFixedPointTest)
+	{
+		CHECK(RunBlockMatchesRunAllModes<Q16_16>());
+	}
+
+	MTEST(RunBlockWritesTermsTest)
+	{
+		Pid<double> pid(
+			2.0,									//!< Kp
+			1.0,									//!< Ki
+			0.5,									//!< Kd
+			Pid<double>::ControllerDirection::PID_DIRECT,		//!< Control type
+			Pid<double>::OutputMode::DONT_ACCUMULATE_OUTPUT,	//!< Control type
+			1000.0,								//!< Update rate (ms)
+			-100.0,									//!< Min output
+			100.0,								//!< Max output
+			5.0									//!< Initial set-point
+		);
+
+		const double inputs[3] = { 1.0, 2.0, 4.0 };
+		double outputs[3];
+		double pTerms[3];
+		double iTerms[3];
+		double dTerms[3];
+		pid.RunBlock(inputs, outputs, pTerms, iTerms, dTerms, 3);
+
+		// Errors are 4, 3 and 1
+		CHECK_CLOSE(pTerms[0], 8.0, 0.0001);
+		CHECK_CLOSE(pTerms[1], 6.0, 0.0001);
+		CHECK_CLOSE(pTerms[2], 2.0, 0.0001);
+		CHECK_CLOSE(iTerms[0], 4.0, 0.0001);
+		CHECK_CLOSE(iTerms[1], 7.0, 0.0001);
+		CHECK_CLOSE(iTerms[2], 8.0, 0.0001);
+		// No derivative on the first step
+		CHECK_CLOSE(dTerms[0], 0.0, 0.0001);
+		CHECK_CLOSE(dTerms[1], -0.5, 0.0001);
+		CHECK_CLOSE(dTerms[2], -1.0, 0.0001);
+		for(int i = 0; i < 3; i++)
+			CHECK_CLOSE(outputs[i], pTerms[i] + iTerms[i] + dTerms[i], 0.0001);
+	}
+
+} // namespace MPidTests
@@ -0,0 +1,144 @@
+//!
+//! @file 			RunTimestepTests.cpp
+//! @author 		Geoffrey Hunter <gbmhunter@gmail.com> (www.mbedded.ninja)
+//! @edited 		n/a
+//! @created		2026-10-16
+//! @last-modified 	2026-10-17
+//! @brief 			Unit tests for Pid::Run(input, dt) and Pid::RunAt().
+//! @details
+//!					See README.rst in repo root dir for more info.
+
+//===== SYSTEM LIBRARIES =====//
+#include <stdint.h>
+
+//====== USER LIBRARIES =====//
+#include "MUnitTest/MUnitTestApi.hpp"
+
+//===== USER SOURCE =====//
+#include "../api/MPidApi.hpp"
+
+using namespace MbeddedNinja::MPidNs;
+
+namespace MPidTests
+{
+
+	//! @brief		Checks Run(input, samplePeriod) gives exactly the same outputs as Run(input).
+	template <class dataType> static bool NominalTimestepMatchesRun()
+	{
+		typedef typename Pid<dataType>::ControllerDirection Dir;
+		typedef typename Pid<dataType>::OutputMode Mode;
+
+		Pid<dataType> fixed(dataType(2), dataType(3), dataType(1), Dir::PID_REVERSE, Mode::ACCUMULATE_OUTPUT,
+			10, dataType(-100), dataType(100), dataType(5));
+		Pid<dataType> timed = fixed;
+
+		for(int i = 0; i < 100; i++)
+		{
+			dataType input = dataType(i % 13) - dataType(6);
+			fixed.Run(input);
+			timed.Run(input, 10);
+			if(!(fixed.output == timed.output))
+				return false;
+		}
+		return true;
+	}
+
+	MTEST(RunWithSamplePeriodMatchesRunTest)
+	{
+		CHECK(NominalTimestepMatchesRun<double>());
+		CHECK(NominalTimestepMatchesRun<float>());
+		CHECK(NominalTimestepMatchesRun<Q16_16>());
+	}
+
+	MTEST(RunWithTimestepScalesIntegralAndDerivativeTest)
+	{
+		typedef Pid<double>::ControllerDirection Dir;
+		typedef Pid<double>::OutputMode Mode;
+
+		// Integral only: a time-step of 25ms integrates 2.5 times as much as 10ms
+		Pid<double> integral(0.0, 4.0, 0.0, Dir::PID_DIRECT, Mode::DONT_ACCUMULATE_OUTPUT, 10.0, -100.0, 100.0, 1.0);
+		integral.Run(0.0, 25.0);
+		CHECK_CLOSE(integral.output, 4.0*0.025, 1e-12);
+		integral.Run(0.0, 0.5);
+		CHECK_CLOSE(integral.output, 4.0*0.0255, 1e-12);
+
+		// A time-step of 0 adds nothing
+		integral.Run(0.0, 0.0);
+		CHECK_CLOSE(integral.output, 4.0*0.0255, 1e-12);
+
+		// Derivative only: the same input change over half the time gives twice the output
+		Pid<double> derivative(0.0, 0.0, 0.1, Dir::PID_DIRECT, Mode::DONT_ACCUMULATE_OUTPUT, 10.0, -100.0, 100.0, 0.0);
+		derivative.Run(0.0, 10.0);
+		derivative.Run(1.0, 5.0);
+		CHECK_CLOSE(derivative.output, -0.1*1.0/0.005, 1e-9);
+		derivative.Run(2.0, 10.0);
+		CHECK_CLOSE(derivative.output, -0.1*1.0/0.010, 1e-9);
+
+		// The same as a controller built with that sample period
+		Pid<double> slow(1.0, 4.0, 0.1, Dir::PID_DIRECT, Mode::DONT_ACCUMULATE_OUTPUT, 20.0, -100.0, 100.0, 1.0);
+		Pid<double> timed(1.0, 4.0, 0.1, Dir::PID_DIRECT, Mode::DONT_ACCUMULATE_OUTPUT, 10.0, -100.0, 100.0, 1.0);
+		for(int i = 0; i < 20; i++)
+		{
+			slow.Run((double)(i % 5));
+			timed.Run((double)(i % 5), 20.0);
+		}
+		CHECK_CLOSE(timed.output, slow.output, 1e-9);
+	}
+
+	MTEST(RunAtUsesTimestampDifferencesTest)
+	{
+		typedef Pid<double>::ControllerDirection Dir;
+		typedef Pid<double>::OutputMode Mode;
+
+		Pid<double> stamped(1.0, 4.0, 0.01, Dir::PID_DIRECT, Mode::DONT_ACCUMULATE_OUTPUT, 1.0, -100.0, 100.0, 1.0);
+		Pid<double> timed = stamped;
+
+		// Jittery timestamps, starting at an arbitrary time
+		const uint64_t timestampsNs[] = { 5000000000ull, 5001100000ull, 5001950000ull, 5003000000ull, 5003990000ull };
+		const double expectedDtMs[] = { 1.0, 1.1, 0.85, 1.05, 0.99 };
+		for(int i = 0; i < 5; i++)
+		{
+			stamped.RunAt((double)i, timestampsNs[i]);
+			timed.Run((double)i, expectedDtMs[i]);
+			CHECK_CLOSE(stamped.output, timed.output, 1e-9);
+		}
+
+		// Going backwards counts as no time passing
+		double iTermBefore = stamped.GetState().iTerm;
+		stamped.RunAt(4.0, 5000000000ull);
+		CHECK_CLOSE(stamped.output, 1.0*(1.0 - 4.0) + iTermBefore, 1e-9);
+	}
+
+	MTEST(RunAtKeepsSubMillisecondPrecisionForFixedPointTest)
+	{
+		typedef Pid<Q16_16>::ControllerDirection Dir;
+		typedef Pid<Q16_16>::OutputMode Mode;
+
+		// Integral only, 1ms sample period, error of 1
+		Pid<Q16_16> pid(Q16_16(0), Q16_16(8), Q16_16(0), Dir::PID_DIRECT, Mode::DONT_ACCUMULATE_OUTPUT,
+			1, Q16_16(-100), Q16_16(100), Q16_16(1));
+		pid.RunAt(Q16_16(0), 0);				// 1ms (the sample period)
+		pid.RunAt(Q16_16(0), 250000);			// 0.25ms
+		CHECK_CLOSE(pid.output.ToDouble(), 8.0*0.00125, 0.0002);
+	}
+
+	MTEST(FixedPointTimestepRatiosOfLongTimestepsTest)
+	{
+		// Q8_24 shifts by 24 bits, so nanosecond counts over 2^40 (about 18 minutes) take the
+		// long-division path
+		Q8_24 ratio, invRatio;
+		PidTraits<Q8_24>::TimestepRatios(3000000000000ull, 1000000000000ull, ratio, invRatio);
+		CHECK_EQUAL(ratio.GetRaw(), 3 << 24);
+		CHECK_EQUAL(invRatio.GetRaw(), (1 << 24)/3);
+
+		PidTraits<Q8_24>::TimestepRatios(2000000000001ull, 3000000000000ull, ratio, invRatio);
+		CHECK_EQUAL(ratio.GetRaw(), (2 << 24)/3);
+		CHECK_EQUAL(invRatio.GetRaw(), (3 << 23) - 1);
+
+		// Too big for Q8_24 saturates rather than wrapping
+		PidTraits<Q8_24>::TimestepRatios(1ull << 62, 1000000ull, ratio, invRatio);
+		CHECK_EQUAL(ratio.GetRaw(), INT32_MAX);
+		CHECK_EQUAL(invRatio.GetRaw(), 0);
+	}
+
+} // namespace MPidTests
@@ -0,0 +1,144 @@
+//!
+//! @file 			StaticPidTests.cpp
+//! @author 		Geoffrey Hunter <gbmhunter@gmail.com> (www.mbedded.ninja)
+//! @edited 		n/a
+//! @created		2026-10-16
+//! @last-modified 	2026-10-17
+//! @brief 			Unit tests which check StaticPid gives the same results as Pid.
+//! @details
+//!					See README.rst in repo root dir for more info.
+
+//===== SYSTEM LIBRARIES =====//
+#include <stdint.h>
+#include <string.h>
+
+//====== USER LIBRARIES =====//
+#include "MUnitTest/MUnitTestApi.hpp"
+
+//===== USER SOURCE =====//
+#include "../api/MPidApi.hpp"
+#include "TestPopulation.hpp"
+
+using namespace MbeddedNinja::MPidNs;
+
+namespace MPidTests
+{
+
+	//! @brief		Runs a StaticPid and a Pid side by side on the same pseudo-random inputs
+	//!				and returns true if every output is identical.
+	template <class staticPidType, class dataType> static bool StaticPidMatchesPid(
+		typename Pid<dataType>::ControllerDirection dir,
+		typename Pid<dataType>::OutputMode mode,
+		dataType kp, dataType ki, dataType kd,
+		dataType minOutput, dataType maxOutput)
+	{
+		staticPidType staticPid(kp, ki, kd, 10.0, minOutput, maxOutput, 2.0);
+		Pid<dataType> pid(kp, ki, kd, dir, mode, 10.0, minOutput, maxOutput, 2.0);
+
+		uint32_t seed = 42;
+		for(int i = 0; i < 500; i++)
+		{
+			dataType input = NextTestInput<dataType>(seed);
+
+			// Change the set-point part way through
+			if(i == 250)
+			{
+				staticPid.setPoint = -3.0;
+				pid.setPoint = -3.0;
+			}
+
+			staticPid.Run(input);
+			pid.Run(input);
+			if(!(staticPid.output == pid.output))
+				return false;
+		}
+		return true;
+	}
+
+	MTEST(StaticPidMatchesPidAllModesTest)
+	{
+		typedef Pid<double> PidD;
+
+		CHECK((StaticPidMatchesPid<StaticPid<double, DirectAction, DontAccumulateOutput>, double>(
+			PidD::ControllerDirection::PID_DIRECT, PidD::OutputMode::DONT_ACCUMULATE_OUTPUT, 1.5, 3.0, 0.02, -20.0, 20.0)));
+		CHECK((StaticPidMatchesPid<StaticPid<double, ReverseAction, DontAccumulateOutput>, double>(
+			PidD::ControllerDirection::PID_REVERSE, PidD::OutputMode::DONT_ACCUMULATE_OUTPUT, 1.5, 3.0, 0.02, -20.0, 20.0)));
+		CHECK((StaticPidMatchesPid<StaticPid<double, DirectAction, AccumulateOutput>, double>(
+			PidD::ControllerDirection::PID_DIRECT, PidD::OutputMode::ACCUMULATE_OUTPUT, 0.5, 1.0, 0.01, -20.0, 20.0)));
+		CHECK((StaticPidMatchesPid<StaticPid<double, ReverseAction, AccumulateOutput>, double>(
+			PidD::ControllerDirection::PID_REVERSE, PidD::OutputMode::ACCUMULATE_OUTPUT, 0.5, 1.0, 0.01, -20.0, 20.0)));
+
+		typedef Pid<float> PidF;
+		CHECK((StaticPidMatchesPid<StaticPid<float, ReverseAction, AccumulateOutput>, float>(
+			PidF::ControllerDirection::PID_REVERSE, PidF::OutputMode::ACCUMULATE_OUTPUT, 0.5f, 1.0f, 0.01f, -20.0f, 20.0f)));
+	}
+
+	//! @brief		The derivative term of the first run is exactly 0, like Pid::Run(), even with an
+	//!				infinite Zd (sample period of 0), where -Zd*0 would be NaN.
+	MTEST(StaticPidFirstRunMatchesPidExactlyTest)
+	{
+		typedef Pid<float> PidF;
+		StaticPid<float, DirectAction, DontAccumulateOutput> staticPid(1.0f, 0.5f, 2.0f, 0.0, -10.0f, 10.0f, 1.0f);
+		PidF pid(1.0f, 0.5f, 2.0f, PidF::ControllerDirection::PID_DIRECT, PidF::OutputMode::DONT_ACCUMULATE_OUTPUT,
+			0.0, -10.0f, 10.0f, 1.0f);
+
+		staticPid.Run(0.25f);
+		pid.Run(0.25f);
+		CHECK_CLOSE(staticPid.output, 0.75f, 0.0001f);
+		CHECK(memcmp(&staticPid.output, &pid.output, sizeof(float)) == 0);
+	}
+
+	MTEST(StaticPidNoDerivativeMatchesZeroKdTest)
+	{
+		typedef Pid<double> PidD;
+		CHECK((StaticPidMatchesPid<StaticPid<double, DirectAction, DontAccumulateOutput, NoDerivative>, double>(
+			PidD::ControllerDirection::PID_DIRECT, PidD::OutputMode::DONT_ACCUMULATE_OUTPUT, 1.5, 3.0, 0.0, -20.0, 20.0)));
+	}
+
+	MTEST(StaticPidNoIntegralClampMatchesWhenUnsaturatedTest)
+	{
+		// With limits this wide the integral clamp never engages, so the results must still match
+		typedef Pid<double> PidD;
+		CHECK((StaticPidMatchesPid<StaticPid<double, DirectAction, DontAccumulateOutput, DerivativeOnMeasurement, NoIntegralClamp>, double>(
+			PidD::ControllerDirection::PID_DIRECT, PidD::OutputMode::DONT_ACCUMULATE_OUTPUT, 1.5, 3.0, 0.02, -1.0e9, 1.0e9)));
+	}
+
+	MTEST(StaticPidNoIntegralClampWindsUpTest)
+	{
+		// I-only controller with a tight output limit
+		StaticPid<double, DirectAction, DontAccumulateOutput, NoDerivative, NoIntegralClamp> pidTest(
+			0.0, 10.0, 0.0, 1000.0, -5.0, 5.0, 0.0);
+
+		// Integral winds up past the limit while the output stays clamped
+		pidTest.Run(-1.0);
+		pidTest.Run(-1.0);
+		CHECK_CLOSE(pidTest.output, 5.0, 0.0001);
+
+		// It takes more than one step of opposite error to come back off the limit
+		pidTest.Run(1.0);
+		CHECK_CLOSE(pidTest.output, 5.0, 0.0001);
+		pidTest.Run(1.0);
+		CHECK_CLOSE(pidTest.output, 0.0, 0.0001);
+	}
+
+	MTEST(StaticPidFixedQMatchesPidTest)
+	{
+		StaticPid<Q16_16, ReverseAction, AccumulateOutput> staticPid(
+			Q16_16(1), Q16_16(2), Q16_16(0.1), 10, Q16_16(-50), Q16_16(50), Q16_16(1));
+		Pid<Q16_16> pid(
+			Q16_16(1), Q16_16(2), Q16_16(0.1),
+			Pid<Q16_16>::ControllerDirection::PID_REVERSE, Pid<Q16_16>::OutputMode::ACCUMULATE_OUTPUT,
+			10, Q16_16(-50), Q16_16(50), Q16_16(1));
+
+		for(int i = 0; i < 100; i++)
+		{
+			Q16_16 input = Q16_16::FromRaw((i*7919) % 200000 - 100000);
+			staticPid.Run(input);
+			pid.Run(input);
+			CHECK(staticPid.output == pid.output);
+		}
+	}
+
+} // namespace MPidTests
+
+// EOF
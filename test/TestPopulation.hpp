@@ -0,0 +1,106 @@
+//!
+//! @file 			TestPopulation.hpp
+//! @author 		Geoffrey Hunter <gbmhunter@gmail.com> (www.mbedded.ninja)
+//! @edited 		n/a
+//! @created		2026-10-17
+//! @last-modified 	2026-10-17
+//! @brief 			The mix of controllers and the pseudo-random inputs the unit tests share.
+//! @details
+//!					See README.rst in repo root dir for more info.
+
+#ifndef M_PID_TESTS_TEST_POPULATION_H
+#define M_PID_TESTS_TEST_POPULATION_H
+
+//===== SYSTEM LIBRARIES =====//
+#include <stdint.h>
+#include <stddef.h>
+#include <vector>
+
+//===== USER SOURCE =====//
+#include "../api/MPidApi.hpp"
+
+namespace MPidTests
+{
+
+	//! @brief		Steps the pseudo-random generator every test uses (an LCG), and returns the new seed.
+	inline uint32_t NextTestSeed(uint32_t & seed)
+	{
+		seed = seed*1103515245u + 12345u;
+		return seed;
+	}
+
+	//! @brief		Returns a repeatable pseudo-random integer in [-halfRange, halfRange].
+	inline int32_t NextTestInt(uint32_t & seed, int32_t halfRange)
+	{
+		return (int32_t)((NextTestSeed(seed) >> 16) % (uint32_t)(2*halfRange + 1)) - halfRange;
+	}
+
+	//! @brief		Returns a repeatable pseudo-random input in [-10, 10], in steps of 0.01.
+	template <class dataType> dataType NextTestInput(uint32_t & seed)
+	{
+		return dataType((double)NextTestInt(seed, 1000)/100.0);
+	}
+
+	//! @brief		The settings of controller i of the mixed population.
+	//! @details	Every third controller is reverse-acting and every other one accumulates. The gains
+	//!				and set-point cycle with different periods, so neighbouring controllers (and so the
+	//!				lanes of every SIMD kernel) all differ. The gains are whole numbers, so every dataType
+	//!				(including the integer and FixedQ ones) holds them exactly. The default sample period
+	//!				of 1000ms keeps Zi and Zd whole too.
+	template <class dataType> struct MixedTestController
+	{
+		typedef typename MbeddedNinja::MPidNs::Pid<dataType>::ControllerDirection ControllerDirection;
+		typedef typename MbeddedNinja::MPidNs::Pid<dataType>::OutputMode OutputMode;
+
+		explicit MixedTestController(size_t i) :
+			kp(dataType((double)(1 + i % 4))),
+			ki(dataType((double)(i % 5))),
+			kd(dataType((double)(i % 3))),
+			controllerDir((i % 3 == 0) ? ControllerDirection::PID_REVERSE : ControllerDirection::PID_DIRECT),
+			outputMode((i % 2 == 0) ? OutputMode::ACCUMULATE_OUTPUT : OutputMode::DONT_ACCUMULATE_OUTPUT),
+			minOutput(dataType(-50.0)),
+			maxOutput(dataType(50.0)),
+			setPoint(dataType((double)(i % 7)))
+		{
+		}
+
+		dataType kp, ki, kd;
+		ControllerDirection controllerDir;
+		OutputMode outputMode;
+		dataType minOutput, maxOutput;
+		dataType setPoint;
+	};
+
+	//! @brief		Adds controller i of the mixed population to a PidBank or PidShards.
+	//! @returns	The index Add() returned.
+	template <template <class> class targetType, class dataType>
+	size_t AddMixedController(targetType<dataType> & target, size_t i, uint32_t samplePeriodMs = 1000)
+	{
+		MixedTestController<dataType> c(i);
+		return target.Add(c.kp, c.ki, c.kd, c.controllerDir, c.outputMode,
+			samplePeriodMs, c.minOutput, c.maxOutput, c.setPoint);
+	}
+
+	//! @brief		Appends controller i of the mixed population to an array of Pids.
+	//! @returns	The index of the new Pid.
+	template <class dataType> size_t AddMixedController(
+		std::vector<MbeddedNinja::MPidNs::Pid<dataType>> & pids, size_t i, uint32_t samplePeriodMs = 1000)
+	{
+		MixedTestController<dataType> c(i);
+		pids.push_back(MbeddedNinja::MPidNs::Pid<dataType>(c.kp, c.ki, c.kd, c.controllerDir, c.outputMode,
+			samplePeriodMs, c.minOutput, c.maxOutput, c.setPoint));
+		return pids.size() - 1;
+	}
+
+	//! @brief		Adds controllers 0 to numControllers - 1 of the mixed population to target.
+	template <class targetType> void AddMixedControllers(targetType & target, size_t numControllers, uint32_t samplePeriodMs = 1000)
+	{
+		for(size_t i = 0; i < numControllers; i++)
+			AddMixedController(target, i, samplePeriodMs);
+	}
+
+} // namespace MPidTests
+
+#endif // #ifndef M_PID_TESTS_TEST_POPULATION_H
+
+// EOF
@@ -0,0 +1,132 @@
+//!
+//! @file 			MPidLogReplay.cpp
+//! @author 		Geoffrey Hunter <gbmhunter@gmail.com> (www.mbedded.ninja)
+//! @created		2026-10-16
+//! @last-modified 	2026-10-16
+//! @brief 			Replays a binary controller log (see PidLog.hpp) and checks the outputs match.
+//! @details
+//!					Usage: MPidLogReplay <log>
+//!					       MPidLogReplay --generate <log> <numControllers> <numTicks>
+//!					Replay rebuilds the controllers from the settings stored in the log, feeds them every
+//!					logged input straight out of the mapped file, and reports the throughput and the
+//!					number of outputs which differ from the log. --generate writes a synthetic float log,
+//!					e.g. for measuring replay throughput.
+
+//===== SYSTEM LIBRARIES =====//
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>
+#include <vector>
+
+//===== USER SOURCE =====//
+#include "../api/MPidApi.hpp"
+
+using namespace MbeddedNinja::MPidNs;
+
+//! @brief		Replays a log holding dataType values.
+template <class dataType> static int Replay(const char * path)
+{
+	PidLogReader<dataType> reader;
+	if(!reader.Open(path))
+	{
+		fprintf(stderr, "Could not open '%s' (or it holds a different version or type).\n", path);
+		return 1;
+	}
+
+	PidBank<dataType> bank;
+	reader.CreateBank(bank);
+
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	PidLogReplayResult result = ReplayPidLog(reader, bank);
+	double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+	uint32_t numColumns = 0;
+	for(uint32_t c = 0; c < pidLogNumColumns; c++)
+		if(reader.GetColumnMask() & (1u << c))
+			numColumns++;
+	double logBytes = (double)reader.GetNumTicks()*reader.GetNumControllers()*sizeof(dataType)*numColumns;
+	printf("controllers:       %u\n", reader.GetNumControllers());
+	printf("ticks:             %llu\n", (unsigned long long)result.numTicks);
+	printf("blocks:            %zu\n", reader.GetNumBlocks());
+	printf("seconds:           %.3f\n", seconds);
+	printf("ticks/sec:         %.0f\n", (double)result.numTicks/seconds);
+	printf("MB/s:              %.1f\n", logBytes/seconds/1.0e6);
+	printf("output mismatches: %llu\n", (unsigned long long)result.numOutputMismatches);
+
+	return result.numOutputMismatches == 0 ? 0 : 2;
+}
+
+//! @brief		Writes a float log with pseudo-random inputs.
+static int Generate(const char * path, uint32_t numControllers, uint32_t numTicks)
+{
+	PidBank<float> bank;
+	bank.Reserve(numControllers);
+	for(uint32_t i = 0; i < numControllers; i++)
+		bank.Add(0.8f, 0.4f, 0.01f, PidBank<float>::ControllerDirection::PID_DIRECT,
+			PidBank<float>::OutputMode::DONT_ACCUMULATE_OUTPUT, 10.0, -100.0f, 100.0f, 1.0f);
+
+	PidLogWriter<float> writer;
+	if(!writer.Open(path, bank))
+	{
+		fprintf(stderr, "Could not create '%s'.\n", path);
+		return 1;
+	}
+
+	std::vector<float> inputs(numControllers);
+	std::vector<float> outputs(numControllers);
+	uint32_t seed = 12345;
+	for(uint32_t t = 0; t < numTicks; t++)
+	{
+		for(uint32_t i = 0; i < numControllers; i++)
+		{
+			seed = seed*1103515245u + 12345u;
+			inputs[i] = (float)((seed >> 16) % 2000)/1000.0f - 1.0f;
+		}
+		bank.RunAll(inputs.data(), outputs.data());
+		writer.AppendTick(bank, inputs.data());
+	}
+
+	if(!writer.Close())
+	{
+		fprintf(stderr, "Could not write '%s'.\n", path);
+		return 1;
+	}
+	return 0;
+}
+
+int main(int argc, char ** argv)
+{
+	if(argc == 5 && strcmp(argv[1], "--generate") == 0)
+		return Generate(argv[2], (uint32_t)strtoul(argv[3], NULL, 10), (uint32_t)strtoul(argv[4], NULL, 10));
+
+	if(argc != 2)
+	{
+		fprintf(stderr, "Usage: %s <log>\n       %s --generate <log> <numControllers> <numTicks>\n", argv[0], argv[0]);
+		return 1;
+	}
+
+	PidLogFileHeader header;
+	if(!ReadPidLogHeader(argv[1], header))
+	{
+		fprintf(stderr, "'%s' is not a controller log.\n", argv[1]);
+		return 1;
+	}
+
+	switch(header.typeId)
+	{
+		case PidLogTypeId<float>::value:	return Replay<float>(argv[1]);
+		case PidLogTypeId<double>::value:	return Replay<double>(argv[1]);
+		case PidLogTypeId<int32_t>::value:	return Replay<int32_t>(argv[1]);
+		case PidLogTypeId<Q16_16>::value:	return Replay<Q16_16>(argv[1]);
+#if defined(__SIZEOF_INT128__)
+		case PidLogTypeId<Q32_32>::value:	return Replay<Q32_32>(argv[1]);
+#endif
+		default:
+			fprintf(stderr, "Logs of type ID %u are not supported by this tool.\n", header.typeId);
+			return 1;
+	}
+}
+
+// EOF
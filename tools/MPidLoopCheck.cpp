@@ -0,0 +1,129 @@
+//!
+//! @file 			MPidLoopCheck.cpp
+//! @author 		Geoffrey Hunter <gbmhunter@gmail.com> (www.mbedded.ninja)
+//! @created		2026-10-16
+//! @last-modified 	2026-10-16
+//! @brief 			Runs a bank of controllers in a PidLoop, and reports the wake-up jitter, compute time
+//!					and deadline misses.
+//! @details
+//!					Usage: MPidLoopCheck [--period-ms <ms>] [--controllers <n>] [--seconds <s>]
+//!					                     [--fifo <priority>] [--lock] [--cpu <cpu>]
+//!					For checking a machine's latency budget before deploying to it. Compute time is for
+//!					one PidBank::RunAll() over all the controllers, so it can be compared with the period.
+
+//===== SYSTEM LIBRARIES =====//
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+//===== USER SOURCE =====//
+#include "../api/MPidApi.hpp"
+
+using namespace MbeddedNinja::MPidNs;
+
+//! @brief		Everything one tick needs.
+struct LoopCheckJob
+{
+	PidBank<float> bank;
+	std::vector<float> inputs;
+	std::vector<float> outputs;
+
+	static void Tick(void * context, uint64_t tick)
+	{
+		LoopCheckJob * job = static_cast<LoopCheckJob *>(context);
+		job->inputs[tick % job->inputs.size()] = (float)(tick % 100)/10.0f;
+		job->bank.RunAll(job->inputs.data(), job->outputs.data());
+	}
+};
+
+//! @brief		Returns a percentile in microseconds. Capped at the max, as percentiles are bucket upper bounds.
+static double PercentileUs(const LogHistogramSnapshot & histogram, double fraction)
+{
+	uint64_t value = histogram.Percentile(fraction);
+	return (double)(value < histogram.max ? value : histogram.max)/1000.0;
+}
+
+//! @brief		Prints one histogram as a row of percentiles, in microseconds.
+static void PrintHistogram(const char * name, const LogHistogramSnapshot & histogram)
+{
+	printf("%-14s %10llu %10.1f %10.1f %10.1f %10.1f %10.1f\n", name,
+		(unsigned long long)histogram.total,
+		histogram.Mean()/1000.0,
+		PercentileUs(histogram, 0.5),
+		PercentileUs(histogram, 0.99),
+		PercentileUs(histogram, 0.999),
+		(double)histogram.max/1000.0);
+}
+
+int main(int argc, char ** argv)
+{
+	double periodMs = 1.0;
+	size_t numControllers = 1000;
+	double seconds = 10.0;
+	PidLoopSettings settings(periodMs);
+
+	for(int i = 1; i < argc; i++)
+	{
+		if(strcmp(argv[i], "--period-ms") == 0 && i + 1 < argc)
+			periodMs = atof(argv[++i]);
+		else if(strcmp(argv[i], "--controllers") == 0 && i + 1 < argc)
+			numControllers = (size_t)atol(argv[++i]);
+		else if(strcmp(argv[i], "--seconds") == 0 && i + 1 < argc)
+			seconds = atof(argv[++i]);
+		else if(strcmp(argv[i], "--fifo") == 0 && i + 1 < argc)
+		{
+			settings.realTime = true;
+			settings.priority = atoi(argv[++i]);
+		}
+		else if(strcmp(argv[i], "--lock") == 0)
+			settings.lockMemory = true;
+		else if(strcmp(argv[i], "--cpu") == 0 && i + 1 < argc)
+			settings.cpu = atoi(argv[++i]);
+		else
+		{
+			fprintf(stderr, "Usage: %s [--period-ms <ms>] [--controllers <n>] [--seconds <s>] [--fifo <priority>] [--lock] [--cpu <cpu>]\n", argv[0]);
+			return 1;
+		}
+	}
+	if(!(periodMs > 0) || numControllers == 0)
+	{
+		fprintf(stderr, "The period and number of controllers must be greater than 0.\n");
+		return 1;
+	}
+	settings.periodMs = periodMs;
+
+	LoopCheckJob job;
+	job.bank.Reserve(numControllers);
+	for(size_t i = 0; i < numControllers; i++)
+		job.bank.Add(0.8f, 0.4f, 0.01f, PidBank<float>::ControllerDirection::PID_DIRECT,
+			PidBank<float>::OutputMode::DONT_ACCUMULATE_OUTPUT, periodMs, -100.0f, 100.0f, 1.0f);
+	job.inputs.assign(numControllers, 0.0f);
+	job.outputs.assign(numControllers, 0.0f);
+
+	PidLoop loop(settings);
+	loop.Run(&LoopCheckJob::Tick, &job, (uint64_t)(seconds*1000.0/periodMs));
+
+	printf("period:        %.3f ms\n", periodMs);
+	printf("controllers:   %zu\n", numControllers);
+	printf("SCHED_FIFO:    %s\n", loop.IsRealTime() ? "yes" : "no");
+	printf("memory locked: %s\n", loop.IsMemoryLocked() ? "yes" : "no");
+	printf("pinned:        %s\n", loop.IsPinned() ? "yes" : "no");
+	for(size_t i = 0; i < loop.GetHints().size(); i++)
+		printf("hint:          %s\n", loop.GetHints()[i].c_str());
+
+	PidLoopStats stats = loop.GetStats();
+	printf("\n%-14s %10s %10s %10s %10s %10s %10s\n", "us", "count", "mean", "p50", "p99", "p99.9", "max");
+	PrintHistogram("wake_latency", stats.wakeLatencyNs);
+	PrintHistogram("compute", stats.computeNs);
+	PrintHistogram("overrun", stats.overrunNs);
+	printf("\nticks: %llu, deadline misses: %llu, periods skipped: %llu\n",
+		(unsigned long long)stats.numTicks, (unsigned long long)stats.numMisses, (unsigned long long)stats.numSkipped);
+	printf("compute is %.1f%% of the period on average, %.1f%% at worst\n",
+		stats.computeNs.Mean()/(periodMs*1.0e4), (double)stats.computeNs.max/(periodMs*1.0e4));
+
+	return stats.numMisses == 0 ? 0 : 2;
+}
+
+// EOF